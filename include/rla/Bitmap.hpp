@@ -22,41 +22,181 @@
 
 #pragma once
 
+#include <rla/gray.hpp>
+#include <rla/simd.hpp>
 #include <rlm/cellular/cell_box2.hpp>
+#include <rlm/color/color_rgb.hpp>
+#include <rlm/color/color_rgba.hpp>
+#include <array>
 #include <cstddef>
 #include <string>
 #include <optional>
+#include <span>
+#include <vector>
 
 namespace rl
 {
     class Image;
     class Png;
+    struct ExecutionPolicy;
 
     class Bitmap
     {
         public:
+            // the sub-byte depths Single, Duple and Quadruple pack 1, 2 or 4 bit channels into each byte with the first
+            // pixel in the most significant bits, like pngs do. their rows start on whole bytes, so views and blits of
+            // sub-byte bitmaps start on a pixel that starts a byte. their channel size is 0. the Half depth stores
+            // normalized channels as ieee binary16 floats, which convert to and from the other depths through 32 bit
+            // floats.
             enum class Depth
             {
                 Octuple = 0,
                 Sexdecuple = 1,
                 Normalized = 2,
+                Single = 3,
+                Duple = 4,
+                Quadruple = 5,
+                Half = 6,
                 Default = Octuple
             };
 
+            // indexed pixels are one index into the palette of their bitmap, so indexed bitmaps have octuple or sub-byte
+            // depth. indexes past the end of the palette are transparent black.
             enum class Color
             {
                 G = 0,
                 Ga = 1,
                 Rgb = 2,
                 Rgba = 3,
+                Indexed = 4,
                 Default = Rgb
             };
 
+            // linear bitmaps store each row after the other. tiled bitmaps store square tiles of pixels after each
+            // other, with the rows of each tile stored after the other, and row_offset being the offset between rows of
+            // tiles. tiles are padded at the right and bottom edges of each page. planar bitmaps store each channel in
+            // its own plane of rows, with plane_offset being the offset between the planes of a page.
+            enum class Layout
+            {
+                Linear = 0,
+                Tiled = 1,
+                Planar = 2,
+                Default = Linear
+            };
+
+            // how blits combine the source with the destination, using normalized channels where s is the source, d is
+            // the destination and sa and da are their alphas. the alpha of sources and destinations without one is 1.
+            // Replace: c = s
+            // Over: straight alpha source over, a = sa + da (1 - sa), c = (s sa + d da (1 - sa)) / a
+            // OverPremultiplied: premultiplied alpha source over, c = s + d (1 - sa), a = sa + da (1 - sa)
+            // Add: c = min(1, d + s sa), a = min(1, da + sa)
+            // Multiply: c = d (1 - sa + s sa), a = da
+            enum class Blend
+            {
+                Replace = 0,
+                Over = 1,
+                OverPremultiplied = 2,
+                Add = 3,
+                Multiply = 4,
+                Default = Replace
+            };
+
+            // premultiplied bitmaps store their colors multiplied by their alpha. the flag only matters for colors with
+            // an alpha channel, and blits and pngs premultiply or unpremultiply while they convert.
+            enum class Alpha
+            {
+                Straight = 0,
+                Premultiplied = 1,
+                Default = Straight
+            };
+
+            // the transfer function of the color channels. srgb channels are gamma encoded like the pixels of pngs, linear
+            // channels are proportional to light, which filters and blends need to be correct. alpha is always linear.
+            // blits between bitmaps of different spaces decode or encode the colors while they convert.
+            enum class Space
+            {
+                Srgb = 0,
+                Linear = 1,
+                Default = Srgb
+            };
+
+            // the filters Resample scales with. box averages the source pixels each destination pixel covers, bilinear
+            // interpolates between the nearest source pixels, and lanczos3 is a windowed sinc over three source pixels
+            // each way that keeps the most detail.
+            enum class Filter
+            {
+                Box = 0,
+                Bilinear = 1,
+                Lanczos3 = 2,
+                Default = Bilinear
+            };
+
+            // how a transformed blit turns the source. the rotations are clockwise, and transpose mirrors the source across
+            // the diagonal from its top left corner. the rotations by 90 and 270 and transpose swap the width and height.
+            enum class Transform
+            {
+                None = 0,
+                FlipHorizontal = 1,
+                FlipVertical = 2,
+                Rotate90 = 3,
+                Rotate180 = 4,
+                Rotate270 = 5,
+                Transpose = 6,
+                Default = None
+            };
+
             using byte_t = std::byte;
 
             using octuple_t = std::uint8_t;
             using sexdecuple_t = std::uint16_t;
             using normalized_t = float;
+            // the bits of a binary16 float
+            using half_t = std::uint16_t;
+
+            // the straight alpha colors of an indexed bitmap. bitmaps and views only point to their palette, images
+            // own theirs.
+            using palette_t = std::span<const rl::color_rgba<rl::Bitmap::octuple_t>>;
+
+            // source pixels with the color of a key are made transparent, or are left out of a blit. the key is
+            // converted to the format of the source and compared with its color channels exactly. blends always leave
+            // keyed pixels out.
+            struct color_key
+            {
+                enum class Mode
+                {
+                    Transparent = 0,
+                    Skip = 1,
+                    Default = Transparent
+                };
+
+                rl::color_rgb<rl::Bitmap::octuple_t> color;
+                rl::Bitmap::color_key::Mode mode = rl::Bitmap::color_key::Mode::Default;
+            };
+
+            // the statistics of the channels of a view, in the order of its channels. sub-byte channels count as the
+            // octuple values a blit would scale them to, and indexes count as they are. integer channels fall in the bin
+            // of their top 8 bits and float channels in the bin of their value clamped to [0, 1] and scaled to 255.
+            // a pixel is non-zero when its alpha is, or when any of its channels is for colors without alpha.
+            struct statistics
+            {
+                std::array<std::array<std::size_t, 256>, 4> histograms = {};
+                std::array<double, 4> minimums = {};
+                std::array<double, 4> maximums = {};
+                std::array<double, 4> means = {};
+                std::size_t non_zero_count = 0;
+                // the smallest box around the non-zero pixels of every page
+                std::optional<rl::cell_box2<int>> non_zero_box_o = std::nullopt;
+            };
+
+            // converts a row of width pixels from one format to another. the scalar converters can convert in place when
+            // both rows start at the same address, the simd converters need rows that do not overlap.
+            using row_converter_t = void (*)(const rl::Bitmap::byte_t* source, rl::Bitmap::byte_t* destination, std::size_t width) noexcept;
+            // turns a row of width rgb or rgba pixels gray with the given mode, keeping the depth. both kinds of converter
+            // shrink rows in place when they start at the same address.
+            using gray_converter_t = void (*)(const rl::Bitmap::byte_t* source, rl::Bitmap::byte_t* destination, std::size_t width, const rl::gray_mode& gray) noexcept;
+            // blends a row of width pixels into a row of the destination format. the source row has the depth of the
+            // destination, and is Ga for gray destinations or Rgba for color destinations.
+            using row_blender_t = void (*)(const rl::Bitmap::byte_t* source, rl::Bitmap::byte_t* destination, std::size_t width) noexcept;
 
             class Row;
             class View;
@@ -64,27 +204,63 @@ namespace rl
             class Row
             {
             protected:
-                rl::Bitmap::byte_t* data;
+                rl::Bitmap::byte_t* data = nullptr;
                 std::size_t width = 0;
                 rl::Bitmap::Depth depth = rl::Bitmap::Depth::Default;
                 rl::Bitmap::Color color = rl::Bitmap::Color::Default;
+                rl::Bitmap::Layout layout = rl::Bitmap::Layout::Default;
+                std::size_t plane_offset = 0;
+                rl::Bitmap::Alpha alpha = rl::Bitmap::Alpha::Default;
+                rl::Bitmap::palette_t palette = {};
+                rl::Bitmap::Space space = rl::Bitmap::Space::Default;
+
+            public:
+                class View;
+
+            protected:
+                // blits a row of the same width with the gray mode already picked, so nested blits all use it.
+                void blit(const rl::Bitmap::Row::View& row, rl::Bitmap::Blend blend, const rl::gray_mode& gray);
+                void blit_planar(const rl::Bitmap::Row::View& row);
+                void blit_blended(const rl::Bitmap::Row::View& row, rl::Bitmap::Blend blend, const rl::gray_mode& gray);
+                void blit_alpha(const rl::Bitmap::Row::View& row, const rl::gray_mode& gray);
+                // turns rgb sources gray at their own depth, before anything else about them changes.
+                void blit_gray(const rl::Bitmap::Row::View& row, const rl::gray_mode& gray);
+                // expands indexed sources through their palette, and maps other sources to the nearest colors of an
+                // indexed destination. indexes copy straight over between indexed rows.
+                void blit_indexed(const rl::Bitmap::Row::View& row, rl::Bitmap::Blend blend, const rl::gray_mode& gray);
+                // unpacks sub-byte sources and packs sub-byte destinations through octuple chunks of the same color.
+                void blit_sub_byte(const rl::Bitmap::Row::View& row, rl::Bitmap::Blend blend, const rl::gray_mode& gray);
+                // decodes srgb sources to linear or encodes linear sources to srgb through normalized chunks of the same
+                // color.
+                void blit_space(const rl::Bitmap::Row::View& row, rl::Bitmap::Blend blend, const rl::gray_mode& gray);
 
             public:
                 class View
                 {
                     protected:
-                        const rl::Bitmap::byte_t* data;
+                        const rl::Bitmap::byte_t* data = nullptr;
                         std::size_t width = 0;
                         rl::Bitmap::Depth depth = rl::Bitmap::Depth::Default;
                         rl::Bitmap::Color color = rl::Bitmap::Color::Default; 
+                        rl::Bitmap::Layout layout = rl::Bitmap::Layout::Default;
+                        std::size_t plane_offset = 0;
+                        rl::Bitmap::Alpha alpha = rl::Bitmap::Alpha::Default;
+                        rl::Bitmap::palette_t palette = {};
+                        rl::Bitmap::Space space = rl::Bitmap::Space::Default;
 
                     public:
                         constexpr View() noexcept = default;
+                        // rows can only have a linear or planar layout.
                         constexpr View(
                             const rl::Bitmap::byte_t* data,
                             std::size_t width,
                             rl::Bitmap::Depth depth,
-                            rl::Bitmap::Color color
+                            rl::Bitmap::Color color,
+                            rl::Bitmap::Layout layout = rl::Bitmap::Layout::Default,
+                            std::optional<std::size_t> plane_offset_o = std::nullopt,
+                            rl::Bitmap::Alpha alpha = rl::Bitmap::Alpha::Default,
+                            rl::Bitmap::palette_t palette = {},
+                            rl::Bitmap::Space space = rl::Bitmap::Space::Default
                         ) noexcept;
                         constexpr View(const rl::Bitmap::Row& row) noexcept;
                         constexpr rl::Bitmap::Row::View& operator=(const rl::Bitmap::Row& row) noexcept;
@@ -92,6 +268,13 @@ namespace rl
                         constexpr std::size_t GetWidth() const noexcept;
                         constexpr rl::Bitmap::Depth GetDepth() const noexcept;
                         constexpr rl::Bitmap::Color GetColor() const noexcept;
+                        constexpr rl::Bitmap::Layout GetLayout() const noexcept;
+                        constexpr std::size_t GetPlaneOffset() const noexcept;
+                        constexpr rl::Bitmap::Alpha GetAlpha() const noexcept;
+                        constexpr rl::Bitmap::palette_t GetPalette() const noexcept;
+                        constexpr rl::Bitmap::Space GetSpace() const noexcept;
+                        // true if the colors are premultiplied by an alpha channel.
+                        constexpr bool GetIsPremultiplied() const noexcept;
                         constexpr const rl::Bitmap::byte_t* GetData() const noexcept;
                         constexpr const rl::Bitmap::byte_t* GetData(std::size_t x, std::size_t channel = 0) const noexcept;
                         constexpr std::size_t GetChannelSize() const noexcept;
@@ -102,24 +285,38 @@ namespace rl
 
             public:
                 constexpr Row() noexcept = default;
+                // rows can only have a linear or planar layout.
                 constexpr Row(
                     rl::Bitmap::byte_t* data,
                     std::size_t width,
                     rl::Bitmap::Depth depth,
-                    rl::Bitmap::Color color
+                    rl::Bitmap::Color color,
+                    rl::Bitmap::Layout layout = rl::Bitmap::Layout::Default,
+                    std::optional<std::size_t> plane_offset_o = std::nullopt,
+                    rl::Bitmap::Alpha alpha = rl::Bitmap::Alpha::Default,
+                    rl::Bitmap::palette_t palette = {},
+                    rl::Bitmap::Space space = rl::Bitmap::Space::Default
                 ) noexcept;
                 virtual ~Row() noexcept = default;
                 
                 constexpr std::size_t GetWidth() const noexcept;
                 constexpr rl::Bitmap::Depth GetDepth() const noexcept;
                 constexpr rl::Bitmap::Color GetColor() const noexcept;
+                constexpr rl::Bitmap::Layout GetLayout() const noexcept;
+                constexpr std::size_t GetPlaneOffset() const noexcept;
+                constexpr rl::Bitmap::Alpha GetAlpha() const noexcept;
+                constexpr rl::Bitmap::palette_t GetPalette() const noexcept;
+                constexpr rl::Bitmap::Space GetSpace() const noexcept;
+                // true if the colors are premultiplied by an alpha channel.
+                constexpr bool GetIsPremultiplied() const noexcept;
                 constexpr rl::Bitmap::byte_t* GetData() const noexcept;
                 constexpr rl::Bitmap::byte_t* GetData(std::size_t x, std::size_t channel = 0) const noexcept;
                 constexpr std::size_t GetChannelSize() const noexcept;
                 constexpr std::size_t GetBitDepth() const noexcept;
                 constexpr std::size_t GetSize() const noexcept;
                 constexpr std::optional<std::size_t> GetByteIndex(std::size_t x, std::size_t channel = 0) const noexcept;
-                constexpr void Blit(const rl::Bitmap::Row::View& row);
+                // colors blit into gray rows with the given gray mode, or with the default mode of rl::get_gray.
+                void Blit(const rl::Bitmap::Row::View& row, rl::Bitmap::Blend blend = rl::Bitmap::Blend::Default, std::optional<rl::gray_mode> gray_o = std::nullopt);
             };
 
             class View
@@ -133,6 +330,11 @@ namespace rl
                     rl::Bitmap::Color color = rl::Bitmap::Color::Default;
                     std::size_t row_offset = 0;
                     std::size_t page_offset = 0;
+                    rl::Bitmap::Layout layout = rl::Bitmap::Layout::Default;
+                    std::size_t plane_offset = 0;
+                    rl::Bitmap::Alpha alpha = rl::Bitmap::Alpha::Default;
+                    rl::Bitmap::palette_t palette = {};
+                    rl::Bitmap::Space space = rl::Bitmap::Space::Default;
 
                 public:
                     constexpr View() noexcept = default;
@@ -144,7 +346,12 @@ namespace rl
                         rl::Bitmap::Depth depth,
                         rl::Bitmap::Color color,
                         std::optional<std::size_t> row_offset_o = std::nullopt,
-                        std::optional<std::size_t> page_offset_o = std::nullopt
+                        std::optional<std::size_t> page_offset_o = std::nullopt,
+                        rl::Bitmap::Layout layout = rl::Bitmap::Layout::Default,
+                        std::optional<std::size_t> plane_offset_o = std::nullopt,
+                        rl::Bitmap::Alpha alpha = rl::Bitmap::Alpha::Default,
+                        rl::Bitmap::palette_t palette = {},
+                        rl::Bitmap::Space space = rl::Bitmap::Space::Default
                     ) noexcept;
                     constexpr View(const rl::Bitmap& bitmap) noexcept;
                     constexpr rl::Bitmap::View& operator=(const rl::Bitmap& bitmap) noexcept;
@@ -158,6 +365,13 @@ namespace rl
                     constexpr std::size_t GetBitDepth() const noexcept;
                     constexpr std::size_t GetRowOffset() const noexcept;
                     constexpr std::size_t GetPageOffset() const noexcept;
+                    constexpr rl::Bitmap::Layout GetLayout() const noexcept;
+                    constexpr std::size_t GetPlaneOffset() const noexcept;
+                    constexpr rl::Bitmap::Alpha GetAlpha() const noexcept;
+                    constexpr rl::Bitmap::palette_t GetPalette() const noexcept;
+                    constexpr rl::Bitmap::Space GetSpace() const noexcept;
+                    // true if the colors are premultiplied by an alpha channel.
+                    constexpr bool GetIsPremultiplied() const noexcept;
                     constexpr const rl::Bitmap::byte_t* GetData() const noexcept;
                     constexpr const rl::Bitmap::byte_t* GetData(std::size_t x, std::size_t y = 0, std::size_t page = 0, std::size_t channel = 0) const noexcept;
                     constexpr std::size_t GetChannelCount() const noexcept;
@@ -170,7 +384,16 @@ namespace rl
                     constexpr const rl::Bitmap::View GetBitmapView(std::optional<rl::Bitmap::Depth> fake_depth_o = std::nullopt, std::optional<rl::Bitmap::Color> fake_color_o = std::nullopt) const;
                     constexpr const rl::Bitmap::View GetBitmapView(std::size_t x, std::size_t y, std::size_t page, std::size_t width, std::size_t height, std::size_t page_count, std::optional<rl::Bitmap::Depth> fake_depth_o = std::nullopt, std::optional<rl::Bitmap::Color> fake_color_o = std::nullopt) const;
                     constexpr const rl::Bitmap::Row::View GetRowView(std::size_t y, std::size_t page, std::optional<rl::Bitmap::Depth> fake_depth_o = std::nullopt, std::optional<rl::Bitmap::Color> fake_color_o = std::nullopt) const;
+                    // views one channel plane of a planar bitmap as a gray bitmap without copying it.
+                    constexpr const rl::Bitmap::View GetPlaneView(std::size_t channel) const;
                     void Save(std::string_view path, std::size_t page = 0);
+                    void Save(const rl::ExecutionPolicy& policy, std::string_view path, std::size_t page = 0);
+                    // gathers the statistics of every page in one pass over the pixels.
+                    rl::Bitmap::statistics GetStatistics() const;
+                    rl::Bitmap::statistics GetStatistics(const rl::ExecutionPolicy& policy) const;
+
+                protected:
+                    rl::Bitmap::statistics get_statistics(const rl::ExecutionPolicy* policy_p) const;
             };
 
         public:
@@ -178,11 +401,36 @@ namespace rl
             static constexpr std::size_t GetChannelSize(rl::Bitmap::Depth depth) noexcept;
             static constexpr std::size_t GetBitDepth(rl::Bitmap::Depth depth) noexcept;
             static constexpr rl::Bitmap::Depth GetDepth(std::size_t bit_depth) noexcept;
+            // true for the depths that pack more than one channel into each byte.
+            static constexpr bool GetIsSubByte(rl::Bitmap::Depth depth) noexcept;
+            // true for the transforms that swap the width and height.
+            static constexpr bool GetIsTransposed(rl::Bitmap::Transform transform) noexcept;
             static constexpr std::size_t GetPixelSize(rl::Bitmap::Depth depth, rl::Bitmap::Color color) noexcept;
             static constexpr std::size_t GetRowSize(std::size_t width, rl::Bitmap::Depth depth, rl::Bitmap::Color color) noexcept;
-            static constexpr std::size_t GetPageSize(std::size_t width, std::size_t height, rl::Bitmap::Depth depth, rl::Bitmap::Color color) noexcept;
-            static constexpr std::size_t GetSize(std::size_t width, std::size_t height, std::size_t pages, rl::Bitmap::Depth depth, rl::Bitmap::Color color) noexcept;
-            static constexpr std::optional<std::size_t> GetByteIndex(std::size_t width, std::size_t height, std::size_t pages, rl::Bitmap::Depth depth, rl::Bitmap::Color color, std::size_t row_offset, std::size_t page_offset, std::size_t x, std::size_t y, std::size_t page, std::size_t channel) noexcept;
+            static constexpr std::size_t GetPageSize(std::size_t width, std::size_t height, rl::Bitmap::Depth depth, rl::Bitmap::Color color, rl::Bitmap::Layout layout = rl::Bitmap::Layout::Linear) noexcept;
+            static constexpr std::size_t GetSize(std::size_t width, std::size_t height, std::size_t pages, rl::Bitmap::Depth depth, rl::Bitmap::Color color, rl::Bitmap::Layout layout = rl::Bitmap::Layout::Linear) noexcept;
+            // the width and height of the square tiles of tiled bitmaps in pixels.
+            static constexpr std::size_t GetTileWidth() noexcept;
+            static constexpr std::size_t GetTileSize(rl::Bitmap::Depth depth, rl::Bitmap::Color color) noexcept;
+            static constexpr std::size_t GetTileRowSize(std::size_t width, rl::Bitmap::Depth depth, rl::Bitmap::Color color) noexcept;
+            static constexpr std::optional<std::size_t> GetByteIndex(std::size_t width, std::size_t height, std::size_t pages, rl::Bitmap::Depth depth, rl::Bitmap::Color color, std::size_t row_offset, std::size_t page_offset, std::size_t x, std::size_t y, std::size_t page, std::size_t channel, rl::Bitmap::Layout layout = rl::Bitmap::Layout::Linear, std::size_t plane_offset = 0) noexcept;
+            // returns nullptr for indexed and sub-byte formats, which only blits can convert. rgb to gray conversions use
+            // rl::Gray::Default, while the gray converters are given their mode.
+            static constexpr rl::Bitmap::row_converter_t GetRowConverter(rl::Bitmap::Depth source_depth, rl::Bitmap::Color source_color, rl::Bitmap::Depth destination_depth, rl::Bitmap::Color destination_color) noexcept;
+            // returns nullptr if there is no kernel for the conversion at the given level. the kernels are bit exact
+            // with the scalar converters and cover every pair of octuple, sexdecuple and normalized formats, adding half
+            // on avx2 and neon. rgb to gray conversions only have kernels on ssse3 and avx2, and none from half.
+            static rl::Bitmap::row_converter_t GetRowConverter(rl::SimdLevel level, rl::Bitmap::Depth source_depth, rl::Bitmap::Color source_color, rl::Bitmap::Depth destination_depth, rl::Bitmap::Color destination_color) noexcept;
+            // returns nullptr unless the source is rgb or rgba and the destination g or ga of a whole byte depth.
+            static constexpr rl::Bitmap::gray_converter_t GetGrayConverter(rl::Bitmap::Depth depth, rl::Bitmap::Color source_color, rl::Bitmap::Color destination_color) noexcept;
+            // returns nullptr if there is no kernel for the conversion at the given level.
+            static rl::Bitmap::gray_converter_t GetGrayConverter(rl::SimdLevel level, rl::Bitmap::Depth depth, rl::Bitmap::Color source_color, rl::Bitmap::Color destination_color) noexcept;
+            // the normalized value of every octuple or sexdecuple channel value, decoded from srgb to linear if is_linear
+            // is true. empty for the other depths. each table is built once, the first time it is used.
+            static std::span<const rl::Bitmap::normalized_t> GetNormalizedTable(rl::Bitmap::Depth depth, bool is_linear = false) noexcept;
+            // the distinct octuple colors of every page of a bitmap in the order they first appear, or nullopt if there
+            // are more than the max color count. indexed bitmaps go through their palette.
+            static std::optional<std::vector<rl::color_rgba<rl::Bitmap::octuple_t>>> FindPalette(const rl::Bitmap::View& bitmap, std::size_t max_color_count = 256);
     
         protected:
             rl::Bitmap::byte_t* data = nullptr;
@@ -193,8 +441,33 @@ namespace rl
             rl::Bitmap::Color color = rl::Bitmap::Color::Default;
             std::size_t row_offset = 0;
             std::size_t page_offset = 0;
+            rl::Bitmap::Layout layout = rl::Bitmap::Layout::Default;
+            std::size_t plane_offset = 0;
+            rl::Bitmap::Alpha alpha = rl::Bitmap::Alpha::Default;
+            rl::Bitmap::palette_t palette = {};
+            rl::Bitmap::Space space = rl::Bitmap::Space::Default;
 
-            constexpr bool blit_fits(const rl::cell_box2<int>& blit_box, std::size_t page) const noexcept;
+            constexpr bool blit_fits(const rl::cell_box2<int>& blit_box, std::size_t page, std::size_t page_count = 1) const noexcept;
+            static constexpr std::size_t get_extent(std::size_t width, std::size_t height, std::size_t page_count, rl::Bitmap::Depth depth, rl::Bitmap::Color color, std::size_t row_offset, std::size_t page_offset, rl::Bitmap::Layout layout = rl::Bitmap::Layout::Linear, std::size_t plane_offset = 0) noexcept;
+            static rl::Bitmap::row_converter_t get_fastest_row_converter(const rl::Bitmap::byte_t* source, std::size_t source_extent, rl::Bitmap::Depth source_depth, rl::Bitmap::Color source_color, const rl::Bitmap::byte_t* destination, std::size_t destination_extent, rl::Bitmap::Depth destination_depth, rl::Bitmap::Color destination_color) noexcept;
+            // decodes octuple and sexdecuple srgb colors to linear normalized or half colors through the linear tables,
+            // leaving alpha linear. returns nullptr for other conversions. converts in place like the scalar converters.
+            static rl::Bitmap::row_converter_t get_linear_row_converter(rl::Bitmap::Depth source_depth, rl::Bitmap::Color source_color, rl::Bitmap::Depth destination_depth, rl::Bitmap::Color destination_color) noexcept;
+            rl::Bitmap::row_converter_t get_blit_converter(const rl::Bitmap::View& bitmap, std::size_t x, std::size_t y, std::size_t page) const noexcept;
+            // picks the simd kernel for the current simd level if there is one.
+            static rl::Bitmap::row_blender_t get_row_blender(rl::Bitmap::Blend blend, rl::Bitmap::Depth depth, rl::Bitmap::Color color) noexcept;
+            // true if a blit between the formats has to premultiply or unpremultiply the colors.
+            static constexpr bool get_is_alpha_conversion(rl::Bitmap::Color source_color, bool is_source_premultiplied, bool is_destination_premultiplied) noexcept;
+            // premultiplies or unpremultiplies the colors of a row in place. colors without alpha are left unchanged.
+            static void premultiply_row(rl::Bitmap::byte_t* data, std::size_t width, rl::Bitmap::Depth depth, rl::Bitmap::Color color) noexcept;
+            static void unpremultiply_row(rl::Bitmap::byte_t* data, std::size_t width, rl::Bitmap::Depth depth, rl::Bitmap::Color color) noexcept;
+            // the policy is only used to convert the loaded rows, decoding is always serial.
+            void blit_png(std::string_view path, std::size_t x, std::size_t y, std::size_t page, const rl::ExecutionPolicy* policy_p, const std::optional<rl::Bitmap::color_key>& color_key_o, const rl::gray_mode& gray);
+            void resample(const rl::Bitmap::View& bitmap, rl::Bitmap::Filter filter, const rl::ExecutionPolicy* policy_p);
+            void fill(const rl::color_rgba<rl::Bitmap::normalized_t>& color, std::size_t x, std::size_t y, std::size_t page, std::size_t width, std::size_t height, std::size_t page_count, const rl::ExecutionPolicy* policy_p);
+            void blit_transformed(const rl::Bitmap::View& bitmap, rl::Bitmap::Transform transform, std::size_t x, std::size_t y, std::size_t page, const rl::ExecutionPolicy* policy_p);
+            void move(std::size_t x, std::size_t y, std::size_t page, std::size_t width, std::size_t height, std::size_t page_count, std::size_t destination_x, std::size_t destination_y, std::size_t destination_page, const rl::ExecutionPolicy* policy_p);
+            void generate_distance_field(const rl::Bitmap::View& bitmap, float spread, const rl::ExecutionPolicy* policy_p);
         public:
             constexpr Bitmap() noexcept = default;
             constexpr Bitmap(
@@ -205,7 +478,12 @@ namespace rl
                 rl::Bitmap::Depth depth,
                 rl::Bitmap::Color color,
                 std::optional<std::size_t> row_offset_o = std::nullopt,
-                std::optional<std::size_t> page_offset_o = std::nullopt
+                std::optional<std::size_t> page_offset_o = std::nullopt,
+                rl::Bitmap::Layout layout = rl::Bitmap::Layout::Default,
+                std::optional<std::size_t> plane_offset_o = std::nullopt,
+                rl::Bitmap::Alpha alpha = rl::Bitmap::Alpha::Default,
+                rl::Bitmap::palette_t palette = {},
+                rl::Bitmap::Space space = rl::Bitmap::Space::Default
             ) noexcept;
             virtual ~Bitmap() noexcept = default;
 
@@ -218,6 +496,13 @@ namespace rl
             constexpr std::size_t GetBitDepth() const noexcept;
             constexpr std::size_t GetRowOffset() const noexcept;
             constexpr std::size_t GetPageOffset() const noexcept;
+            constexpr rl::Bitmap::Layout GetLayout() const noexcept;
+            constexpr std::size_t GetPlaneOffset() const noexcept;
+            constexpr rl::Bitmap::Alpha GetAlpha() const noexcept;
+            constexpr rl::Bitmap::palette_t GetPalette() const noexcept;
+            constexpr rl::Bitmap::Space GetSpace() const noexcept;
+            // true if the colors are premultiplied by an alpha channel.
+            constexpr bool GetIsPremultiplied() const noexcept;
             constexpr rl::Bitmap::byte_t* GetData() const noexcept;
             constexpr rl::Bitmap::byte_t* GetData(std::size_t x, std::size_t y = 0, std::size_t page = 0, std::size_t channel = 0) const noexcept;            
             constexpr std::size_t GetChannelCount() const noexcept;
@@ -233,14 +518,50 @@ namespace rl
             constexpr rl::Bitmap::View GetBitmapView(std::size_t x, std::size_t y, std::size_t page, std::size_t width, std::size_t height, std::size_t page_count, std::optional<rl::Bitmap::Depth> fake_depth_o = std::nullopt, std::optional<rl::Bitmap::Color> fake_color_o = std::nullopt) const;
             constexpr rl::Bitmap::Row GetRow(std::size_t y, std::size_t page, std::optional<rl::Bitmap::Depth> fake_depth_o = std::nullopt, std::optional<rl::Bitmap::Color> fake_color_o = std::nullopt) const;
             constexpr const rl::Bitmap::Row::View GetRowView(std::size_t y, std::size_t page, std::optional<rl::Bitmap::Depth> fake_depth_o = std::nullopt, std::optional<rl::Bitmap::Color> fake_color_o = std::nullopt) const;
+            // one channel plane of a planar bitmap as a gray bitmap without copying it.
+            constexpr rl::Bitmap GetPlane(std::size_t channel);
+            constexpr rl::Bitmap::View GetPlaneView(std::size_t channel) const;
             void Save(std::string_view path, std::size_t page = 0);
-            constexpr void Blit(const rl::Bitmap::View& bitmap, std::size_t x, std::size_t y, std::size_t page);
-            void Blit(const rl::Png& png, std::size_t x, std::size_t y, std::size_t page);
-            void Blit(std::string_view path, std::size_t x, std::size_t y, std::size_t page);
+            void Save(const rl::ExecutionPolicy& policy, std::string_view path, std::size_t page = 0);
+            rl::Bitmap::statistics GetStatistics() const;
+            rl::Bitmap::statistics GetStatistics(const rl::ExecutionPolicy& policy) const;
+            // colors blit into gray bitmaps with the given gray mode, or with the default mode of rl::get_gray.
+            void Blit(const rl::Bitmap::View& bitmap, std::size_t x, std::size_t y, std::size_t page, rl::Bitmap::Blend blend = rl::Bitmap::Blend::Default, std::optional<rl::Bitmap::color_key> color_key_o = std::nullopt, std::optional<rl::gray_mode> gray_o = std::nullopt);
+            void Blit(const rl::Png& png, std::size_t x, std::size_t y, std::size_t page, std::optional<rl::Bitmap::color_key> color_key_o = std::nullopt, std::optional<rl::gray_mode> gray_o = std::nullopt);
+            void Blit(std::string_view path, std::size_t x, std::size_t y, std::size_t page, std::optional<rl::Bitmap::color_key> color_key_o = std::nullopt, std::optional<rl::gray_mode> gray_o = std::nullopt);
+            void Blit(const rl::ExecutionPolicy& policy, const rl::Bitmap::View& bitmap, std::size_t x, std::size_t y, std::size_t page, rl::Bitmap::Blend blend = rl::Bitmap::Blend::Default, std::optional<rl::Bitmap::color_key> color_key_o = std::nullopt, std::optional<rl::gray_mode> gray_o = std::nullopt);
+            void Blit(const rl::ExecutionPolicy& policy, const rl::Png& png, std::size_t x, std::size_t y, std::size_t page, std::optional<rl::Bitmap::color_key> color_key_o = std::nullopt, std::optional<rl::gray_mode> gray_o = std::nullopt);
+            void Blit(const rl::ExecutionPolicy& policy, std::string_view path, std::size_t x, std::size_t y, std::size_t page, std::optional<rl::Bitmap::color_key> color_key_o = std::nullopt, std::optional<rl::gray_mode> gray_o = std::nullopt);
+            // blits every page of the source turned by a transform, replacing the pixels it covers and converting them like a
+            // blit. the pixels are moved without converting when both bitmaps have the same format.
+            void Blit(const rl::Bitmap::View& bitmap, rl::Bitmap::Transform transform, std::size_t x, std::size_t y, std::size_t page);
+            void Blit(const rl::ExecutionPolicy& policy, const rl::Bitmap::View& bitmap, rl::Bitmap::Transform transform, std::size_t x, std::size_t y, std::size_t page);
+            // scales every page of the source to fill the whole bitmap, converting the pixels like a blit. the source needs as
+            // many pages as the bitmap.
+            void Resample(const rl::Bitmap::View& bitmap, rl::Bitmap::Filter filter = rl::Bitmap::Filter::Default);
+            void Resample(const rl::ExecutionPolicy& policy, const rl::Bitmap::View& bitmap, rl::Bitmap::Filter filter = rl::Bitmap::Filter::Default);
+            // sets every pixel of the pages of a rectangle, or of the whole bitmap, to a straight alpha color of the space of
+            // the bitmap, converting the color like a blit. indexed bitmaps get the nearest color of their palette.
+            void Fill(const rl::color_rgba<rl::Bitmap::normalized_t>& color);
+            void Fill(const rl::color_rgba<rl::Bitmap::normalized_t>& color, std::size_t x, std::size_t y, std::size_t page, std::size_t width, std::size_t height, std::size_t page_count = 1);
+            void Fill(const rl::ExecutionPolicy& policy, const rl::color_rgba<rl::Bitmap::normalized_t>& color);
+            void Fill(const rl::ExecutionPolicy& policy, const rl::color_rgba<rl::Bitmap::normalized_t>& color, std::size_t x, std::size_t y, std::size_t page, std::size_t width, std::size_t height, std::size_t page_count = 1);
+            // moves the pixels of the pages of a rectangle to another place in the same bitmap without converting them, like
+            // when scrolling. the source and destination can overlap, and the pixels of the source that the destination
+            // does not cover are left unchanged.
+            void Move(std::size_t x, std::size_t y, std::size_t page, std::size_t width, std::size_t height, std::size_t page_count, std::size_t destination_x, std::size_t destination_y, std::size_t destination_page);
+            void Move(const rl::ExecutionPolicy& policy, std::size_t x, std::size_t y, std::size_t page, std::size_t width, std::size_t height, std::size_t page_count, std::size_t destination_x, std::size_t destination_y, std::size_t destination_page);
+            // fills every page with the signed distance field of the same page of the source, scaled to the size of the bitmap
+            // with a box filter. source pixels at least half covered by their alpha, or by their gray level for colors
+            // without alpha, are inside. fields are 0.5 on edges and reach 1 and 0 at spread source pixels inside and
+            // outside of them.
+            void GenerateDistanceField(const rl::Bitmap::View& bitmap, float spread);
+            void GenerateDistanceField(const rl::ExecutionPolicy& policy, const rl::Bitmap::View& bitmap, float spread);
     };
 }
 
 #include <rla/detail/Bitmap.inl>
+#include <rla/detail/row_converters.inl>
 #include <rla/detail/Bitmap_View.inl>
 #include <rla/detail/Bitmap_Row.inl>
 #include <rla/detail/Bitmap_Row_View.inl>
\ No newline at end of file
@@ -40,8 +40,13 @@ namespace rl
             std::vector<std::size_t> glyph_identifiers = std::vector<std::size_t>();
             rl::Packer<int> packer = rl::Packer<int>();
 
+            rl::console_atlas create(const rl::console_atlas::layout& layout, const rl::ExecutionPolicy* policy_p);
+
         public:
 
             rl::console_atlas Create(const rl::console_atlas::layout& layout); 
+            // the policy generates the distance fields of the glyphs in parallel. fonts are still rendered one glyph at a
+            // time.
+            rl::console_atlas Create(const rl::ExecutionPolicy& policy, const rl::console_atlas::layout& layout);
     };
 }
\ No newline at end of file
@@ -0,0 +1,82 @@
+// SPDX-FileCopyrightText: 2023 Daniel Aimé Valcour <fosssweeper@gmail.com>
+//
+// SPDX-License-Identifier: MIT
+
+/*
+    Copyright (c) 2023 Daniel Aimé Valcour
+    Permission is hereby granted, free of charge, to any person obtaining a copy of
+    this software and associated documentation files (the "Software"), to deal in
+    the Software without restriction, including without limitation the rights to
+    use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+    the Software, and to permit persons to whom the Software is furnished to do so,
+    subject to the following conditions:
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+    FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+    COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+    IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+    CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace rl
+{
+    // a pool of worker threads that runs indexed tasks. idle workers and the calling thread claim the next unstarted
+    // task as they finish, so uneven tasks balance themselves across the pool.
+    class Executor
+    {
+        protected:
+            struct job_t;
+
+            std::vector<std::thread> workers;
+            std::mutex mutex;
+            std::mutex run_mutex;
+            std::condition_variable work_condition;
+            std::condition_variable done_condition;
+            job_t* job = nullptr;
+            std::size_t generation = 0;
+            std::size_t active_worker_count = 0;
+            bool stopping = false;
+
+            void work() noexcept;
+            static void run_tasks(job_t& job) noexcept;
+
+        public:
+            // a thread count of 0 uses one thread per hardware thread. the calling thread counts as one of the threads.
+            Executor(std::size_t thread_count = 0);
+            Executor(const rl::Executor&) = delete;
+            rl::Executor& operator=(const rl::Executor&) = delete;
+            ~Executor() noexcept;
+
+            std::size_t GetThreadCount() const noexcept;
+            // runs task(0) to task(task_count - 1) and returns when all of them are done. the first exception thrown by
+            // a task is rethrown. runs serially when called from inside a task.
+            void Run(std::size_t task_count, const std::function<void(std::size_t)>& task);
+
+            static rl::Executor& GetDefault();
+    };
+
+    struct ExecutionPolicy
+    {
+        // the executor to run on. nullptr uses the default executor.
+        rl::Executor* executor = nullptr;
+        // operations that touch fewer bytes than this run on the calling thread.
+        std::size_t serial_threshold = 1 << 20;
+
+        rl::Executor& GetExecutor() const;
+        bool GetIsSerial(std::size_t byte_count) const;
+        // the number of rows per task when splitting row_count rows into bands across the executor.
+        std::size_t GetBandSize(std::size_t row_count) const;
+    };
+}
@@ -44,11 +44,24 @@ namespace rl
     {
         protected:
             void shrink_data();
-            void reserve_data(std::size_t capacity);
+            void reserve_data(std::size_t capacity, std::size_t alignment);
             void free_data() noexcept;
+            std::size_t get_used_size() const noexcept;
+            std::size_t get_mip_start(std::size_t level) const;
+            void clear_skipped(const std::optional<rl::Bitmap::color_key>& color_key_o) noexcept;
+            void generate_mips(std::optional<std::size_t> mip_count_o, bool is_srgb, const rl::ExecutionPolicy* policy_p);
+            void load(const rl::Png& png, std::optional<rl::Bitmap::Depth> depth_o, std::optional<rl::Bitmap::Color> color_o, rl::Bitmap::Alpha alpha, std::optional<rl::Bitmap::color_key> color_key_o, rl::Bitmap::Space space, std::optional<rl::gray_mode> gray_o, const rl::ExecutionPolicy* policy_p);
 
         protected:
             std::size_t capacity = 0;
+            // the alignment of the data in bytes.
+            std::size_t alignment = 64;
+            // the alignment of the rows in bytes, kept when the layout is converted.
+            std::size_t row_alignment = 1;
+            // the number of mip levels stored after each other in the data, including the image itself.
+            std::size_t mip_count = 1;
+            // the colors the palette of the image points to.
+            std::vector<rl::color_rgba<rl::Bitmap::octuple_t>> palette_colors;
 
         public:
             class Row : public rl::Bitmap::Row
@@ -80,18 +93,55 @@ namespace rl
             using rl::Bitmap::Bitmap;
 
             constexpr Image() noexcept = default;
-            Image(const rl::Png& png, std::optional<rl::Bitmap::Depth> depth_o = std::nullopt, std::optional<rl::Bitmap::Color> color_o = std::nullopt);
-            Image(std::string_view path, std::optional<rl::Bitmap::Depth> depth_o = std::nullopt, std::optional<rl::Bitmap::Color> color_o = std::nullopt);
+            Image(const rl::Png& png, std::optional<rl::Bitmap::Depth> depth_o = std::nullopt, std::optional<rl::Bitmap::Color> color_o = std::nullopt, rl::Bitmap::Alpha alpha = rl::Bitmap::Alpha::Default, std::optional<rl::Bitmap::color_key> color_key_o = std::nullopt, rl::Bitmap::Space space = rl::Bitmap::Space::Default, std::optional<rl::gray_mode> gray_o = std::nullopt);
+            Image(std::string_view path, std::optional<rl::Bitmap::Depth> depth_o = std::nullopt, std::optional<rl::Bitmap::Color> color_o = std::nullopt, rl::Bitmap::Alpha alpha = rl::Bitmap::Alpha::Default, std::optional<rl::Bitmap::color_key> color_key_o = std::nullopt, rl::Bitmap::Space space = rl::Bitmap::Space::Default, std::optional<rl::gray_mode> gray_o = std::nullopt);
             Image(std::size_t capacity);
-            Image(std::size_t width, std::size_t height, std::size_t page_count, rl::Bitmap::Depth depth, rl::Bitmap::Color color);
+            Image(std::size_t width, std::size_t height, std::size_t page_count, rl::Bitmap::Depth depth, rl::Bitmap::Color color, rl::Bitmap::Layout layout = rl::Bitmap::Layout::Default, std::size_t row_alignment = 1, std::optional<std::size_t> row_offset_o = std::nullopt, rl::Bitmap::Alpha alpha = rl::Bitmap::Alpha::Default, rl::Bitmap::Space space = rl::Bitmap::Space::Default);
+            Image(std::size_t width, std::size_t height, std::size_t page_count, rl::Bitmap::Depth depth, rl::Bitmap::Color color, const rl::color_rgba<rl::Bitmap::normalized_t>& fill, rl::Bitmap::Layout layout = rl::Bitmap::Layout::Default, std::size_t row_alignment = 1, std::optional<std::size_t> row_offset_o = std::nullopt, rl::Bitmap::Alpha alpha = rl::Bitmap::Alpha::Default, rl::Bitmap::Space space = rl::Bitmap::Space::Default);
             ~Image() noexcept override;
 
             void Clear() noexcept;
             void ShrinkToFit();
-            void Reserve(std::size_t capacity);
+            // the alignment must be a power of two. the data is never aligned to less than it already is.
+            void Reserve(std::size_t capacity, std::size_t alignment = 1);
             std::size_t GetCapacity() const noexcept;
-            void Create(std::size_t width, std::size_t height, std::size_t page_count, rl::Bitmap::Depth depth, rl::Bitmap::Color color);
-            void Load(const rl::Png& png, std::optional<rl::Bitmap::Depth> depth_o = std::nullopt, std::optional<rl::Bitmap::Color> color_o = std::nullopt);
-            void Load(std::string_view path, std::optional<rl::Bitmap::Depth> depth_o = std::nullopt, std::optional<rl::Bitmap::Color> color_o = std::nullopt);
+            std::size_t GetAlignment() const noexcept;
+            // rows are padded so each one starts at a multiple of the row alignment, unless a row offset is given. a
+            // given row offset must fit the row and be a multiple of the row alignment. for tiled images the rows are
+            // the rows of tiles. the pixels are left uninitialized.
+            void Create(std::size_t width, std::size_t height, std::size_t page_count, rl::Bitmap::Depth depth, rl::Bitmap::Color color, rl::Bitmap::Layout layout = rl::Bitmap::Layout::Default, std::size_t row_alignment = 1, std::optional<std::size_t> row_offset_o = std::nullopt, rl::Bitmap::Alpha alpha = rl::Bitmap::Alpha::Default, rl::Bitmap::Space space = rl::Bitmap::Space::Default);
+            // creates the image like above with every pixel set to the fill color. transparent black zeroes every byte,
+            // padding included. throws for indexed images, which are created without a palette to map the color to.
+            void Create(std::size_t width, std::size_t height, std::size_t page_count, rl::Bitmap::Depth depth, rl::Bitmap::Color color, const rl::color_rgba<rl::Bitmap::normalized_t>& fill, rl::Bitmap::Layout layout = rl::Bitmap::Layout::Default, std::size_t row_alignment = 1, std::optional<std::size_t> row_offset_o = std::nullopt, rl::Bitmap::Alpha alpha = rl::Bitmap::Alpha::Default, rl::Bitmap::Space space = rl::Bitmap::Space::Default);
+            // rearranges the pixels into the given layout, keeping their values.
+            void ConvertLayout(rl::Bitmap::Layout layout);
+            // copies the palette into the image. palettes hold at most 256 colors.
+            void SetPalette(rl::Bitmap::palette_t palette);
+            // converts the image to indexed octuple pixels if it has no more than 256 distinct octuple colors, keeping
+            // every pixel. returns false and changes nothing if it has more. the mip levels are dropped, and the palette
+            // holds srgb colors.
+            bool ConvertToIndexed();
+            // a color key gives pngs without alpha an alpha channel unless a color is given. pixels skipped by a key are zero.
+            // palette pngs load indexed with their palette by default. loading other pngs as indexed finds their exact
+            // palette, and throws if they have more than 256 colors.
+            // pngs hold srgb colors, which linear images decode as they load.
+            // color pngs load into gray images with the given gray mode, or with the default mode of rl::get_gray.
+            void Load(const rl::Png& png, std::optional<rl::Bitmap::Depth> depth_o = std::nullopt, std::optional<rl::Bitmap::Color> color_o = std::nullopt, rl::Bitmap::Alpha alpha = rl::Bitmap::Alpha::Default, std::optional<rl::Bitmap::color_key> color_key_o = std::nullopt, rl::Bitmap::Space space = rl::Bitmap::Space::Default, std::optional<rl::gray_mode> gray_o = std::nullopt);
+            void Load(std::string_view path, std::optional<rl::Bitmap::Depth> depth_o = std::nullopt, std::optional<rl::Bitmap::Color> color_o = std::nullopt, rl::Bitmap::Alpha alpha = rl::Bitmap::Alpha::Default, std::optional<rl::Bitmap::color_key> color_key_o = std::nullopt, rl::Bitmap::Space space = rl::Bitmap::Space::Default, std::optional<rl::gray_mode> gray_o = std::nullopt);
+            void Load(const rl::ExecutionPolicy& policy, const rl::Png& png, std::optional<rl::Bitmap::Depth> depth_o = std::nullopt, std::optional<rl::Bitmap::Color> color_o = std::nullopt, rl::Bitmap::Alpha alpha = rl::Bitmap::Alpha::Default, std::optional<rl::Bitmap::color_key> color_key_o = std::nullopt, rl::Bitmap::Space space = rl::Bitmap::Space::Default, std::optional<rl::gray_mode> gray_o = std::nullopt);
+            void Load(const rl::ExecutionPolicy& policy, std::string_view path, std::optional<rl::Bitmap::Depth> depth_o = std::nullopt, std::optional<rl::Bitmap::Color> color_o = std::nullopt, rl::Bitmap::Alpha alpha = rl::Bitmap::Alpha::Default, std::optional<rl::Bitmap::color_key> color_key_o = std::nullopt, rl::Bitmap::Space space = rl::Bitmap::Space::Default, std::optional<rl::gray_mode> gray_o = std::nullopt);
+            // the number of levels in a full mip chain, from the full size level down to a 1x1 level.
+            static std::size_t GetMaxMipCount(std::size_t width, std::size_t height) noexcept;
+            std::size_t GetMipCount() const noexcept;
+            // mip level 0 is the image itself. each level after it is half the size of the level before, rounded down,
+            // with the same pages, format and layout.
+            rl::Bitmap GetMip(std::size_t level);
+            rl::Bitmap::View GetMipView(std::size_t level) const;
+            // builds mip levels after the image by averaging 2x2 blocks of the level before, a full chain unless a mip
+            // count is given. colors are averaged in linear light, decoding srgb images unless is_srgb is false. creating the
+            // image again drops the levels.
+            // indexed images can not have mips.
+            void GenerateMips(std::optional<std::size_t> mip_count_o = std::nullopt, bool is_srgb = true);
+            void GenerateMips(const rl::ExecutionPolicy& policy, std::optional<std::size_t> mip_count_o = std::nullopt, bool is_srgb = true);
     };
 }
\ No newline at end of file
@@ -22,8 +22,12 @@
 
 #pragma once
 
+#include <rlm/color/color_rgba.hpp>
 #include <string>
 #include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
 
 namespace rl
 {
@@ -46,6 +50,7 @@ namespace rl
             std::size_t height = 0;
             rl::Png::Color color = rl::Png::Color::None;
             std::size_t bit_depth = 0;
+            std::vector<rl::color_rgba<std::uint8_t>> palette;
 
         public:
             constexpr Png() noexcept = default;
@@ -58,6 +63,8 @@ namespace rl
             std::size_t GetHeight() const noexcept;
             std::size_t GetBitDepth() const noexcept;
             rl::Png::Color GetColor() const noexcept;
+            // the colors of palette pngs with the alpha of their transparency chunk. empty for other pngs.
+            std::span<const rl::color_rgba<std::uint8_t>> GetPalette() const noexcept;
             void Clear() noexcept;
     };
 }
\ No newline at end of file
@@ -0,0 +1,160 @@
+// SPDX-FileCopyrightText: 2023 Daniel Aimé Valcour <fosssweeper@gmail.com>
+//
+// SPDX-License-Identifier: MIT
+
+/*
+    Copyright (c) 2023 Daniel Aimé Valcour
+    Permission is hereby granted, free of charge, to any person obtaining a copy of
+    this software and associated documentation files (the "Software"), to deal in
+    the Software without restriction, including without limitation the rights to
+    use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+    the Software, and to permit persons to whom the Software is furnished to do so,
+    subject to the following conditions:
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+    FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+    COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+    IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+    CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include <rla/Bitmap.hpp>
+#include <array>
+#include <cstddef>
+#include <iterator>
+#include <optional>
+#include <ranges>
+#include <span>
+#include <type_traits>
+
+namespace rl
+{
+    // the channel type of a depth. sub-byte depths have no channel type, since their channels do not start on bytes.
+    template<rl::Bitmap::Depth Depth>
+    struct typed_channel;
+    template<>
+    struct typed_channel<rl::Bitmap::Depth::Octuple>
+    {
+        using type = rl::Bitmap::octuple_t;
+    };
+    template<>
+    struct typed_channel<rl::Bitmap::Depth::Sexdecuple>
+    {
+        using type = rl::Bitmap::sexdecuple_t;
+    };
+    template<>
+    struct typed_channel<rl::Bitmap::Depth::Normalized>
+    {
+        using type = rl::Bitmap::normalized_t;
+    };
+    template<>
+    struct typed_channel<rl::Bitmap::Depth::Half>
+    {
+        using type = rl::Bitmap::half_t;
+    };
+
+    // a linear bitmap with its depth and color fixed at compile time, so pixels are arrays of channels that rows point
+    // to directly. the accessors do not check their arguments, which is up to the caller, and views are only checked when
+    // they are made with Checked. the rows are spans, so they and the range of every row work with std::ranges.
+    template<rl::Bitmap::Depth Depth, rl::Bitmap::Color Color, bool IsMutable>
+    class BasicTypedView
+    {
+        public:
+            using channel_t = typename rl::typed_channel<Depth>::type;
+            static constexpr std::size_t channel_count = rl::Bitmap::GetChannelCount(Color);
+            using pixel_t = std::array<channel_t, channel_count>;
+            using byte_pointer_t = std::conditional_t<IsMutable, rl::Bitmap::byte_t*, const rl::Bitmap::byte_t*>;
+            using pixel_pointer_t = std::conditional_t<IsMutable, pixel_t*, const pixel_t*>;
+            using row_t = std::span<std::remove_pointer_t<pixel_pointer_t>>;
+            using bitmap_t = std::conditional_t<IsMutable, rl::Bitmap, rl::Bitmap::View>;
+
+            static_assert(sizeof(pixel_t) == rl::Bitmap::GetPixelSize(Depth, Color), "pixel arrays are padded");
+
+            // walks the pixels of every row after each other, skipping the padding between rows. the iterator copies
+            // the layout of the view, so only the data of the view has to outlive it.
+            class PixelIterator
+            {
+                protected:
+                    pixel_pointer_t pixel = nullptr;
+                    pixel_pointer_t row_end = nullptr;
+                    std::size_t row_i = 0;
+                    byte_pointer_t data = nullptr;
+                    std::size_t width = 0;
+                    std::size_t height = 0;
+                    std::size_t row_count = 0;
+                    std::size_t row_offset = 0;
+                    std::size_t page_offset = 0;
+
+                    void set_row(std::size_t row_i) noexcept;
+
+                public:
+                    using iterator_concept = std::forward_iterator_tag;
+                    using iterator_category = std::forward_iterator_tag;
+                    using value_type = pixel_t;
+                    using difference_type = std::ptrdiff_t;
+                    using pointer = pixel_pointer_t;
+                    using reference = std::remove_pointer_t<pixel_pointer_t>&;
+
+                    constexpr PixelIterator() noexcept = default;
+                    PixelIterator(const rl::BasicTypedView<Depth, Color, IsMutable>& view, std::size_t row_i) noexcept;
+                    reference operator*() const noexcept;
+                    pointer operator->() const noexcept;
+                    PixelIterator& operator++() noexcept;
+                    PixelIterator operator++(int) noexcept;
+                    constexpr bool operator==(const PixelIterator& that) const noexcept;
+            };
+
+        protected:
+            byte_pointer_t data = nullptr;
+            std::size_t width = 0;
+            std::size_t height = 0;
+            std::size_t page_count = 0;
+            std::size_t row_offset = 0;
+            std::size_t page_offset = 0;
+
+        public:
+            constexpr BasicTypedView() noexcept = default;
+            // the offsets are in bytes and default to packed rows and pages.
+            constexpr BasicTypedView(
+                byte_pointer_t data,
+                std::size_t width,
+                std::size_t height,
+                std::size_t page_count,
+                std::optional<std::size_t> row_offset_o = std::nullopt,
+                std::optional<std::size_t> page_offset_o = std::nullopt
+            ) noexcept;
+            // typed bitmaps are typed views too.
+            template<bool IsViewMutable>
+                requires (IsViewMutable && !IsMutable)
+            constexpr BasicTypedView(const rl::BasicTypedView<Depth, Color, IsViewMutable>& view) noexcept;
+            // throws unless the bitmap is linear, has the depth and color of the view, and its data and offsets are
+            // aligned to the channels.
+            static rl::BasicTypedView<Depth, Color, IsMutable> Checked(const bitmap_t& bitmap);
+
+            constexpr byte_pointer_t GetData() const noexcept;
+            constexpr std::size_t GetWidth() const noexcept;
+            constexpr std::size_t GetHeight() const noexcept;
+            constexpr std::size_t GetPageCount() const noexcept;
+            constexpr std::size_t GetRowOffset() const noexcept;
+            constexpr std::size_t GetPageOffset() const noexcept;
+            constexpr bool GetIsEmpty() const noexcept;
+            pixel_pointer_t GetRowData(std::size_t y, std::size_t page = 0) const noexcept;
+            row_t GetRow(std::size_t y, std::size_t page = 0) const noexcept;
+            std::remove_pointer_t<pixel_pointer_t>& GetPixel(std::size_t x, std::size_t y, std::size_t page = 0) const noexcept;
+            // the rows of every page after each other.
+            auto GetRows() const noexcept;
+            // the pixels of every row after each other. like the rows, the range outlives the view but not its data.
+            std::ranges::subrange<PixelIterator> GetPixels() const noexcept;
+    };
+
+    template<rl::Bitmap::Depth Depth, rl::Bitmap::Color Color>
+    using TypedView = rl::BasicTypedView<Depth, Color, false>;
+    template<rl::Bitmap::Depth Depth, rl::Bitmap::Color Color>
+    using TypedBitmap = rl::BasicTypedView<Depth, Color, true>;
+}
+
+#include <rla/detail/TypedView.inl>
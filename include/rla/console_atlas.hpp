@@ -24,6 +24,7 @@
 
 #include <rla/Image.hpp>
 #include <rlm/cellular/cell_vector2.hpp>
+#include <optional>
 #include <string>
 #include <vector>
 #include <map>
@@ -38,6 +39,9 @@ namespace rl
         enum class Color
         {
             GGrayStencilFg,
+            // the signed distance from each pixel to the nearest glyph edge, 0.5 on edges and rising inside glyphs, so one
+            // atlas can be thresholded crisply at any scale.
+            GDistanceFieldFg,
             //GaBlendFgAlphaBg,   // TODO
             //GaGrayFgAlphaBg,    // TODO
             //RgbaBlendFgAlphaBg, // TODO
@@ -58,7 +62,13 @@ namespace rl
                 std::size_t source_i = 0;
                 rl::console_atlas::layout::Source source = rl::console_atlas::layout::Source::Png;
                 rl::cell_vector2<int> top_left;
+                // the size of the tile in a bitmap or png source when it is not the size of the atlas tiles. the tile
+                // is resampled to fit.
+                std::optional<rl::cell_vector2<int>> size_o;
                 std::optional<rl::console_atlas::codepoint_i> codepoint_o;
+                // turns the tile before it is resampled and baked into the atlas, so facing directions and rotated
+                // pieces do not need their own tiles. transposing transforms turn the size of the tile too.
+                rl::Bitmap::Transform transform = rl::Bitmap::Transform::None;
             };
 
             struct face
@@ -73,6 +83,20 @@ namespace rl
             int tile_width;
             int tile_height;
             rl::console_atlas::Color color = rl::console_atlas::Color::Default;
+            // the filter used to resample source tiles that are not the size of the atlas tiles.
+            rl::Bitmap::Filter filter = rl::Bitmap::Filter::Default;
+            // pixels around each glyph filled with its edge pixels, so neighboring glyphs do not bleed into each other when
+            // the atlas is filtered or mipmapped.
+            int gutter = 0;
+            // builds a full mip chain for the pages of the atlas image.
+            bool mipmapped = false;
+            // the distance in atlas pixels from a glyph edge to where a distance field atlas reaches 0 or 1.
+            float distance_field_spread = 4.0f;
+            // distance field glyphs are baked at this multiple of the tile size, so their fields come from sharper edges.
+            int distance_field_scale = 4;
+            // trims each glyph to the box around its non-zero pixels before it is packed, so mostly empty glyphs take less
+            // of the atlas. the faces keep the offset of each trimmed glyph within its tile.
+            bool trimmed = false;
             std::vector<rl::console_atlas::layout::face> faces;
         };
 
@@ -80,6 +104,9 @@ namespace rl
         {
             bool letterboxed = false;
             std::vector<float> texture_coordinates = std::vector<float>();
+            // the top left of each glyph within its tile, in the order of the glyphs of the face. only trimmed glyphs are
+            // offset.
+            std::vector<rl::cell_vector2<int>> glyph_offsets = std::vector<rl::cell_vector2<int>>();
             std::map<rl::console_atlas::codepoint_i, rl::console_atlas::glyph_i> codepoint_map = std::map<rl::console_atlas::codepoint_i, rl::console_atlas::glyph_i>();
         };
 
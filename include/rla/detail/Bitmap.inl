@@ -47,6 +47,8 @@ constexpr std::size_t rl::Bitmap::GetChannelCount(rl::Bitmap::Color color) noexc
             return 3;
         case rl::Bitmap::Color::Rgba:
 			return 4;
+        case rl::Bitmap::Color::Indexed:
+            return 1;
     }
 	return 3;
 }
@@ -61,19 +63,54 @@ constexpr std::size_t rl::Bitmap::GetChannelSize(rl::Bitmap::Depth depth) noexce
 			return 2;
 		case rl::Bitmap::Depth::Normalized:
 			return 4;
+		case rl::Bitmap::Depth::Half:
+			return 2;
+		case rl::Bitmap::Depth::Single:
+		case rl::Bitmap::Depth::Duple:
+		case rl::Bitmap::Depth::Quadruple:
+			return 0;
 	}
 	return 1;
 }
 
 constexpr std::size_t rl::Bitmap::GetBitDepth(rl::Bitmap::Depth depth) noexcept
 {
-    return rl::Bitmap::GetChannelSize(depth) * 8;
+    switch (depth)
+    {
+        case rl::Bitmap::Depth::Single:
+            return 1;
+        case rl::Bitmap::Depth::Duple:
+            return 2;
+        case rl::Bitmap::Depth::Quadruple:
+            return 4;
+        default:
+            return rl::Bitmap::GetChannelSize(depth) * 8;
+    }
+}
+
+constexpr bool rl::Bitmap::GetIsSubByte(rl::Bitmap::Depth depth) noexcept
+{
+    return rl::Bitmap::GetBitDepth(depth) < 8;
+}
+
+constexpr bool rl::Bitmap::GetIsTransposed(rl::Bitmap::Transform transform) noexcept
+{
+    return
+        transform == rl::Bitmap::Transform::Rotate90 ||
+        transform == rl::Bitmap::Transform::Rotate270 ||
+        transform == rl::Bitmap::Transform::Transpose;
 }
 
 constexpr rl::Bitmap::Depth rl::Bitmap::GetDepth(std::size_t bit_depth) noexcept
 {
 	switch (bit_depth)
 	{
+		case 1:
+			return rl::Bitmap::Depth::Single;
+		case 2:
+			return rl::Bitmap::Depth::Duple;
+		case 4:
+			return rl::Bitmap::Depth::Quadruple;
 		case 8:
 			return rl::Bitmap::Depth::Octuple;
 		case 16:
@@ -91,32 +128,73 @@ constexpr std::size_t rl::Bitmap::GetPixelSize(rl::Bitmap::Depth depth, rl::Bitm
 
 constexpr std::size_t rl::Bitmap::GetRowSize(std::size_t width, rl::Bitmap::Depth depth, rl::Bitmap::Color color) noexcept
 {
+    // sub-byte rows are padded to a whole byte
     return
-        width *
-        rl::Bitmap::GetChannelSize(depth) *
-        rl::Bitmap::GetChannelCount(color);
+        (
+            width *
+            rl::Bitmap::GetBitDepth(depth) *
+            rl::Bitmap::GetChannelCount(color) +
+            7
+        ) /
+        8;
 }
 
-constexpr std::size_t rl::Bitmap::GetPageSize(std::size_t width, std::size_t height, rl::Bitmap::Depth depth, rl::Bitmap::Color color) noexcept
+constexpr std::size_t rl::Bitmap::GetPageSize(std::size_t width, std::size_t height, rl::Bitmap::Depth depth, rl::Bitmap::Color color, rl::Bitmap::Layout layout) noexcept
 {
+    if (layout == rl::Bitmap::Layout::Tiled)
+    {
+        return
+            rl::Bitmap::GetTileRowSize(width, depth, color) *
+            (
+                (height + rl::Bitmap::GetTileWidth() - 1) /
+                rl::Bitmap::GetTileWidth()
+            );
+    }
+    if (layout == rl::Bitmap::Layout::Planar)
+    {
+        return
+            rl::Bitmap::GetRowSize(width, depth, rl::Bitmap::Color::G) *
+            height *
+            rl::Bitmap::GetChannelCount(color);
+    }
     return
-        width *
-        height *
-        rl::Bitmap::GetChannelSize(depth) *
-        rl::Bitmap::GetChannelCount(color);
+        rl::Bitmap::GetRowSize(width, depth, color) *
+        height;
 }
 
-constexpr std::size_t rl::Bitmap::GetSize(std::size_t width, std::size_t height, std::size_t pages, rl::Bitmap::Depth depth, rl::Bitmap::Color color) noexcept
+constexpr std::size_t rl::Bitmap::GetSize(std::size_t width, std::size_t height, std::size_t pages, rl::Bitmap::Depth depth, rl::Bitmap::Color color, rl::Bitmap::Layout layout) noexcept
 {
     return
-        width *
-        height *
         pages *
-        rl::Bitmap::GetChannelSize(depth) *
-        rl::Bitmap::GetChannelCount(color);
+        rl::Bitmap::GetPageSize(width, height, depth, color, layout);
+}
+
+constexpr std::size_t rl::Bitmap::GetTileWidth() noexcept
+{
+    return 8;
+}
+
+constexpr std::size_t rl::Bitmap::GetTileSize(rl::Bitmap::Depth depth, rl::Bitmap::Color color) noexcept
+{
+    return
+        rl::Bitmap::GetTileWidth() *
+        rl::Bitmap::GetTileWidth() *
+        rl::Bitmap::GetBitDepth(depth) *
+        rl::Bitmap::GetChannelCount(color) /
+        8;
+}
+
+constexpr std::size_t rl::Bitmap::GetTileRowSize(std::size_t width, rl::Bitmap::Depth depth, rl::Bitmap::Color color) noexcept
+{
+    return
+        rl::Bitmap::GetTileSize(depth, color) *
+        (
+            (width + rl::Bitmap::GetTileWidth() - 1) /
+            rl::Bitmap::GetTileWidth()
+        );
 }
 
-constexpr std::optional<std::size_t> rl::Bitmap::GetByteIndex(std::size_t width, std::size_t height, std::size_t pages, rl::Bitmap::Depth depth, rl::Bitmap::Color color, std::size_t row_offset, std::size_t page_offset, std::size_t x, std::size_t y, std::size_t page, std::size_t channel) noexcept
+constexpr std::optional<std::size_t> rl::Bitmap::GetByteIndex(std::size_t width, std::size_t height, std::size_t pages, rl::Bitmap::Depth depth, rl::Bitmap::Color color, std::size_t row_offset, std::size_t page_offset, std::size_t x, std::size_t y, std::size_t page, std::size_t channel, rl::Bitmap::Layout layout, std::size_t plane_offset) noexcept
 {
     if (
         channel >= rl::Bitmap::GetChannelCount(color) ||
@@ -127,10 +205,65 @@ constexpr std::optional<std::size_t> rl::Bitmap::GetByteIndex(std::size_t width,
     {
         return std::nullopt;
     }
+    // the index of a sub-byte channel is the index of the byte it is packed into
+    if (layout == rl::Bitmap::Layout::Planar)
+    {
+        return
+            (
+                x *
+                rl::Bitmap::GetBitDepth(depth) /
+                8
+            ) +
+            (
+                y *
+                row_offset
+            ) +
+            (
+                page *
+                page_offset
+            ) +
+            (
+                channel *
+                plane_offset
+            );
+    }
+    if (layout == rl::Bitmap::Layout::Tiled)
+    {
+        const auto tile_width = rl::Bitmap::GetTileWidth();
+        return
+            (
+                (x / tile_width) *
+                rl::Bitmap::GetTileSize(depth, color)
+            ) +
+            (
+                (
+                    (y % tile_width) *
+                    tile_width +
+                    (x % tile_width)
+                ) *
+                rl::Bitmap::GetBitDepth(depth) *
+                rl::Bitmap::GetChannelCount(color) /
+                8
+            ) +
+            (
+                (y / tile_width) *
+                row_offset
+            ) +
+            (
+                page *
+                page_offset
+            ) +
+            (
+                rl::Bitmap::GetChannelSize(depth) *
+                channel
+            );
+    }
     return
         (
             x *
-            rl::Bitmap::GetPixelSize(depth, color)
+            rl::Bitmap::GetBitDepth(depth) *
+            rl::Bitmap::GetChannelCount(color) /
+            8
         ) +
         (
             y *
@@ -146,7 +279,7 @@ constexpr std::optional<std::size_t> rl::Bitmap::GetByteIndex(std::size_t width,
         );
 }
 
-constexpr bool rl::Bitmap::blit_fits(const rl::cell_box2<int>& blit_box, std::size_t page) const noexcept
+constexpr bool rl::Bitmap::blit_fits(const rl::cell_box2<int>& blit_box, std::size_t page, std::size_t page_count) const noexcept
 {
     rl::cell_box2<int> this_box(
         0,
@@ -155,10 +288,49 @@ constexpr bool rl::Bitmap::blit_fits(const rl::cell_box2<int>& blit_box, std::si
         static_cast<int>(this->GetHeight())
     );
     return 
-        page < this->GetPageCount() &&
+        page + page_count <= this->GetPageCount() &&
         rl::does_contain(this_box, blit_box);
 }
 
+constexpr std::size_t rl::Bitmap::get_extent(std::size_t width, std::size_t height, std::size_t page_count, rl::Bitmap::Depth depth, rl::Bitmap::Color color, std::size_t row_offset, std::size_t page_offset, rl::Bitmap::Layout layout, std::size_t plane_offset) noexcept
+{
+    if (width == 0 || height == 0 || page_count == 0)
+    {
+        return 0;
+    }
+    if (layout == rl::Bitmap::Layout::Planar)
+    {
+        return
+            (page_count - 1) * page_offset +
+            (rl::Bitmap::GetChannelCount(color) - 1) * plane_offset +
+            (height - 1) * row_offset +
+            rl::Bitmap::GetRowSize(width, depth, rl::Bitmap::Color::G);
+    }
+    if (layout == rl::Bitmap::Layout::Tiled)
+    {
+        return
+            (page_count - 1) * page_offset +
+            ((height - 1) / rl::Bitmap::GetTileWidth()) * row_offset +
+            rl::Bitmap::GetTileRowSize(width, depth, color);
+    }
+    return
+        (page_count - 1) * page_offset +
+        (height - 1) * row_offset +
+        rl::Bitmap::GetRowSize(width, depth, color);
+}
+
+constexpr bool rl::Bitmap::get_is_alpha_conversion(rl::Bitmap::Color source_color, bool is_source_premultiplied, bool is_destination_premultiplied) noexcept
+{
+    // sources without alpha are opaque, so premultiplying them changes nothing
+    if (is_source_premultiplied)
+    {
+        return !is_destination_premultiplied;
+    }
+    return
+        is_destination_premultiplied &&
+        (source_color == rl::Bitmap::Color::Ga || source_color == rl::Bitmap::Color::Rgba);
+}
+
 constexpr rl::Bitmap::Bitmap(
     rl::Bitmap::byte_t* data,
     std::size_t width,
@@ -167,7 +339,12 @@ constexpr rl::Bitmap::Bitmap(
     rl::Bitmap::Depth depth,
     rl::Bitmap::Color color,
     std::optional<std::size_t> row_offset_o,
-    std::optional<std::size_t> page_offset_o
+    std::optional<std::size_t> page_offset_o,
+    rl::Bitmap::Layout layout,
+    std::optional<std::size_t> plane_offset_o,
+    rl::Bitmap::Alpha alpha,
+    rl::Bitmap::palette_t palette,
+    rl::Bitmap::Space space
 ) noexcept
     : data(data)
     , width(width)
@@ -175,7 +352,43 @@ constexpr rl::Bitmap::Bitmap(
     , page_count(page_count)
     , depth(depth)
     , color(color)
-    , row_offset(row_offset)
+    , row_offset(
+        row_offset_o.value_or(
+            (layout == rl::Bitmap::Layout::Tiled) ?
+                rl::Bitmap::GetTileRowSize(
+                    width,
+                    depth,
+                    color
+                ) :
+                rl::Bitmap::GetRowSize(
+                    width,
+                    depth,
+                    (layout == rl::Bitmap::Layout::Planar) ? rl::Bitmap::Color::G : color
+                )
+        )
+    )
+    , page_offset(
+        page_offset_o.value_or(
+            rl::Bitmap::GetPageSize(
+                width,
+                height,
+                depth,
+                color,
+                layout
+            )
+        )
+    )
+    , layout(layout)
+    , plane_offset(
+        plane_offset_o.value_or(
+            (layout == rl::Bitmap::Layout::Planar) ?
+                this->row_offset * height :
+                0
+        )
+    )
+    , alpha(alpha)
+    , palette(palette)
+    , space(space)
 {
 }
 
@@ -271,7 +484,8 @@ constexpr std::size_t rl::Bitmap::GetPageSize() const noexcept
             this->width,
             this->height,
             this->depth,
-            this->color
+            this->color,
+            this->layout
         );
 }
 
@@ -283,7 +497,8 @@ constexpr std::size_t rl::Bitmap::GetSize() const noexcept
             this->height,
             this->page_count,
             this->depth,
-            this->color
+            this->color,
+            this->layout
         );
 }
 
@@ -297,6 +512,38 @@ constexpr std::size_t rl::Bitmap::GetPageOffset() const noexcept
     return this->page_offset;
 }
 
+constexpr rl::Bitmap::Layout rl::Bitmap::GetLayout() const noexcept
+{
+    return this->layout;
+}
+
+constexpr std::size_t rl::Bitmap::GetPlaneOffset() const noexcept
+{
+    return this->plane_offset;
+}
+
+constexpr rl::Bitmap::Alpha rl::Bitmap::GetAlpha() const noexcept
+{
+    return this->alpha;
+}
+
+constexpr rl::Bitmap::palette_t rl::Bitmap::GetPalette() const noexcept
+{
+    return this->palette;
+}
+
+constexpr rl::Bitmap::Space rl::Bitmap::GetSpace() const noexcept
+{
+    return this->space;
+}
+
+constexpr bool rl::Bitmap::GetIsPremultiplied() const noexcept
+{
+    return
+        this->alpha == rl::Bitmap::Alpha::Premultiplied &&
+        (this->color == rl::Bitmap::Color::Ga || this->color == rl::Bitmap::Color::Rgba);
+}
+
 constexpr std::optional<std::size_t> rl::Bitmap::GetByteIndex(std::size_t x, std::size_t y, std::size_t page, std::size_t channel) const noexcept
 {
     return
@@ -311,7 +558,9 @@ constexpr std::optional<std::size_t> rl::Bitmap::GetByteIndex(std::size_t x, std
             x,
             y,
             page,
-            channel
+            channel,
+            this->layout,
+            this->plane_offset
         );
 }
 
@@ -336,13 +585,31 @@ constexpr rl::Bitmap rl::Bitmap::GetBitmap(std::size_t x, std::size_t y, std::si
         x >= this->width ||
         y >= this->height ||
         page >= this->page_count ||
-        x + width >= this->width ||
-        y + height >= this->height ||
-        page + page_count >= this->page_count
+        x + width > this->width ||
+        y + height > this->height ||
+        page + page_count > this->page_count
     )
     {
         throw rl::runtime_error("view out of bitmap");
     }
+    if (
+        this->layout == rl::Bitmap::Layout::Tiled &&
+        (x % rl::Bitmap::GetTileWidth() != 0 || y % rl::Bitmap::GetTileWidth() != 0)
+    )
+    {
+        throw rl::runtime_error("view of tiled bitmap not aligned to tiles");
+    }
+    if (x * rl::Bitmap::GetBitDepth(this->depth) * this->GetChannelCount() % 8 != 0)
+    {
+        throw rl::runtime_error("view of sub-byte bitmap not aligned to bytes");
+    }
+    if (
+        this->layout == rl::Bitmap::Layout::Tiled &&
+        rl::Bitmap::GetTileSize(fake_depth_o.value_or(this->depth), fake_color_o.value_or(this->color)) != rl::Bitmap::GetTileSize(this->depth, this->color)
+    )
+    {
+        throw rl::runtime_error("fake pixel size of tiled bitmap different from real pixel size");
+    }
     if (rl::Bitmap::GetRowSize(this->width, fake_depth_o.value_or(this->depth), fake_color_o.value_or(this->color)) > this->GetRowSize())
     {
         throw rl::runtime_error("fake bitmap size larger than real bitmap size");
@@ -356,7 +623,12 @@ constexpr rl::Bitmap rl::Bitmap::GetBitmap(std::size_t x, std::size_t y, std::si
             fake_depth_o.value_or(this->depth),
             fake_color_o.value_or(this->color),
             this->row_offset,
-            this->page_offset
+            this->page_offset,
+            this->layout,
+            this->plane_offset,
+            this->alpha,
+            this->palette,
+            this->space
         );
 }
 
@@ -381,13 +653,31 @@ constexpr rl::Bitmap::View rl::Bitmap::GetBitmapView(std::size_t x, std::size_t
         x >= this->width ||
         y >= this->height ||
         page >= this->page_count ||
-        x + width >= this->width ||
-        y + height >= this->height ||
-        page + page_count >= this->page_count
+        x + width > this->width ||
+        y + height > this->height ||
+        page + page_count > this->page_count
     )
     {
         throw rl::runtime_error("view out of bitmap");
     }
+    if (
+        this->layout == rl::Bitmap::Layout::Tiled &&
+        (x % rl::Bitmap::GetTileWidth() != 0 || y % rl::Bitmap::GetTileWidth() != 0)
+    )
+    {
+        throw rl::runtime_error("view of tiled bitmap not aligned to tiles");
+    }
+    if (x * rl::Bitmap::GetBitDepth(this->depth) * this->GetChannelCount() % 8 != 0)
+    {
+        throw rl::runtime_error("view of sub-byte bitmap not aligned to bytes");
+    }
+    if (
+        this->layout == rl::Bitmap::Layout::Tiled &&
+        rl::Bitmap::GetTileSize(fake_depth_o.value_or(this->depth), fake_color_o.value_or(this->color)) != rl::Bitmap::GetTileSize(this->depth, this->color)
+    )
+    {
+        throw rl::runtime_error("fake pixel size of tiled bitmap different from real pixel size");
+    }
     if (rl::Bitmap::GetRowSize(this->width, fake_depth_o.value_or(this->depth), fake_color_o.value_or(this->color)) > this->GetRowSize())
     {
         throw rl::runtime_error("fake bitmap size larger than real bitmap size");
@@ -401,7 +691,12 @@ constexpr rl::Bitmap::View rl::Bitmap::GetBitmapView(std::size_t x, std::size_t
             fake_depth_o.value_or(this->depth),
             fake_color_o.value_or(this->color),
             this->row_offset,
-            this->page_offset
+            this->page_offset,
+            this->layout,
+            this->plane_offset,
+            this->alpha,
+            this->palette,
+            this->space
         );
 }
 
@@ -411,6 +706,10 @@ constexpr rl::Bitmap::Row rl::Bitmap::GetRow(std::size_t y, std::size_t page, st
     {
         throw rl::runtime_error("row out of bitmap");
     }
+    if (this->layout == rl::Bitmap::Layout::Tiled)
+    {
+        throw rl::runtime_error("rows of tiled bitmap are not contiguous");
+    }
     if (rl::Bitmap::GetRowSize(this->width, fake_depth_o.value_or(this->depth), fake_color_o.value_or(this->color)) > this->GetRowSize())
     {
         throw rl::runtime_error("fake row size larger than real row size");
@@ -420,7 +719,12 @@ constexpr rl::Bitmap::Row rl::Bitmap::GetRow(std::size_t y, std::size_t page, st
             this->GetData(0, y, page, 0),
             this->width,
             fake_depth_o.value_or(this->depth),
-            fake_color_o.value_or(this->color)
+            fake_color_o.value_or(this->color),
+            this->layout,
+            this->plane_offset,
+            this->alpha,
+            this->palette,
+            this->space
         );
 }
 
@@ -430,6 +734,10 @@ constexpr const rl::Bitmap::Row::View rl::Bitmap::GetRowView(std::size_t y, std:
     {
         throw rl::runtime_error("row out of bitmap");
     }
+    if (this->layout == rl::Bitmap::Layout::Tiled)
+    {
+        throw rl::runtime_error("rows of tiled bitmap are not contiguous");
+    }
     if (rl::Bitmap::GetRowSize(this->width, fake_depth_o.value_or(this->depth), fake_color_o.value_or(this->color)) > this->GetRowSize())
     {
         throw rl::runtime_error("fake row size larger than real row size");
@@ -439,39 +747,62 @@ constexpr const rl::Bitmap::Row::View rl::Bitmap::GetRowView(std::size_t y, std:
             this->GetData(0, y, page, 0),
             this->width,
             fake_depth_o.value_or(this->depth),
-            fake_color_o.value_or(this->color)
+            fake_color_o.value_or(this->color),
+            this->layout,
+            this->plane_offset,
+            this->alpha,
+            this->palette,
+            this->space
         );
 }
 
-constexpr bool rl::Bitmap::GetIsEmpty() const noexcept
+constexpr rl::Bitmap rl::Bitmap::GetPlane(std::size_t channel)
 {
-    return this->width == 0;
+    if (this->layout != rl::Bitmap::Layout::Planar)
+    {
+        throw rl::runtime_error("plane of bitmap that is not planar");
+    }
+    if (channel >= this->GetChannelCount())
+    {
+        throw rl::runtime_error("plane out of bitmap");
+    }
+    return
+        rl::Bitmap(
+            this->data + channel * this->plane_offset,
+            this->width,
+            this->height,
+            this->page_count,
+            this->depth,
+            rl::Bitmap::Color::G,
+            this->row_offset,
+            this->page_offset
+        );
 }
 
-
-constexpr void rl::Bitmap::Blit(const rl::Bitmap::View& bitmap, std::size_t x, std::size_t y, std::size_t page)
+constexpr rl::Bitmap::View rl::Bitmap::GetPlaneView(std::size_t channel) const
 {
-    if (
-        !this->blit_fits(
-            rl::cell_box2<int>(
-                x,
-                y,
-                bitmap.GetWidth(),
-                bitmap.GetHeight()
-            ),
-            page
-        )
-    )
+    if (this->layout != rl::Bitmap::Layout::Planar)
     {
-        throw rl::runtime_error("blit out of bitmap");
+        throw rl::runtime_error("plane of bitmap that is not planar");
     }
-    for (std::size_t blit_page = 0; blit_page < bitmap.GetPageCount(); blit_page++)
+    if (channel >= this->GetChannelCount())
     {
-        for (std::size_t blit_y = 0; blit_y < bitmap.GetHeight(); blit_y++)
-        {
-            const auto source_row = bitmap.GetRowView(blit_y, blit_page);
-            auto destination_row = this->GetRow(blit_y, blit_page);
-            destination_row.Blit(source_row);
-        }
+        throw rl::runtime_error("plane out of bitmap");
     }
-}
\ No newline at end of file
+    return
+        rl::Bitmap::View(
+            this->data + channel * this->plane_offset,
+            this->width,
+            this->height,
+            this->page_count,
+            this->depth,
+            rl::Bitmap::Color::G,
+            this->row_offset,
+            this->page_offset
+        );
+}
+
+constexpr bool rl::Bitmap::GetIsEmpty() const noexcept
+{
+    return this->width == 0;
+}
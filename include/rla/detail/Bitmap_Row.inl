@@ -31,12 +31,28 @@ constexpr rl::Bitmap::Row::Row(
     rl::Bitmap::byte_t* data,
     std::size_t width,
     rl::Bitmap::Depth depth,
-    rl::Bitmap::Color color
+    rl::Bitmap::Color color,
+    rl::Bitmap::Layout layout,
+    std::optional<std::size_t> plane_offset_o,
+    rl::Bitmap::Alpha alpha,
+    rl::Bitmap::palette_t palette,
+    rl::Bitmap::Space space
 ) noexcept
     : data(data)
     , width(width)
     , depth(depth)
     , color(color)
+    , layout(layout)
+    , plane_offset(
+        plane_offset_o.value_or(
+            (layout == rl::Bitmap::Layout::Planar) ?
+                rl::Bitmap::GetRowSize(width, depth, rl::Bitmap::Color::G) :
+                0
+        )
+    )
+    , alpha(alpha)
+    , palette(palette)
+    , space(space)
 {
 }
 
@@ -55,6 +71,38 @@ constexpr rl::Bitmap::Color rl::Bitmap::Row::GetColor() const noexcept
     return this->color;
 }
 
+constexpr rl::Bitmap::Layout rl::Bitmap::Row::GetLayout() const noexcept
+{
+    return this->layout;
+}
+
+constexpr std::size_t rl::Bitmap::Row::GetPlaneOffset() const noexcept
+{
+    return this->plane_offset;
+}
+
+constexpr rl::Bitmap::Alpha rl::Bitmap::Row::GetAlpha() const noexcept
+{
+    return this->alpha;
+}
+
+constexpr rl::Bitmap::palette_t rl::Bitmap::Row::GetPalette() const noexcept
+{
+    return this->palette;
+}
+
+constexpr rl::Bitmap::Space rl::Bitmap::Row::GetSpace() const noexcept
+{
+    return this->space;
+}
+
+constexpr bool rl::Bitmap::Row::GetIsPremultiplied() const noexcept
+{
+    return
+        this->alpha == rl::Bitmap::Alpha::Premultiplied &&
+        (this->color == rl::Bitmap::Color::Ga || this->color == rl::Bitmap::Color::Rgba);
+}
+
 constexpr rl::Bitmap::byte_t* rl::Bitmap::Row::GetData() const noexcept
 {
     return this->data;
@@ -84,7 +132,18 @@ constexpr std::size_t rl::Bitmap::Row::GetBitDepth() const noexcept
 
 constexpr std::size_t rl::Bitmap::Row::GetSize() const noexcept
 {
-    return rl::Bitmap::GetRowSize(this->width, this->depth, this->color);
+    return
+        rl::Bitmap::get_extent(
+            this->width,
+            1,
+            1,
+            this->depth,
+            this->color,
+            0,
+            0,
+            this->layout,
+            this->plane_offset
+        );
 }
 
 constexpr std::optional<std::size_t> rl::Bitmap::Row::GetByteIndex(std::size_t x, std::size_t channel) const noexcept
@@ -101,154 +160,8 @@ constexpr std::optional<std::size_t> rl::Bitmap::Row::GetByteIndex(std::size_t x
             x,
             0,
             0,
-            channel
+            channel,
+            this->layout,
+            this->plane_offset
         );
 }
-
-constexpr void rl::Bitmap::Row::Blit(const rl::Bitmap::Row::View& row)
-{
-    if (row.GetWidth() != this->width)
-    {
-        throw rl::runtime_error("blit row has different width");
-    }
-    auto convert_row = [&]<typename S, typename D>() 
-	{
-		auto source_to_destination = [&]<typename SP>(std::size_t x, const SP& source_pixel) 
-        {
-            std::size_t channel_i = 0;
-            D* destination_ptr = reinterpret_cast<D*>(this->GetData(x, 0));
-			if (this->color == rl::Bitmap::Color::G)
-			{
-				const auto destination_pixel = rl::to_color_g<D, S>(source_pixel);
-				destination_ptr[channel_i++] = destination_pixel.g;
-			}
-			else if (this->color == rl::Bitmap::Color::Ga)
-			{
-				const auto destination_pixel = rl::to_color_ga<D, S>(source_pixel);
-				destination_ptr[channel_i++] = destination_pixel.g;
-				destination_ptr[channel_i] = destination_pixel.a;
-			}
-			else if (this->color == rl::Bitmap::Color::Rgb)
-			{
-				const auto destination_pixel = rl::to_color_rgb<D, S>(source_pixel);
-				destination_ptr[channel_i++] = destination_pixel.r;
-				destination_ptr[channel_i++] = destination_pixel.g;
-				destination_ptr[channel_i] = destination_pixel.b;
-			}
-			else if (this->color == rl::Bitmap::Color::Rgba)
-			{
-				const auto destination_pixel = rl::to_color_rgba<D, S>(source_pixel);
-				destination_ptr[channel_i++] = destination_pixel.r;
-				destination_ptr[channel_i++] = destination_pixel.g;
-				destination_ptr[channel_i++] = destination_pixel.b;
-				destination_ptr[channel_i] = destination_pixel.a;
-			}
-		};
-		auto convert_pixel = [&](std::size_t x) 
-		{
-			const S* source_ptr = reinterpret_cast<const S*>(row.GetData(x, 0));
-            std::size_t channel_i = 0;
-			if (row.GetColor() == rl::Bitmap::Color::G)
-			{
-				source_to_destination(
-					x,
-					rl::color_g<S>(
-						source_ptr[channel_i]
-					)
-				);
-			}
-			else if (row.GetColor() == rl::Bitmap::Color::Ga)
-			{
-				source_to_destination(
-					x,
-					rl::color_ga<S>(
-						source_ptr[channel_i++],
-						source_ptr[channel_i]
-					)
-				);
-			}
-			else if (row.GetColor() == rl::Bitmap::Color::Rgb)
-			{
-				source_to_destination(
-					x,
-					rl::color_rgb<S>(
-						source_ptr[channel_i++],
-						source_ptr[channel_i++],
-						source_ptr[channel_i]
-					)
-				);				
-			}
-			else if (row.GetColor() == rl::Bitmap::Color::Rgba)
-			{
-				source_to_destination(
-					x,
-					rl::color_rgba<S>(
-						source_ptr[channel_i++],
-						source_ptr[channel_i++],
-						source_ptr[channel_i++],
-						source_ptr[channel_i]
-					)
-				);
-			}
-		};
-		// convert in reverse if necessary to prevent pixel overwriting when the pixels are converted in place. 
-		if (sizeof(S) >= sizeof(D))
-		{
-			for (int pixel_i = 0; pixel_i < this->GetWidth(); pixel_i++)
-			{
-				convert_pixel(static_cast<std::size_t>(pixel_i));
-			}
-		}
-		else
-		{
-			for (int pixel_i = this->GetWidth(); pixel_i >= 0; pixel_i--)
-			{
-				convert_pixel(static_cast<std::size_t>(pixel_i));
-			}
-		}
-	};
-	switch (row.GetDepth())
-	{
-		case rl::Bitmap::Depth::Octuple:
-			switch (this->depth)
-			{
-				case rl::Bitmap::Depth::Octuple:
-					convert_row.template operator()<rl::Bitmap::octuple_t, rl::Bitmap::octuple_t>();
-					break;
-				case rl::Bitmap::Depth::Sexdecuple:
-					convert_row.template operator()<rl::Bitmap::octuple_t, rl::Bitmap::sexdecuple_t>();
-					break;
-				case rl::Bitmap::Depth::Normalized:
-					convert_row.template operator()<rl::Bitmap::octuple_t, rl::Bitmap::normalized_t>();
-					break;
-			}
-			break;
-		case rl::Bitmap::Depth::Sexdecuple:
-			switch (this->depth)
-			{
-				case rl::Bitmap::Depth::Octuple:
-					convert_row.template operator()<rl::Bitmap::sexdecuple_t, rl::Bitmap::octuple_t>();
-					break;
-				case rl::Bitmap::Depth::Sexdecuple:
-					convert_row.template operator()<rl::Bitmap::sexdecuple_t, rl::Bitmap::sexdecuple_t>();
-					break;
-				case rl::Bitmap::Depth::Normalized:
-					convert_row.template operator()<rl::Bitmap::sexdecuple_t, rl::Bitmap::normalized_t>();
-					break;
-			}
-			break;
-		case rl::Bitmap::Depth::Normalized:
-			switch (this->depth)
-			{
-				case rl::Bitmap::Depth::Octuple:
-					convert_row.template operator()<rl::Bitmap::normalized_t, rl::Bitmap::octuple_t>();
-					break;
-				case rl::Bitmap::Depth::Sexdecuple:
-					convert_row.template operator()<rl::Bitmap::normalized_t, rl::Bitmap::sexdecuple_t>();
-					break;
-				case rl::Bitmap::Depth::Normalized:
-					convert_row.template operator()<rl::Bitmap::normalized_t, rl::Bitmap::normalized_t>();
-					break;
-			}
-	}
-}
\ No newline at end of file
@@ -30,12 +30,28 @@ constexpr rl::Bitmap::Row::View::View(
     const rl::Bitmap::byte_t* data,
     std::size_t width,
     rl::Bitmap::Depth depth,
-    rl::Bitmap::Color color
+    rl::Bitmap::Color color,
+    rl::Bitmap::Layout layout,
+    std::optional<std::size_t> plane_offset_o,
+    rl::Bitmap::Alpha alpha,
+    rl::Bitmap::palette_t palette,
+    rl::Bitmap::Space space
 ) noexcept
     : data(data)
     , width(width)
     , depth(depth)
     , color(color)
+    , layout(layout)
+    , plane_offset(
+        plane_offset_o.value_or(
+            (layout == rl::Bitmap::Layout::Planar) ?
+                rl::Bitmap::GetRowSize(width, depth, rl::Bitmap::Color::G) :
+                0
+        )
+    )
+    , alpha(alpha)
+    , palette(palette)
+    , space(space)
 {
 }
 
@@ -44,6 +60,11 @@ constexpr rl::Bitmap::Row::View::View(const rl::Bitmap::Row& row) noexcept
     , width(row.GetWidth())
     , depth(row.GetDepth())
     , color(row.GetColor())
+    , layout(row.GetLayout())
+    , plane_offset(row.GetPlaneOffset())
+    , alpha(row.GetAlpha())
+    , palette(row.GetPalette())
+    , space(row.GetSpace())
 {
 }
 
@@ -53,6 +74,11 @@ constexpr rl::Bitmap::Row::View& rl::Bitmap::Row::View::operator=(const rl::Bitm
     this->width = row.GetWidth();
     this->depth = row.GetDepth();
     this->color = row.GetColor();
+    this->layout = row.GetLayout();
+    this->plane_offset = row.GetPlaneOffset();
+    this->alpha = row.GetAlpha();
+    this->palette = row.GetPalette();
+    this->space = row.GetSpace();
     return *this;
 }
 
@@ -71,6 +97,38 @@ constexpr rl::Bitmap::Color rl::Bitmap::Row::View::GetColor() const noexcept
     return this->color;
 }
 
+constexpr rl::Bitmap::Layout rl::Bitmap::Row::View::GetLayout() const noexcept
+{
+    return this->layout;
+}
+
+constexpr std::size_t rl::Bitmap::Row::View::GetPlaneOffset() const noexcept
+{
+    return this->plane_offset;
+}
+
+constexpr rl::Bitmap::Alpha rl::Bitmap::Row::View::GetAlpha() const noexcept
+{
+    return this->alpha;
+}
+
+constexpr rl::Bitmap::palette_t rl::Bitmap::Row::View::GetPalette() const noexcept
+{
+    return this->palette;
+}
+
+constexpr rl::Bitmap::Space rl::Bitmap::Row::View::GetSpace() const noexcept
+{
+    return this->space;
+}
+
+constexpr bool rl::Bitmap::Row::View::GetIsPremultiplied() const noexcept
+{
+    return
+        this->alpha == rl::Bitmap::Alpha::Premultiplied &&
+        (this->color == rl::Bitmap::Color::Ga || this->color == rl::Bitmap::Color::Rgba);
+}
+
 constexpr const rl::Bitmap::byte_t* rl::Bitmap::Row::View::GetData() const noexcept
 {
     return this->data;
@@ -100,7 +158,18 @@ constexpr std::size_t rl::Bitmap::Row::View::GetBitDepth() const noexcept
 
 constexpr std::size_t rl::Bitmap::Row::View::GetSize() const noexcept
 {
-    return rl::Bitmap::GetRowSize(this->width, this->depth, this->color);
+    return
+        rl::Bitmap::get_extent(
+            this->width,
+            1,
+            1,
+            this->depth,
+            this->color,
+            0,
+            0,
+            this->layout,
+            this->plane_offset
+        );
 }
 
 constexpr std::optional<std::size_t> rl::Bitmap::Row::View::GetByteIndex(std::size_t x, std::size_t channel) const noexcept
@@ -117,6 +186,8 @@ constexpr std::optional<std::size_t> rl::Bitmap::Row::View::GetByteIndex(std::si
             x,
             0,
             0,
-            channel
+            channel,
+            this->layout,
+            this->plane_offset
         );
 }
\ No newline at end of file
@@ -34,7 +34,12 @@ constexpr rl::Bitmap::View::View(
     rl::Bitmap::Depth depth,
     rl::Bitmap::Color color,
     std::optional<std::size_t> row_offset_o,
-    std::optional<std::size_t> page_offset_o
+    std::optional<std::size_t> page_offset_o,
+    rl::Bitmap::Layout layout,
+    std::optional<std::size_t> plane_offset_o,
+    rl::Bitmap::Alpha alpha,
+    rl::Bitmap::palette_t palette,
+    rl::Bitmap::Space space
 ) noexcept
     : data(data)
     , width(width)
@@ -44,11 +49,17 @@ constexpr rl::Bitmap::View::View(
     , color(color)
     , row_offset(
         row_offset_o.value_or(
-            rl::Bitmap::GetRowSize(\
-                width,
-                depth,
-                color
-            )
+            (layout == rl::Bitmap::Layout::Tiled) ?
+                rl::Bitmap::GetTileRowSize(
+                    width,
+                    depth,
+                    color
+                ) :
+                rl::Bitmap::GetRowSize(
+                    width,
+                    depth,
+                    (layout == rl::Bitmap::Layout::Planar) ? rl::Bitmap::Color::G : color
+                )
         )
     )
     , page_offset(
@@ -57,10 +68,22 @@ constexpr rl::Bitmap::View::View(
                 width,
                 height,
                 depth,
-                color
+                color,
+                layout
             )
         )
     )
+    , layout(layout)
+    , plane_offset(
+        plane_offset_o.value_or(
+            (layout == rl::Bitmap::Layout::Planar) ?
+                this->row_offset * height :
+                0
+        )
+    )
+    , alpha(alpha)
+    , palette(palette)
+    , space(space)
 {
 }
 
@@ -73,6 +96,11 @@ constexpr rl::Bitmap::View::View(const rl::Bitmap& bitmap) noexcept
     , color(bitmap.GetColor())
     , row_offset(bitmap.GetRowOffset())
     , page_offset(bitmap.GetPageOffset())
+    , layout(bitmap.GetLayout())
+    , plane_offset(bitmap.GetPlaneOffset())
+    , alpha(bitmap.GetAlpha())
+    , palette(bitmap.GetPalette())
+    , space(bitmap.GetSpace())
 {
 }
 
@@ -86,6 +114,11 @@ constexpr rl::Bitmap::View& rl::Bitmap::View::operator=(const rl::Bitmap& bitmap
     this->color = bitmap.GetColor();
     this->row_offset = bitmap.GetRowOffset();
     this->page_offset = bitmap.GetPageOffset();
+    this->layout = bitmap.GetLayout();
+    this->plane_offset = bitmap.GetPlaneOffset();
+    this->alpha = bitmap.GetAlpha();
+    this->palette = bitmap.GetPalette();
+    this->space = bitmap.GetSpace();
     return *this;
 }
 
@@ -134,6 +167,38 @@ constexpr std::size_t rl::Bitmap::View::GetPageOffset() const noexcept
     return this->page_offset;
 }
 
+constexpr rl::Bitmap::Layout rl::Bitmap::View::GetLayout() const noexcept
+{
+    return this->layout;
+}
+
+constexpr std::size_t rl::Bitmap::View::GetPlaneOffset() const noexcept
+{
+    return this->plane_offset;
+}
+
+constexpr rl::Bitmap::Alpha rl::Bitmap::View::GetAlpha() const noexcept
+{
+    return this->alpha;
+}
+
+constexpr rl::Bitmap::palette_t rl::Bitmap::View::GetPalette() const noexcept
+{
+    return this->palette;
+}
+
+constexpr rl::Bitmap::Space rl::Bitmap::View::GetSpace() const noexcept
+{
+    return this->space;
+}
+
+constexpr bool rl::Bitmap::View::GetIsPremultiplied() const noexcept
+{
+    return
+        this->alpha == rl::Bitmap::Alpha::Premultiplied &&
+        (this->color == rl::Bitmap::Color::Ga || this->color == rl::Bitmap::Color::Rgba);
+}
+
 constexpr const rl::Bitmap::byte_t* rl::Bitmap::View::GetData() const noexcept
 {
     return this->data;
@@ -141,7 +206,7 @@ constexpr const rl::Bitmap::byte_t* rl::Bitmap::View::GetData() const noexcept
 
 constexpr const rl::Bitmap::byte_t* rl::Bitmap::View::GetData(std::size_t x, std::size_t y, std::size_t page, std::size_t channel) const noexcept
 {
-    const auto byte_index_o = this->GetByteIndex(x, channel);
+    const auto byte_index_o = this->GetByteIndex(x, y, page, channel);
     if (!byte_index_o.has_value())
     {
         return nullptr;
@@ -168,12 +233,12 @@ constexpr std::size_t rl::Bitmap::View::GetPixelSize() const noexcept
 
 constexpr std::size_t rl::Bitmap::View::GetPageSize() const noexcept
 {
-    return rl::Bitmap::GetPageSize(this->width, this->height, this->depth, this->color);
+    return rl::Bitmap::GetPageSize(this->width, this->height, this->depth, this->color, this->layout);
 }
 
 constexpr std::size_t rl::Bitmap::View::GetSize() const noexcept
 {
-    return rl::Bitmap::GetSize(this->width, this->height, this->page_count, this->depth, this->color);
+    return rl::Bitmap::GetSize(this->width, this->height, this->page_count, this->depth, this->color, this->layout);
 }
 
 constexpr std::optional<std::size_t> rl::Bitmap::View::GetByteIndex(std::size_t x, std::size_t y, std::size_t page, std::size_t channel) const noexcept
@@ -190,7 +255,9 @@ constexpr std::optional<std::size_t> rl::Bitmap::View::GetByteIndex(std::size_t
             x,
             y,
             page,
-            channel
+            channel,
+            this->layout,
+            this->plane_offset
         );
 }
 
@@ -220,13 +287,31 @@ constexpr const rl::Bitmap::View rl::Bitmap::View::GetBitmapView(std::size_t x,
         x >= this->width ||
         y >= this->height ||
         page >= this->page_count ||
-        x + width >= this->width ||
-        y + height >= this->height ||
-        page + page_count >= this->page_count
+        x + width > this->width ||
+        y + height > this->height ||
+        page + page_count > this->page_count
     )
     {
         throw rl::runtime_error("view out of bitmap");
     }
+    if (
+        this->layout == rl::Bitmap::Layout::Tiled &&
+        (x % rl::Bitmap::GetTileWidth() != 0 || y % rl::Bitmap::GetTileWidth() != 0)
+    )
+    {
+        throw rl::runtime_error("view of tiled bitmap not aligned to tiles");
+    }
+    if (x * rl::Bitmap::GetBitDepth(this->depth) * this->GetChannelCount() % 8 != 0)
+    {
+        throw rl::runtime_error("view of sub-byte bitmap not aligned to bytes");
+    }
+    if (
+        this->layout == rl::Bitmap::Layout::Tiled &&
+        rl::Bitmap::GetTileSize(fake_depth_o.value_or(this->depth), fake_color_o.value_or(this->color)) != rl::Bitmap::GetTileSize(this->depth, this->color)
+    )
+    {
+        throw rl::runtime_error("fake pixel size of tiled bitmap different from real pixel size");
+    }
     if (rl::Bitmap::GetRowSize(this->width, fake_depth_o.value_or(this->depth), fake_color_o.value_or(this->color)) > this->GetRowSize())
     {
         throw rl::runtime_error("fake bitmap size larger than real bitmap size");
@@ -240,7 +325,12 @@ constexpr const rl::Bitmap::View rl::Bitmap::View::GetBitmapView(std::size_t x,
             fake_depth_o.value_or(this->depth),
             fake_color_o.value_or(this->color),
             this->row_offset,
-            this->page_offset
+            this->page_offset,
+            this->layout,
+            this->plane_offset,
+            this->alpha,
+            this->palette,
+            this->space
         );
 }
 
@@ -250,6 +340,10 @@ constexpr const rl::Bitmap::Row::View rl::Bitmap::View::GetRowView(std::size_t y
     {
         throw rl::runtime_error("row out of bitmap");
     }
+    if (this->layout == rl::Bitmap::Layout::Tiled)
+    {
+        throw rl::runtime_error("rows of tiled bitmap are not contiguous");
+    }
     if (rl::Bitmap::GetRowSize(this->width, fake_depth_o.value_or(this->depth), fake_color_o.value_or(this->color)) > this->GetRowSize())
     {
         throw rl::runtime_error("fake row size larger than real row size");
@@ -259,6 +353,34 @@ constexpr const rl::Bitmap::Row::View rl::Bitmap::View::GetRowView(std::size_t y
             this->GetData(0, y, page, 0),
             this->width,
             fake_depth_o.value_or(this->depth),
-            fake_color_o.value_or(this->color)
+            fake_color_o.value_or(this->color),
+            this->layout,
+            this->plane_offset,
+            this->alpha,
+            this->palette,
+            this->space
+        );
+}
+
+constexpr const rl::Bitmap::View rl::Bitmap::View::GetPlaneView(std::size_t channel) const
+{
+    if (this->layout != rl::Bitmap::Layout::Planar)
+    {
+        throw rl::runtime_error("plane of bitmap that is not planar");
+    }
+    if (channel >= this->GetChannelCount())
+    {
+        throw rl::runtime_error("plane out of bitmap");
+    }
+    return
+        rl::Bitmap::View(
+            this->data + channel * this->plane_offset,
+            this->width,
+            this->height,
+            this->page_count,
+            this->depth,
+            rl::Bitmap::Color::G,
+            this->row_offset,
+            this->page_offset
         );
-}
\ No newline at end of file
+}
@@ -0,0 +1,244 @@
+// SPDX-FileCopyrightText: 2023 Daniel Aimé Valcour <fosssweeper@gmail.com>
+//
+// SPDX-License-Identifier: MIT
+
+/*
+    Copyright (c) 2023 Daniel Aimé Valcour
+    Permission is hereby granted, free of charge, to any person obtaining a copy of
+    this software and associated documentation files (the "Software"), to deal in
+    the Software without restriction, including without limitation the rights to
+    use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+    the Software, and to permit persons to whom the Software is furnished to do so,
+    subject to the following conditions:
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+    FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+    COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+    IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+    CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include <rla/TypedView.hpp>
+#include <rld/except.hpp>
+#include <cstdint>
+
+template<rl::Bitmap::Depth Depth, rl::Bitmap::Color Color, bool IsMutable>
+constexpr rl::BasicTypedView<Depth, Color, IsMutable>::BasicTypedView(
+    byte_pointer_t data,
+    std::size_t width,
+    std::size_t height,
+    std::size_t page_count,
+    std::optional<std::size_t> row_offset_o,
+    std::optional<std::size_t> page_offset_o
+) noexcept
+    : data(data)
+    , width(width)
+    , height(height)
+    , page_count(page_count)
+    , row_offset(row_offset_o.value_or(width * sizeof(pixel_t)))
+    , page_offset(page_offset_o.value_or(row_offset_o.value_or(width * sizeof(pixel_t)) * height))
+{
+}
+
+template<rl::Bitmap::Depth Depth, rl::Bitmap::Color Color, bool IsMutable>
+template<bool IsViewMutable>
+    requires (IsViewMutable && !IsMutable)
+constexpr rl::BasicTypedView<Depth, Color, IsMutable>::BasicTypedView(const rl::BasicTypedView<Depth, Color, IsViewMutable>& view) noexcept
+    : data(view.GetData())
+    , width(view.GetWidth())
+    , height(view.GetHeight())
+    , page_count(view.GetPageCount())
+    , row_offset(view.GetRowOffset())
+    , page_offset(view.GetPageOffset())
+{
+}
+
+template<rl::Bitmap::Depth Depth, rl::Bitmap::Color Color, bool IsMutable>
+rl::BasicTypedView<Depth, Color, IsMutable> rl::BasicTypedView<Depth, Color, IsMutable>::Checked(const bitmap_t& bitmap)
+{
+    if (bitmap.GetDepth() != Depth || bitmap.GetColor() != Color)
+    {
+        throw rl::runtime_error("typed view format different from bitmap format");
+    }
+    if (bitmap.GetLayout() != rl::Bitmap::Layout::Linear)
+    {
+        throw rl::runtime_error("typed view of bitmap that is not linear");
+    }
+    if (
+        reinterpret_cast<std::uintptr_t>(bitmap.GetData()) % alignof(channel_t) != 0 ||
+        bitmap.GetRowOffset() % alignof(channel_t) != 0 ||
+        bitmap.GetPageOffset() % alignof(channel_t) != 0
+    )
+    {
+        throw rl::runtime_error("typed view of bitmap not aligned to channels");
+    }
+    return
+        rl::BasicTypedView<Depth, Color, IsMutable>(
+            bitmap.GetData(),
+            bitmap.GetWidth(),
+            bitmap.GetHeight(),
+            bitmap.GetPageCount(),
+            bitmap.GetRowOffset(),
+            bitmap.GetPageOffset()
+        );
+}
+
+template<rl::Bitmap::Depth Depth, rl::Bitmap::Color Color, bool IsMutable>
+constexpr typename rl::BasicTypedView<Depth, Color, IsMutable>::byte_pointer_t rl::BasicTypedView<Depth, Color, IsMutable>::GetData() const noexcept
+{
+    return this->data;
+}
+
+template<rl::Bitmap::Depth Depth, rl::Bitmap::Color Color, bool IsMutable>
+constexpr std::size_t rl::BasicTypedView<Depth, Color, IsMutable>::GetWidth() const noexcept
+{
+    return this->width;
+}
+
+template<rl::Bitmap::Depth Depth, rl::Bitmap::Color Color, bool IsMutable>
+constexpr std::size_t rl::BasicTypedView<Depth, Color, IsMutable>::GetHeight() const noexcept
+{
+    return this->height;
+}
+
+template<rl::Bitmap::Depth Depth, rl::Bitmap::Color Color, bool IsMutable>
+constexpr std::size_t rl::BasicTypedView<Depth, Color, IsMutable>::GetPageCount() const noexcept
+{
+    return this->page_count;
+}
+
+template<rl::Bitmap::Depth Depth, rl::Bitmap::Color Color, bool IsMutable>
+constexpr std::size_t rl::BasicTypedView<Depth, Color, IsMutable>::GetRowOffset() const noexcept
+{
+    return this->row_offset;
+}
+
+template<rl::Bitmap::Depth Depth, rl::Bitmap::Color Color, bool IsMutable>
+constexpr std::size_t rl::BasicTypedView<Depth, Color, IsMutable>::GetPageOffset() const noexcept
+{
+    return this->page_offset;
+}
+
+template<rl::Bitmap::Depth Depth, rl::Bitmap::Color Color, bool IsMutable>
+constexpr bool rl::BasicTypedView<Depth, Color, IsMutable>::GetIsEmpty() const noexcept
+{
+    return this->data == nullptr || this->width == 0 || this->height == 0 || this->page_count == 0;
+}
+
+template<rl::Bitmap::Depth Depth, rl::Bitmap::Color Color, bool IsMutable>
+typename rl::BasicTypedView<Depth, Color, IsMutable>::pixel_pointer_t rl::BasicTypedView<Depth, Color, IsMutable>::GetRowData(std::size_t y, std::size_t page) const noexcept
+{
+    return
+        reinterpret_cast<pixel_pointer_t>(
+            this->data +
+            page * this->page_offset +
+            y * this->row_offset
+        );
+}
+
+template<rl::Bitmap::Depth Depth, rl::Bitmap::Color Color, bool IsMutable>
+typename rl::BasicTypedView<Depth, Color, IsMutable>::row_t rl::BasicTypedView<Depth, Color, IsMutable>::GetRow(std::size_t y, std::size_t page) const noexcept
+{
+    return row_t(this->GetRowData(y, page), this->width);
+}
+
+template<rl::Bitmap::Depth Depth, rl::Bitmap::Color Color, bool IsMutable>
+std::remove_pointer_t<typename rl::BasicTypedView<Depth, Color, IsMutable>::pixel_pointer_t>& rl::BasicTypedView<Depth, Color, IsMutable>::GetPixel(std::size_t x, std::size_t y, std::size_t page) const noexcept
+{
+    return this->GetRowData(y, page)[x];
+}
+
+template<rl::Bitmap::Depth Depth, rl::Bitmap::Color Color, bool IsMutable>
+auto rl::BasicTypedView<Depth, Color, IsMutable>::GetRows() const noexcept
+{
+    // the view is copied into the range, so the range outlives the view but not its data
+    return
+        std::views::iota(std::size_t(0), this->height * this->page_count) |
+        std::views::transform(
+            [view = *this](std::size_t row_i)
+            {
+                return view.GetRow(row_i % view.height, row_i / view.height);
+            }
+        );
+}
+
+template<rl::Bitmap::Depth Depth, rl::Bitmap::Color Color, bool IsMutable>
+std::ranges::subrange<typename rl::BasicTypedView<Depth, Color, IsMutable>::PixelIterator> rl::BasicTypedView<Depth, Color, IsMutable>::GetPixels() const noexcept
+{
+    const std::size_t row_count = (this->width == 0) ? 0 : this->height * this->page_count;
+    return
+        std::ranges::subrange<PixelIterator>(
+            PixelIterator(*this, 0),
+            PixelIterator(*this, row_count)
+        );
+}
+
+template<rl::Bitmap::Depth Depth, rl::Bitmap::Color Color, bool IsMutable>
+rl::BasicTypedView<Depth, Color, IsMutable>::PixelIterator::PixelIterator(const rl::BasicTypedView<Depth, Color, IsMutable>& view, std::size_t row_i) noexcept
+    : data(view.GetData())
+    , width(view.GetWidth())
+    , height(view.GetHeight())
+    , row_count(view.GetHeight() * view.GetPageCount())
+    , row_offset(view.GetRowOffset())
+    , page_offset(view.GetPageOffset())
+{
+    this->set_row(row_i);
+}
+
+template<rl::Bitmap::Depth Depth, rl::Bitmap::Color Color, bool IsMutable>
+void rl::BasicTypedView<Depth, Color, IsMutable>::PixelIterator::set_row(std::size_t row_i) noexcept
+{
+    this->row_i = row_i;
+    // iterators past the last row have no pixel, so every end iterator is equal
+    if (row_i < this->row_count && this->width != 0)
+    {
+        this->pixel = reinterpret_cast<pixel_pointer_t>(this->data + (row_i / this->height) * this->page_offset + (row_i % this->height) * this->row_offset);
+        this->row_end = this->pixel + this->width;
+    }
+    else
+    {
+        this->pixel = nullptr;
+        this->row_end = nullptr;
+    }
+}
+
+template<rl::Bitmap::Depth Depth, rl::Bitmap::Color Color, bool IsMutable>
+typename rl::BasicTypedView<Depth, Color, IsMutable>::PixelIterator::reference rl::BasicTypedView<Depth, Color, IsMutable>::PixelIterator::operator*() const noexcept
+{
+    return *this->pixel;
+}
+
+template<rl::Bitmap::Depth Depth, rl::Bitmap::Color Color, bool IsMutable>
+typename rl::BasicTypedView<Depth, Color, IsMutable>::PixelIterator::pointer rl::BasicTypedView<Depth, Color, IsMutable>::PixelIterator::operator->() const noexcept
+{
+    return this->pixel;
+}
+
+template<rl::Bitmap::Depth Depth, rl::Bitmap::Color Color, bool IsMutable>
+typename rl::BasicTypedView<Depth, Color, IsMutable>::PixelIterator& rl::BasicTypedView<Depth, Color, IsMutable>::PixelIterator::operator++() noexcept
+{
+    ++this->pixel;
+    if (this->pixel == this->row_end)
+    {
+        this->set_row(this->row_i + 1);
+    }
+    return *this;
+}
+
+template<rl::Bitmap::Depth Depth, rl::Bitmap::Color Color, bool IsMutable>
+typename rl::BasicTypedView<Depth, Color, IsMutable>::PixelIterator rl::BasicTypedView<Depth, Color, IsMutable>::PixelIterator::operator++(int) noexcept
+{
+    auto previous = *this;
+    ++*this;
+    return previous;
+}
+
+template<rl::Bitmap::Depth Depth, rl::Bitmap::Color Color, bool IsMutable>
+constexpr bool rl::BasicTypedView<Depth, Color, IsMutable>::PixelIterator::operator==(const PixelIterator& that) const noexcept
+{
+    return this->pixel == that.pixel;
+}
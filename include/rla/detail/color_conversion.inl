@@ -37,6 +37,8 @@ constexpr rl::Png::Color rl::to_png_color(rl::Bitmap::Color color) noexcept
             return rl::Png::Color::Rgb;
         case rl::Bitmap::Color::Rgba:
             return rl::Png::Color::Rgba;
+        case rl::Bitmap::Color::Indexed:
+            return rl::Png::Color::Palette;
     }
     return rl::Png::Color::Rgb;
 }
@@ -54,7 +56,7 @@ constexpr rl::Bitmap::Color rl::to_bitmap_color(rl::Png::Color color) noexcept
         case rl::Png::Color::Rgba:
             return rl::Bitmap::Color::Rgba;
         case rl::Png::Color::Palette:
-            return rl::Bitmap::Color::Rgb;
+            return rl::Bitmap::Color::Indexed;
     }
     return rl::Bitmap::Color::Rgb;
 }
\ No newline at end of file
@@ -0,0 +1,435 @@
+// SPDX-FileCopyrightText: 2023 Daniel Aimé Valcour <fosssweeper@gmail.com>
+//
+// SPDX-License-Identifier: MIT
+
+/*
+    Copyright (c) 2023 Daniel Aimé Valcour
+    Permission is hereby granted, free of charge, to any person obtaining a copy of
+    this software and associated documentation files (the "Software"), to deal in
+    the Software without restriction, including without limitation the rights to
+    use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+    the Software, and to permit persons to whom the Software is furnished to do so,
+    subject to the following conditions:
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+    FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+    COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+    IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+    CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include <rla/gray.hpp>
+#include <rlm/color/color_g.hpp>
+#include <rlm/color/color_ga.hpp>
+#include <rlm/color/color_rgb.hpp>
+#include <rlm/color/color_rgba.hpp>
+#include <rlm/color/color_conversion.hpp>
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+namespace rl::detail
+{
+    template<rl::Bitmap::Depth Depth>
+    struct bitmap_channel;
+
+    template<>
+    struct bitmap_channel<rl::Bitmap::Depth::Octuple>
+    {
+        using type = rl::Bitmap::octuple_t;
+    };
+
+    template<>
+    struct bitmap_channel<rl::Bitmap::Depth::Sexdecuple>
+    {
+        using type = rl::Bitmap::sexdecuple_t;
+    };
+
+    template<>
+    struct bitmap_channel<rl::Bitmap::Depth::Normalized>
+    {
+        using type = rl::Bitmap::normalized_t;
+    };
+
+    // half channels are converted as floats
+    template<>
+    struct bitmap_channel<rl::Bitmap::Depth::Half>
+    {
+        using type = rl::Bitmap::normalized_t;
+    };
+
+    template<rl::Bitmap::Depth Depth>
+    using bitmap_channel_t = typename rl::detail::bitmap_channel<Depth>::type;
+
+    // exact, and quiets signaling nans like the f16c and neon conversions do
+    constexpr float half_to_float(rl::Bitmap::half_t half) noexcept
+    {
+        constexpr std::uint32_t shifted_exponent = 0x7c00u << 13;
+        std::uint32_t bits = (static_cast<std::uint32_t>(half) & 0x7fffu) << 13;
+        const std::uint32_t exponent = bits & shifted_exponent;
+        bits += (127u - 15u) << 23;
+        if (exponent == shifted_exponent)
+        {
+            // infinities and nans keep the maximum exponent
+            bits += (128u - 16u) << 23;
+            if ((bits & 0x7fffffu) != 0)
+            {
+                bits |= 0x400000u;
+            }
+        }
+        else if (exponent == 0)
+        {
+            // subnormals are normalized by the float subtraction
+            bits += 1u << 23;
+            bits = std::bit_cast<std::uint32_t>(std::bit_cast<float>(bits) - std::bit_cast<float>(113u << 23));
+        }
+        return std::bit_cast<float>(bits | ((static_cast<std::uint32_t>(half) & 0x8000u) << 16));
+    }
+
+    // rounds to the nearest even half like the f16c and neon conversions do
+    constexpr rl::Bitmap::half_t float_to_half(float value) noexcept
+    {
+        std::uint32_t bits = std::bit_cast<std::uint32_t>(value);
+        const std::uint32_t sign = (bits >> 16) & 0x8000u;
+        bits &= 0x7fffffffu;
+        std::uint32_t half = 0;
+        if (bits > 0x7f800000u)
+        {
+            half = 0x7e00u | ((bits >> 13) & 0x3ffu);
+        }
+        else if (bits >= (127u + 16u) << 23)
+        {
+            half = 0x7c00u;
+        }
+        else if (bits < 113u << 23)
+        {
+            // the float addition rounds the subnormal mantissa into the low bits
+            constexpr std::uint32_t subnormal_magic = ((127u - 15u) + (23u - 10u) + 1u) << 23;
+            half = std::bit_cast<std::uint32_t>(std::bit_cast<float>(bits) + std::bit_cast<float>(subnormal_magic)) - subnormal_magic;
+        }
+        else
+        {
+            const std::uint32_t is_mantissa_odd = (bits >> 13) & 1u;
+            bits += ((15u - 127u) << 23) + 0xfffu + is_mantissa_odd;
+            half = bits >> 13;
+        }
+        return static_cast<rl::Bitmap::half_t>(half | sign);
+    }
+
+    // channels are copied as they are stored, except for half channels which are widened to floats
+    template<rl::Bitmap::Depth Depth, typename C>
+    void load_channels(const rl::Bitmap::byte_t* source, C* channels, std::size_t channel_count) noexcept
+    {
+        if constexpr (Depth == rl::Bitmap::Depth::Half)
+        {
+            for (std::size_t channel_i = 0; channel_i < channel_count; channel_i++)
+            {
+                rl::Bitmap::half_t half;
+                std::memcpy(&half, source + channel_i * sizeof(half), sizeof(half));
+                channels[channel_i] = rl::detail::half_to_float(half);
+            }
+        }
+        else
+        {
+            std::memcpy(channels, source, channel_count * sizeof(C));
+        }
+    }
+
+    template<rl::Bitmap::Depth Depth, typename C>
+    void store_channels(const C* channels, rl::Bitmap::byte_t* destination, std::size_t channel_count) noexcept
+    {
+        if constexpr (Depth == rl::Bitmap::Depth::Half)
+        {
+            for (std::size_t channel_i = 0; channel_i < channel_count; channel_i++)
+            {
+                const rl::Bitmap::half_t half = rl::detail::float_to_half(channels[channel_i]);
+                std::memcpy(destination + channel_i * sizeof(half), &half, sizeof(half));
+            }
+        }
+        else
+        {
+            std::memcpy(destination, channels, channel_count * sizeof(C));
+        }
+    }
+
+    template<rl::Bitmap::Color Color, typename C>
+    constexpr auto make_color(const C* channels) noexcept
+    {
+        if constexpr (Color == rl::Bitmap::Color::G)
+        {
+            return rl::color_g<C>(channels[0]);
+        }
+        else if constexpr (Color == rl::Bitmap::Color::Ga)
+        {
+            return rl::color_ga<C>(channels[0], channels[1]);
+        }
+        else if constexpr (Color == rl::Bitmap::Color::Rgb)
+        {
+            return rl::color_rgb<C>(channels[0], channels[1], channels[2]);
+        }
+        else
+        {
+            return rl::color_rgba<C>(channels[0], channels[1], channels[2], channels[3]);
+        }
+    }
+
+    template<rl::Bitmap::Color Color, typename D, typename SP>
+    constexpr void write_color(const SP& source_pixel, D* channels) noexcept
+    {
+        using S = std::remove_cvref_t<decltype(source_pixel.g)>;
+        if constexpr (Color == rl::Bitmap::Color::G)
+        {
+            const auto pixel = rl::to_color_g<D, S>(source_pixel);
+            channels[0] = pixel.g;
+        }
+        else if constexpr (Color == rl::Bitmap::Color::Ga)
+        {
+            const auto pixel = rl::to_color_ga<D, S>(source_pixel);
+            channels[0] = pixel.g;
+            channels[1] = pixel.a;
+        }
+        else if constexpr (Color == rl::Bitmap::Color::Rgb)
+        {
+            const auto pixel = rl::to_color_rgb<D, S>(source_pixel);
+            channels[0] = pixel.r;
+            channels[1] = pixel.g;
+            channels[2] = pixel.b;
+        }
+        else
+        {
+            const auto pixel = rl::to_color_rgba<D, S>(source_pixel);
+            channels[0] = pixel.r;
+            channels[1] = pixel.g;
+            channels[2] = pixel.b;
+            channels[3] = pixel.a;
+        }
+    }
+
+    // the gray of an rgb color in its own channel type, with integer channels rounded to the nearest value. the simd
+    // kernels do the same float math in the same order, so they match this bit for bit.
+    template<typename C>
+    C to_gray(C r, C g, C b, rl::Gray gray, const rl::color_rgb<float>& weights) noexcept
+    {
+        const float value =
+            (gray == rl::Gray::Max) ?
+                std::max(std::max(static_cast<float>(r), static_cast<float>(g)), static_cast<float>(b)) :
+                static_cast<float>(r) * weights.r + static_cast<float>(g) * weights.g + static_cast<float>(b) * weights.b;
+        if constexpr (std::is_floating_point_v<C>)
+        {
+            return value;
+        }
+        else
+        {
+            return static_cast<C>(std::clamp(value + 0.5f, 0.0f, static_cast<float>(std::numeric_limits<C>::max())));
+        }
+    }
+
+    // a row conversion with the formats fixed at compile time, so the pixel loop has no format branches.
+    template<rl::Bitmap::Depth SourceDepth, rl::Bitmap::Color SourceColor, rl::Bitmap::Depth DestinationDepth, rl::Bitmap::Color DestinationColor>
+    void convert_row(const rl::Bitmap::byte_t* source, rl::Bitmap::byte_t* destination, std::size_t width) noexcept
+    {
+        using S = rl::detail::bitmap_channel_t<SourceDepth>;
+        using D = rl::detail::bitmap_channel_t<DestinationDepth>;
+        constexpr auto source_channel_count = rl::Bitmap::GetChannelCount(SourceColor);
+        constexpr auto destination_channel_count = rl::Bitmap::GetChannelCount(DestinationColor);
+        constexpr auto source_pixel_size = rl::Bitmap::GetPixelSize(SourceDepth, SourceColor);
+        constexpr auto destination_pixel_size = rl::Bitmap::GetPixelSize(DestinationDepth, DestinationColor);
+        // rgb colors turn gray in the source channel type before their depth changes. row converters are not given a
+        // mode, so they use rl::Gray::Default instead of reading the mutable default of rl::get_gray for every row.
+        constexpr bool is_gray =
+            (SourceColor == rl::Bitmap::Color::Rgb || SourceColor == rl::Bitmap::Color::Rgba) &&
+            (DestinationColor == rl::Bitmap::Color::G || DestinationColor == rl::Bitmap::Color::Ga);
+        const auto gray = rl::gray_mode();
+        const auto gray_weights = rl::get_gray_weights(gray);
+        auto convert_pixel = [&](std::size_t x)
+        {
+            // copy the channels out first so the pixel can be converted in place
+            std::array<S, source_channel_count> source_channels;
+            rl::detail::load_channels<SourceDepth>(source + x * source_pixel_size, source_channels.data(), source_channel_count);
+            std::array<D, destination_channel_count> destination_channels;
+            if constexpr (is_gray)
+            {
+                const S gray_channel = rl::detail::to_gray(source_channels[0], source_channels[1], source_channels[2], gray.gray, gray_weights);
+                if constexpr (SourceColor == rl::Bitmap::Color::Rgba)
+                {
+                    rl::detail::write_color<DestinationColor>(rl::color_ga<S>(gray_channel, source_channels[3]), destination_channels.data());
+                }
+                else
+                {
+                    rl::detail::write_color<DestinationColor>(rl::color_g<S>(gray_channel), destination_channels.data());
+                }
+            }
+            else
+            {
+                rl::detail::write_color<DestinationColor>(
+                    rl::detail::make_color<SourceColor>(source_channels.data()),
+                    destination_channels.data()
+                );
+            }
+            rl::detail::store_channels<DestinationDepth>(destination_channels.data(), destination + x * destination_pixel_size, destination_channel_count);
+        };
+        // convert in reverse if necessary to prevent pixel overwriting when the pixels are converted in place.
+        if constexpr (source_pixel_size >= destination_pixel_size)
+        {
+            for (std::size_t x = 0; x < width; x++)
+            {
+                convert_pixel(x);
+            }
+        }
+        else
+        {
+            for (std::size_t x = width; x > 0; x--)
+            {
+                convert_pixel(x - 1);
+            }
+        }
+    }
+
+    // turns an rgb row gray with the given mode without changing its depth. the gray pixels are smaller, so rows that
+    // start at the same address shrink in place.
+    template<rl::Bitmap::Depth Depth, rl::Bitmap::Color SourceColor, rl::Bitmap::Color DestinationColor>
+    void convert_gray_row(const rl::Bitmap::byte_t* source, rl::Bitmap::byte_t* destination, std::size_t width, const rl::gray_mode& gray) noexcept
+    {
+        using C = rl::detail::bitmap_channel_t<Depth>;
+        constexpr auto source_channel_count = rl::Bitmap::GetChannelCount(SourceColor);
+        constexpr auto destination_channel_count = rl::Bitmap::GetChannelCount(DestinationColor);
+        constexpr auto source_pixel_size = rl::Bitmap::GetPixelSize(Depth, SourceColor);
+        constexpr auto destination_pixel_size = rl::Bitmap::GetPixelSize(Depth, DestinationColor);
+        const auto gray_weights = rl::get_gray_weights(gray);
+        for (std::size_t x = 0; x < width; x++)
+        {
+            std::array<C, source_channel_count> source_channels;
+            rl::detail::load_channels<Depth>(source + x * source_pixel_size, source_channels.data(), source_channel_count);
+            const C gray_channel = rl::detail::to_gray(source_channels[0], source_channels[1], source_channels[2], gray.gray, gray_weights);
+            std::array<C, destination_channel_count> destination_channels;
+            if constexpr (SourceColor == rl::Bitmap::Color::Rgba)
+            {
+                rl::detail::write_color<DestinationColor>(rl::color_ga<C>(gray_channel, source_channels[3]), destination_channels.data());
+            }
+            else
+            {
+                rl::detail::write_color<DestinationColor>(rl::color_g<C>(gray_channel), destination_channels.data());
+            }
+            rl::detail::store_channels<Depth>(destination_channels.data(), destination + x * destination_pixel_size, destination_channel_count);
+        }
+    }
+
+    // the depths with whole byte channels, in the order of the table
+    inline constexpr std::array<rl::Bitmap::Depth, 4> bitmap_depths = {
+        rl::Bitmap::Depth::Octuple,
+        rl::Bitmap::Depth::Sexdecuple,
+        rl::Bitmap::Depth::Normalized,
+        rl::Bitmap::Depth::Half
+    };
+    constexpr std::size_t bitmap_depth_count = rl::detail::bitmap_depths.size();
+    constexpr std::size_t bitmap_color_count = 4;
+    constexpr std::size_t bitmap_format_count = rl::detail::bitmap_depth_count * rl::detail::bitmap_color_count;
+
+    constexpr std::size_t get_bitmap_depth_index(rl::Bitmap::Depth depth) noexcept
+    {
+        return (depth == rl::Bitmap::Depth::Half) ? 3 : static_cast<std::size_t>(depth);
+    }
+
+    constexpr std::size_t get_bitmap_format_index(rl::Bitmap::Depth depth, rl::Bitmap::Color color) noexcept
+    {
+        return
+            rl::detail::get_bitmap_depth_index(depth) * rl::detail::bitmap_color_count +
+            static_cast<std::size_t>(color);
+    }
+
+    template<std::size_t ConverterI>
+    constexpr rl::Bitmap::row_converter_t get_row_converter() noexcept
+    {
+        constexpr auto source_format_i = ConverterI / rl::detail::bitmap_format_count;
+        constexpr auto destination_format_i = ConverterI % rl::detail::bitmap_format_count;
+        return
+            &rl::detail::convert_row<
+                rl::detail::bitmap_depths[source_format_i / rl::detail::bitmap_color_count],
+                static_cast<rl::Bitmap::Color>(source_format_i % rl::detail::bitmap_color_count),
+                rl::detail::bitmap_depths[destination_format_i / rl::detail::bitmap_color_count],
+                static_cast<rl::Bitmap::Color>(destination_format_i % rl::detail::bitmap_color_count)
+            >;
+    }
+
+    template<std::size_t... ConverterIs>
+    constexpr std::array<rl::Bitmap::row_converter_t, sizeof...(ConverterIs)> make_row_converters(std::index_sequence<ConverterIs...>) noexcept
+    {
+        return { rl::detail::get_row_converter<ConverterIs>()... };
+    }
+
+    // indexed by depth index * 4 + source color is rgba * 2 + destination color is ga
+    template<std::size_t ConverterI>
+    constexpr rl::Bitmap::gray_converter_t get_gray_converter() noexcept
+    {
+        return
+            &rl::detail::convert_gray_row<
+                rl::detail::bitmap_depths[ConverterI / 4],
+                ((ConverterI / 2) % 2 == 0) ? rl::Bitmap::Color::Rgb : rl::Bitmap::Color::Rgba,
+                (ConverterI % 2 == 0) ? rl::Bitmap::Color::G : rl::Bitmap::Color::Ga
+            >;
+    }
+
+    template<std::size_t... ConverterIs>
+    constexpr std::array<rl::Bitmap::gray_converter_t, sizeof...(ConverterIs)> make_gray_converters(std::index_sequence<ConverterIs...>) noexcept
+    {
+        return { rl::detail::get_gray_converter<ConverterIs>()... };
+    }
+
+    inline constexpr auto gray_converters =
+        rl::detail::make_gray_converters(
+            std::make_index_sequence<rl::detail::bitmap_depth_count * 4>()
+        );
+
+    // indexed by source format index * format count + destination format index
+    inline constexpr auto row_converters =
+        rl::detail::make_row_converters(
+            std::make_index_sequence<rl::detail::bitmap_format_count * rl::detail::bitmap_format_count>()
+        );
+}
+
+constexpr rl::Bitmap::row_converter_t rl::Bitmap::GetRowConverter(rl::Bitmap::Depth source_depth, rl::Bitmap::Color source_color, rl::Bitmap::Depth destination_depth, rl::Bitmap::Color destination_color) noexcept
+{
+    // the table only holds the byte channel formats
+    if (
+        source_color == rl::Bitmap::Color::Indexed ||
+        destination_color == rl::Bitmap::Color::Indexed ||
+        rl::Bitmap::GetIsSubByte(source_depth) ||
+        rl::Bitmap::GetIsSubByte(destination_depth)
+    )
+    {
+        return nullptr;
+    }
+    return
+        rl::detail::row_converters[
+            rl::detail::get_bitmap_format_index(source_depth, source_color) * rl::detail::bitmap_format_count +
+            rl::detail::get_bitmap_format_index(destination_depth, destination_color)
+        ];
+}
+
+constexpr rl::Bitmap::gray_converter_t rl::Bitmap::GetGrayConverter(rl::Bitmap::Depth depth, rl::Bitmap::Color source_color, rl::Bitmap::Color destination_color) noexcept
+{
+    if (
+        rl::Bitmap::GetIsSubByte(depth) ||
+        (source_color != rl::Bitmap::Color::Rgb && source_color != rl::Bitmap::Color::Rgba) ||
+        (destination_color != rl::Bitmap::Color::G && destination_color != rl::Bitmap::Color::Ga)
+    )
+    {
+        return nullptr;
+    }
+    return
+        rl::detail::gray_converters[
+            rl::detail::get_bitmap_depth_index(depth) * 4 +
+            (source_color == rl::Bitmap::Color::Rgba ? 2 : 0) +
+            (destination_color == rl::Bitmap::Color::Ga ? 1 : 0)
+        ];
+}
@@ -0,0 +1,57 @@
+// SPDX-FileCopyrightText: 2023 Daniel Aimé Valcour <fosssweeper@gmail.com>
+//
+// SPDX-License-Identifier: MIT
+
+/*
+    Copyright (c) 2023 Daniel Aimé Valcour
+    Permission is hereby granted, free of charge, to any person obtaining a copy of
+    this software and associated documentation files (the "Software"), to deal in
+    the Software without restriction, including without limitation the rights to
+    use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+    the Software, and to permit persons to whom the Software is furnished to do so,
+    subject to the following conditions:
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+    FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+    COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+    IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+    CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include <rlm/color/color_rgb.hpp>
+
+namespace rl
+{
+    // how rla turns rgb colors gray, both when blitting them into gray bitmaps and when loading rgb pngs into gray
+    // bitmaps. the weighted modes add up the channels times their weights.
+    enum class Gray
+    {
+        Rec709 = 0,
+        Rec601 = 1,
+        Average = 2,
+        // the brightest channel
+        Max = 3,
+        Custom = 4,
+        Default = Rec709
+    };
+
+    // a mode with the weights of the custom mode, so conversions are given everything they turn rgb gray with.
+    struct gray_mode
+    {
+        rl::Gray gray = rl::Gray::Default;
+        // only used by the custom mode. weights that do not add up to one can push integer channels out of range, which
+        // are clamped.
+        rl::color_rgb<float> custom_weights = rl::color_rgb<float>(0.0f, 0.0f, 0.0f);
+    };
+
+    // the weights of a weighted mode, or the custom weights for the custom mode. the max mode has no weights.
+    rl::color_rgb<float> get_gray_weights(const rl::gray_mode& gray) noexcept;
+    // the mode of blits and loads that are not given one. defaults to rec. 709, which is what libpng uses.
+    // blits and loads read it once, so changing it while they run does not change the mode of their rows.
+    rl::gray_mode get_gray();
+    void set_gray(const rl::gray_mode& gray);
+}
@@ -0,0 +1,44 @@
+// SPDX-FileCopyrightText: 2023 Daniel Aimé Valcour <fosssweeper@gmail.com>
+//
+// SPDX-License-Identifier: MIT
+
+/*
+    Copyright (c) 2023 Daniel Aimé Valcour
+    Permission is hereby granted, free of charge, to any person obtaining a copy of
+    this software and associated documentation files (the "Software"), to deal in
+    the Software without restriction, including without limitation the rights to
+    use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+    the Software, and to permit persons to whom the Software is furnished to do so,
+    subject to the following conditions:
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+    FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+    COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+    IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+    CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+namespace rl
+{
+    // the instruction set extensions that rla can use to accelerate pixel conversion kernels. the avx2 level also
+    // requires f16c.
+    enum class SimdLevel
+    {
+        Scalar = 0,
+        Ssse3 = 1,
+        Avx2 = 2,
+        Neon = 3
+    };
+
+    // the best level supported by the cpu of this process. detected once on first use.
+    rl::SimdLevel get_supported_simd_level() noexcept;
+    bool get_is_simd_level_supported(rl::SimdLevel level) noexcept;
+    // the level used by rla at runtime. defaults to the supported level.
+    rl::SimdLevel get_simd_level() noexcept;
+    // override the level used by rla at runtime. returns false and changes nothing if the level is not supported.
+    bool set_simd_level(rl::SimdLevel level) noexcept;
+}
@@ -21,26 +21,853 @@
 */
 
 #include <rla/Bitmap.hpp>
+#include <rla/Executor.hpp>
+#include <rla/Image.hpp>
+#include <rla/Png.hpp>
+#include <rla/color_conversion.hpp>
+#include <rla/simd.hpp>
 #include <rld/except.hpp>
 #include <rlm/cellular/cell_box2.hpp>
 #include <rlm/cellular/does_contain.hpp>
 #include "libpng_ext.hpp"
+#include "row_bands.hpp"
+#include "simd_target.hpp"
 #include <png.h>
+#include <algorithm>
+#include <array>
+#include <cmath>
 #include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <fstream>
+#include <limits>
+#include <numbers>
+#include <span>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace
+{
+    void blit_run(const rl::Bitmap::byte_t* source, rl::Bitmap::byte_t* destination, std::size_t width, std::size_t pixel_size, rl::Bitmap::row_converter_t converter) noexcept
+    {
+        // no converter means same format
+        if (converter == nullptr)
+        {
+            std::memcpy(destination, source, width * pixel_size);
+        }
+        else
+        {
+            converter(source, destination, width);
+        }
+    }
+
+    // blits between indexed and other colors go through the palettes in the rows
+    bool get_is_palette_conversion(rl::Bitmap::Color source_color, rl::Bitmap::Color destination_color) noexcept
+    {
+        return
+            source_color != destination_color &&
+            (source_color == rl::Bitmap::Color::Indexed || destination_color == rl::Bitmap::Color::Indexed);
+    }
+
+    // blits from or into sub-byte bitmaps unpack and pack the pixels in the rows
+    bool get_is_sub_byte_conversion(rl::Bitmap::Depth source_depth, rl::Bitmap::Depth destination_depth) noexcept
+    {
+        return rl::Bitmap::GetIsSubByte(source_depth) || rl::Bitmap::GetIsSubByte(destination_depth);
+    }
+
+    // blits between spaces decode or encode the colors in the rows
+    bool get_is_space_conversion(rl::Bitmap::Space source_space, rl::Bitmap::Space destination_space) noexcept
+    {
+        return source_space != destination_space;
+    }
+
+    // blits of colors into gray bitmaps turn them gray in the rows, with the gray mode of the blit
+    bool get_is_gray_conversion(rl::Bitmap::Color source_color, rl::Bitmap::Color destination_color) noexcept
+    {
+        const auto get_is_gray =
+            [](rl::Bitmap::Color color)
+            {
+                return color == rl::Bitmap::Color::G || color == rl::Bitmap::Color::Ga;
+            };
+        return !get_is_gray(source_color) && get_is_gray(destination_color);
+    }
+
+    // the default mode is only read by blits that turn colors gray without being given a mode
+    rl::gray_mode get_blit_gray(const std::optional<rl::gray_mode>& gray_o, bool is_gray_conversion) noexcept
+    {
+        return (gray_o.has_value() || !is_gray_conversion) ? gray_o.value_or(rl::gray_mode()) : rl::get_gray();
+    }
+
+    // sub-byte rows start on whole bytes, so blits into them have to start on a pixel that starts a byte
+    void check_sub_byte_blit(const rl::Bitmap& destination, std::size_t x)
+    {
+        if (x * destination.GetBitDepth() * destination.GetChannelCount() % 8 != 0)
+        {
+            throw rl::runtime_error("blit into sub-byte bitmap not aligned to bytes");
+        }
+    }
+
+    // the rows of a blit can not throw, so blits the rows can not do are caught up front
+    void check_indexed_blit(const rl::Bitmap::View& source, const rl::Bitmap& destination, rl::Bitmap::Blend blend)
+    {
+        if (destination.GetColor() != rl::Bitmap::Color::Indexed)
+        {
+            return;
+        }
+        if (blend != rl::Bitmap::Blend::Replace)
+        {
+            throw rl::runtime_error("blend into indexed bitmap");
+        }
+        if (source.GetColor() != rl::Bitmap::Color::Indexed && destination.GetPalette().empty())
+        {
+            throw rl::runtime_error("blit into indexed bitmap without palette");
+        }
+    }
+
+    // true if every color of the source palette has the same index in the destination palette
+    bool get_is_palette_prefix(rl::Bitmap::palette_t source, rl::Bitmap::palette_t destination) noexcept
+    {
+        return
+            source.size() <= destination.size() &&
+            std::equal(
+                source.begin(),
+                source.end(),
+                destination.begin(),
+                [](const rl::color_rgba<rl::Bitmap::octuple_t>& source_color, const rl::color_rgba<rl::Bitmap::octuple_t>& destination_color)
+                {
+                    return
+                        source_color.r == destination_color.r &&
+                        source_color.g == destination_color.g &&
+                        source_color.b == destination_color.b &&
+                        source_color.a == destination_color.a;
+                }
+            );
+    }
+
+    rl::Bitmap::Layout get_row_layout(rl::Bitmap::Layout layout) noexcept
+    {
+        // the runs of a tiled row are linear within the tile
+        return (layout == rl::Bitmap::Layout::Planar) ? rl::Bitmap::Layout::Planar : rl::Bitmap::Layout::Linear;
+    }
+
+    // a color key converted to the format of the source of a blit
+    struct blit_key
+    {
+        std::array<rl::Bitmap::byte_t, 16> pixel = {};
+        // the size of the color channels of a source pixel, which are the channels that are compared
+        std::size_t compare_size = 0;
+        // keyed pixels are cleared when true, or else left unchanged
+        bool is_transparent = false;
+        // indexed sources compare their indexes instead of their pixels
+        std::array<bool, 256> keyed_indexes = {};
+    };
+
+    blit_key make_blit_key(const rl::Bitmap::color_key& color_key, rl::Bitmap::Depth depth, rl::Bitmap::Color color, rl::Bitmap::Blend blend, rl::Bitmap::palette_t palette, const rl::gray_mode& gray) noexcept
+    {
+        blit_key key;
+        if (color == rl::Bitmap::Color::Indexed)
+        {
+            // indexed pixels are keyed by the indexes of the palette colors equal to the key
+            const std::size_t color_count = std::min(palette.size(), key.keyed_indexes.size());
+            for (std::size_t color_i = 0; color_i < color_count; color_i++)
+            {
+                key.keyed_indexes[color_i] =
+                    palette[color_i].r == color_key.color.r &&
+                    palette[color_i].g == color_key.color.g &&
+                    palette[color_i].b == color_key.color.b;
+            }
+        }
+        else
+        {
+            // keys of gray sources turn gray like the pixels of the blit would
+            const std::array<rl::Bitmap::octuple_t, 3> channels = { color_key.color.r, color_key.color.g, color_key.color.b };
+            rl::Bitmap::Row(key.pixel.data(), 1, depth, color).Blit(
+                rl::Bitmap::Row::View(reinterpret_cast<const rl::Bitmap::byte_t*>(channels.data()), 1, rl::Bitmap::Depth::Octuple, rl::Bitmap::Color::Rgb),
+                rl::Bitmap::Blend::Replace,
+                gray
+            );
+            const bool has_alpha = color == rl::Bitmap::Color::Ga || color == rl::Bitmap::Color::Rgba;
+            key.compare_size = rl::Bitmap::GetPixelSize(depth, color) - (has_alpha ? rl::Bitmap::GetChannelSize(depth) : 0);
+        }
+        // a keyed pixel blended onto the destination would not change it, so only replacing blits clear them
+        key.is_transparent = color_key.mode == rl::Bitmap::color_key::Mode::Transparent && blend == rl::Bitmap::Blend::Replace;
+        return key;
+    }
+
+    std::optional<blit_key> make_blit_key(const std::optional<rl::Bitmap::color_key>& color_key_o, const rl::Bitmap::View& source, rl::Bitmap::Blend blend, const rl::gray_mode& gray) noexcept
+    {
+        if (!color_key_o.has_value())
+        {
+            return std::nullopt;
+        }
+        if (!rl::Bitmap::GetIsSubByte(source.GetDepth()))
+        {
+            return make_blit_key(color_key_o.value(), source.GetDepth(), source.GetColor(), blend, source.GetPalette(), gray);
+        }
+        // sub-byte sources are keyed in the octuple chunks they are unpacked to, so the key is rounded to the sub-byte
+        // depth and back
+        auto key = make_blit_key(color_key_o.value(), rl::Bitmap::Depth::Octuple, source.GetColor(), blend, source.GetPalette(), gray);
+        if (source.GetColor() != rl::Bitmap::Color::Indexed)
+        {
+            const std::uint32_t max = (1u << source.GetBitDepth()) - 1;
+            for (std::size_t channel_i = 0; channel_i < key.compare_size; channel_i++)
+            {
+                const std::uint32_t value = std::to_integer<std::uint32_t>(key.pixel[channel_i]);
+                key.pixel[channel_i] = static_cast<rl::Bitmap::byte_t>((value * max + 127) / 255 * (255 / max));
+            }
+        }
+        return key;
+    }
+
+#if defined(RL_SIMD_X86)
+    void write_key_matches(int mask, std::size_t count, bool* matches) noexcept
+    {
+        for (std::size_t match_i = 0; match_i < count; match_i++)
+        {
+            matches[match_i] = ((mask >> match_i) & 1) != 0;
+        }
+    }
+
+    // compares whole pixels of 3, 4 or 8 bytes at once. returns the number of pixels compared.
+    RL_TARGET_AVX2 std::size_t get_key_matches_avx2(const rl::Bitmap::byte_t* source, std::size_t width, std::size_t pixel_size, const blit_key& key, bool* matches) noexcept
+    {
+        std::size_t x = 0;
+        std::uint64_t key_value = 0;
+        std::uint64_t compare_mask = 0;
+        std::memcpy(&key_value, key.pixel.data(), std::min<std::size_t>(key.compare_size, sizeof(key_value)));
+        std::memset(&compare_mask, 0xFF, std::min<std::size_t>(key.compare_size, sizeof(compare_mask)));
+        if (pixel_size == 3)
+        {
+            // spread 8 pixels of 3 bytes over the 32 bit lanes. 32 bytes are loaded for 24 bytes of pixels.
+            const __m256i permute = _mm256_setr_epi32(0, 1, 2, 3, 3, 4, 5, 6);
+            const __m256i shuffle =
+                _mm256_setr_epi8(
+                    0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1,
+                    0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1
+                );
+            const __m256i keys = _mm256_set1_epi32(static_cast<int>(key_value));
+            for (; x + 11 <= width; x += 8)
+            {
+                const __m256i pixels = _mm256_shuffle_epi8(_mm256_permutevar8x32_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(source + x * 3)), permute), shuffle);
+                write_key_matches(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(pixels, keys))), 8, matches + x);
+            }
+        }
+        else if (pixel_size == 4)
+        {
+            const __m256i keys = _mm256_set1_epi32(static_cast<int>(key_value));
+            const __m256i masks = _mm256_set1_epi32(static_cast<int>(compare_mask));
+            for (; x + 8 <= width; x += 8)
+            {
+                const __m256i pixels = _mm256_and_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(source + x * 4)), masks);
+                write_key_matches(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(pixels, keys))), 8, matches + x);
+            }
+        }
+        else if (pixel_size == 8)
+        {
+            const __m256i keys = _mm256_set1_epi64x(static_cast<long long>(key_value));
+            const __m256i masks = _mm256_set1_epi64x(static_cast<long long>(compare_mask));
+            for (; x + 4 <= width; x += 4)
+            {
+                const __m256i pixels = _mm256_and_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(source + x * 8)), masks);
+                write_key_matches(_mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(pixels, keys))), 4, matches + x);
+            }
+        }
+        return x;
+    }
+#endif
+
+    // sets matches[x] to true for the pixels of a source run with the colors of the key
+    void get_key_matches(const rl::Bitmap::Row::View& source, const blit_key& key, bool* matches) noexcept
+    {
+        const std::size_t width = source.GetWidth();
+        const std::size_t channel_size = source.GetChannelSize();
+        if (source.GetColor() == rl::Bitmap::Color::Indexed)
+        {
+            const auto* indexes = reinterpret_cast<const std::uint8_t*>(source.GetData());
+            for (std::size_t x = 0; x < width; x++)
+            {
+                matches[x] = key.keyed_indexes[indexes[x]];
+            }
+            return;
+        }
+        if (source.GetLayout() == rl::Bitmap::Layout::Planar)
+        {
+            // the channels of planar pixels are compared one plane at a time
+            const std::size_t compare_count = key.compare_size / channel_size;
+            for (std::size_t x = 0; x < width; x++)
+            {
+                bool is_match = true;
+                for (std::size_t channel_i = 0; channel_i < compare_count && is_match; channel_i++)
+                {
+                    is_match = std::memcmp(source.GetData(x, channel_i), key.pixel.data() + channel_i * channel_size, channel_size) == 0;
+                }
+                matches[x] = is_match;
+            }
+            return;
+        }
+        const std::size_t pixel_size = rl::Bitmap::GetPixelSize(source.GetDepth(), source.GetColor());
+        std::size_t x = 0;
+#if defined(RL_SIMD_X86)
+        if (rl::get_simd_level() == rl::SimdLevel::Avx2)
+        {
+            x = get_key_matches_avx2(source.GetData(), width, pixel_size, key, matches);
+        }
+#endif
+        for (; x < width; x++)
+        {
+            matches[x] = std::memcmp(source.GetData() + x * pixel_size, key.pixel.data(), key.compare_size) == 0;
+        }
+    }
+
+    void clear_span(const rl::Bitmap::Row& destination, std::size_t x, std::size_t width) noexcept
+    {
+        if (destination.GetLayout() == rl::Bitmap::Layout::Planar)
+        {
+            for (std::size_t channel_i = 0; channel_i < rl::Bitmap::GetChannelCount(destination.GetColor()); channel_i++)
+            {
+                for (std::size_t span_x = x; span_x < x + width; span_x++)
+                {
+                    std::memset(destination.GetData(span_x, channel_i), 0, destination.GetChannelSize());
+                }
+            }
+            return;
+        }
+        std::memset(destination.GetData(x), 0, width * rl::Bitmap::GetPixelSize(destination.GetDepth(), destination.GetColor()));
+    }
+
+    // blits the spans of a run without keyed pixels with blit_span(x, width), and clears or skips the keyed spans
+    template<typename F>
+    void blit_keyed_run(const rl::Bitmap::Row::View& source, const rl::Bitmap::Row& destination, const blit_key& key, const F& blit_span) noexcept
+    {
+        constexpr std::size_t chunk_width = 256;
+        std::array<bool, chunk_width> matches;
+        for (std::size_t chunk_x = 0; chunk_x < source.GetWidth(); chunk_x += chunk_width)
+        {
+            const std::size_t width = std::min(chunk_width, source.GetWidth() - chunk_x);
+            get_key_matches(
+                rl::Bitmap::Row::View(source.GetData(chunk_x), width, source.GetDepth(), source.GetColor(), source.GetLayout(), source.GetPlaneOffset(), source.GetAlpha(), source.GetPalette(), source.GetSpace()),
+                key,
+                matches.data()
+            );
+            for (std::size_t span_x = 0; span_x < width;)
+            {
+                std::size_t span_end = span_x + 1;
+                while (span_end < width && matches[span_end] == matches[span_x])
+                {
+                    span_end++;
+                }
+                if (!matches[span_x])
+                {
+                    blit_span(chunk_x + span_x, span_end - span_x);
+                }
+                else if (key.is_transparent)
+                {
+                    clear_span(destination, chunk_x + span_x, span_end - span_x);
+                }
+                span_x = span_end;
+            }
+        }
+    }
+
+    rl::Bitmap::Row get_sub_row(const rl::Bitmap::Row& row, std::size_t x, std::size_t width) noexcept
+    {
+        return rl::Bitmap::Row(row.GetData(x, 0), width, row.GetDepth(), row.GetColor(), row.GetLayout(), row.GetPlaneOffset(), row.GetAlpha(), row.GetPalette(), row.GetSpace());
+    }
+
+    rl::Bitmap::Row::View get_sub_row(const rl::Bitmap::Row::View& row, std::size_t x, std::size_t width) noexcept
+    {
+        return rl::Bitmap::Row::View(row.GetData(x, 0), width, row.GetDepth(), row.GetColor(), row.GetLayout(), row.GetPlaneOffset(), row.GetAlpha(), row.GetPalette(), row.GetSpace());
+    }
+
+    // keyed spans start on any pixel, but sub-byte rows only start on whole bytes. so the sub-byte sides of a keyed run
+    // are unpacked to octuple chunks, keyed there, and packed back.
+    void blit_sub_byte_keyed_run(const rl::Bitmap::Row::View& source, const rl::Bitmap::Row& destination, const blit_key& key, rl::Bitmap::Blend blend, const rl::gray_mode& gray) noexcept
+    {
+        constexpr std::size_t chunk_width = 256;
+        constexpr std::size_t max_channel_count = 4;
+        std::array<rl::Bitmap::byte_t, chunk_width * max_channel_count> source_chunk;
+        std::array<rl::Bitmap::byte_t, chunk_width * max_channel_count> destination_chunk;
+        const bool is_source_sub_byte = rl::Bitmap::GetIsSubByte(source.GetDepth());
+        const bool is_destination_sub_byte = rl::Bitmap::GetIsSubByte(destination.GetDepth());
+        // nearest colors are only looked for in the part of the palette the indexes can reach
+        const auto destination_palette =
+            is_destination_sub_byte ?
+                destination.GetPalette().first(std::min<std::size_t>(destination.GetPalette().size(), std::size_t{1} << destination.GetBitDepth())) :
+                destination.GetPalette();
+        for (std::size_t chunk_x = 0; chunk_x < source.GetWidth(); chunk_x += chunk_width)
+        {
+            const std::size_t width = std::min(chunk_width, source.GetWidth() - chunk_x);
+            auto source_run = get_sub_row(source, chunk_x, width);
+            if (is_source_sub_byte)
+            {
+                rl::Bitmap::Row unpacked(source_chunk.data(), width, rl::Bitmap::Depth::Octuple, source.GetColor(), rl::Bitmap::Layout::Linear, std::nullopt, source.GetAlpha(), source.GetPalette(), source.GetSpace());
+                unpacked.Blit(source_run);
+                source_run = unpacked;
+            }
+            auto destination_run = get_sub_row(destination, chunk_x, width);
+            auto keyed_run = destination_run;
+            if (is_destination_sub_byte)
+            {
+                keyed_run = rl::Bitmap::Row(destination_chunk.data(), width, rl::Bitmap::Depth::Octuple, destination.GetColor(), rl::Bitmap::Layout::Linear, std::nullopt, destination.GetAlpha(), destination_palette, destination.GetSpace());
+                keyed_run.Blit(destination_run);
+            }
+            blit_keyed_run(
+                source_run,
+                keyed_run,
+                key,
+                [&](std::size_t span_x, std::size_t span_width)
+                {
+                    get_sub_row(keyed_run, span_x, span_width).Blit(get_sub_row(source_run, span_x, span_width), blend, gray);
+                }
+            );
+            if (is_destination_sub_byte)
+            {
+                destination_run.Blit(keyed_run);
+            }
+        }
+    }
+
+    // copies or converts the rows first_row to last_row of a blit, counting the rows of every page in order
+    void blit_rows(
+        const rl::Bitmap::View& source,
+        const rl::Bitmap& destination,
+        std::size_t x,
+        std::size_t y,
+        std::size_t page,
+        rl::Bitmap::row_converter_t converter,
+        rl::Bitmap::Blend blend,
+        bool is_row_conversion,
+        const blit_key* key_p,
+        const rl::gray_mode& gray,
+        std::size_t first_row,
+        std::size_t last_row
+    ) noexcept
+    {
+        // blended runs and runs that premultiply, unpremultiply, go through a palette, have sub-byte pixels or change
+        // space need more than a converter
+        const bool is_replace = blend == rl::Bitmap::Blend::Replace && !is_row_conversion;
+        const bool is_linear =
+            is_replace &&
+            key_p == nullptr &&
+            source.GetLayout() == rl::Bitmap::Layout::Linear &&
+            destination.GetLayout() == rl::Bitmap::Layout::Linear;
+        // those runs and planar runs go through the rows
+        const bool is_row_blit =
+            !is_replace ||
+            source.GetLayout() == rl::Bitmap::Layout::Planar ||
+            destination.GetLayout() == rl::Bitmap::Layout::Planar;
+        const std::size_t tile_width = rl::Bitmap::GetTileWidth();
+        // blits of whole tiles between tiled bitmaps see every row of tiles as one contiguous run of pixels
+        const bool is_tile_aligned =
+            is_replace &&
+            key_p == nullptr &&
+            source.GetLayout() == rl::Bitmap::Layout::Tiled &&
+            destination.GetLayout() == rl::Bitmap::Layout::Tiled &&
+            x % tile_width == 0 &&
+            y % tile_width == 0 &&
+            source.GetWidth() % tile_width == 0 &&
+            source.GetHeight() % tile_width == 0;
+        for (std::size_t row_i = first_row; row_i < last_row; row_i++)
+        {
+            const std::size_t blit_page = row_i / source.GetHeight();
+            const std::size_t blit_y = row_i % source.GetHeight();
+            if (is_tile_aligned)
+            {
+                // the row of tiles is blit with its first row
+                if (blit_y % tile_width == 0)
+                {
+                    blit_run(
+                        source.GetData(0, blit_y, blit_page, 0),
+                        destination.GetData(x, y + blit_y, page + blit_page, 0),
+                        source.GetWidth() * tile_width,
+                        source.GetPixelSize(),
+                        converter
+                    );
+                }
+                continue;
+            }
+            if (is_linear)
+            {
+                blit_run(
+                    source.GetData(0, blit_y, blit_page, 0),
+                    destination.GetData(x, y + blit_y, page + blit_page, 0),
+                    source.GetWidth(),
+                    source.GetPixelSize(),
+                    converter
+                );
+                continue;
+            }
+            const auto get_source_run =
+                [&](std::size_t run_x, std::size_t run_width)
+                {
+                    return
+                        rl::Bitmap::Row::View(
+                            source.GetData(run_x, blit_y, blit_page, 0),
+                            run_width,
+                            source.GetDepth(),
+                            source.GetColor(),
+                            get_row_layout(source.GetLayout()),
+                            source.GetPlaneOffset(),
+                            source.GetAlpha(),
+                            source.GetPalette(),
+                            source.GetSpace()
+                        );
+                };
+            const auto get_destination_run =
+                [&](std::size_t run_x, std::size_t run_width)
+                {
+                    return
+                        rl::Bitmap::Row(
+                            destination.GetData(x + run_x, y + blit_y, page + blit_page, 0),
+                            run_width,
+                            destination.GetDepth(),
+                            destination.GetColor(),
+                            get_row_layout(destination.GetLayout()),
+                            destination.GetPlaneOffset(),
+                            destination.GetAlpha(),
+                            destination.GetPalette(),
+                            destination.GetSpace()
+                        );
+                };
+            const auto blit_span =
+                [&](std::size_t span_x, std::size_t span_width)
+                {
+                    if (is_row_blit)
+                    {
+                        get_destination_run(span_x, span_width).Blit(get_source_run(span_x, span_width), blend, gray);
+                    }
+                    else
+                    {
+                        blit_run(
+                            source.GetData(span_x, blit_y, blit_page, 0),
+                            destination.GetData(x + span_x, y + blit_y, page + blit_page, 0),
+                            span_width,
+                            source.GetPixelSize(),
+                            converter
+                        );
+                    }
+                };
+            // tiled rows are only contiguous within a tile, so blit the row in runs that do not cross a tile edge
+            for (std::size_t blit_x = 0; blit_x < source.GetWidth();)
+            {
+                std::size_t run_width = source.GetWidth() - blit_x;
+                if (source.GetLayout() == rl::Bitmap::Layout::Tiled)
+                {
+                    run_width = std::min(run_width, tile_width - blit_x % tile_width);
+                }
+                if (destination.GetLayout() == rl::Bitmap::Layout::Tiled)
+                {
+                    run_width = std::min(run_width, tile_width - (x + blit_x) % tile_width);
+                }
+                if (key_p != nullptr && get_is_sub_byte_conversion(source.GetDepth(), destination.GetDepth()))
+                {
+                    blit_sub_byte_keyed_run(get_source_run(blit_x, run_width), get_destination_run(blit_x, run_width), *key_p, blend, gray);
+                }
+                else if (key_p != nullptr)
+                {
+                    blit_keyed_run(
+                        get_source_run(blit_x, run_width),
+                        get_destination_run(blit_x, run_width),
+                        *key_p,
+                        [&](std::size_t span_x, std::size_t span_width)
+                        {
+                            blit_span(blit_x + span_x, span_width);
+                        }
+                    );
+                }
+                else
+                {
+                    blit_span(blit_x, run_width);
+                }
+                blit_x += run_width;
+            }
+        }
+    }
+}
 
 void rl::Bitmap::Save(std::string_view path, std::size_t page)
 {
     this->GetBitmapView().Save(path, page);
 }
 
-void rl::Bitmap::Blit(const rl::Png& png, std::size_t x, std::size_t y, std::size_t page)
+void rl::Bitmap::Save(const rl::ExecutionPolicy& policy, std::string_view path, std::size_t page)
+{
+    this->GetBitmapView().Save(policy, path, page);
+}
+
+rl::Bitmap::statistics rl::Bitmap::GetStatistics() const
+{
+    return this->GetBitmapView().GetStatistics();
+}
+
+rl::Bitmap::statistics rl::Bitmap::GetStatistics(const rl::ExecutionPolicy& policy) const
+{
+    return this->GetBitmapView().GetStatistics(policy);
+}
+
+void rl::Bitmap::Blit(const rl::Bitmap::View& bitmap, std::size_t x, std::size_t y, std::size_t page, rl::Bitmap::Blend blend, std::optional<rl::Bitmap::color_key> color_key_o, std::optional<rl::gray_mode> gray_o)
+{
+    if (
+        !this->blit_fits(
+            rl::cell_box2<int>(
+                x,
+                y,
+                bitmap.GetWidth(),
+                bitmap.GetHeight()
+            ),
+            page,
+            bitmap.GetPageCount()
+        )
+    )
+    {
+        throw rl::runtime_error("blit out of bitmap");
+    }
+    check_indexed_blit(bitmap, *this, blend);
+    check_sub_byte_blit(*this, x);
+    if (bitmap.GetIsEmpty() || bitmap.GetHeight() == 0 || bitmap.GetPageCount() == 0)
+    {
+        return;
+    }
+    const bool is_linear = bitmap.GetLayout() == rl::Bitmap::Layout::Linear && this->layout == rl::Bitmap::Layout::Linear;
+    const bool is_row_conversion =
+        rl::Bitmap::get_is_alpha_conversion(bitmap.GetColor(), bitmap.GetIsPremultiplied(), this->GetIsPremultiplied()) ||
+        get_is_palette_conversion(bitmap.GetColor(), this->color) ||
+        get_is_sub_byte_conversion(bitmap.GetDepth(), this->depth) ||
+        get_is_space_conversion(bitmap.GetSpace(), this->space) ||
+        get_is_gray_conversion(bitmap.GetColor(), this->color);
+    const auto gray = get_blit_gray(gray_o, get_is_gray_conversion(bitmap.GetColor(), this->color));
+    const auto key_o = make_blit_key(color_key_o, bitmap, blend, gray);
+    const blit_key* key_p = key_o.has_value() ? &key_o.value() : nullptr;
+    if (blend != rl::Bitmap::Blend::Replace || is_row_conversion)
+    {
+        blit_rows(bitmap, *this, x, y, page, nullptr, blend, is_row_conversion, key_p, gray, 0, bitmap.GetHeight() * bitmap.GetPageCount());
+        return;
+    }
+    // same format blits do not need any conversion, so copy the bytes straight over
+    if (is_linear && key_p == nullptr && bitmap.GetDepth() == this->depth && bitmap.GetColor() == this->color)
+    {
+        rl::Bitmap::byte_t* destination = this->GetData(x, y, page, 0);
+        const std::size_t row_size = bitmap.GetRowSize();
+        const std::size_t page_size = row_size * bitmap.GetHeight();
+        // padded rows are skipped by copying row by row, since the bytes between rows can belong to another bitmap
+        const bool rows_packed = bitmap.GetRowOffset() == row_size && this->row_offset == row_size;
+        // one copy for everything if the pages are packed too
+        if (rows_packed && bitmap.GetPageOffset() == page_size && this->page_offset == page_size)
+        {
+            std::memcpy(destination, bitmap.GetData(), page_size * bitmap.GetPageCount());
+            return;
+        }
+        // one copy per page if the rows are packed
+        if (rows_packed)
+        {
+            for (std::size_t blit_page = 0; blit_page < bitmap.GetPageCount(); blit_page++)
+            {
+                std::memcpy(destination + blit_page * this->page_offset, bitmap.GetData() + blit_page * bitmap.GetPageOffset(), page_size);
+            }
+            return;
+        }
+        blit_rows(bitmap, *this, x, y, page, nullptr, rl::Bitmap::Blend::Replace, false, nullptr, gray, 0, bitmap.GetHeight() * bitmap.GetPageCount());
+        return;
+    }
+    // pick the converter once for the whole blit instead of once per pixel
+    const auto converter =
+        (bitmap.GetDepth() == this->depth && bitmap.GetColor() == this->color) ?
+            nullptr :
+            this->get_blit_converter(bitmap, x, y, page);
+    blit_rows(bitmap, *this, x, y, page, converter, rl::Bitmap::Blend::Replace, false, key_p, gray, 0, bitmap.GetHeight() * bitmap.GetPageCount());
+}
+
+void rl::Bitmap::Blit(const rl::ExecutionPolicy& policy, const rl::Bitmap::View& bitmap, std::size_t x, std::size_t y, std::size_t page, rl::Bitmap::Blend blend, std::optional<rl::Bitmap::color_key> color_key_o, std::optional<rl::gray_mode> gray_o)
+{
+    const std::size_t blit_size = rl::Bitmap::GetSize(bitmap.GetWidth(), bitmap.GetHeight(), bitmap.GetPageCount(), this->depth, this->color);
+    if (policy.GetIsSerial(blit_size))
+    {
+        this->Blit(bitmap, x, y, page, blend, color_key_o, gray_o);
+        return;
+    }
+    if (
+        !this->blit_fits(
+            rl::cell_box2<int>(
+                x,
+                y,
+                bitmap.GetWidth(),
+                bitmap.GetHeight()
+            ),
+            page,
+            bitmap.GetPageCount()
+        )
+    )
+    {
+        throw rl::runtime_error("blit out of bitmap");
+    }
+    check_indexed_blit(bitmap, *this, blend);
+    check_sub_byte_blit(*this, x);
+    if (bitmap.GetIsEmpty() || bitmap.GetHeight() == 0 || bitmap.GetPageCount() == 0)
+    {
+        return;
+    }
+    // blended blits and blits that premultiply, unpremultiply, go through a palette, have sub-byte pixels, change space
+    // or turn colors gray pick their converters in the rows
+    const bool is_row_conversion =
+        rl::Bitmap::get_is_alpha_conversion(bitmap.GetColor(), bitmap.GetIsPremultiplied(), this->GetIsPremultiplied()) ||
+        get_is_palette_conversion(bitmap.GetColor(), this->color) ||
+        get_is_sub_byte_conversion(bitmap.GetDepth(), this->depth) ||
+        get_is_space_conversion(bitmap.GetSpace(), this->space) ||
+        get_is_gray_conversion(bitmap.GetColor(), this->color);
+    const auto converter =
+        (blend != rl::Bitmap::Blend::Replace || is_row_conversion || (bitmap.GetDepth() == this->depth && bitmap.GetColor() == this->color)) ?
+            nullptr :
+            this->get_blit_converter(bitmap, x, y, page);
+    const auto gray = get_blit_gray(gray_o, get_is_gray_conversion(bitmap.GetColor(), this->color));
+    const auto key_o = make_blit_key(color_key_o, bitmap, blend, gray);
+    const blit_key* key_p = key_o.has_value() ? &key_o.value() : nullptr;
+    // split the rows of every page into bands, so blits of many small pages spread as well as blits of one big page
+    rl::run_row_bands(
+        &policy,
+        blit_size,
+        bitmap.GetHeight() * bitmap.GetPageCount(),
+        [&](std::size_t first_row, std::size_t last_row)
+        {
+            blit_rows(bitmap, *this, x, y, page, converter, blend, is_row_conversion, key_p, gray, first_row, last_row);
+        }
+    );
+}
+
+rl::Bitmap::row_converter_t rl::Bitmap::get_blit_converter(const rl::Bitmap::View& bitmap, std::size_t x, std::size_t y, std::size_t page) const noexcept
+{
+    // the extent of a tiled destination starts at the tile the blit starts in
+    const std::size_t tile_width = (this->layout == rl::Bitmap::Layout::Tiled) ? rl::Bitmap::GetTileWidth() : 1;
+    const auto destination_origin = this->GetData(x - x % tile_width, y - y % tile_width, page, 0);
+    return
+        rl::Bitmap::get_fastest_row_converter(
+            bitmap.GetData(),
+            rl::Bitmap::get_extent(bitmap.GetWidth(), bitmap.GetHeight(), bitmap.GetPageCount(), bitmap.GetDepth(), bitmap.GetColor(), bitmap.GetRowOffset(), bitmap.GetPageOffset(), bitmap.GetLayout(), bitmap.GetPlaneOffset()),
+            bitmap.GetDepth(),
+            bitmap.GetColor(),
+            destination_origin,
+            rl::Bitmap::get_extent(bitmap.GetWidth() + x % tile_width, bitmap.GetHeight() + y % tile_width, bitmap.GetPageCount(), this->depth, this->color, this->row_offset, this->page_offset, this->layout, this->plane_offset),
+            this->depth,
+            this->color
+        );
+}
+
+void rl::Bitmap::Blit(const rl::Png& png, std::size_t x, std::size_t y, std::size_t page, std::optional<rl::Bitmap::color_key> color_key_o, std::optional<rl::gray_mode> gray_o)
+{
+    this->Blit(png.GetPath(), x, y, page, color_key_o, gray_o);    
+}
+
+void rl::Bitmap::Blit(std::string_view path, std::size_t x, std::size_t y, std::size_t page, std::optional<rl::Bitmap::color_key> color_key_o, std::optional<rl::gray_mode> gray_o)
+{
+    // any png may hold colors, so every blit into a gray bitmap picks a mode
+    this->blit_png(path, x, y, page, nullptr, color_key_o, get_blit_gray(gray_o, get_is_gray_conversion(rl::Bitmap::Color::Rgb, this->color)));
+}
+
+void rl::Bitmap::Blit(const rl::ExecutionPolicy& policy, const rl::Png& png, std::size_t x, std::size_t y, std::size_t page, std::optional<rl::Bitmap::color_key> color_key_o, std::optional<rl::gray_mode> gray_o)
 {
-    this->Blit(png.GetPath(), x, y, page);    
+    this->Blit(policy, png.GetPath(), x, y, page, color_key_o, gray_o);
 }
 
-void rl::Bitmap::Blit(std::string_view path, std::size_t x, std::size_t y, std::size_t page)
+void rl::Bitmap::Blit(const rl::ExecutionPolicy& policy, std::string_view path, std::size_t x, std::size_t y, std::size_t page, std::optional<rl::Bitmap::color_key> color_key_o, std::optional<rl::gray_mode> gray_o)
 {
+    this->blit_png(path, x, y, page, &policy, color_key_o, get_blit_gray(gray_o, get_is_gray_conversion(rl::Bitmap::Color::Rgb, this->color)));
+}
+
+void rl::Bitmap::blit_png(std::string_view path, std::size_t x, std::size_t y, std::size_t page, const rl::ExecutionPolicy* policy_p, const std::optional<rl::Bitmap::color_key>& color_key_o, const rl::gray_mode& gray)
+{
+    // keyed pngs are compared in the format of the file, so each decoded row is blit with the key
+    if (color_key_o.has_value())
+    {
+        const auto png = rl::Png(path);
+        // the format is used after setjmp is armed, so it is volatile to keep a longjmp from clobbering it
+        volatile auto png_depth = rl::Bitmap::GetDepth(png.GetBitDepth());
+        volatile auto png_color = rl::to_bitmap_color(png.GetColor());
+        // the indexes of palette pngs only copy straight into indexed bitmaps with the same palette
+        if (
+            png_color == rl::Bitmap::Color::Indexed &&
+            this->color == rl::Bitmap::Color::Indexed &&
+            !get_is_palette_prefix(png.GetPalette(), this->palette)
+        )
+        {
+            png_depth = rl::Bitmap::Depth::Octuple;
+            png_color = rl::Bitmap::Color::Rgba;
+        }
+        else if (png_color == rl::Bitmap::Color::Indexed)
+        {
+            png_depth = rl::Bitmap::Depth::Octuple;
+        }
+        // decoding is serial, so parallel blits decode the whole png before blitting it
+        if (policy_p != nullptr && !policy_p->GetIsSerial(rl::Bitmap::GetPageSize(png.GetWidth(), png.GetHeight(), this->depth, this->color)))
+        {
+            rl::Image decoded(png.GetWidth(), png.GetHeight(), 1, png_depth, png_color);
+            decoded.SetPalette(png.GetPalette());
+            decoded.blit_png(path, 0, 0, 0, nullptr, std::nullopt, gray);
+            this->Blit(*policy_p, decoded, x, y, page, rl::Bitmap::Blend::Replace, color_key_o, gray);
+            return;
+        }
+        if (!this->blit_fits(rl::cell_box2<int>(x, y, png.GetWidth(), png.GetHeight()), page))
+        {
+            throw rl::runtime_error("blit out of bitmap");
+        }
+        png_structp png_ptr = nullptr;
+        png_infop info_ptr = nullptr;
+        std::ifstream file;
+        try
+        {
+            rl::libpng_read_open(path, png_ptr, info_ptr, file);
+            if (setjmp(png_jmpbuf(png_ptr)))
+            {
+                throw rl::runtime_error("libpng jump buffer called");
+            }
+            rl::libpng_set_read_fn(png_ptr, file);
+            png_uint_32 png_width, png_height;
+            int png_bit_depth, png_color_type;
+            rl::libpng_read_file_info(png_ptr, info_ptr, png_width, png_height, png_bit_depth, png_color_type);
+            rl::libpng_read_configure(png_ptr, info_ptr, png_bit_depth, png_color_type, png_depth, png_color, gray);
+            rl::Image::Row row(png_width, png_depth, png_color);
+            for (std::size_t png_y = 0; png_y < png_height; png_y++)
+            {
+                png_read_row(png_ptr, reinterpret_cast<png_bytep>(row.GetData()), NULL);
+                this->Blit(
+                    rl::Bitmap::View(row.GetData(), png_width, 1, 1, png_depth, png_color, std::nullopt, std::nullopt, rl::Bitmap::Layout::Linear, std::nullopt, rl::Bitmap::Alpha::Straight, png.GetPalette()),
+                    x,
+                    y + png_y,
+                    page,
+                    rl::Bitmap::Blend::Replace,
+                    color_key_o,
+                    gray
+                );
+            }
+        }
+        catch(...)
+        {
+            rl::libpng_read_close(png_ptr, info_ptr, file);
+            throw;
+        }
+        rl::libpng_read_close(png_ptr, info_ptr, file);
+        return;
+    }
+    // pngs hold srgb colors. floating point bitmaps decode them through the linear tables as they load, the others load
+    // into an srgb image first and decode that as they blit it.
+    const bool is_float = this->depth == rl::Bitmap::Depth::Normalized || this->depth == rl::Bitmap::Depth::Half;
+    const bool is_decoded = this->space == rl::Bitmap::Space::Linear && !is_float;
+    // libpng writes whole rows, so load into a linear image first and blit that into the tiles
+    if (this->layout != rl::Bitmap::Layout::Linear || is_decoded)
+    {
+        const auto png = rl::Png(path);
+        rl::Image linear(png.GetWidth(), png.GetHeight(), 1, this->depth, this->color, rl::Bitmap::Layout::Linear, 1, std::nullopt, this->alpha, is_decoded ? rl::Bitmap::Space::Srgb : this->space);
+        linear.SetPalette(this->palette);
+        linear.blit_png(path, 0, 0, 0, policy_p, std::nullopt, gray);
+        if (policy_p != nullptr)
+        {
+            this->Blit(*policy_p, linear, x, y, page);
+        }
+        else
+        {
+            this->Blit(linear, x, y, page);
+        }
+        return;
+    }
     png_structp png_ptr = nullptr;
     png_infop info_ptr = nullptr;
     std::ifstream file;
@@ -55,40 +882,1605 @@ void rl::Bitmap::Blit(std::string_view path, std::size_t x, std::size_t y, std::
         png_uint_32 png_width, png_height;
         int png_bit_depth, png_color_type;
         rl::libpng_read_file_info(png_ptr, info_ptr, png_width, png_height, png_bit_depth, png_color_type);
-        // libpng can not load images with normalized floating point depth, so some manual conversion is required
-        if (this->GetDepth() == rl::Bitmap::Depth::Normalized)
+        if (!this->blit_fits(rl::cell_box2<int>(x, y, png_width, png_height), page))
+        {
+            throw rl::runtime_error("blit out of bitmap");
+        }
+        check_sub_byte_blit(*this, x);
+        // pngs store straight alpha, so premultiplied bitmaps premultiply each row as soon as it is decoded
+        const bool is_premultiplied = this->GetIsPremultiplied();
+        // palette pngs with the palette of an indexed bitmap load their indexes as they are, and other pngs are decoded
+        // to rgba and mapped to the nearest colors of the palette
+        if (this->color == rl::Bitmap::Color::Indexed)
         {
-            // load the image as sexdecuple. will convert the pixels to normalized depth as we go.
-            rl::libpng_read_configure(png_ptr, info_ptr, png_bit_depth, png_color_type, rl::Bitmap::Depth::Sexdecuple, this->color);
-            for (size_t y = 0; y < png_height; y++)
+            const bool is_palette_png =
+                png_color_type == PNG_COLOR_TYPE_PALETTE &&
+                get_is_palette_prefix(rl::libpng_read_palette(png_ptr, info_ptr), this->palette);
+            if (is_palette_png && this->depth == rl::Bitmap::Depth::Octuple)
             {
-                // use a pointer to the row but pretend it has sexdecuple depth
-                auto source_row = this->GetRow(y, page, rl::Bitmap::Depth::Sexdecuple);
+                rl::libpng_read_configure(png_ptr, info_ptr, png_bit_depth, png_color_type, this->depth, this->color, gray);
+                for (std::size_t png_y = 0; png_y < png_height; png_y++)
+                {
+                    png_read_row(png_ptr, reinterpret_cast<png_bytep>(this->GetData(x, y + png_y, page, 0)), NULL);
+                }
+            }
+            // sub-byte indexes are read as they are from pngs of the same bit depth, or else unpacked to octuple. png
+            // rows overwrite the bits after their last pixel, so they are read into a row first.
+            else if (is_palette_png)
+            {
+                const auto read_depth = (static_cast<std::size_t>(png_bit_depth) == this->GetBitDepth()) ? this->depth : rl::Bitmap::Depth::Octuple;
+                rl::libpng_read_configure(png_ptr, info_ptr, png_bit_depth, png_color_type, read_depth, this->color, gray);
+                rl::Image::Row row(png_width, read_depth, this->color);
+                for (std::size_t png_y = 0; png_y < png_height; png_y++)
+                {
+                    png_read_row(png_ptr, reinterpret_cast<png_bytep>(row.GetData()), NULL);
+                    this->GetBitmap(x, y + png_y, page, png_width, 1, 1).GetRow(0, 0).Blit(row);
+                }
+            }
+            else
+            {
+                if (this->palette.empty())
+                {
+                    throw rl::runtime_error("blit into indexed bitmap without palette");
+                }
+                rl::libpng_read_configure(png_ptr, info_ptr, png_bit_depth, png_color_type, rl::Bitmap::Depth::Octuple, rl::Bitmap::Color::Rgba, gray);
+                rl::Image::Row row(png_width, rl::Bitmap::Depth::Octuple, rl::Bitmap::Color::Rgba);
+                for (std::size_t png_y = 0; png_y < png_height; png_y++)
+                {
+                    png_read_row(png_ptr, reinterpret_cast<png_bytep>(row.GetData()), NULL);
+                    this->GetBitmap(x, y + png_y, page, png_width, 1, 1).GetRow(0, 0).Blit(row);
+                }
+            }
+        }
+        // gray pngs with the bit depth of a gray bitmap read their packed rows as they are, and other pngs are decoded to
+        // octuple and packed. png rows overwrite the bits after their last pixel, so they are read into a row first.
+        else if (rl::Bitmap::GetIsSubByte(this->depth))
+        {
+            const bool is_packed_png =
+                this->color == rl::Bitmap::Color::G &&
+                png_color_type == PNG_COLOR_TYPE_GRAY &&
+                static_cast<std::size_t>(png_bit_depth) == this->GetBitDepth();
+            const auto read_depth = is_packed_png ? this->depth : rl::Bitmap::Depth::Octuple;
+            rl::libpng_read_configure(png_ptr, info_ptr, png_bit_depth, png_color_type, read_depth, this->color, gray);
+            rl::Image::Row row(png_width, read_depth, this->color);
+            for (std::size_t png_y = 0; png_y < png_height; png_y++)
+            {
+                png_read_row(png_ptr, reinterpret_cast<png_bytep>(row.GetData()), NULL);
+                this->GetBitmap(x, y + png_y, page, png_width, 1, 1).GetRow(0, 0).Blit(row);
+            }
+        }
+        // libpng can not load images with floating point depths, so some manual conversion is required
+        else if (is_float)
+        {
+            // load the image as sexdecuple. will convert the pixels to the floating point depth as we go.
+            rl::libpng_read_configure(png_ptr, info_ptr, png_bit_depth, png_color_type, rl::Bitmap::Depth::Sexdecuple, this->color, gray);
+            // the scalar and table converters convert in place when the rows start at the same address
+            const auto* first_row_data = this->GetData(x, y, page, 0);
+            const auto converter =
+                (this->space == rl::Bitmap::Space::Linear) ?
+                    rl::Bitmap::get_linear_row_converter(
+                        rl::Bitmap::Depth::Sexdecuple,
+                        this->color,
+                        this->depth,
+                        this->color
+                    ) :
+                    rl::Bitmap::get_fastest_row_converter(
+                        first_row_data,
+                        rl::Bitmap::GetRowSize(png_width, rl::Bitmap::Depth::Sexdecuple, this->color),
+                        rl::Bitmap::Depth::Sexdecuple,
+                        this->color,
+                        first_row_data,
+                        rl::Bitmap::GetRowSize(png_width, this->depth, this->color),
+                        this->depth,
+                        this->color
+                    );
+            const std::size_t png_page_size = rl::Bitmap::GetPageSize(png_width, png_height, this->depth, this->color);
+            const bool is_parallel = rl::get_row_band_size(policy_p, png_page_size, png_height) < png_height;
+            for (std::size_t png_y = 0; png_y < png_height; png_y++)
+            {
+                auto row_data = this->GetData(x, y + png_y, page, 0);
                 // load the 16 bit pixels in place instead of allocating seperate memory to decrease allocations
-                png_read_row(png_ptr, reinterpret_cast<png_bytep>(source_row.GetData()), NULL);
-                // now get a mutable view to the row with the correct depth
-                auto destination_row = this->GetRow(y, page);
-                // blit the row to itself, converting the depth to be normalized
-                destination_row.Blit(source_row);
+                png_read_row(png_ptr, reinterpret_cast<png_bytep>(row_data), NULL);
+                // convert the row to itself, converting the depth to be floating point
+                if (!is_parallel)
+                {
+                    converter(row_data, row_data, png_width);
+                    if (is_premultiplied)
+                    {
+                        rl::Bitmap::premultiply_row(row_data, png_width, this->depth, this->color);
+                    }
+                }
+            }
+            // decoding is serial, but the loaded rows can be converted in parallel afterwards
+            if (is_parallel)
+            {
+                rl::run_row_bands(
+                    policy_p,
+                    png_page_size,
+                    png_height,
+                    [&](std::size_t first_y, std::size_t last_y)
+                    {
+                        for (std::size_t png_y = first_y; png_y < last_y; png_y++)
+                        {
+                            auto row_data = this->GetData(x, y + png_y, page, 0);
+                            converter(row_data, row_data, png_width);
+                            if (is_premultiplied)
+                            {
+                                rl::Bitmap::premultiply_row(row_data, png_width, this->depth, this->color);
+                            }
+                        }
+                    }
+                );
             }
         }
         // libpng can load all other situations for us
         else
         {
-            rl::libpng_read_configure(png_ptr, info_ptr, png_bit_depth, png_color_type, this->depth, this->color);
-            for (size_t y = 0; y < png_height; y++)
+            rl::libpng_read_configure(png_ptr, info_ptr, png_bit_depth, png_color_type, this->depth, this->color, gray);
+            for (std::size_t png_y = 0; png_y < png_height; png_y++)
             {
-                // grab the row
-                auto row = this->GetRow(y, page);
-                // write the pixels to it
-                png_read_row(png_ptr, reinterpret_cast<png_bytep>(row.GetData()), NULL);
+                // write the pixels straight into the row
+                auto row_data = this->GetData(x, y + png_y, page, 0);
+                png_read_row(png_ptr, reinterpret_cast<png_bytep>(row_data), NULL);
+                if (is_premultiplied)
+                {
+                    rl::Bitmap::premultiply_row(row_data, png_width, this->depth, this->color);
+                }
             }
         }
     }
-    catch(const std::exception& e)
+    catch(...)
     {
         rl::libpng_read_close(png_ptr, info_ptr, file);
-        throw e;
+        throw;
     }
     rl::libpng_read_close(png_ptr, info_ptr, file);
 }
+
+namespace
+{
+    // the source pixels each destination pixel of one axis is filtered from. every destination pixel reads tap_count
+    // source pixels starting at its first tap, so the kernels have no bounds to check.
+    struct resample_weights
+    {
+        std::size_t tap_count = 0;
+        std::vector<std::size_t> first_taps;
+        std::vector<float> weights;
+    };
+
+    float get_filter_support(rl::Bitmap::Filter filter) noexcept
+    {
+        switch (filter)
+        {
+            case rl::Bitmap::Filter::Box:
+                return 0.5f;
+            case rl::Bitmap::Filter::Bilinear:
+                return 1.0f;
+            case rl::Bitmap::Filter::Lanczos3:
+                return 3.0f;
+        }
+        return 1.0f;
+    }
+
+    float get_filter_weight(rl::Bitmap::Filter filter, float x) noexcept
+    {
+        switch (filter)
+        {
+            case rl::Bitmap::Filter::Box:
+                return (x >= -0.5f && x < 0.5f) ? 1.0f : 0.0f;
+            case rl::Bitmap::Filter::Bilinear:
+                return std::max(0.0f, 1.0f - std::abs(x));
+            case rl::Bitmap::Filter::Lanczos3:
+            {
+                if (x == 0.0f)
+                {
+                    return 1.0f;
+                }
+                if (std::abs(x) >= 3.0f)
+                {
+                    return 0.0f;
+                }
+                const float pi_x = std::numbers::pi_v<float> * x;
+                return 3.0f * std::sin(pi_x) * std::sin(pi_x / 3.0f) / (pi_x * pi_x);
+            }
+        }
+        return 0.0f;
+    }
+
+    resample_weights make_resample_weights(std::size_t source_size, std::size_t destination_size, rl::Bitmap::Filter filter)
+    {
+        const float scale = static_cast<float>(source_size) / static_cast<float>(destination_size);
+        // downsampling stretches the filter over all of the source pixels a destination pixel covers
+        const float filter_scale = std::max(scale, 1.0f);
+        const float support = get_filter_support(filter) * filter_scale;
+        resample_weights weights;
+        weights.tap_count = std::min(static_cast<std::size_t>(std::ceil(support * 2.0f)) + 2, source_size);
+        weights.first_taps.resize(destination_size);
+        weights.weights.assign(destination_size * weights.tap_count, 0.0f);
+        const auto last_source_i = static_cast<std::ptrdiff_t>(source_size) - 1;
+        for (std::size_t destination_i = 0; destination_i < destination_size; destination_i++)
+        {
+            const float center = (static_cast<float>(destination_i) + 0.5f) * scale - 0.5f;
+            const auto low = static_cast<std::ptrdiff_t>(std::floor(center - support));
+            const auto high = static_cast<std::ptrdiff_t>(std::ceil(center + support));
+            const auto first_tap =
+                static_cast<std::size_t>(
+                    std::min(
+                        std::max<std::ptrdiff_t>(low, 0),
+                        static_cast<std::ptrdiff_t>(source_size - weights.tap_count)
+                    )
+                );
+            weights.first_taps[destination_i] = first_tap;
+            float* tap_weights = weights.weights.data() + destination_i * weights.tap_count;
+            float weight_sum = 0.0f;
+            for (std::ptrdiff_t source_i = low; source_i <= high; source_i++)
+            {
+                const float weight = get_filter_weight(filter, (static_cast<float>(source_i) - center) / filter_scale);
+                // pixels past the edges repeat the edge pixels
+                const auto clamped_i = static_cast<std::size_t>(std::clamp<std::ptrdiff_t>(source_i, 0, last_source_i));
+                tap_weights[clamped_i - first_tap] += weight;
+                weight_sum += weight;
+            }
+            if (weight_sum == 0.0f)
+            {
+                const auto nearest_i = static_cast<std::size_t>(std::clamp<std::ptrdiff_t>(std::lround(center), 0, last_source_i));
+                tap_weights[nearest_i - first_tap] = 1.0f;
+                continue;
+            }
+            for (std::size_t tap_i = 0; tap_i < weights.tap_count; tap_i++)
+            {
+                tap_weights[tap_i] /= weight_sum;
+            }
+        }
+        return weights;
+    }
+
+    template<std::size_t ChannelCount>
+    void resample_row(const float* source, float* destination, const resample_weights& weights) noexcept
+    {
+        for (std::size_t destination_i = 0; destination_i < weights.first_taps.size(); destination_i++)
+        {
+            const float* tap_weights = weights.weights.data() + destination_i * weights.tap_count;
+            const float* taps = source + weights.first_taps[destination_i] * ChannelCount;
+            float sums[ChannelCount] = {};
+            for (std::size_t tap_i = 0; tap_i < weights.tap_count; tap_i++)
+            {
+                for (std::size_t channel_i = 0; channel_i < ChannelCount; channel_i++)
+                {
+                    sums[channel_i] += tap_weights[tap_i] * taps[tap_i * ChannelCount + channel_i];
+                }
+            }
+            std::memcpy(destination + destination_i * ChannelCount, sums, sizeof(sums));
+        }
+    }
+
+    void accumulate_row(const float* source, float* destination, float weight, std::size_t count) noexcept
+    {
+        for (std::size_t value_i = 0; value_i < count; value_i++)
+        {
+            destination[value_i] += weight * source[value_i];
+        }
+    }
+
+#if defined(RL_SIMD_X86)
+    // the simd kernels do the same multiplies and adds in the same order as the scalar ones, so they are bit exact
+    RL_TARGET_AVX2 void resample_rgba_row_avx2(const float* source, float* destination, const resample_weights& weights) noexcept
+    {
+        for (std::size_t destination_i = 0; destination_i < weights.first_taps.size(); destination_i++)
+        {
+            const float* tap_weights = weights.weights.data() + destination_i * weights.tap_count;
+            const float* taps = source + weights.first_taps[destination_i] * 4;
+            __m128 sums = _mm_setzero_ps();
+            for (std::size_t tap_i = 0; tap_i < weights.tap_count; tap_i++)
+            {
+                sums = _mm_add_ps(sums, _mm_mul_ps(_mm_set1_ps(tap_weights[tap_i]), _mm_loadu_ps(taps + tap_i * 4)));
+            }
+            _mm_storeu_ps(destination + destination_i * 4, sums);
+        }
+    }
+
+    RL_TARGET_AVX2 void accumulate_row_avx2(const float* source, float* destination, float weight, std::size_t count) noexcept
+    {
+        const __m256 weights = _mm256_set1_ps(weight);
+        std::size_t value_i = 0;
+        for (; value_i + 8 <= count; value_i += 8)
+        {
+            _mm256_storeu_ps(
+                destination + value_i,
+                _mm256_add_ps(_mm256_loadu_ps(destination + value_i), _mm256_mul_ps(weights, _mm256_loadu_ps(source + value_i)))
+            );
+        }
+        accumulate_row(source + value_i, destination + value_i, weight, count - value_i);
+    }
+#endif
+
+    void resample_row(const float* source, float* destination, const resample_weights& weights, std::size_t channel_count, bool is_avx2) noexcept
+    {
+        switch (channel_count)
+        {
+            case 1:
+                resample_row<1>(source, destination, weights);
+                break;
+            case 2:
+                resample_row<2>(source, destination, weights);
+                break;
+            case 3:
+                resample_row<3>(source, destination, weights);
+                break;
+            case 4:
+#if defined(RL_SIMD_X86)
+                if (is_avx2)
+                {
+                    resample_rgba_row_avx2(source, destination, weights);
+                    break;
+                }
+#endif
+                resample_row<4>(source, destination, weights);
+                break;
+        }
+    }
+
+    void accumulate_row(const float* source, float* destination, float weight, std::size_t count, bool is_avx2) noexcept
+    {
+#if defined(RL_SIMD_X86)
+        if (is_avx2)
+        {
+            accumulate_row_avx2(source, destination, weight, count);
+            return;
+        }
+#endif
+        accumulate_row(source, destination, weight, count);
+    }
+
+    // lanczos rings past the range of the channels. alpha is always kept in its range, but colors are only clamped
+    // where they have one: integer channels, and premultiplied colors which can not be more than their alpha. for
+    // straight integer output, clamping the premultiplied color to its alpha clamps the straight color to one. float
+    // colors of straight output keep their overshoot and values past one.
+    void clamp_resampled_row(float* row, std::size_t width, std::size_t channel_count, bool has_alpha, bool is_color_clamped) noexcept
+    {
+        const std::size_t color_count = has_alpha ? channel_count - 1 : channel_count;
+        for (std::size_t pixel_i = 0; pixel_i < width; pixel_i++)
+        {
+            float* pixel = row + pixel_i * channel_count;
+            const float alpha = has_alpha ? std::clamp(pixel[color_count], 0.0f, 1.0f) : 1.0f;
+            if (has_alpha)
+            {
+                pixel[color_count] = alpha;
+            }
+            if (is_color_clamped)
+            {
+                for (std::size_t channel_i = 0; channel_i < color_count; channel_i++)
+                {
+                    pixel[channel_i] = std::clamp(pixel[channel_i], 0.0f, alpha);
+                }
+            }
+        }
+    }
+}
+
+void rl::Bitmap::Resample(const rl::Bitmap::View& bitmap, rl::Bitmap::Filter filter)
+{
+    this->resample(bitmap, filter, nullptr);
+}
+
+void rl::Bitmap::Resample(const rl::ExecutionPolicy& policy, const rl::Bitmap::View& bitmap, rl::Bitmap::Filter filter)
+{
+    this->resample(bitmap, filter, &policy);
+}
+
+void rl::Bitmap::resample(const rl::Bitmap::View& bitmap, rl::Bitmap::Filter filter, const rl::ExecutionPolicy* policy_p)
+{
+    if (bitmap.GetPageCount() != this->page_count)
+    {
+        throw rl::runtime_error("resample page count different from bitmap page count");
+    }
+    if (this->GetIsEmpty() || this->height == 0 || this->page_count == 0)
+    {
+        return;
+    }
+    if (bitmap.GetIsEmpty() || bitmap.GetHeight() == 0)
+    {
+        throw rl::runtime_error("resample of empty bitmap");
+    }
+    const auto blit = [&](rl::Bitmap& destination, const rl::Bitmap::View& source)
+    {
+        if (policy_p != nullptr)
+        {
+            destination.Blit(*policy_p, source, 0, 0, 0);
+        }
+        else
+        {
+            destination.Blit(source, 0, 0, 0);
+        }
+    };
+    // every filter keeps the pixels of a source of the same size
+    if (bitmap.GetWidth() == this->width && bitmap.GetHeight() == this->height)
+    {
+        blit(*this, bitmap);
+        return;
+    }
+    // filtered colors are not in the palette, so indexed bitmaps are resampled in rgba and mapped to their nearest colors
+    if (this->color == rl::Bitmap::Color::Indexed)
+    {
+        rl::Image rgba(this->width, this->height, this->page_count, rl::Bitmap::Depth::Octuple, rl::Bitmap::Color::Rgba, rl::Bitmap::Layout::Linear, 1, std::nullopt, rl::Bitmap::Alpha::Straight, this->space);
+        rgba.resample(bitmap, filter, policy_p);
+        blit(*this, rgba);
+        return;
+    }
+    // tiled rows are not contiguous, so tiled bitmaps are resampled through linear images
+    if (bitmap.GetLayout() == rl::Bitmap::Layout::Tiled)
+    {
+        rl::Image linear(bitmap.GetWidth(), bitmap.GetHeight(), bitmap.GetPageCount(), bitmap.GetDepth(), bitmap.GetColor(), rl::Bitmap::Layout::Linear, 1, std::nullopt, bitmap.GetAlpha(), bitmap.GetSpace());
+        linear.SetPalette(bitmap.GetPalette());
+        blit(linear, bitmap);
+        this->resample(linear, filter, policy_p);
+        return;
+    }
+    if (this->layout == rl::Bitmap::Layout::Tiled)
+    {
+        rl::Image linear(this->width, this->height, this->page_count, this->depth, this->color, rl::Bitmap::Layout::Linear, 1, std::nullopt, this->alpha, this->space);
+        linear.resample(bitmap, filter, policy_p);
+        blit(*this, linear);
+        return;
+    }
+    const bool is_avx2 = rl::get_simd_level() == rl::SimdLevel::Avx2;
+    const std::size_t channel_count = this->GetChannelCount();
+    const bool has_alpha = this->color == rl::Bitmap::Color::Ga || this->color == rl::Bitmap::Color::Rgba;
+    const bool is_float = this->depth == rl::Bitmap::Depth::Normalized || this->depth == rl::Bitmap::Depth::Half;
+    const bool is_color_clamped = !is_float || (has_alpha && this->GetIsPremultiplied());
+    const auto horizontal_weights = make_resample_weights(bitmap.GetWidth(), this->width, filter);
+    const auto vertical_weights = make_resample_weights(bitmap.GetHeight(), this->height, filter);
+    // the filtering is done on premultiplied floats, so transparent pixels do not bleed their colors into their neighbors.
+    // it is done in the space of the bitmap, so linear bitmaps filter srgb sources in linear light.
+    const auto filter_depth = rl::Bitmap::Depth::Normalized;
+    const auto filter_alpha = rl::Bitmap::Alpha::Premultiplied;
+    rl::Image horizontal(this->width, bitmap.GetHeight(), this->page_count, filter_depth, this->color, rl::Bitmap::Layout::Linear, 1, std::nullopt, filter_alpha, this->space);
+    rl::run_row_bands(
+        policy_p,
+        horizontal.GetSize(),
+        bitmap.GetHeight() * this->page_count,
+        [&](std::size_t first_row, std::size_t last_row)
+        {
+            std::vector<float> source_row(bitmap.GetWidth() * channel_count);
+            rl::Bitmap::Row filter_row(reinterpret_cast<rl::Bitmap::byte_t*>(source_row.data()), bitmap.GetWidth(), filter_depth, this->color, rl::Bitmap::Layout::Linear, std::nullopt, filter_alpha, {}, this->space);
+            for (std::size_t row_i = first_row; row_i < last_row; row_i++)
+            {
+                const std::size_t page = row_i / bitmap.GetHeight();
+                const std::size_t y = row_i % bitmap.GetHeight();
+                filter_row.Blit(bitmap.GetRowView(y, page));
+                resample_row(source_row.data(), reinterpret_cast<float*>(horizontal.GetData(0, y, page, 0)), horizontal_weights, channel_count, is_avx2);
+            }
+        }
+    );
+    rl::run_row_bands(
+        policy_p,
+        this->GetSize(),
+        this->height * this->page_count,
+        [&](std::size_t first_row, std::size_t last_row)
+        {
+            std::vector<float> destination_row(this->width * channel_count);
+            const rl::Bitmap::Row::View filter_row(reinterpret_cast<const rl::Bitmap::byte_t*>(destination_row.data()), this->width, filter_depth, this->color, rl::Bitmap::Layout::Linear, std::nullopt, filter_alpha, {}, this->space);
+            for (std::size_t row_i = first_row; row_i < last_row; row_i++)
+            {
+                const std::size_t page = row_i / this->height;
+                const std::size_t y = row_i % this->height;
+                std::fill(destination_row.begin(), destination_row.end(), 0.0f);
+                const float* tap_weights = vertical_weights.weights.data() + y * vertical_weights.tap_count;
+                for (std::size_t tap_i = 0; tap_i < vertical_weights.tap_count; tap_i++)
+                {
+                    if (tap_weights[tap_i] != 0.0f)
+                    {
+                        accumulate_row(
+                            reinterpret_cast<const float*>(horizontal.GetData(0, vertical_weights.first_taps[y] + tap_i, page, 0)),
+                            destination_row.data(),
+                            tap_weights[tap_i],
+                            destination_row.size(),
+                            is_avx2
+                        );
+                    }
+                }
+                if (has_alpha || is_color_clamped)
+                {
+                    clamp_resampled_row(destination_row.data(), this->width, channel_count, has_alpha, is_color_clamped);
+                }
+                this->GetRow(y, page).Blit(filter_row);
+            }
+        }
+    );
+}
+
+std::optional<std::vector<rl::color_rgba<rl::Bitmap::octuple_t>>> rl::Bitmap::FindPalette(const rl::Bitmap::View& bitmap, std::size_t max_color_count)
+{
+    std::vector<rl::color_rgba<rl::Bitmap::octuple_t>> palette;
+    if (bitmap.GetIsEmpty() || bitmap.GetHeight() == 0 || bitmap.GetPageCount() == 0)
+    {
+        return palette;
+    }
+    // tiled rows are not contiguous, so tiled bitmaps are searched through a linear image
+    if (bitmap.GetLayout() == rl::Bitmap::Layout::Tiled)
+    {
+        rl::Image linear(bitmap.GetWidth(), bitmap.GetHeight(), bitmap.GetPageCount(), bitmap.GetDepth(), bitmap.GetColor(), rl::Bitmap::Layout::Linear, 1, std::nullopt, bitmap.GetAlpha(), bitmap.GetSpace());
+        linear.SetPalette(bitmap.GetPalette());
+        linear.Blit(bitmap, 0, 0, 0);
+        return rl::Bitmap::FindPalette(linear, max_color_count);
+    }
+    // every row is converted to packed straight rgba octuple pixels, so colors compare as integers
+    std::vector<std::uint32_t> pixels(bitmap.GetWidth());
+    rl::Bitmap::Row rgba_row(reinterpret_cast<rl::Bitmap::byte_t*>(pixels.data()), bitmap.GetWidth(), rl::Bitmap::Depth::Octuple, rl::Bitmap::Color::Rgba);
+    std::unordered_set<std::uint32_t> found_pixels;
+    for (std::size_t page = 0; page < bitmap.GetPageCount(); page++)
+    {
+        for (std::size_t y = 0; y < bitmap.GetHeight(); y++)
+        {
+            rgba_row.Blit(bitmap.GetRowView(y, page));
+            for (std::size_t x = 0; x < pixels.size(); x++)
+            {
+                // neighbouring pixels often have the same color
+                if ((x > 0 && pixels[x] == pixels[x - 1]) || !found_pixels.insert(pixels[x]).second)
+                {
+                    continue;
+                }
+                if (palette.size() == max_color_count)
+                {
+                    return std::nullopt;
+                }
+                std::array<rl::Bitmap::octuple_t, 4> channels;
+                std::memcpy(channels.data(), &pixels[x], sizeof(std::uint32_t));
+                palette.emplace_back(channels[0], channels[1], channels[2], channels[3]);
+            }
+        }
+    }
+    return palette;
+}
+
+namespace
+{
+    // the pattern a fill copies holds this many pixels, which is a multiple of 32 bytes for every format and plane
+    constexpr std::size_t fill_pattern_width = 256;
+    // fills at least this big stream past the caches instead of evicting everything else for pixels that are not read
+    // again soon
+    constexpr std::size_t streaming_fill_size = std::size_t(1) << 23;
+
+    // the pixels of a fill in the format of its bitmap, once for linear and tiled bitmaps or once per plane for planar
+    // bitmaps. each pattern is stored twice in a row, so copies can start anywhere in the first one.
+    struct fill_pattern
+    {
+        std::array<rl::Bitmap::byte_t, fill_pattern_width * 16 * 2> data = {};
+        std::size_t size = 0;
+        bool is_streaming = false;
+    };
+
+    fill_pattern make_fill_pattern(const rl::Bitmap& bitmap, const rl::color_rgba<rl::Bitmap::normalized_t>& color, std::size_t fill_size)
+    {
+        std::array<rl::Bitmap::normalized_t, fill_pattern_width * 4> source;
+        for (std::size_t pixel_i = 0; pixel_i < fill_pattern_width; pixel_i++)
+        {
+            source[pixel_i * 4] = color.r;
+            source[pixel_i * 4 + 1] = color.g;
+            source[pixel_i * 4 + 2] = color.b;
+            source[pixel_i * 4 + 3] = color.a;
+        }
+        fill_pattern pattern;
+        const bool is_planar = bitmap.GetLayout() == rl::Bitmap::Layout::Planar;
+        pattern.size =
+            is_planar ?
+                rl::Bitmap::GetRowSize(fill_pattern_width, bitmap.GetDepth(), rl::Bitmap::Color::G) :
+                rl::Bitmap::GetRowSize(fill_pattern_width, bitmap.GetDepth(), bitmap.GetColor());
+        pattern.is_streaming = fill_size >= streaming_fill_size;
+        rl::Bitmap::Row(
+            pattern.data.data(),
+            fill_pattern_width,
+            bitmap.GetDepth(),
+            bitmap.GetColor(),
+            is_planar ? rl::Bitmap::Layout::Planar : rl::Bitmap::Layout::Linear,
+            pattern.size * 2,
+            bitmap.GetAlpha(),
+            bitmap.GetPalette(),
+            bitmap.GetSpace()
+        ).Blit(
+            rl::Bitmap::Row::View(
+                reinterpret_cast<const rl::Bitmap::byte_t*>(source.data()),
+                fill_pattern_width,
+                rl::Bitmap::Depth::Normalized,
+                rl::Bitmap::Color::Rgba,
+                rl::Bitmap::Layout::Linear,
+                0,
+                rl::Bitmap::Alpha::Straight,
+                {},
+                bitmap.GetSpace()
+            )
+        );
+        const std::size_t plane_count = is_planar ? bitmap.GetChannelCount() : 1;
+        for (std::size_t plane_i = 0; plane_i < plane_count; plane_i++)
+        {
+            auto* plane_pattern = pattern.data.data() + plane_i * pattern.size * 2;
+            std::memcpy(plane_pattern + pattern.size, plane_pattern, pattern.size);
+        }
+        return pattern;
+    }
+
+#if defined(RL_SIMD_X86)
+    // returns the number of bytes filled, leaving the last bytes that do not fill a whole store
+    RL_TARGET_AVX2 std::size_t fill_bytes_avx2(rl::Bitmap::byte_t* destination, std::size_t size, const rl::Bitmap::byte_t* pattern, std::size_t pattern_size, bool is_streaming) noexcept
+    {
+        // streaming stores need aligned addresses, so the bytes up to the first aligned address are copied first
+        const std::size_t head_size = (32 - reinterpret_cast<std::uintptr_t>(destination) % 32) % 32;
+        if (size < head_size + 32)
+        {
+            return 0;
+        }
+        std::memcpy(destination, pattern, head_size);
+        std::size_t byte_i = head_size;
+        for (; byte_i + 32 <= size; byte_i += 32)
+        {
+            const __m256i pixels = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pattern + byte_i % pattern_size));
+            if (is_streaming)
+            {
+                _mm256_stream_si256(reinterpret_cast<__m256i*>(destination + byte_i), pixels);
+            }
+            else
+            {
+                _mm256_store_si256(reinterpret_cast<__m256i*>(destination + byte_i), pixels);
+            }
+        }
+        if (is_streaming)
+        {
+            _mm_sfence();
+        }
+        return byte_i;
+    }
+#endif
+
+    // fills a run of pixels that starts on a whole byte with a pattern of one plane or of whole pixels
+    void fill_run(rl::Bitmap::byte_t* destination, std::size_t width, std::size_t pixel_bit_count, const rl::Bitmap::byte_t* pattern, std::size_t pattern_size, bool is_streaming) noexcept
+    {
+        const std::size_t size = width * pixel_bit_count / 8;
+        std::size_t byte_i = 0;
+#if defined(RL_SIMD_X86)
+        if (rl::get_simd_level() == rl::SimdLevel::Avx2)
+        {
+            byte_i = fill_bytes_avx2(destination, size, pattern, pattern_size, is_streaming);
+        }
+#endif
+        while (byte_i < size)
+        {
+            const std::size_t copy_size = std::min(pattern_size - byte_i % pattern_size, size - byte_i);
+            std::memcpy(destination + byte_i, pattern + byte_i % pattern_size, copy_size);
+            byte_i += copy_size;
+        }
+        // the last pixels of a sub-byte run can end inside a byte, whose other bits are kept
+        const std::size_t tail_bit_count = width * pixel_bit_count % 8;
+        if (tail_bit_count != 0)
+        {
+            const auto mask = static_cast<std::uint8_t>(0xff << (8 - tail_bit_count));
+            const auto pattern_byte = std::to_integer<std::uint8_t>(pattern[size % pattern_size]);
+            const auto byte = std::to_integer<std::uint8_t>(destination[size]);
+            destination[size] = static_cast<rl::Bitmap::byte_t>((byte & ~mask) | (pattern_byte & mask));
+        }
+    }
+
+    void fill_rows(
+        const rl::Bitmap& bitmap,
+        const fill_pattern& pattern,
+        std::size_t x,
+        std::size_t y,
+        std::size_t page,
+        std::size_t width,
+        std::size_t height,
+        std::size_t first_row,
+        std::size_t last_row
+    ) noexcept
+    {
+        const std::size_t tile_width = rl::Bitmap::GetTileWidth();
+        const bool is_planar = bitmap.GetLayout() == rl::Bitmap::Layout::Planar;
+        const std::size_t pixel_bit_count = bitmap.GetBitDepth() * (is_planar ? 1 : bitmap.GetChannelCount());
+        const std::size_t plane_count = is_planar ? bitmap.GetChannelCount() : 1;
+        // fills of whole tiles see every row of tiles as one contiguous run of pixels
+        const bool is_tile_aligned =
+            bitmap.GetLayout() == rl::Bitmap::Layout::Tiled &&
+            x % tile_width == 0 &&
+            y % tile_width == 0 &&
+            width % tile_width == 0 &&
+            height % tile_width == 0;
+        // rows of whole bytes that follow each other without padding are filled as one run
+        const bool is_whole_bytes = width * pixel_bit_count % 8 == 0;
+        rl::Bitmap::byte_t* run_data = nullptr;
+        std::size_t run_width = 0;
+        const auto flush_run =
+            [&]()
+            {
+                if (run_width != 0)
+                {
+                    fill_run(run_data, run_width, pixel_bit_count, pattern.data.data(), pattern.size, pattern.is_streaming);
+                }
+                run_width = 0;
+            };
+        for (std::size_t row_i = first_row; row_i < last_row; row_i++)
+        {
+            const std::size_t fill_page = page + row_i / height;
+            const std::size_t fill_y = y + row_i % height;
+            if (is_tile_aligned)
+            {
+                // the row of tiles is filled with its first row
+                if (fill_y % tile_width == 0)
+                {
+                    fill_run(bitmap.GetData(x, fill_y, fill_page, 0), width * tile_width, pixel_bit_count, pattern.data.data(), pattern.size, pattern.is_streaming);
+                }
+                continue;
+            }
+            if (bitmap.GetLayout() == rl::Bitmap::Layout::Tiled)
+            {
+                // tiled rows are only contiguous within a tile
+                for (std::size_t fill_x = x; fill_x < x + width;)
+                {
+                    const std::size_t tile_run_width = std::min(x + width - fill_x, tile_width - fill_x % tile_width);
+                    fill_run(bitmap.GetData(fill_x, fill_y, fill_page, 0), tile_run_width, pixel_bit_count, pattern.data.data(), pattern.size, pattern.is_streaming);
+                    fill_x += tile_run_width;
+                }
+                continue;
+            }
+            if (is_planar)
+            {
+                for (std::size_t plane_i = 0; plane_i < plane_count; plane_i++)
+                {
+                    fill_run(bitmap.GetData(x, fill_y, fill_page, plane_i), width, pixel_bit_count, pattern.data.data() + plane_i * pattern.size * 2, pattern.size, pattern.is_streaming);
+                }
+                continue;
+            }
+            auto* row_data = bitmap.GetData(x, fill_y, fill_page, 0);
+            if (is_whole_bytes && run_width != 0 && run_data + run_width * pixel_bit_count / 8 == row_data)
+            {
+                run_width += width;
+                continue;
+            }
+            flush_run();
+            run_data = row_data;
+            run_width = width;
+        }
+        flush_run();
+    }
+}
+
+void rl::Bitmap::Fill(const rl::color_rgba<rl::Bitmap::normalized_t>& color)
+{
+    this->fill(color, 0, 0, 0, this->width, this->height, this->page_count, nullptr);
+}
+
+void rl::Bitmap::Fill(const rl::color_rgba<rl::Bitmap::normalized_t>& color, std::size_t x, std::size_t y, std::size_t page, std::size_t width, std::size_t height, std::size_t page_count)
+{
+    this->fill(color, x, y, page, width, height, page_count, nullptr);
+}
+
+void rl::Bitmap::Fill(const rl::ExecutionPolicy& policy, const rl::color_rgba<rl::Bitmap::normalized_t>& color)
+{
+    this->fill(color, 0, 0, 0, this->width, this->height, this->page_count, &policy);
+}
+
+void rl::Bitmap::Fill(const rl::ExecutionPolicy& policy, const rl::color_rgba<rl::Bitmap::normalized_t>& color, std::size_t x, std::size_t y, std::size_t page, std::size_t width, std::size_t height, std::size_t page_count)
+{
+    this->fill(color, x, y, page, width, height, page_count, &policy);
+}
+
+void rl::Bitmap::fill(const rl::color_rgba<rl::Bitmap::normalized_t>& color, std::size_t x, std::size_t y, std::size_t page, std::size_t width, std::size_t height, std::size_t page_count, const rl::ExecutionPolicy* policy_p)
+{
+    if (width == 0 || height == 0 || page_count == 0)
+    {
+        return;
+    }
+    if (!this->blit_fits(rl::cell_box2<int>(x, y, width, height), page, page_count))
+    {
+        throw rl::runtime_error("fill out of bitmap");
+    }
+    if (x * this->GetBitDepth() * this->GetChannelCount() % 8 != 0)
+    {
+        throw rl::runtime_error("fill of sub-byte bitmap not aligned to bytes");
+    }
+    if (this->color == rl::Bitmap::Color::Indexed && this->palette.empty())
+    {
+        throw rl::runtime_error("fill of indexed bitmap without palette");
+    }
+    const std::size_t fill_size = rl::Bitmap::GetSize(width, height, page_count, this->depth, this->color);
+    const auto pattern = make_fill_pattern(*this, color, fill_size);
+    // bands of tiled fills start on a row of tiles, since whole rows of tiles are filled at once
+    rl::run_row_bands(
+        policy_p,
+        fill_size,
+        height * page_count,
+        [&](std::size_t first_row, std::size_t last_row)
+        {
+            fill_rows(*this, pattern, x, y, page, width, height, first_row, last_row);
+        },
+        (this->layout == rl::Bitmap::Layout::Tiled) ? rl::Bitmap::GetTileWidth() : 1
+    );
+}
+
+namespace
+{
+    // transforms only move whole pixels, so the kernels work on pixel sizes instead of formats. the pixels are copied
+    // with fixed size copies, which compile to plain moves.
+    template<std::size_t PixelSize>
+    void reverse_pixels_scalar(const rl::Bitmap::byte_t* source, rl::Bitmap::byte_t* destination, std::size_t first_pixel, std::size_t width) noexcept
+    {
+        for (std::size_t pixel_i = first_pixel; pixel_i < width; pixel_i++)
+        {
+            std::memcpy(destination + (width - 1 - pixel_i) * PixelSize, source + pixel_i * PixelSize, PixelSize);
+        }
+    }
+
+    // destination pixel x, y is source pixel y, x for a block of width by height destination pixels. strides can be
+    // negative to read or write the rows backwards.
+    template<std::size_t PixelSize>
+    void transpose_pixels_scalar(const rl::Bitmap::byte_t* source, std::ptrdiff_t source_stride, rl::Bitmap::byte_t* destination, std::ptrdiff_t destination_stride, std::size_t width, std::size_t height) noexcept
+    {
+        for (std::size_t y = 0; y < height; y++)
+        {
+            for (std::size_t x = 0; x < width; x++)
+            {
+                std::memcpy(
+                    destination + static_cast<std::ptrdiff_t>(y) * destination_stride + x * PixelSize,
+                    source + static_cast<std::ptrdiff_t>(x) * source_stride + y * PixelSize,
+                    PixelSize
+                );
+            }
+        }
+    }
+
+    // pixel sizes that divide a vector have shuffle kernels, the others are copied pixel by pixel
+    constexpr bool get_is_transform_shuffle(std::size_t pixel_size) noexcept
+    {
+        return pixel_size == 1 || pixel_size == 2 || pixel_size == 4 || pixel_size == 8;
+    }
+
+    bool get_is_transform_simd() noexcept
+    {
+        const auto level = rl::get_simd_level();
+        return level == rl::SimdLevel::Ssse3 || level == rl::SimdLevel::Avx2;
+    }
+
+#if defined(RL_SIMD_X86)
+    template<std::size_t PixelSize>
+    constexpr std::array<std::uint8_t, 16> make_reverse_mask() noexcept
+    {
+        std::array<std::uint8_t, 16> mask = {};
+        constexpr std::size_t pixel_count = 16 / PixelSize;
+        for (std::size_t byte_i = 0; byte_i < 16; byte_i++)
+        {
+            mask[byte_i] = static_cast<std::uint8_t>((pixel_count - 1 - byte_i / PixelSize) * PixelSize + byte_i % PixelSize);
+        }
+        return mask;
+    }
+
+    template<std::size_t PixelSize>
+    RL_TARGET_SSSE3 void reverse_pixels_ssse3(const rl::Bitmap::byte_t* source, rl::Bitmap::byte_t* destination, std::size_t width) noexcept
+    {
+        static constexpr auto reverse_mask = make_reverse_mask<PixelSize>();
+        constexpr std::size_t pixel_count = 16 / PixelSize;
+        const __m128i mask = _mm_loadu_si128(reinterpret_cast<const __m128i*>(reverse_mask.data()));
+        std::size_t pixel_i = 0;
+        for (; pixel_i + pixel_count <= width; pixel_i += pixel_count)
+        {
+            const __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + pixel_i * PixelSize));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + (width - pixel_i - pixel_count) * PixelSize), _mm_shuffle_epi8(pixels, mask));
+        }
+        reverse_pixels_scalar<PixelSize>(source, destination, pixel_i, width);
+    }
+
+    template<std::size_t PixelSize>
+    RL_TARGET_SSSE3 inline __m128i unpack_pixels_lo(__m128i a, __m128i b) noexcept
+    {
+        if constexpr (PixelSize == 1)
+        {
+            return _mm_unpacklo_epi8(a, b);
+        }
+        else if constexpr (PixelSize == 2)
+        {
+            return _mm_unpacklo_epi16(a, b);
+        }
+        else if constexpr (PixelSize == 4)
+        {
+            return _mm_unpacklo_epi32(a, b);
+        }
+        else
+        {
+            return _mm_unpacklo_epi64(a, b);
+        }
+    }
+
+    template<std::size_t PixelSize>
+    RL_TARGET_SSSE3 inline __m128i unpack_pixels_hi(__m128i a, __m128i b) noexcept
+    {
+        if constexpr (PixelSize == 1)
+        {
+            return _mm_unpackhi_epi8(a, b);
+        }
+        else if constexpr (PixelSize == 2)
+        {
+            return _mm_unpackhi_epi16(a, b);
+        }
+        else if constexpr (PixelSize == 4)
+        {
+            return _mm_unpackhi_epi32(a, b);
+        }
+        else
+        {
+            return _mm_unpackhi_epi64(a, b);
+        }
+    }
+
+    // transposes a square of as many rows as pixels fit in a vector. each round interleaves the first half of the rows
+    // with the second half, which moves one bit of the row index into the column index, so after log2 of the row count
+    // rounds the rows and columns have swapped.
+    template<std::size_t PixelSize>
+    RL_TARGET_SSSE3 void transpose_square_ssse3(const rl::Bitmap::byte_t* source, std::ptrdiff_t source_stride, rl::Bitmap::byte_t* destination, std::ptrdiff_t destination_stride) noexcept
+    {
+        constexpr std::size_t row_count = 16 / PixelSize;
+        __m128i rows[row_count];
+        for (std::size_t row_i = 0; row_i < row_count; row_i++)
+        {
+            rows[row_i] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + static_cast<std::ptrdiff_t>(row_i) * source_stride));
+        }
+        for (std::size_t round_count = row_count; round_count > 1; round_count /= 2)
+        {
+            __m128i interleaved[row_count];
+            for (std::size_t row_i = 0; row_i < row_count / 2; row_i++)
+            {
+                interleaved[row_i * 2] = unpack_pixels_lo<PixelSize>(rows[row_i], rows[row_i + row_count / 2]);
+                interleaved[row_i * 2 + 1] = unpack_pixels_hi<PixelSize>(rows[row_i], rows[row_i + row_count / 2]);
+            }
+            std::copy(interleaved, interleaved + row_count, rows);
+        }
+        for (std::size_t row_i = 0; row_i < row_count; row_i++)
+        {
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + static_cast<std::ptrdiff_t>(row_i) * destination_stride), rows[row_i]);
+        }
+    }
+#endif
+
+    template<std::size_t PixelSize>
+    void reverse_pixels(const rl::Bitmap::byte_t* source, rl::Bitmap::byte_t* destination, std::size_t width) noexcept
+    {
+#if defined(RL_SIMD_X86)
+        if constexpr (get_is_transform_shuffle(PixelSize))
+        {
+            if (get_is_transform_simd())
+            {
+                reverse_pixels_ssse3<PixelSize>(source, destination, width);
+                return;
+            }
+        }
+#endif
+        reverse_pixels_scalar<PixelSize>(source, destination, 0, width);
+    }
+
+    template<std::size_t PixelSize>
+    void transpose_pixels(const rl::Bitmap::byte_t* source, std::ptrdiff_t source_stride, rl::Bitmap::byte_t* destination, std::ptrdiff_t destination_stride, std::size_t width, std::size_t height) noexcept
+    {
+        // the pixels are moved in blocks whose source and destination rows stay in the cache together
+        constexpr std::size_t block_width = 64;
+        const auto transpose_block =
+            [&](std::size_t run_x, std::size_t run_y, std::size_t run_width, std::size_t run_height)
+            {
+                transpose_pixels_scalar<PixelSize>(
+                    source + static_cast<std::ptrdiff_t>(run_x) * source_stride + run_y * PixelSize,
+                    source_stride,
+                    destination + static_cast<std::ptrdiff_t>(run_y) * destination_stride + run_x * PixelSize,
+                    destination_stride,
+                    run_width,
+                    run_height
+                );
+            };
+        for (std::size_t block_y = 0; block_y < height; block_y += block_width)
+        {
+            const std::size_t block_height = std::min(block_width, height - block_y);
+            for (std::size_t block_x = 0; block_x < width; block_x += block_width)
+            {
+                const std::size_t block_row_width = std::min(block_width, width - block_x);
+#if defined(RL_SIMD_X86)
+                if constexpr (get_is_transform_shuffle(PixelSize))
+                {
+                    if (get_is_transform_simd())
+                    {
+                        constexpr std::size_t square_width = 16 / PixelSize;
+                        const std::size_t square_row_width = block_row_width / square_width * square_width;
+                        const std::size_t square_height = block_height / square_width * square_width;
+                        for (std::size_t y = block_y; y < block_y + square_height; y += square_width)
+                        {
+                            for (std::size_t x = block_x; x < block_x + square_row_width; x += square_width)
+                            {
+                                transpose_square_ssse3<PixelSize>(
+                                    source + static_cast<std::ptrdiff_t>(x) * source_stride + y * PixelSize,
+                                    source_stride,
+                                    destination + static_cast<std::ptrdiff_t>(y) * destination_stride + x * PixelSize,
+                                    destination_stride
+                                );
+                            }
+                        }
+                        // the pixels right of and below the squares
+                        transpose_block(block_x + square_row_width, block_y, block_row_width - square_row_width, square_height);
+                        transpose_block(block_x, block_y + square_height, block_row_width, block_height - square_height);
+                        continue;
+                    }
+                }
+#endif
+                transpose_block(block_x, block_y, block_row_width, block_height);
+            }
+        }
+    }
+
+    // transforms the rows of the destination from first row to last row, counting the rows of every page after each
+    // other. both bitmaps are linear with the same pixel size.
+    template<std::size_t PixelSize>
+    void transform_rows(
+        const rl::Bitmap::View& source,
+        const rl::Bitmap& destination,
+        rl::Bitmap::Transform transform,
+        std::size_t x,
+        std::size_t y,
+        std::size_t page,
+        std::size_t first_row,
+        std::size_t last_row
+    ) noexcept
+    {
+        const bool is_transposed = rl::Bitmap::GetIsTransposed(transform);
+        const std::size_t width = is_transposed ? source.GetHeight() : source.GetWidth();
+        const std::size_t height = is_transposed ? source.GetWidth() : source.GetHeight();
+        const auto source_stride = static_cast<std::ptrdiff_t>(source.GetRowOffset());
+        const auto destination_stride = static_cast<std::ptrdiff_t>(destination.GetRowOffset());
+        for (std::size_t row_i = first_row; row_i < last_row;)
+        {
+            const std::size_t transform_page = row_i / height;
+            const std::size_t first_y = row_i % height;
+            const std::size_t last_y = std::min(height, first_y + (last_row - row_i));
+            const rl::Bitmap::byte_t* source_page = source.GetData(0, 0, transform_page, 0);
+            const auto get_source_row =
+                [&](std::size_t source_y)
+                {
+                    return source_page + static_cast<std::ptrdiff_t>(source_y) * source_stride;
+                };
+            const auto get_destination_row =
+                [&](std::size_t destination_y)
+                {
+                    return destination.GetData(x, y + destination_y, page + transform_page, 0);
+                };
+            switch (transform)
+            {
+                case rl::Bitmap::Transform::FlipHorizontal:
+                    for (std::size_t transform_y = first_y; transform_y < last_y; transform_y++)
+                    {
+                        reverse_pixels<PixelSize>(get_source_row(transform_y), get_destination_row(transform_y), width);
+                    }
+                    break;
+                case rl::Bitmap::Transform::FlipVertical:
+                    for (std::size_t transform_y = first_y; transform_y < last_y; transform_y++)
+                    {
+                        std::memcpy(get_destination_row(transform_y), get_source_row(height - 1 - transform_y), width * PixelSize);
+                    }
+                    break;
+                case rl::Bitmap::Transform::Rotate180:
+                    for (std::size_t transform_y = first_y; transform_y < last_y; transform_y++)
+                    {
+                        reverse_pixels<PixelSize>(get_source_row(height - 1 - transform_y), get_destination_row(transform_y), width);
+                    }
+                    break;
+                case rl::Bitmap::Transform::Transpose:
+                    // destination row y is source column y
+                    transpose_pixels<PixelSize>(
+                        get_source_row(0) + first_y * PixelSize,
+                        source_stride,
+                        get_destination_row(first_y),
+                        destination_stride,
+                        width,
+                        last_y - first_y
+                    );
+                    break;
+                case rl::Bitmap::Transform::Rotate90:
+                    // the transpose of the source read from its last row up
+                    transpose_pixels<PixelSize>(
+                        get_source_row(width - 1) + first_y * PixelSize,
+                        -source_stride,
+                        get_destination_row(first_y),
+                        destination_stride,
+                        width,
+                        last_y - first_y
+                    );
+                    break;
+                case rl::Bitmap::Transform::Rotate270:
+                    // the transpose of the source written from the last destination row up
+                    transpose_pixels<PixelSize>(
+                        get_source_row(0) + (height - last_y) * PixelSize,
+                        source_stride,
+                        get_destination_row(last_y - 1),
+                        -destination_stride,
+                        width,
+                        last_y - first_y
+                    );
+                    break;
+                default:
+                    break;
+            }
+            row_i += last_y - first_y;
+        }
+    }
+
+    void transform_rows(
+        const rl::Bitmap::View& source,
+        const rl::Bitmap& destination,
+        rl::Bitmap::Transform transform,
+        std::size_t x,
+        std::size_t y,
+        std::size_t page,
+        std::size_t first_row,
+        std::size_t last_row
+    ) noexcept
+    {
+        switch (source.GetPixelSize())
+        {
+            case 1:
+                transform_rows<1>(source, destination, transform, x, y, page, first_row, last_row);
+                return;
+            case 2:
+                transform_rows<2>(source, destination, transform, x, y, page, first_row, last_row);
+                return;
+            case 3:
+                transform_rows<3>(source, destination, transform, x, y, page, first_row, last_row);
+                return;
+            case 4:
+                transform_rows<4>(source, destination, transform, x, y, page, first_row, last_row);
+                return;
+            case 6:
+                transform_rows<6>(source, destination, transform, x, y, page, first_row, last_row);
+                return;
+            case 8:
+                transform_rows<8>(source, destination, transform, x, y, page, first_row, last_row);
+                return;
+            case 12:
+                transform_rows<12>(source, destination, transform, x, y, page, first_row, last_row);
+                return;
+            case 16:
+                transform_rows<16>(source, destination, transform, x, y, page, first_row, last_row);
+                return;
+            default:
+                return;
+        }
+    }
+}
+
+void rl::Bitmap::Blit(const rl::Bitmap::View& bitmap, rl::Bitmap::Transform transform, std::size_t x, std::size_t y, std::size_t page)
+{
+    this->blit_transformed(bitmap, transform, x, y, page, nullptr);
+}
+
+void rl::Bitmap::Blit(const rl::ExecutionPolicy& policy, const rl::Bitmap::View& bitmap, rl::Bitmap::Transform transform, std::size_t x, std::size_t y, std::size_t page)
+{
+    this->blit_transformed(bitmap, transform, x, y, page, &policy);
+}
+
+void rl::Bitmap::blit_transformed(const rl::Bitmap::View& bitmap, rl::Bitmap::Transform transform, std::size_t x, std::size_t y, std::size_t page, const rl::ExecutionPolicy* policy_p)
+{
+    if (transform == rl::Bitmap::Transform::None)
+    {
+        if (policy_p == nullptr)
+        {
+            this->Blit(bitmap, x, y, page);
+        }
+        else
+        {
+            this->Blit(*policy_p, bitmap, x, y, page);
+        }
+        return;
+    }
+    const bool is_transposed = rl::Bitmap::GetIsTransposed(transform);
+    const std::size_t width = is_transposed ? bitmap.GetHeight() : bitmap.GetWidth();
+    const std::size_t height = is_transposed ? bitmap.GetWidth() : bitmap.GetHeight();
+    if (!this->blit_fits(rl::cell_box2<int>(x, y, width, height), page, bitmap.GetPageCount()))
+    {
+        throw rl::runtime_error("blit out of bitmap");
+    }
+    check_indexed_blit(bitmap, *this, rl::Bitmap::Blend::Replace);
+    check_sub_byte_blit(*this, x);
+    if (bitmap.GetIsEmpty() || bitmap.GetHeight() == 0 || bitmap.GetPageCount() == 0)
+    {
+        return;
+    }
+    // the kernels move whole pixels between linear rows, so other sources are blit into a linear image first, with
+    // sub-byte pixels unpacked to octuple ones
+    rl::Image linear_source;
+    rl::Bitmap::View source = bitmap;
+    if (bitmap.GetLayout() != rl::Bitmap::Layout::Linear || rl::Bitmap::GetIsSubByte(bitmap.GetDepth()))
+    {
+        linear_source.Create(
+            bitmap.GetWidth(),
+            bitmap.GetHeight(),
+            bitmap.GetPageCount(),
+            rl::Bitmap::GetIsSubByte(bitmap.GetDepth()) ? rl::Bitmap::Depth::Octuple : bitmap.GetDepth(),
+            bitmap.GetColor(),
+            rl::Bitmap::Layout::Linear,
+            1,
+            std::nullopt,
+            bitmap.GetAlpha(),
+            bitmap.GetSpace()
+        );
+        linear_source.SetPalette(bitmap.GetPalette());
+        linear_source.Blit(bitmap, 0, 0, 0);
+        source = linear_source.GetBitmapView();
+    }
+    // and destinations of other formats get the transformed pixels through a linear image of the source format
+    const bool is_same_format =
+        this->layout == rl::Bitmap::Layout::Linear &&
+        source.GetDepth() == this->depth &&
+        source.GetColor() == this->color &&
+        source.GetIsPremultiplied() == this->GetIsPremultiplied() &&
+        (source.GetSpace() == this->space || this->color == rl::Bitmap::Color::Indexed) &&
+        (this->color != rl::Bitmap::Color::Indexed || get_is_palette_prefix(source.GetPalette(), this->palette));
+    if (!is_same_format)
+    {
+        rl::Image transformed(width, height, source.GetPageCount(), source.GetDepth(), source.GetColor(), rl::Bitmap::Layout::Linear, 1, std::nullopt, source.GetAlpha(), source.GetSpace());
+        transformed.SetPalette(source.GetPalette());
+        transformed.blit_transformed(source, transform, 0, 0, 0, policy_p);
+        if (policy_p == nullptr)
+        {
+            this->Blit(transformed, x, y, page);
+        }
+        else
+        {
+            this->Blit(*policy_p, transformed, x, y, page);
+        }
+        return;
+    }
+    rl::run_row_bands(
+        policy_p,
+        rl::Bitmap::GetSize(width, height, source.GetPageCount(), this->depth, this->color),
+        height * source.GetPageCount(),
+        [&](std::size_t first_row, std::size_t last_row)
+        {
+            transform_rows(source, *this, transform, x, y, page, first_row, last_row);
+        }
+    );
+}
+
+namespace
+{
+    // moves a run of pixels that starts on a whole byte. the runs can overlap.
+    void move_run(rl::Bitmap::byte_t* destination, const rl::Bitmap::byte_t* source, std::size_t width, std::size_t pixel_bit_count) noexcept
+    {
+        const std::size_t size = width * pixel_bit_count / 8;
+        const std::size_t tail_bit_count = width * pixel_bit_count % 8;
+        // the last byte of a sub-byte run is read before the move can overwrite it, and only its bits of the run are
+        // written
+        const auto tail_byte = (tail_bit_count != 0) ? std::to_integer<std::uint8_t>(source[size]) : std::uint8_t(0);
+        std::memmove(destination, source, size);
+        if (tail_bit_count != 0)
+        {
+            const auto mask = static_cast<std::uint8_t>(0xff << (8 - tail_bit_count));
+            const auto byte = std::to_integer<std::uint8_t>(destination[size]);
+            destination[size] = static_cast<rl::Bitmap::byte_t>((byte & ~mask) | (tail_byte & mask));
+        }
+    }
+
+    // calls a function with the runs of a row of a tiled rectangle that do not cross a tile edge
+    template<typename F>
+    void for_each_tile_run(std::size_t x, std::size_t width, F&& func)
+    {
+        const std::size_t tile_width = rl::Bitmap::GetTileWidth();
+        for (std::size_t run_x = x; run_x < x + width;)
+        {
+            const std::size_t run_width = std::min(x + width - run_x, tile_width - run_x % tile_width);
+            func(run_x, run_width);
+            run_x += run_width;
+        }
+    }
+
+    void move_rows(
+        const rl::Bitmap& bitmap,
+        std::size_t x,
+        std::size_t y,
+        std::size_t page,
+        std::size_t width,
+        std::size_t height,
+        std::size_t destination_x,
+        std::size_t destination_y,
+        std::size_t destination_page,
+        bool is_backward,
+        std::size_t first_row,
+        std::size_t last_row
+    )
+    {
+        const bool is_planar = bitmap.GetLayout() == rl::Bitmap::Layout::Planar;
+        const std::size_t pixel_bit_count = bitmap.GetBitDepth() * (is_planar ? 1 : bitmap.GetChannelCount());
+        const std::size_t plane_count = is_planar ? bitmap.GetChannelCount() : 1;
+        // tiled rows are only contiguous within a tile, so they are read whole into a buffer before any of them is written
+        std::vector<rl::Bitmap::byte_t> row_buffer;
+        if (bitmap.GetLayout() == rl::Bitmap::Layout::Tiled)
+        {
+            row_buffer.resize(width * pixel_bit_count / 8 + 1);
+        }
+        for (std::size_t step_i = first_row; step_i < last_row; step_i++)
+        {
+            // rows are moved away from the rows they overwrite, so every row is read before it is written
+            const std::size_t row_i = is_backward ? first_row + last_row - 1 - step_i : step_i;
+            const std::size_t source_y = y + row_i % height;
+            const std::size_t source_page = page + row_i / height;
+            const std::size_t move_y = destination_y + row_i % height;
+            const std::size_t move_page = destination_page + row_i / height;
+            if (bitmap.GetLayout() != rl::Bitmap::Layout::Tiled)
+            {
+                for (std::size_t plane_i = 0; plane_i < plane_count; plane_i++)
+                {
+                    move_run(bitmap.GetData(destination_x, move_y, move_page, plane_i), bitmap.GetData(x, source_y, source_page, plane_i), width, pixel_bit_count);
+                }
+                continue;
+            }
+            for_each_tile_run(
+                x,
+                width,
+                [&](std::size_t run_x, std::size_t run_width)
+                {
+                    move_run(row_buffer.data() + (run_x - x) * pixel_bit_count / 8, bitmap.GetData(run_x, source_y, source_page, 0), run_width, pixel_bit_count);
+                }
+            );
+            for_each_tile_run(
+                destination_x,
+                width,
+                [&](std::size_t run_x, std::size_t run_width)
+                {
+                    move_run(bitmap.GetData(run_x, move_y, move_page, 0), row_buffer.data() + (run_x - destination_x) * pixel_bit_count / 8, run_width, pixel_bit_count);
+                }
+            );
+        }
+    }
+}
+
+void rl::Bitmap::Move(std::size_t x, std::size_t y, std::size_t page, std::size_t width, std::size_t height, std::size_t page_count, std::size_t destination_x, std::size_t destination_y, std::size_t destination_page)
+{
+    this->move(x, y, page, width, height, page_count, destination_x, destination_y, destination_page, nullptr);
+}
+
+void rl::Bitmap::Move(const rl::ExecutionPolicy& policy, std::size_t x, std::size_t y, std::size_t page, std::size_t width, std::size_t height, std::size_t page_count, std::size_t destination_x, std::size_t destination_y, std::size_t destination_page)
+{
+    this->move(x, y, page, width, height, page_count, destination_x, destination_y, destination_page, &policy);
+}
+
+void rl::Bitmap::move(std::size_t x, std::size_t y, std::size_t page, std::size_t width, std::size_t height, std::size_t page_count, std::size_t destination_x, std::size_t destination_y, std::size_t destination_page, const rl::ExecutionPolicy* policy_p)
+{
+    if (width == 0 || height == 0 || page_count == 0)
+    {
+        return;
+    }
+    if (
+        !this->blit_fits(rl::cell_box2<int>(x, y, width, height), page, page_count) ||
+        !this->blit_fits(rl::cell_box2<int>(destination_x, destination_y, width, height), destination_page, page_count)
+    )
+    {
+        throw rl::runtime_error("move out of bitmap");
+    }
+    if ((x * this->GetBitDepth() * this->GetChannelCount() % 8 != 0) || (destination_x * this->GetBitDepth() * this->GetChannelCount() % 8 != 0))
+    {
+        throw rl::runtime_error("move of sub-byte bitmap not aligned to bytes");
+    }
+    // the rows are walked away from the destination when it comes after the source
+    const bool is_backward = std::pair(destination_page, destination_y) > std::pair(page, y);
+    const std::size_t row_count = height * page_count;
+    const std::size_t move_size = rl::Bitmap::GetSize(width, height, page_count, this->depth, this->color);
+    // overlapping moves depend on the order of the rows, so only moves between rectangles that do not overlap are split
+    // into bands
+    const bool is_overlapping =
+        x < destination_x + width && destination_x < x + width &&
+        y < destination_y + height && destination_y < y + height &&
+        page < destination_page + page_count && destination_page < page + page_count;
+    rl::run_row_bands(
+        is_overlapping ? nullptr : policy_p,
+        move_size,
+        row_count,
+        [&](std::size_t first_row, std::size_t last_row)
+        {
+            move_rows(*this, x, y, page, width, height, destination_x, destination_y, destination_page, is_backward, first_row, last_row);
+        }
+    );
+}
+
+namespace
+{
+    constexpr float distance_infinity = std::numeric_limits<float>::infinity();
+
+    // the scratch space of the lines of a band of a distance transform
+    struct distance_lines
+    {
+        std::vector<float> squared;
+        std::vector<float> transformed;
+        std::vector<std::size_t> vertexes;
+        std::vector<double> boundaries;
+
+        distance_lines(std::size_t count) :
+            squared(count),
+            transformed(count),
+            vertexes(count),
+            boundaries(count)
+        {
+        }
+    };
+
+    // the exact squared euclidean distance transform of a line of squared distances, as the lower envelope of the
+    // parabolas rooted at its finite samples (felzenszwalb and huttenlocher). lines without finite samples stay infinite.
+    void transform_distance_line(distance_lines& lines, std::size_t count) noexcept
+    {
+        const float* squared = lines.squared.data();
+        std::size_t vertex_count = 0;
+        for (std::size_t q = 0; q < count; q++)
+        {
+            if (squared[q] == distance_infinity)
+            {
+                continue;
+            }
+            const double height_q = static_cast<double>(squared[q]) + static_cast<double>(q) * static_cast<double>(q);
+            double boundary = -std::numeric_limits<double>::infinity();
+            while (vertex_count != 0)
+            {
+                const std::size_t v = lines.vertexes[vertex_count - 1];
+                const double height_v = static_cast<double>(squared[v]) + static_cast<double>(v) * static_cast<double>(v);
+                boundary = (height_q - height_v) / (2.0 * static_cast<double>(q - v));
+                if (boundary > lines.boundaries[vertex_count - 1])
+                {
+                    break;
+                }
+                vertex_count--;
+                boundary = -std::numeric_limits<double>::infinity();
+            }
+            lines.vertexes[vertex_count] = q;
+            lines.boundaries[vertex_count] = boundary;
+            vertex_count++;
+        }
+        if (vertex_count == 0)
+        {
+            std::fill_n(lines.transformed.begin(), count, distance_infinity);
+            return;
+        }
+        std::size_t vertex_i = 0;
+        for (std::size_t q = 0; q < count; q++)
+        {
+            while (vertex_i + 1 < vertex_count && lines.boundaries[vertex_i + 1] < static_cast<double>(q))
+            {
+                vertex_i++;
+            }
+            const std::size_t v = lines.vertexes[vertex_i];
+            const double offset = static_cast<double>(q) - static_cast<double>(v);
+            lines.transformed[q] = static_cast<float>(offset * offset + static_cast<double>(squared[v]));
+        }
+    }
+
+    // transforms the lines from first_line_i to last_line_i of each of the distance planes in place. a line starts at
+    // line_start(line_i) and steps by stride between its count samples.
+    template<typename F>
+    void transform_distance_lines(std::span<std::vector<float>*> planes, std::size_t count, std::size_t stride, const F& line_start, std::size_t first_line_i, std::size_t last_line_i)
+    {
+        distance_lines lines(count);
+        for (std::size_t line_i = first_line_i; line_i < last_line_i; line_i++)
+        {
+            const std::size_t start = line_start(line_i);
+            for (auto* plane_p : planes)
+            {
+                auto& plane = *plane_p;
+                for (std::size_t sample_i = 0; sample_i < count; sample_i++)
+                {
+                    lines.squared[sample_i] = plane[start + sample_i * stride];
+                }
+                transform_distance_line(lines, count);
+                for (std::size_t sample_i = 0; sample_i < count; sample_i++)
+                {
+                    plane[start + sample_i * stride] = lines.transformed[sample_i];
+                }
+            }
+        }
+    }
+}
+
+void rl::Bitmap::GenerateDistanceField(const rl::Bitmap::View& bitmap, float spread)
+{
+    this->generate_distance_field(bitmap, spread, nullptr);
+}
+
+void rl::Bitmap::GenerateDistanceField(const rl::ExecutionPolicy& policy, const rl::Bitmap::View& bitmap, float spread)
+{
+    this->generate_distance_field(bitmap, spread, &policy);
+}
+
+void rl::Bitmap::generate_distance_field(const rl::Bitmap::View& bitmap, float spread, const rl::ExecutionPolicy* policy_p)
+{
+    if (bitmap.GetPageCount() != this->page_count)
+    {
+        throw rl::runtime_error("distance field page count different from bitmap page count");
+    }
+    if (!(spread > 0.0f))
+    {
+        throw rl::runtime_error("invalid distance field spread");
+    }
+    if (this->GetIsEmpty() || this->height == 0 || this->page_count == 0)
+    {
+        return;
+    }
+    if (bitmap.GetIsEmpty() || bitmap.GetHeight() == 0)
+    {
+        throw rl::runtime_error("distance field of empty bitmap");
+    }
+    const std::size_t width = bitmap.GetWidth();
+    const std::size_t height = bitmap.GetHeight();
+    const std::size_t page_size = width * height;
+    // coverage is read from a normalized copy, with the alpha of colors that have it in the second channel
+    const bool is_alpha =
+        bitmap.GetColor() == rl::Bitmap::Color::Ga ||
+        bitmap.GetColor() == rl::Bitmap::Color::Rgba ||
+        bitmap.GetColor() == rl::Bitmap::Color::Indexed;
+    rl::Image coverage(width, height, this->page_count, rl::Bitmap::Depth::Normalized, is_alpha ? rl::Bitmap::Color::Ga : rl::Bitmap::Color::G, rl::Bitmap::Layout::Linear, 1, std::nullopt, rl::Bitmap::Alpha::Straight);
+    if (policy_p != nullptr)
+    {
+        coverage.Blit(*policy_p, bitmap, 0, 0, 0);
+    }
+    else
+    {
+        coverage.Blit(bitmap, 0, 0, 0);
+    }
+    // the squared distances from inside pixels to the nearest outside pixel, and from outside pixels to the nearest
+    // inside pixel. each starts at 0 on the pixels it measures to.
+    std::vector<float> inside_distances(page_size * this->page_count);
+    std::vector<float> outside_distances(page_size * this->page_count);
+    const std::size_t coverage_channel_count = is_alpha ? 2 : 1;
+    for (std::size_t page_i = 0; page_i < this->page_count; page_i++)
+    {
+        for (std::size_t y = 0; y < height; y++)
+        {
+            const auto* row = reinterpret_cast<const rl::Bitmap::normalized_t*>(coverage.GetData(0, y, page_i));
+            for (std::size_t x = 0; x < width; x++)
+            {
+                const bool is_inside = row[x * coverage_channel_count + coverage_channel_count - 1] >= 0.5f;
+                const std::size_t pixel_i = page_i * page_size + y * width + x;
+                inside_distances[pixel_i] = is_inside ? distance_infinity : 0.0f;
+                outside_distances[pixel_i] = is_inside ? 0.0f : distance_infinity;
+            }
+        }
+    }
+    // the transform is separable, so every column is transformed and then every row
+    std::vector<float>* planes[] = { &inside_distances, &outside_distances };
+    const auto transform =
+        [&](std::size_t line_count, std::size_t count, std::size_t stride, const auto& line_start)
+        {
+            rl::run_row_bands(
+                policy_p,
+                sizeof(float) * 2 * page_size * this->page_count,
+                line_count,
+                [&](std::size_t first_line, std::size_t last_line)
+                {
+                    transform_distance_lines(planes, count, stride, line_start, first_line, last_line);
+                }
+            );
+        };
+    transform(
+        width * this->page_count,
+        height,
+        width,
+        [&](std::size_t line_i) { return line_i / width * page_size + line_i % width; }
+    );
+    transform(
+        height * this->page_count,
+        width,
+        1,
+        [&](std::size_t line_i) { return line_i * width; }
+    );
+    // edges lie halfway between inside and outside pixels
+    rl::Image field(width, height, this->page_count, rl::Bitmap::Depth::Normalized, rl::Bitmap::Color::G, rl::Bitmap::Layout::Linear);
+    for (std::size_t page_i = 0; page_i < this->page_count; page_i++)
+    {
+        for (std::size_t y = 0; y < height; y++)
+        {
+            auto* row = reinterpret_cast<rl::Bitmap::normalized_t*>(field.GetData(0, y, page_i));
+            for (std::size_t x = 0; x < width; x++)
+            {
+                const std::size_t pixel_i = page_i * page_size + y * width + x;
+                const float distance =
+                    outside_distances[pixel_i] == 0.0f ?
+                        std::sqrt(inside_distances[pixel_i]) - 0.5f :
+                        0.5f - std::sqrt(outside_distances[pixel_i]);
+                row[x] = std::clamp(0.5f + distance / (2.0f * spread), 0.0f, 1.0f);
+            }
+        }
+    }
+    this->resample(field, rl::Bitmap::Filter::Box, policy_p);
+}
@@ -0,0 +1,3310 @@
+// SPDX-FileCopyrightText: 2023 Daniel Aimé Valcour <fosssweeper@gmail.com>
+//
+// SPDX-License-Identifier: MIT
+
+/*
+    Copyright (c) 2023 Daniel Aimé Valcour
+    Permission is hereby granted, free of charge, to any person obtaining a copy of
+    this software and associated documentation files (the "Software"), to deal in
+    the Software without restriction, including without limitation the rights to
+    use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+    the Software, and to permit persons to whom the Software is furnished to do so,
+    subject to the following conditions:
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+    FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+    COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+    IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+    CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include <rla/Bitmap.hpp>
+#include <rla/gray.hpp>
+#include <rla/simd.hpp>
+#include <rld/except.hpp>
+#include "simd_target.hpp"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace
+{
+    // the simd kernels are bit exact with the scalar rl::Bitmap::Row::Blit path. the ones that move channels around
+    // do so by construction, and the ones that change depths further down round the way the scalar channel
+    // conversions do. rgb to gray conversions have kernels of their own.
+    constexpr int fill_alpha = -1;
+
+    constexpr bool get_has_alpha(rl::Bitmap::Color color) noexcept
+    {
+        return
+            color == rl::Bitmap::Color::Ga ||
+            color == rl::Bitmap::Color::Rgba;
+    }
+
+    constexpr bool get_is_gray(rl::Bitmap::Color color) noexcept
+    {
+        return
+            color == rl::Bitmap::Color::G ||
+            color == rl::Bitmap::Color::Ga;
+    }
+
+    constexpr bool get_is_shuffle(rl::Bitmap::Color source_color, rl::Bitmap::Color destination_color) noexcept
+    {
+        return
+            source_color != destination_color &&
+            (
+                !get_is_gray(destination_color) ||
+                get_is_gray(source_color)
+            );
+    }
+
+    // the source channel that each destination channel is copied from, or fill_alpha if it is set fully opaque.
+    constexpr std::array<int, 4> get_channel_map(rl::Bitmap::Color source_color, rl::Bitmap::Color destination_color) noexcept
+    {
+        const int alpha = 
+            get_has_alpha(source_color) ?
+            static_cast<int>(rl::Bitmap::GetChannelCount(source_color)) - 1 :
+            fill_alpha;
+        const bool gray = get_is_gray(source_color);
+        switch (destination_color)
+        {
+            case rl::Bitmap::Color::G:
+                return {0, 0, 0, 0};
+            case rl::Bitmap::Color::Ga:
+                return {0, alpha, 0, 0};
+            case rl::Bitmap::Color::Rgb:
+                return {0, gray ? 0 : 1, gray ? 0 : 2, 0};
+            case rl::Bitmap::Color::Rgba:
+                return {0, gray ? 0 : 1, gray ? 0 : 2, alpha};
+            case rl::Bitmap::Color::Indexed:
+                // indexes are expanded through the palette, never shuffled
+                break;
+        }
+        return {0, 0, 0, 0};
+    }
+
+    template<rl::Bitmap::Depth Depth>
+    constexpr std::array<std::uint8_t, rl::Bitmap::GetChannelSize(Depth)> get_opaque_alpha() noexcept
+    {
+        if constexpr (Depth == rl::Bitmap::Depth::Normalized)
+        {
+            return std::bit_cast<std::array<std::uint8_t, sizeof(rl::Bitmap::normalized_t)>>(rl::Bitmap::normalized_t(1.0f));
+        }
+        else if constexpr (Depth == rl::Bitmap::Depth::Half)
+        {
+            return std::bit_cast<std::array<std::uint8_t, sizeof(rl::Bitmap::half_t)>>(rl::detail::float_to_half(1.0f));
+        }
+        else
+        {
+            std::array<std::uint8_t, rl::Bitmap::GetChannelSize(Depth)> alpha;
+            alpha.fill(0xff);
+            return alpha;
+        }
+    }
+
+    template<rl::Bitmap::Depth Depth, rl::Bitmap::Color SourceColor, rl::Bitmap::Color DestinationColor>
+    struct shuffle_kernel
+    {
+        static constexpr std::size_t channel_size = rl::Bitmap::GetChannelSize(Depth);
+        static constexpr std::size_t channel_count = rl::Bitmap::GetChannelCount(DestinationColor);
+        static constexpr std::size_t source_pixel_size = channel_size * rl::Bitmap::GetChannelCount(SourceColor);
+        static constexpr std::size_t destination_pixel_size = channel_size * channel_count;
+        static constexpr std::array<int, 4> channel_map = get_channel_map(SourceColor, DestinationColor);
+        static constexpr std::array<std::uint8_t, channel_size> opaque_alpha = get_opaque_alpha<Depth>();
+        // pixels converted by one 16 byte shuffle
+        static constexpr std::size_t block_width = 16 / std::max(source_pixel_size, destination_pixel_size);
+        // pixels that must remain so a 16 byte load and store stay inside both rows
+        static constexpr std::size_t vector_width = (16 + std::min(source_pixel_size, destination_pixel_size) - 1) / std::min(source_pixel_size, destination_pixel_size);
+
+        static constexpr std::array<std::uint8_t, 16> get_shuffle_mask() noexcept
+        {
+            std::array<std::uint8_t, 16> mask;
+            for (std::size_t byte_i = 0; byte_i < mask.size(); byte_i++)
+            {
+                const auto pixel_i = byte_i / destination_pixel_size;
+                const auto channel_i = (byte_i % destination_pixel_size) / channel_size;
+                const auto source_channel = channel_map[channel_i];
+                // indices with the high bit set write a zero
+                mask[byte_i] = 0x80;
+                if (pixel_i < block_width && source_channel != fill_alpha)
+                {
+                    mask[byte_i] =
+                        static_cast<std::uint8_t>(
+                            pixel_i * source_pixel_size +
+                            static_cast<std::size_t>(source_channel) * channel_size +
+                            byte_i % channel_size
+                        );
+                }
+            }
+            return mask;
+        }
+
+        static constexpr std::array<std::uint8_t, 16> get_fill() noexcept
+        {
+            std::array<std::uint8_t, 16> fill;
+            fill.fill(0);
+            for (std::size_t byte_i = 0; byte_i < fill.size(); byte_i++)
+            {
+                const auto pixel_i = byte_i / destination_pixel_size;
+                const auto channel_i = (byte_i % destination_pixel_size) / channel_size;
+                if (pixel_i < block_width && channel_map[channel_i] == fill_alpha)
+                {
+                    fill[byte_i] = opaque_alpha[byte_i % channel_size];
+                }
+            }
+            return fill;
+        }
+
+        static constexpr std::array<std::uint8_t, 16> shuffle_mask = get_shuffle_mask();
+        static constexpr std::array<std::uint8_t, 16> fill = get_fill();
+
+        static void convert_scalar(const rl::Bitmap::byte_t* source, rl::Bitmap::byte_t* destination, std::size_t width) noexcept
+        {
+            for (std::size_t pixel_i = 0; pixel_i < width; pixel_i++)
+            {
+                for (std::size_t channel_i = 0; channel_i < channel_count; channel_i++)
+                {
+                    const auto source_channel = channel_map[channel_i];
+                    if (source_channel == fill_alpha)
+                    {
+                        std::memcpy(destination + channel_i * channel_size, opaque_alpha.data(), channel_size);
+                    }
+                    else
+                    {
+                        std::memcpy(destination + channel_i * channel_size, source + source_channel * channel_size, channel_size);
+                    }
+                }
+                source += source_pixel_size;
+                destination += destination_pixel_size;
+            }
+        }
+
+#if defined(RL_SIMD_X86)
+        RL_TARGET_SSSE3 static void convert_ssse3(const rl::Bitmap::byte_t* source, rl::Bitmap::byte_t* destination, std::size_t width) noexcept
+        {
+            const __m128i mask = _mm_loadu_si128(reinterpret_cast<const __m128i*>(shuffle_mask.data()));
+            const __m128i alpha = _mm_loadu_si128(reinterpret_cast<const __m128i*>(fill.data()));
+            std::size_t pixel_i = 0;
+            for (; pixel_i + vector_width <= width; pixel_i += block_width)
+            {
+                const __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + pixel_i * source_pixel_size));
+                _mm_storeu_si128(
+                    reinterpret_cast<__m128i*>(destination + pixel_i * destination_pixel_size),
+                    _mm_or_si128(_mm_shuffle_epi8(pixels, mask), alpha)
+                );
+            }
+            convert_scalar(source + pixel_i * source_pixel_size, destination + pixel_i * destination_pixel_size, width - pixel_i);
+        }
+
+        RL_TARGET_AVX2 static void convert_avx2(const rl::Bitmap::byte_t* source, rl::Bitmap::byte_t* destination, std::size_t width) noexcept
+        {
+            // vpshufb can not cross 128 bit lanes, so each lane converts its own block
+            const __m256i mask = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(shuffle_mask.data())));
+            const __m256i alpha = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(fill.data())));
+            std::size_t pixel_i = 0;
+            for (; pixel_i + block_width + vector_width <= width; pixel_i += block_width * 2)
+            {
+                const auto* source_block = source + pixel_i * source_pixel_size;
+                auto* destination_block = destination + pixel_i * destination_pixel_size;
+                __m256i pixels =
+                    _mm256_inserti128_si256(
+                        _mm256_castsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(source_block))),
+                        _mm_loadu_si128(reinterpret_cast<const __m128i*>(source_block + block_width * source_pixel_size)),
+                        1
+                    );
+                pixels = _mm256_or_si256(_mm256_shuffle_epi8(pixels, mask), alpha);
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(destination_block), _mm256_castsi256_si128(pixels));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(destination_block + block_width * destination_pixel_size), _mm256_extracti128_si256(pixels, 1));
+            }
+            for (; pixel_i + vector_width <= width; pixel_i += block_width)
+            {
+                const __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + pixel_i * source_pixel_size));
+                _mm_storeu_si128(
+                    reinterpret_cast<__m128i*>(destination + pixel_i * destination_pixel_size),
+                    _mm_or_si128(_mm_shuffle_epi8(pixels, _mm256_castsi256_si128(mask)), _mm256_castsi256_si128(alpha))
+                );
+            }
+            convert_scalar(source + pixel_i * source_pixel_size, destination + pixel_i * destination_pixel_size, width - pixel_i);
+        }
+#endif
+
+#if defined(RL_SIMD_NEON)
+        static void convert_neon(const rl::Bitmap::byte_t* source, rl::Bitmap::byte_t* destination, std::size_t width) noexcept
+        {
+            // tbl writes a zero for out of range indices just like pshufb
+            const uint8x16_t mask = vld1q_u8(shuffle_mask.data());
+            const uint8x16_t alpha = vld1q_u8(fill.data());
+            std::size_t pixel_i = 0;
+            for (; pixel_i + vector_width <= width; pixel_i += block_width)
+            {
+                const uint8x16_t pixels = vld1q_u8(reinterpret_cast<const std::uint8_t*>(source + pixel_i * source_pixel_size));
+                vst1q_u8(
+                    reinterpret_cast<std::uint8_t*>(destination + pixel_i * destination_pixel_size),
+                    vorrq_u8(vqtbl1q_u8(pixels, mask), alpha)
+                );
+            }
+            convert_scalar(source + pixel_i * source_pixel_size, destination + pixel_i * destination_pixel_size, width - pixel_i);
+        }
+#endif
+    };
+
+    template<rl::SimdLevel Level, rl::Bitmap::Depth Depth, rl::Bitmap::Color SourceColor, rl::Bitmap::Color DestinationColor>
+    constexpr rl::Bitmap::row_converter_t get_shuffle_converter() noexcept
+    {
+        if constexpr (!get_is_shuffle(SourceColor, DestinationColor))
+        {
+            return nullptr;
+        }
+#if defined(RL_SIMD_X86)
+        else if constexpr (Level == rl::SimdLevel::Ssse3)
+        {
+            return &shuffle_kernel<Depth, SourceColor, DestinationColor>::convert_ssse3;
+        }
+        else if constexpr (Level == rl::SimdLevel::Avx2)
+        {
+            return &shuffle_kernel<Depth, SourceColor, DestinationColor>::convert_avx2;
+        }
+#endif
+#if defined(RL_SIMD_NEON)
+        else if constexpr (Level == rl::SimdLevel::Neon)
+        {
+            return &shuffle_kernel<Depth, SourceColor, DestinationColor>::convert_neon;
+        }
+#endif
+        else
+        {
+            return nullptr;
+        }
+    }
+
+    // indexed by source color * 4 + destination color
+    template<rl::SimdLevel Level, rl::Bitmap::Depth Depth, std::size_t... ColorPairIs>
+    constexpr std::array<rl::Bitmap::row_converter_t, sizeof...(ColorPairIs)> make_shuffle_converters(std::index_sequence<ColorPairIs...>) noexcept
+    {
+        return {
+            get_shuffle_converter<
+                Level,
+                Depth,
+                static_cast<rl::Bitmap::Color>(ColorPairIs / 4),
+                static_cast<rl::Bitmap::Color>(ColorPairIs % 4)
+            >()...
+        };
+    }
+
+    template<rl::SimdLevel Level>
+    rl::Bitmap::row_converter_t get_shuffle_converter(rl::Bitmap::Depth depth, rl::Bitmap::Color source_color, rl::Bitmap::Color destination_color) noexcept
+    {
+        static constexpr auto octuple_converters = make_shuffle_converters<Level, rl::Bitmap::Depth::Octuple>(std::make_index_sequence<16>());
+        static constexpr auto sexdecuple_converters = make_shuffle_converters<Level, rl::Bitmap::Depth::Sexdecuple>(std::make_index_sequence<16>());
+        static constexpr auto normalized_converters = make_shuffle_converters<Level, rl::Bitmap::Depth::Normalized>(std::make_index_sequence<16>());
+        static constexpr auto half_converters = make_shuffle_converters<Level, rl::Bitmap::Depth::Half>(std::make_index_sequence<16>());
+        const auto color_pair_i = static_cast<std::size_t>(source_color) * 4 + static_cast<std::size_t>(destination_color);
+        switch (depth)
+        {
+            case rl::Bitmap::Depth::Octuple:
+                return octuple_converters[color_pair_i];
+            case rl::Bitmap::Depth::Sexdecuple:
+                return sexdecuple_converters[color_pair_i];
+            case rl::Bitmap::Depth::Normalized:
+                return normalized_converters[color_pair_i];
+            case rl::Bitmap::Depth::Half:
+                return half_converters[color_pair_i];
+            case rl::Bitmap::Depth::Single:
+            case rl::Bitmap::Depth::Duple:
+            case rl::Bitmap::Depth::Quadruple:
+                // sub-byte channels are unpacked by the blits, not shuffled
+                return nullptr;
+        }
+        return nullptr;
+    }
+}
+
+namespace
+{
+    // half and normalized rows of the same color convert channel by channel, so the tail of a row converts like a gray
+    // row of its remaining channels. the conversions round to the nearest even half like the scalar ones.
+    constexpr bool get_is_half_conversion(rl::Bitmap::Depth source_depth, rl::Bitmap::Color source_color, rl::Bitmap::Depth destination_depth, rl::Bitmap::Color destination_color) noexcept
+    {
+        return
+            source_color == destination_color &&
+            (
+                (source_depth == rl::Bitmap::Depth::Half && destination_depth == rl::Bitmap::Depth::Normalized) ||
+                (source_depth == rl::Bitmap::Depth::Normalized && destination_depth == rl::Bitmap::Depth::Half)
+            );
+    }
+
+    void widen_half_channels(const rl::Bitmap::byte_t* source, rl::Bitmap::byte_t* destination, std::size_t channel_count) noexcept
+    {
+        rl::detail::convert_row<rl::Bitmap::Depth::Half, rl::Bitmap::Color::G, rl::Bitmap::Depth::Normalized, rl::Bitmap::Color::G>(source, destination, channel_count);
+    }
+
+    void narrow_half_channels(const rl::Bitmap::byte_t* source, rl::Bitmap::byte_t* destination, std::size_t channel_count) noexcept
+    {
+        rl::detail::convert_row<rl::Bitmap::Depth::Normalized, rl::Bitmap::Color::G, rl::Bitmap::Depth::Half, rl::Bitmap::Color::G>(source, destination, channel_count);
+    }
+
+#if defined(RL_SIMD_X86)
+    template<std::size_t ChannelCount>
+    RL_TARGET_F16C void widen_half_row_f16c(const rl::Bitmap::byte_t* source, rl::Bitmap::byte_t* destination, std::size_t width) noexcept
+    {
+        const std::size_t channel_count = width * ChannelCount;
+        std::size_t channel_i = 0;
+        for (; channel_i + 8 <= channel_count; channel_i += 8)
+        {
+            const __m128i halves = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + channel_i * sizeof(rl::Bitmap::half_t)));
+            _mm256_storeu_ps(reinterpret_cast<float*>(destination + channel_i * sizeof(rl::Bitmap::normalized_t)), _mm256_cvtph_ps(halves));
+        }
+        widen_half_channels(source + channel_i * sizeof(rl::Bitmap::half_t), destination + channel_i * sizeof(rl::Bitmap::normalized_t), channel_count - channel_i);
+    }
+
+    template<std::size_t ChannelCount>
+    RL_TARGET_F16C void narrow_half_row_f16c(const rl::Bitmap::byte_t* source, rl::Bitmap::byte_t* destination, std::size_t width) noexcept
+    {
+        const std::size_t channel_count = width * ChannelCount;
+        std::size_t channel_i = 0;
+        for (; channel_i + 8 <= channel_count; channel_i += 8)
+        {
+            const __m256 floats = _mm256_loadu_ps(reinterpret_cast<const float*>(source + channel_i * sizeof(rl::Bitmap::normalized_t)));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + channel_i * sizeof(rl::Bitmap::half_t)), _mm256_cvtps_ph(floats, _MM_FROUND_TO_NEAREST_INT));
+        }
+        narrow_half_channels(source + channel_i * sizeof(rl::Bitmap::normalized_t), destination + channel_i * sizeof(rl::Bitmap::half_t), channel_count - channel_i);
+    }
+#endif
+
+#if defined(RL_SIMD_NEON)
+    template<std::size_t ChannelCount>
+    void widen_half_row_neon(const rl::Bitmap::byte_t* source, rl::Bitmap::byte_t* destination, std::size_t width) noexcept
+    {
+        const std::size_t channel_count = width * ChannelCount;
+        std::size_t channel_i = 0;
+        for (; channel_i + 4 <= channel_count; channel_i += 4)
+        {
+            const float16x4_t halves = vreinterpret_f16_u16(vld1_u16(reinterpret_cast<const std::uint16_t*>(source + channel_i * sizeof(rl::Bitmap::half_t))));
+            vst1q_f32(reinterpret_cast<float*>(destination + channel_i * sizeof(rl::Bitmap::normalized_t)), vcvt_f32_f16(halves));
+        }
+        widen_half_channels(source + channel_i * sizeof(rl::Bitmap::half_t), destination + channel_i * sizeof(rl::Bitmap::normalized_t), channel_count - channel_i);
+    }
+
+    template<std::size_t ChannelCount>
+    void narrow_half_row_neon(const rl::Bitmap::byte_t* source, rl::Bitmap::byte_t* destination, std::size_t width) noexcept
+    {
+        const std::size_t channel_count = width * ChannelCount;
+        std::size_t channel_i = 0;
+        for (; channel_i + 4 <= channel_count; channel_i += 4)
+        {
+            const float32x4_t floats = vld1q_f32(reinterpret_cast<const float*>(source + channel_i * sizeof(rl::Bitmap::normalized_t)));
+            vst1_u16(reinterpret_cast<std::uint16_t*>(destination + channel_i * sizeof(rl::Bitmap::half_t)), vreinterpret_u16_f16(vcvt_f16_f32(floats)));
+        }
+        narrow_half_channels(source + channel_i * sizeof(rl::Bitmap::normalized_t), destination + channel_i * sizeof(rl::Bitmap::half_t), channel_count - channel_i);
+    }
+#endif
+
+    template<std::size_t ChannelCount>
+    rl::Bitmap::row_converter_t get_half_converter(rl::SimdLevel level, bool is_widening) noexcept
+    {
+        switch (level)
+        {
+#if defined(RL_SIMD_X86)
+            case rl::SimdLevel::Avx2:
+                return is_widening ? &widen_half_row_f16c<ChannelCount> : &narrow_half_row_f16c<ChannelCount>;
+#endif
+#if defined(RL_SIMD_NEON)
+            case rl::SimdLevel::Neon:
+                return is_widening ? &widen_half_row_neon<ChannelCount> : &narrow_half_row_neon<ChannelCount>;
+#endif
+            default:
+                return nullptr;
+        }
+    }
+
+    rl::Bitmap::row_converter_t get_half_converter(rl::SimdLevel level, rl::Bitmap::Depth source_depth, rl::Bitmap::Color color) noexcept
+    {
+        const bool is_widening = source_depth == rl::Bitmap::Depth::Half;
+        switch (color)
+        {
+            case rl::Bitmap::Color::G:
+                return get_half_converter<1>(level, is_widening);
+            case rl::Bitmap::Color::Ga:
+                return get_half_converter<2>(level, is_widening);
+            case rl::Bitmap::Color::Rgb:
+                return get_half_converter<3>(level, is_widening);
+            case rl::Bitmap::Color::Rgba:
+                return get_half_converter<4>(level, is_widening);
+            default:
+                return nullptr;
+        }
+    }
+}
+
+namespace
+{
+    // octuple rows widen to sexdecuple rows of the same color channel by channel. each channel v becomes v * 257, which
+    // is exact, so the kernels repeat the byte of the channel instead of doing any math.
+    constexpr bool get_is_sexdecuple_conversion(rl::Bitmap::Depth source_depth, rl::Bitmap::Color source_color, rl::Bitmap::Depth destination_depth, rl::Bitmap::Color destination_color) noexcept
+    {
+        return
+            source_color == destination_color &&
+            source_color != rl::Bitmap::Color::Indexed &&
+            source_depth == rl::Bitmap::Depth::Octuple &&
+            destination_depth == rl::Bitmap::Depth::Sexdecuple;
+    }
+
+    void widen_octuple_channels(const rl::Bitmap::byte_t* source, rl::Bitmap::byte_t* destination, std::size_t channel_count) noexcept
+    {
+        rl::detail::convert_row<rl::Bitmap::Depth::Octuple, rl::Bitmap::Color::G, rl::Bitmap::Depth::Sexdecuple, rl::Bitmap::Color::G>(source, destination, channel_count);
+    }
+
+#if defined(RL_SIMD_X86)
+    template<std::size_t ChannelCount>
+    RL_TARGET_SSSE3 void widen_octuple_row_ssse3(const rl::Bitmap::byte_t* source, rl::Bitmap::byte_t* destination, std::size_t width) noexcept
+    {
+        const std::size_t channel_count = width * ChannelCount;
+        std::size_t channel_i = 0;
+        for (; channel_i + 16 <= channel_count; channel_i += 16)
+        {
+            const __m128i channels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + channel_i));
+            auto* destination_channels = destination + channel_i * sizeof(rl::Bitmap::sexdecuple_t);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(destination_channels), _mm_unpacklo_epi8(channels, channels));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(destination_channels + 16), _mm_unpackhi_epi8(channels, channels));
+        }
+        widen_octuple_channels(source + channel_i, destination + channel_i * sizeof(rl::Bitmap::sexdecuple_t), channel_count - channel_i);
+    }
+
+    template<std::size_t ChannelCount>
+    RL_TARGET_AVX2 void widen_octuple_row_avx2(const rl::Bitmap::byte_t* source, rl::Bitmap::byte_t* destination, std::size_t width) noexcept
+    {
+        const std::size_t channel_count = width * ChannelCount;
+        std::size_t channel_i = 0;
+        for (; channel_i + 32 <= channel_count; channel_i += 32)
+        {
+            // unpacking works within 128 bit lanes, so the lanes are put in order first
+            const __m256i channels = _mm256_permute4x64_epi64(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(source + channel_i)), 0xd8);
+            auto* destination_channels = destination + channel_i * sizeof(rl::Bitmap::sexdecuple_t);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(destination_channels), _mm256_unpacklo_epi8(channels, channels));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(destination_channels + 32), _mm256_unpackhi_epi8(channels, channels));
+        }
+        widen_octuple_row_ssse3<1>(source + channel_i, destination + channel_i * sizeof(rl::Bitmap::sexdecuple_t), channel_count - channel_i);
+    }
+#endif
+
+#if defined(RL_SIMD_NEON)
+    template<std::size_t ChannelCount>
+    void widen_octuple_row_neon(const rl::Bitmap::byte_t* source, rl::Bitmap::byte_t* destination, std::size_t width) noexcept
+    {
+        const std::size_t channel_count = width * ChannelCount;
+        std::size_t channel_i = 0;
+        for (; channel_i + 16 <= channel_count; channel_i += 16)
+        {
+            const uint8x16_t channels = vld1q_u8(reinterpret_cast<const std::uint8_t*>(source + channel_i));
+            auto* destination_channels = reinterpret_cast<std::uint8_t*>(destination + channel_i * sizeof(rl::Bitmap::sexdecuple_t));
+            vst1q_u8(destination_channels, vzip1q_u8(channels, channels));
+            vst1q_u8(destination_channels + 16, vzip2q_u8(channels, channels));
+        }
+        widen_octuple_channels(source + channel_i, destination + channel_i * sizeof(rl::Bitmap::sexdecuple_t), channel_count - channel_i);
+    }
+#endif
+
+    template<std::size_t ChannelCount>
+    rl::Bitmap::row_converter_t get_sexdecuple_converter(rl::SimdLevel level) noexcept
+    {
+        switch (level)
+        {
+#if defined(RL_SIMD_X86)
+            case rl::SimdLevel::Ssse3:
+                return &widen_octuple_row_ssse3<ChannelCount>;
+            case rl::SimdLevel::Avx2:
+                return &widen_octuple_row_avx2<ChannelCount>;
+#endif
+#if defined(RL_SIMD_NEON)
+            case rl::SimdLevel::Neon:
+                return &widen_octuple_row_neon<ChannelCount>;
+#endif
+            default:
+                return nullptr;
+        }
+    }
+
+    rl::Bitmap::row_converter_t get_sexdecuple_converter(rl::SimdLevel level, rl::Bitmap::Color color) noexcept
+    {
+        switch (color)
+        {
+            case rl::Bitmap::Color::G:
+                return get_sexdecuple_converter<1>(level);
+            case rl::Bitmap::Color::Ga:
+                return get_sexdecuple_converter<2>(level);
+            case rl::Bitmap::Color::Rgb:
+                return get_sexdecuple_converter<3>(level);
+            case rl::Bitmap::Color::Rgba:
+                return get_sexdecuple_converter<4>(level);
+            default:
+                return nullptr;
+        }
+    }
+}
+
+namespace
+{
+    // octuple and sexdecuple rows widen to normalized rows of the same color, and sexdecuple, normalized and half rows
+    // narrow to integer rows of the same color, with the math of the scalar channel conversions. integers are divided
+    // by their maximum in double precision and rounded to floats. floats are clamped to [0, 1], and v * max + 0.5 is
+    // taken in double precision, where it is exact, truncated and packed with saturation. sexdecuple channels round to
+    // (v * 255 + 32767) / 65535, which is (t - (t >> 8)) >> 8 for t = v + 128 saturated to 16 bits.
+    constexpr bool get_is_arithmetic_conversion(rl::Bitmap::Depth source_depth, rl::Bitmap::Color source_color, rl::Bitmap::Depth destination_depth, rl::Bitmap::Color destination_color) noexcept
+    {
+        const bool is_source_integer = source_depth == rl::Bitmap::Depth::Octuple || source_depth == rl::Bitmap::Depth::Sexdecuple;
+        const bool is_source_float = source_depth == rl::Bitmap::Depth::Normalized || source_depth == rl::Bitmap::Depth::Half;
+        const bool is_destination_integer = destination_depth == rl::Bitmap::Depth::Octuple || destination_depth == rl::Bitmap::Depth::Sexdecuple;
+        return
+            source_color == destination_color &&
+            source_color != rl::Bitmap::Color::Indexed &&
+            (
+                (is_source_integer && destination_depth == rl::Bitmap::Depth::Normalized) ||
+                (is_source_float && is_destination_integer) ||
+                (source_depth == rl::Bitmap::Depth::Sexdecuple && destination_depth == rl::Bitmap::Depth::Octuple)
+            );
+    }
+
+    template<rl::Bitmap::Depth Depth>
+    constexpr double get_channel_max() noexcept
+    {
+        return static_cast<double>(std::numeric_limits<rl::detail::bitmap_channel_t<Depth>>::max());
+    }
+
+    template<rl::Bitmap::Depth SourceDepth, rl::Bitmap::Depth DestinationDepth>
+    void convert_channels(const rl::Bitmap::byte_t* source, rl::Bitmap::byte_t* destination, std::size_t channel_count) noexcept
+    {
+        rl::detail::convert_row<SourceDepth, rl::Bitmap::Color::G, DestinationDepth, rl::Bitmap::Color::G>(source, destination, channel_count);
+    }
+
+#if defined(RL_SIMD_X86)
+    template<rl::Bitmap::Depth SourceDepth>
+    RL_TARGET_SSSE3 __m128 divide_channels_ssse3(__m128i channels) noexcept
+    {
+        const __m128d channel_max = _mm_set1_pd(get_channel_max<SourceDepth>());
+        const __m128 low = _mm_cvtpd_ps(_mm_div_pd(_mm_cvtepi32_pd(channels), channel_max));
+        const __m128 high = _mm_cvtpd_ps(_mm_div_pd(_mm_cvtepi32_pd(_mm_unpackhi_epi64(channels, channels)), channel_max));
+        return _mm_movelh_ps(low, high);
+    }
+
+    template<rl::Bitmap::Depth DestinationDepth>
+    RL_TARGET_SSSE3 __m128i round_floats_ssse3(__m128 floats) noexcept
+    {
+        const __m128d channel_max = _mm_set1_pd(get_channel_max<DestinationDepth>());
+        const __m128d half = _mm_set1_pd(0.5);
+        const __m128 clamped = _mm_min_ps(_mm_max_ps(floats, _mm_setzero_ps()), _mm_set1_ps(1.0f));
+        const __m128i low = _mm_cvttpd_epi32(_mm_add_pd(_mm_mul_pd(_mm_cvtps_pd(clamped), channel_max), half));
+        const __m128i high = _mm_cvttpd_epi32(_mm_add_pd(_mm_mul_pd(_mm_cvtps_pd(_mm_movehl_ps(clamped, clamped)), channel_max), half));
+        return _mm_unpacklo_epi64(low, high);
+    }
+
+    template<rl::Bitmap::Depth DestinationDepth>
+    RL_TARGET_AVX2 __m128i round_floats_avx2(__m128 floats) noexcept
+    {
+        const __m128 clamped = _mm_min_ps(_mm_max_ps(floats, _mm_setzero_ps()), _mm_set1_ps(1.0f));
+        return
+            _mm256_cvttpd_epi32(
+                _mm256_add_pd(
+                    _mm256_mul_pd(_mm256_cvtps_pd(clamped), _mm256_set1_pd(get_channel_max<DestinationDepth>())),
+                    _mm256_set1_pd(0.5)
+                )
+            );
+    }
+
+    // packs sixteen rounded channels into octuple channels, or eight into sexdecuple channels
+    template<rl::Bitmap::Depth DestinationDepth>
+    RL_TARGET_SSSE3 __m128i pack_channels_ssse3(const __m128i* channels) noexcept
+    {
+        if constexpr (DestinationDepth == rl::Bitmap::Depth::Octuple)
+        {
+            return _mm_packus_epi16(_mm_packs_epi32(channels[0], channels[1]), _mm_packs_epi32(channels[2], channels[3]));
+        }
+        else
+        {
+            // there is no unsigned 32 bit pack before sse4.1, so the channels are packed signed around zero instead
+            const __m128i bias = _mm_set1_epi32(0x8000);
+            return
+                _mm_xor_si128(
+                    _mm_packs_epi32(_mm_sub_epi32(channels[0], bias), _mm_sub_epi32(channels[1], bias)),
+                    _mm_set1_epi16(std::numeric_limits<std::int16_t>::min())
+                );
+        }
+    }
+
+    template<rl::Bitmap::Depth SourceDepth, std::size_t ChannelCount>
+    RL_TARGET_SSSE3 void widen_integer_row_ssse3(const rl::Bitmap::byte_t* source, rl::Bitmap::byte_t* destination, std::size_t width) noexcept
+    {
+        using S = rl::detail::bitmap_channel_t<SourceDepth>;
+        constexpr std::size_t block_size = 16 / sizeof(S);
+        const __m128i zero = _mm_setzero_si128();
+        const std::size_t channel_count = width * ChannelCount;
+        std::size_t channel_i = 0;
+        for (; channel_i + block_size <= channel_count; channel_i += block_size)
+        {
+            const __m128i loaded = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + channel_i * sizeof(S)));
+            __m128i channels[block_size / 4];
+            if constexpr (SourceDepth == rl::Bitmap::Depth::Octuple)
+            {
+                const __m128i low = _mm_unpacklo_epi8(loaded, zero);
+                const __m128i high = _mm_unpackhi_epi8(loaded, zero);
+                channels[0] = _mm_unpacklo_epi16(low, zero);
+                channels[1] = _mm_unpackhi_epi16(low, zero);
+                channels[2] = _mm_unpacklo_epi16(high, zero);
+                channels[3] = _mm_unpackhi_epi16(high, zero);
+            }
+            else
+            {
+                channels[0] = _mm_unpacklo_epi16(loaded, zero);
+                channels[1] = _mm_unpackhi_epi16(loaded, zero);
+            }
+            for (std::size_t vector_i = 0; vector_i < block_size / 4; vector_i++)
+            {
+                _mm_storeu_ps(
+                    reinterpret_cast<float*>(destination + (channel_i + vector_i * 4) * sizeof(rl::Bitmap::normalized_t)),
+                    divide_channels_ssse3<SourceDepth>(channels[vector_i])
+                );
+            }
+        }
+        convert_channels<SourceDepth, rl::Bitmap::Depth::Normalized>(source + channel_i * sizeof(S), destination + channel_i * sizeof(rl::Bitmap::normalized_t), channel_count - channel_i);
+    }
+
+    template<std::size_t ChannelCount>
+    RL_TARGET_SSSE3 void narrow_sexdecuple_row_ssse3(const rl::Bitmap::byte_t* source, rl::Bitmap::byte_t* destination, std::size_t width) noexcept
+    {
+        const __m128i round = _mm_set1_epi16(0x80);
+        const std::size_t channel_count = width * ChannelCount;
+        std::size_t channel_i = 0;
+        for (; channel_i + 16 <= channel_count; channel_i += 16)
+        {
+            __m128i channels[2];
+            for (std::size_t vector_i = 0; vector_i < 2; vector_i++)
+            {
+                const __m128i rounded = _mm_adds_epu16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(source + (channel_i + vector_i * 8) * sizeof(rl::Bitmap::sexdecuple_t))), round);
+                channels[vector_i] = _mm_srli_epi16(_mm_sub_epi16(rounded, _mm_srli_epi16(rounded, 8)), 8);
+            }
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + channel_i), _mm_packus_epi16(channels[0], channels[1]));
+        }
+        convert_channels<rl::Bitmap::Depth::Sexdecuple, rl::Bitmap::Depth::Octuple>(source + channel_i * sizeof(rl::Bitmap::sexdecuple_t), destination + channel_i, channel_count - channel_i);
+    }
+
+    template<std::size_t ChannelCount>
+    RL_TARGET_AVX2 void narrow_sexdecuple_row_avx2(const rl::Bitmap::byte_t* source, rl::Bitmap::byte_t* destination, std::size_t width) noexcept
+    {
+        const __m256i round = _mm256_set1_epi16(0x80);
+        const std::size_t channel_count = width * ChannelCount;
+        std::size_t channel_i = 0;
+        for (; channel_i + 32 <= channel_count; channel_i += 32)
+        {
+            __m256i channels[2];
+            for (std::size_t vector_i = 0; vector_i < 2; vector_i++)
+            {
+                const __m256i rounded = _mm256_adds_epu16(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(source + (channel_i + vector_i * 16) * sizeof(rl::Bitmap::sexdecuple_t))), round);
+                channels[vector_i] = _mm256_srli_epi16(_mm256_sub_epi16(rounded, _mm256_srli_epi16(rounded, 8)), 8);
+            }
+            // packing works within 128 bit lanes, so the lanes are put back in order afterwards
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(destination + channel_i), _mm256_permute4x64_epi64(_mm256_packus_epi16(channels[0], channels[1]), 0xd8));
+        }
+        narrow_sexdecuple_row_ssse3<1>(source + channel_i * sizeof(rl::Bitmap::sexdecuple_t), destination + channel_i, channel_count - channel_i);
+    }
+
+    template<rl::Bitmap::Depth DestinationDepth, std::size_t ChannelCount>
+    RL_TARGET_SSSE3 void narrow_normalized_row_ssse3(const rl::Bitmap::byte_t* source, rl::Bitmap::byte_t* destination, std::size_t width) noexcept
+    {
+        using D = rl::detail::bitmap_channel_t<DestinationDepth>;
+        constexpr std::size_t block_size = 16 / sizeof(D);
+        const std::size_t channel_count = width * ChannelCount;
+        std::size_t channel_i = 0;
+        for (; channel_i + block_size <= channel_count; channel_i += block_size)
+        {
+            __m128i channels[block_size / 4];
+            for (std::size_t vector_i = 0; vector_i < block_size / 4; vector_i++)
+            {
+                channels[vector_i] = round_floats_ssse3<DestinationDepth>(_mm_loadu_ps(reinterpret_cast<const float*>(source + (channel_i + vector_i * 4) * sizeof(rl::Bitmap::normalized_t))));
+            }
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + channel_i * sizeof(D)), pack_channels_ssse3<DestinationDepth>(channels));
+        }
+        convert_channels<rl::Bitmap::Depth::Normalized, DestinationDepth>(source + channel_i * sizeof(rl::Bitmap::normalized_t), destination + channel_i * sizeof(D), channel_count - channel_i);
+    }
+
+    // half channels are widened to floats eight at a time first
+    template<rl::Bitmap::Depth SourceDepth, rl::Bitmap::Depth DestinationDepth, std::size_t ChannelCount>
+    RL_TARGET_F16C void narrow_float_row_avx2(const rl::Bitmap::byte_t* source, rl::Bitmap::byte_t* destination, std::size_t width) noexcept
+    {
+        constexpr std::size_t source_channel_size = rl::Bitmap::GetChannelSize(SourceDepth);
+        using D = rl::detail::bitmap_channel_t<DestinationDepth>;
+        constexpr std::size_t block_size = 16 / sizeof(D);
+        const std::size_t channel_count = width * ChannelCount;
+        std::size_t channel_i = 0;
+        for (; channel_i + block_size <= channel_count; channel_i += block_size)
+        {
+            __m128i channels[block_size / 4];
+            for (std::size_t vector_i = 0; vector_i < block_size / 8; vector_i++)
+            {
+                const auto* vector_source = source + (channel_i + vector_i * 8) * source_channel_size;
+                __m256 floats;
+                if constexpr (SourceDepth == rl::Bitmap::Depth::Half)
+                {
+                    floats = _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(vector_source)));
+                }
+                else
+                {
+                    floats = _mm256_loadu_ps(reinterpret_cast<const float*>(vector_source));
+                }
+                channels[vector_i * 2] = round_floats_avx2<DestinationDepth>(_mm256_castps256_ps128(floats));
+                channels[vector_i * 2 + 1] = round_floats_avx2<DestinationDepth>(_mm256_extractf128_ps(floats, 1));
+            }
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + channel_i * sizeof(D)), pack_channels_ssse3<DestinationDepth>(channels));
+        }
+        convert_channels<SourceDepth, DestinationDepth>(source + channel_i * source_channel_size, destination + channel_i * sizeof(D), channel_count - channel_i);
+    }
+#endif
+
+#if defined(RL_SIMD_NEON)
+    template<rl::Bitmap::Depth SourceDepth>
+    float32x4_t divide_channels_neon(uint32x4_t channels) noexcept
+    {
+        const float64x2_t channel_max = vdupq_n_f64(get_channel_max<SourceDepth>());
+        const float32x2_t low = vcvt_f32_f64(vdivq_f64(vcvtq_f64_u64(vmovl_u32(vget_low_u32(channels))), channel_max));
+        const float32x2_t high = vcvt_f32_f64(vdivq_f64(vcvtq_f64_u64(vmovl_high_u32(channels)), channel_max));
+        return vcombine_f32(low, high);
+    }
+
+    template<rl::Bitmap::Depth DestinationDepth>
+    uint32x4_t round_floats_neon(float32x4_t floats) noexcept
+    {
+        const float64x2_t channel_max = vdupq_n_f64(get_channel_max<DestinationDepth>());
+        const float64x2_t half = vdupq_n_f64(0.5);
+        const float32x4_t clamped = vminq_f32(vmaxq_f32(floats, vdupq_n_f32(0.0f)), vdupq_n_f32(1.0f));
+        const uint64x2_t low = vcvtq_u64_f64(vaddq_f64(vmulq_f64(vcvt_f64_f32(vget_low_f32(clamped)), channel_max), half));
+        const uint64x2_t high = vcvtq_u64_f64(vaddq_f64(vmulq_f64(vcvt_high_f64_f32(clamped), channel_max), half));
+        return vcombine_u32(vqmovn_u64(low), vqmovn_u64(high));
+    }
+
+    template<rl::Bitmap::Depth SourceDepth, std::size_t ChannelCount>
+    void widen_integer_row_neon(const rl::Bitmap::byte_t* source, rl::Bitmap::byte_t* destination, std::size_t width) noexcept
+    {
+        using S = rl::detail::bitmap_channel_t<SourceDepth>;
+        constexpr std::size_t block_size = 16 / sizeof(S);
+        const std::size_t channel_count = width * ChannelCount;
+        std::size_t channel_i = 0;
+        for (; channel_i + block_size <= channel_count; channel_i += block_size)
+        {
+            uint32x4_t channels[block_size / 4];
+            if constexpr (SourceDepth == rl::Bitmap::Depth::Octuple)
+            {
+                const uint8x16_t loaded = vld1q_u8(reinterpret_cast<const std::uint8_t*>(source + channel_i));
+                const uint16x8_t low = vmovl_u8(vget_low_u8(loaded));
+                const uint16x8_t high = vmovl_high_u8(loaded);
+                channels[0] = vmovl_u16(vget_low_u16(low));
+                channels[1] = vmovl_high_u16(low);
+                channels[2] = vmovl_u16(vget_low_u16(high));
+                channels[3] = vmovl_high_u16(high);
+            }
+            else
+            {
+                const uint16x8_t loaded = vld1q_u16(reinterpret_cast<const std::uint16_t*>(source + channel_i * sizeof(S)));
+                channels[0] = vmovl_u16(vget_low_u16(loaded));
+                channels[1] = vmovl_high_u16(loaded);
+            }
+            for (std::size_t vector_i = 0; vector_i < block_size / 4; vector_i++)
+            {
+                vst1q_f32(
+                    reinterpret_cast<float*>(destination + (channel_i + vector_i * 4) * sizeof(rl::Bitmap::normalized_t)),
+                    divide_channels_neon<SourceDepth>(channels[vector_i])
+                );
+            }
+        }
+        convert_channels<SourceDepth, rl::Bitmap::Depth::Normalized>(source + channel_i * sizeof(S), destination + channel_i * sizeof(rl::Bitmap::normalized_t), channel_count - channel_i);
+    }
+
+    template<std::size_t ChannelCount>
+    void narrow_sexdecuple_row_neon(const rl::Bitmap::byte_t* source, rl::Bitmap::byte_t* destination, std::size_t width) noexcept
+    {
+        const uint16x8_t round = vdupq_n_u16(0x80);
+        const std::size_t channel_count = width * ChannelCount;
+        std::size_t channel_i = 0;
+        for (; channel_i + 16 <= channel_count; channel_i += 16)
+        {
+            uint8x8_t channels[2];
+            for (std::size_t vector_i = 0; vector_i < 2; vector_i++)
+            {
+                const uint16x8_t rounded = vqaddq_u16(vld1q_u16(reinterpret_cast<const std::uint16_t*>(source + (channel_i + vector_i * 8) * sizeof(rl::Bitmap::sexdecuple_t))), round);
+                channels[vector_i] = vqmovn_u16(vshrq_n_u16(vsubq_u16(rounded, vshrq_n_u16(rounded, 8)), 8));
+            }
+            vst1q_u8(reinterpret_cast<std::uint8_t*>(destination + channel_i), vcombine_u8(channels[0], channels[1]));
+        }
+        convert_channels<rl::Bitmap::Depth::Sexdecuple, rl::Bitmap::Depth::Octuple>(source + channel_i * sizeof(rl::Bitmap::sexdecuple_t), destination + channel_i, channel_count - channel_i);
+    }
+
+    template<rl::Bitmap::Depth SourceDepth, rl::Bitmap::Depth DestinationDepth, std::size_t ChannelCount>
+    void narrow_float_row_neon(const rl::Bitmap::byte_t* source, rl::Bitmap::byte_t* destination, std::size_t width) noexcept
+    {
+        constexpr std::size_t source_channel_size = rl::Bitmap::GetChannelSize(SourceDepth);
+        using D = rl::detail::bitmap_channel_t<DestinationDepth>;
+        constexpr std::size_t block_size = 16 / sizeof(D);
+        const std::size_t channel_count = width * ChannelCount;
+        std::size_t channel_i = 0;
+        for (; channel_i + block_size <= channel_count; channel_i += block_size)
+        {
+            uint16x4_t channels[block_size / 4];
+            for (std::size_t vector_i = 0; vector_i < block_size / 4; vector_i++)
+            {
+                const auto* vector_source = source + (channel_i + vector_i * 4) * source_channel_size;
+                float32x4_t floats;
+                if constexpr (SourceDepth == rl::Bitmap::Depth::Half)
+                {
+                    floats = vcvt_f32_f16(vreinterpret_f16_u16(vld1_u16(reinterpret_cast<const std::uint16_t*>(vector_source))));
+                }
+                else
+                {
+                    floats = vld1q_f32(reinterpret_cast<const float*>(vector_source));
+                }
+                channels[vector_i] = vqmovn_u32(round_floats_neon<DestinationDepth>(floats));
+            }
+            auto* block = destination + channel_i * sizeof(D);
+            if constexpr (DestinationDepth == rl::Bitmap::Depth::Octuple)
+            {
+                vst1q_u8(
+                    reinterpret_cast<std::uint8_t*>(block),
+                    vcombine_u8(vqmovn_u16(vcombine_u16(channels[0], channels[1])), vqmovn_u16(vcombine_u16(channels[2], channels[3])))
+                );
+            }
+            else
+            {
+                vst1q_u16(reinterpret_cast<std::uint16_t*>(block), vcombine_u16(channels[0], channels[1]));
+            }
+        }
+        convert_channels<SourceDepth, DestinationDepth>(source + channel_i * source_channel_size, destination + channel_i * sizeof(D), channel_count - channel_i);
+    }
+#endif
+
+    template<rl::SimdLevel Level, rl::Bitmap::Depth SourceDepth, rl::Bitmap::Depth DestinationDepth, rl::Bitmap::Color Color>
+    constexpr rl::Bitmap::row_converter_t get_arithmetic_converter() noexcept
+    {
+        constexpr std::size_t channel_count = rl::Bitmap::GetChannelCount(Color);
+        constexpr bool is_integer_widening = DestinationDepth == rl::Bitmap::Depth::Normalized;
+        constexpr bool is_sexdecuple_narrowing = SourceDepth == rl::Bitmap::Depth::Sexdecuple;
+        if constexpr (!get_is_arithmetic_conversion(SourceDepth, Color, DestinationDepth, Color))
+        {
+            return nullptr;
+        }
+#if defined(RL_SIMD_X86)
+        else if constexpr (Level == rl::SimdLevel::Ssse3)
+        {
+            if constexpr (is_integer_widening)
+            {
+                return &widen_integer_row_ssse3<SourceDepth, channel_count>;
+            }
+            else if constexpr (is_sexdecuple_narrowing)
+            {
+                return &narrow_sexdecuple_row_ssse3<channel_count>;
+            }
+            else if constexpr (SourceDepth == rl::Bitmap::Depth::Normalized)
+            {
+                return &narrow_normalized_row_ssse3<DestinationDepth, channel_count>;
+            }
+            else
+            {
+                // half channels need f16c to widen
+                return nullptr;
+            }
+        }
+        else if constexpr (Level == rl::SimdLevel::Avx2)
+        {
+            if constexpr (is_integer_widening)
+            {
+                // the integer channels are gathered from the normalized tables instead
+                return nullptr;
+            }
+            else if constexpr (is_sexdecuple_narrowing)
+            {
+                return &narrow_sexdecuple_row_avx2<channel_count>;
+            }
+            else
+            {
+                return &narrow_float_row_avx2<SourceDepth, DestinationDepth, channel_count>;
+            }
+        }
+#endif
+#if defined(RL_SIMD_NEON)
+        else if constexpr (Level == rl::SimdLevel::Neon)
+        {
+            if constexpr (is_integer_widening)
+            {
+                return &widen_integer_row_neon<SourceDepth, channel_count>;
+            }
+            else if constexpr (is_sexdecuple_narrowing)
+            {
+                return &narrow_sexdecuple_row_neon<channel_count>;
+            }
+            else
+            {
+                return &narrow_float_row_neon<SourceDepth, DestinationDepth, channel_count>;
+            }
+        }
+#endif
+        else
+        {
+            return nullptr;
+        }
+    }
+
+    // indexed by source depth index * 16 + destination depth index * 4 + color
+    template<rl::SimdLevel Level, std::size_t... ConverterIs>
+    constexpr std::array<rl::Bitmap::row_converter_t, sizeof...(ConverterIs)> make_arithmetic_converters(std::index_sequence<ConverterIs...>) noexcept
+    {
+        return {
+            get_arithmetic_converter<
+                Level,
+                rl::detail::bitmap_depths[ConverterIs / 16],
+                rl::detail::bitmap_depths[(ConverterIs / 4) % 4],
+                static_cast<rl::Bitmap::Color>(ConverterIs % 4)
+            >()...
+        };
+    }
+
+    rl::Bitmap::row_converter_t get_arithmetic_converter(rl::SimdLevel level, rl::Bitmap::Depth source_depth, rl::Bitmap::Depth destination_depth, rl::Bitmap::Color color) noexcept
+    {
+        if (!get_is_arithmetic_conversion(source_depth, color, destination_depth, color))
+        {
+            return nullptr;
+        }
+        const std::size_t converter_i =
+            rl::detail::get_bitmap_depth_index(source_depth) * 16 +
+            rl::detail::get_bitmap_depth_index(destination_depth) * 4 +
+            static_cast<std::size_t>(color);
+        switch (level)
+        {
+#if defined(RL_SIMD_X86)
+            case rl::SimdLevel::Ssse3:
+            {
+                static constexpr auto converters = make_arithmetic_converters<rl::SimdLevel::Ssse3>(std::make_index_sequence<64>());
+                return converters[converter_i];
+            }
+            case rl::SimdLevel::Avx2:
+            {
+                static constexpr auto converters = make_arithmetic_converters<rl::SimdLevel::Avx2>(std::make_index_sequence<64>());
+                return converters[converter_i];
+            }
+#endif
+#if defined(RL_SIMD_NEON)
+            case rl::SimdLevel::Neon:
+            {
+                static constexpr auto converters = make_arithmetic_converters<rl::SimdLevel::Neon>(std::make_index_sequence<64>());
+                return converters[converter_i];
+            }
+#endif
+            default:
+                return nullptr;
+        }
+    }
+}
+
+namespace
+{
+    template<rl::Bitmap::Depth Depth>
+    std::vector<rl::Bitmap::normalized_t> make_normalized_table(bool is_linear)
+    {
+        using channel_t = rl::detail::bitmap_channel_t<Depth>;
+        std::vector<rl::Bitmap::normalized_t> table(static_cast<std::size_t>(std::numeric_limits<channel_t>::max()) + 1);
+        for (std::size_t value_i = 0; value_i < table.size(); value_i++)
+        {
+            // each value goes through the scalar converter, so a table lookup gives the same float as converting
+            const auto channel = static_cast<channel_t>(value_i);
+            rl::Bitmap::normalized_t value;
+            rl::detail::convert_row<Depth, rl::Bitmap::Color::G, rl::Bitmap::Depth::Normalized, rl::Bitmap::Color::G>(
+                reinterpret_cast<const rl::Bitmap::byte_t*>(&channel),
+                reinterpret_cast<rl::Bitmap::byte_t*>(&value),
+                1
+            );
+            if (is_linear)
+            {
+                const double srgb = value;
+                value = static_cast<rl::Bitmap::normalized_t>((srgb <= 0.04045) ? srgb / 12.92 : std::pow((srgb + 0.055) / 1.055, 2.4));
+            }
+            table[value_i] = value;
+        }
+        return table;
+    }
+}
+
+std::span<const rl::Bitmap::normalized_t> rl::Bitmap::GetNormalizedTable(rl::Bitmap::Depth depth, bool is_linear) noexcept
+{
+    switch (depth)
+    {
+        case rl::Bitmap::Depth::Octuple:
+        {
+            static const auto table = make_normalized_table<rl::Bitmap::Depth::Octuple>(false);
+            static const auto linear_table = make_normalized_table<rl::Bitmap::Depth::Octuple>(true);
+            return is_linear ? linear_table : table;
+        }
+        case rl::Bitmap::Depth::Sexdecuple:
+        {
+            // the linear table is only built if it is used
+            if (is_linear)
+            {
+                static const auto linear_table = make_normalized_table<rl::Bitmap::Depth::Sexdecuple>(true);
+                return linear_table;
+            }
+            static const auto table = make_normalized_table<rl::Bitmap::Depth::Sexdecuple>(false);
+            return table;
+        }
+        default:
+            return {};
+    }
+}
+
+namespace
+{
+    // integer channels widen to floats by looking up their value in the normalized tables. only the conversions that
+    // move channels around use the tables, since they convert each channel on its own.
+    constexpr bool get_is_table_conversion(rl::Bitmap::Depth source_depth, rl::Bitmap::Color source_color, rl::Bitmap::Depth destination_depth, rl::Bitmap::Color destination_color) noexcept
+    {
+        return
+            (source_depth == rl::Bitmap::Depth::Octuple || source_depth == rl::Bitmap::Depth::Sexdecuple) &&
+            (destination_depth == rl::Bitmap::Depth::Normalized || destination_depth == rl::Bitmap::Depth::Half) &&
+            source_color != rl::Bitmap::Color::Indexed &&
+            destination_color != rl::Bitmap::Color::Indexed &&
+            (source_color == destination_color || get_is_shuffle(source_color, destination_color));
+    }
+
+    // linear rows decode their colors through the linear tables, and look their alpha up in the plain tables
+    template<rl::Bitmap::Depth SourceDepth, rl::Bitmap::Color SourceColor, rl::Bitmap::Depth DestinationDepth, rl::Bitmap::Color DestinationColor, bool IsLinear>
+    void convert_table_row(const rl::Bitmap::byte_t* source, rl::Bitmap::byte_t* destination, std::size_t width) noexcept
+    {
+        using S = rl::detail::bitmap_channel_t<SourceDepth>;
+        constexpr auto source_channel_count = rl::Bitmap::GetChannelCount(SourceColor);
+        constexpr auto destination_channel_count = rl::Bitmap::GetChannelCount(DestinationColor);
+        constexpr auto source_pixel_size = rl::Bitmap::GetPixelSize(SourceDepth, SourceColor);
+        constexpr auto destination_pixel_size = rl::Bitmap::GetPixelSize(DestinationDepth, DestinationColor);
+        constexpr auto channel_map = get_channel_map(SourceColor, DestinationColor);
+        // the channel map holds ints so it can hold fill_alpha, so the alpha index is an int too
+        constexpr int source_alpha_i =
+            (SourceColor == rl::Bitmap::Color::Ga || SourceColor == rl::Bitmap::Color::Rgba) ?
+                static_cast<int>(source_channel_count) - 1 :
+                static_cast<int>(source_channel_count);
+        const auto* table = rl::Bitmap::GetNormalizedTable(SourceDepth).data();
+        const auto* color_table = rl::Bitmap::GetNormalizedTable(SourceDepth, IsLinear).data();
+        auto convert_pixel = [&](std::size_t x)
+        {
+            std::array<S, source_channel_count> source_channels;
+            std::memcpy(source_channels.data(), source + x * source_pixel_size, source_pixel_size);
+            std::array<rl::Bitmap::normalized_t, destination_channel_count> destination_channels;
+            for (std::size_t channel_i = 0; channel_i < destination_channel_count; channel_i++)
+            {
+                const int source_channel_i = channel_map[channel_i];
+                destination_channels[channel_i] =
+                    (source_channel_i == fill_alpha) ?
+                        1.0f :
+                        ((source_channel_i == source_alpha_i) ? table : color_table)[source_channels[source_channel_i]];
+            }
+            rl::detail::store_channels<DestinationDepth>(destination_channels.data(), destination + x * destination_pixel_size, destination_channel_count);
+        };
+        // in place conversions go in reverse when the pixels grow, like the scalar converters
+        if constexpr (source_pixel_size >= destination_pixel_size)
+        {
+            for (std::size_t x = 0; x < width; x++)
+            {
+                convert_pixel(x);
+            }
+        }
+        else
+        {
+            for (std::size_t x = width; x > 0; x--)
+            {
+                convert_pixel(x - 1);
+            }
+        }
+    }
+
+    // indexed by linear * 64 + source depth * 32 + destination depth * 16 + source color * 4 + destination color, where
+    // the depths are 0 for octuple and normalized and 1 for sexdecuple and half
+    template<std::size_t ConverterI>
+    constexpr rl::Bitmap::row_converter_t get_table_converter() noexcept
+    {
+        constexpr bool is_linear = ConverterI / 64 == 1;
+        constexpr auto source_depth = ((ConverterI / 32) % 2 == 0) ? rl::Bitmap::Depth::Octuple : rl::Bitmap::Depth::Sexdecuple;
+        constexpr auto destination_depth = ((ConverterI / 16) % 2 == 0) ? rl::Bitmap::Depth::Normalized : rl::Bitmap::Depth::Half;
+        constexpr auto source_color = static_cast<rl::Bitmap::Color>((ConverterI / 4) % 4);
+        constexpr auto destination_color = static_cast<rl::Bitmap::Color>(ConverterI % 4);
+        if constexpr (!get_is_table_conversion(source_depth, source_color, destination_depth, destination_color))
+        {
+            return nullptr;
+        }
+        else
+        {
+            return &convert_table_row<source_depth, source_color, destination_depth, destination_color, is_linear>;
+        }
+    }
+
+    template<std::size_t... ConverterIs>
+    constexpr std::array<rl::Bitmap::row_converter_t, sizeof...(ConverterIs)> make_table_converters(std::index_sequence<ConverterIs...>) noexcept
+    {
+        return { get_table_converter<ConverterIs>()... };
+    }
+
+    rl::Bitmap::row_converter_t get_table_converter(rl::Bitmap::Depth source_depth, rl::Bitmap::Color source_color, rl::Bitmap::Depth destination_depth, rl::Bitmap::Color destination_color, bool is_linear = false) noexcept
+    {
+        static constexpr auto table_converters = make_table_converters(std::make_index_sequence<128>());
+        if (!get_is_table_conversion(source_depth, source_color, destination_depth, destination_color))
+        {
+            return nullptr;
+        }
+        return
+            table_converters[
+                (is_linear ? 64 : 0) +
+                (source_depth == rl::Bitmap::Depth::Sexdecuple ? 32 : 0) +
+                (destination_depth == rl::Bitmap::Depth::Half ? 16 : 0) +
+                static_cast<std::size_t>(source_color) * 4 +
+                static_cast<std::size_t>(destination_color)
+            ];
+    }
+
+#if defined(RL_SIMD_X86)
+    // rows of the same color gather eight channels at a time from the table
+    template<rl::Bitmap::Depth SourceDepth, std::size_t ChannelCount>
+    RL_TARGET_AVX2 void gather_normalized_row_avx2(const rl::Bitmap::byte_t* source, rl::Bitmap::byte_t* destination, std::size_t width) noexcept
+    {
+        using S = rl::detail::bitmap_channel_t<SourceDepth>;
+        const auto* table = rl::Bitmap::GetNormalizedTable(SourceDepth).data();
+        const std::size_t channel_count = width * ChannelCount;
+        std::size_t channel_i = 0;
+        for (; channel_i + 8 <= channel_count; channel_i += 8)
+        {
+            __m256i indexes;
+            if constexpr (SourceDepth == rl::Bitmap::Depth::Octuple)
+            {
+                indexes = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(source + channel_i)));
+            }
+            else
+            {
+                indexes = _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(source + channel_i * sizeof(S))));
+            }
+            _mm256_storeu_ps(reinterpret_cast<float*>(destination + channel_i * sizeof(rl::Bitmap::normalized_t)), _mm256_i32gather_ps(table, indexes, 4));
+        }
+        for (; channel_i < channel_count; channel_i++)
+        {
+            S channel;
+            std::memcpy(&channel, source + channel_i * sizeof(S), sizeof(S));
+            std::memcpy(destination + channel_i * sizeof(rl::Bitmap::normalized_t), &table[channel], sizeof(rl::Bitmap::normalized_t));
+        }
+    }
+
+    template<rl::Bitmap::Depth SourceDepth>
+    rl::Bitmap::row_converter_t get_gather_converter(rl::Bitmap::Color color) noexcept
+    {
+        switch (color)
+        {
+            case rl::Bitmap::Color::G:
+                return &gather_normalized_row_avx2<SourceDepth, 1>;
+            case rl::Bitmap::Color::Ga:
+                return &gather_normalized_row_avx2<SourceDepth, 2>;
+            case rl::Bitmap::Color::Rgb:
+                return &gather_normalized_row_avx2<SourceDepth, 3>;
+            case rl::Bitmap::Color::Rgba:
+                return &gather_normalized_row_avx2<SourceDepth, 4>;
+            default:
+                return nullptr;
+        }
+    }
+#endif
+
+    rl::Bitmap::row_converter_t get_gather_converter(rl::SimdLevel level, rl::Bitmap::Depth source_depth, rl::Bitmap::Color source_color, rl::Bitmap::Depth destination_depth, rl::Bitmap::Color destination_color) noexcept
+    {
+#if defined(RL_SIMD_X86)
+        if (
+            level == rl::SimdLevel::Avx2 &&
+            destination_depth == rl::Bitmap::Depth::Normalized &&
+            source_color == destination_color &&
+            get_is_table_conversion(source_depth, source_color, destination_depth, destination_color)
+        )
+        {
+            return
+                (source_depth == rl::Bitmap::Depth::Octuple) ?
+                    get_gather_converter<rl::Bitmap::Depth::Octuple>(source_color) :
+                    get_gather_converter<rl::Bitmap::Depth::Sexdecuple>(source_color);
+        }
+#endif
+        return nullptr;
+    }
+}
+
+namespace
+{
+    // rgb rows of whole byte integer or float channels turn gray four pixels at a time, with the same float math as
+    // rl::detail::to_gray. the stores only write the converted pixels, so the kernels can shrink rows in place.
+    constexpr bool get_is_gray_conversion(rl::Bitmap::Depth source_depth, rl::Bitmap::Color source_color, rl::Bitmap::Depth destination_depth, rl::Bitmap::Color destination_color) noexcept
+    {
+        return
+            source_depth == destination_depth &&
+            (
+                source_depth == rl::Bitmap::Depth::Octuple ||
+                source_depth == rl::Bitmap::Depth::Sexdecuple ||
+                source_depth == rl::Bitmap::Depth::Normalized
+            ) &&
+            (source_color == rl::Bitmap::Color::Rgb || source_color == rl::Bitmap::Color::Rgba) &&
+            (destination_color == rl::Bitmap::Color::G || destination_color == rl::Bitmap::Color::Ga);
+    }
+
+#if defined(RL_SIMD_X86)
+    template<rl::Bitmap::Depth Depth, rl::Bitmap::Color SourceColor, rl::Bitmap::Color DestinationColor>
+    struct gray_kernel
+    {
+        static constexpr std::size_t channel_size = rl::Bitmap::GetChannelSize(Depth);
+        static constexpr std::size_t source_pixel_size = rl::Bitmap::GetPixelSize(Depth, SourceColor);
+        static constexpr std::size_t destination_pixel_size = rl::Bitmap::GetPixelSize(Depth, DestinationColor);
+        static constexpr bool is_float = Depth == rl::Bitmap::Depth::Normalized;
+        // the four pixels of a block are loaded by one, two or four 16 byte loads
+        static constexpr std::size_t load_width = std::min<std::size_t>(4, 16 / source_pixel_size);
+        static constexpr std::size_t load_count = 4 / load_width;
+        // bytes a block reads from the start of its first pixel
+        static constexpr std::size_t read_size = (4 - load_width) * source_pixel_size + 16;
+        static constexpr std::size_t store_size = 4 * destination_pixel_size;
+
+        // picks a channel of the pixels of one load into the 32 bit lanes of those pixels, zero extended
+        static constexpr std::array<std::uint8_t, 16> get_channel_mask(std::size_t channel_i, std::size_t load_i) noexcept
+        {
+            std::array<std::uint8_t, 16> mask;
+            mask.fill(0x80);
+            for (std::size_t lane_i = load_i * load_width; lane_i < load_i * load_width + load_width; lane_i++)
+            {
+                for (std::size_t byte_i = 0; byte_i < channel_size; byte_i++)
+                {
+                    mask[lane_i * 4 + byte_i] = static_cast<std::uint8_t>((lane_i % load_width) * source_pixel_size + channel_i * channel_size + byte_i);
+                }
+            }
+            return mask;
+        }
+
+        // picks the gray or alpha lanes into the bytes of one 16 byte store of the destination pixels
+        static constexpr std::array<std::uint8_t, 16> get_store_mask(std::size_t channel_i, std::size_t store_i) noexcept
+        {
+            std::array<std::uint8_t, 16> mask;
+            mask.fill(0x80);
+            for (std::size_t byte_i = 0; byte_i < 16 && store_i * 16 + byte_i < store_size; byte_i++)
+            {
+                const std::size_t destination_byte_i = store_i * 16 + byte_i;
+                if ((destination_byte_i % destination_pixel_size) / channel_size == channel_i)
+                {
+                    mask[byte_i] = static_cast<std::uint8_t>((destination_byte_i / destination_pixel_size) * 4 + destination_byte_i % channel_size);
+                }
+            }
+            return mask;
+        }
+
+        static constexpr std::array<std::array<std::array<std::uint8_t, 16>, load_count>, 4> get_channel_masks() noexcept
+        {
+            std::array<std::array<std::array<std::uint8_t, 16>, load_count>, 4> masks;
+            for (std::size_t channel_i = 0; channel_i < 4; channel_i++)
+            {
+                for (std::size_t load_i = 0; load_i < load_count; load_i++)
+                {
+                    masks[channel_i][load_i] = get_channel_mask(channel_i, load_i);
+                }
+            }
+            return masks;
+        }
+
+        static constexpr std::array<std::array<std::array<std::uint8_t, 16>, 2>, 2> get_store_masks() noexcept
+        {
+            std::array<std::array<std::array<std::uint8_t, 16>, 2>, 2> masks;
+            for (std::size_t channel_i = 0; channel_i < 2; channel_i++)
+            {
+                for (std::size_t store_i = 0; store_i < 2; store_i++)
+                {
+                    masks[channel_i][store_i] = get_store_mask(channel_i, store_i);
+                }
+            }
+            return masks;
+        }
+
+        static constexpr auto channel_masks = get_channel_masks();
+        static constexpr auto store_masks = get_store_masks();
+
+        RL_TARGET_SSSE3 static __m128i load_channel(const __m128i* pixels, std::size_t channel_i) noexcept
+        {
+            __m128i lanes = _mm_setzero_si128();
+            for (std::size_t load_i = 0; load_i < load_count; load_i++)
+            {
+                const __m128i mask = _mm_loadu_si128(reinterpret_cast<const __m128i*>(channel_masks[channel_i][load_i].data()));
+                lanes = _mm_or_si128(lanes, _mm_shuffle_epi8(pixels[load_i], mask));
+            }
+            return lanes;
+        }
+
+        RL_TARGET_SSSE3 static __m128 to_floats(__m128i lanes) noexcept
+        {
+            return is_float ? _mm_castsi128_ps(lanes) : _mm_cvtepi32_ps(lanes);
+        }
+
+        RL_TARGET_SSSE3 static void convert_ssse3(const rl::Bitmap::byte_t* source, rl::Bitmap::byte_t* destination, std::size_t width, const rl::gray_mode& gray) noexcept
+        {
+            const auto weights = rl::get_gray_weights(gray);
+            const bool is_max = gray.gray == rl::Gray::Max;
+            const __m128 r_weight = _mm_set1_ps(weights.r);
+            const __m128 g_weight = _mm_set1_ps(weights.g);
+            const __m128 b_weight = _mm_set1_ps(weights.b);
+            const __m128 max_channel = _mm_set1_ps(static_cast<float>((Depth == rl::Bitmap::Depth::Octuple) ? 0xff : 0xffff));
+            const __m128i opaque_alpha =
+                is_float ?
+                    _mm_castps_si128(_mm_set1_ps(1.0f)) :
+                    _mm_set1_epi32((Depth == rl::Bitmap::Depth::Octuple) ? 0xff : 0xffff);
+            std::size_t pixel_i = 0;
+            for (; pixel_i + 4 <= width && pixel_i * source_pixel_size + read_size <= width * source_pixel_size; pixel_i += 4)
+            {
+                __m128i pixels[load_count];
+                for (std::size_t load_i = 0; load_i < load_count; load_i++)
+                {
+                    pixels[load_i] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + (pixel_i + load_i * load_width) * source_pixel_size));
+                }
+                const __m128 r = to_floats(load_channel(pixels, 0));
+                const __m128 g = to_floats(load_channel(pixels, 1));
+                const __m128 b = to_floats(load_channel(pixels, 2));
+                const __m128 value =
+                    is_max ?
+                        _mm_max_ps(_mm_max_ps(r, g), b) :
+                        _mm_add_ps(_mm_add_ps(_mm_mul_ps(r, r_weight), _mm_mul_ps(g, g_weight)), _mm_mul_ps(b, b_weight));
+                const __m128i gray_lanes =
+                    is_float ?
+                        _mm_castps_si128(value) :
+                        _mm_cvttps_epi32(_mm_min_ps(_mm_max_ps(_mm_add_ps(value, _mm_set1_ps(0.5f)), _mm_setzero_ps()), max_channel));
+                const __m128i alpha_lanes = (SourceColor == rl::Bitmap::Color::Rgba) ? load_channel(pixels, 3) : opaque_alpha;
+                auto* block = destination + pixel_i * destination_pixel_size;
+                for (std::size_t store_i = 0; store_i * 16 < store_size; store_i++)
+                {
+                    __m128i stored = _mm_shuffle_epi8(gray_lanes, _mm_loadu_si128(reinterpret_cast<const __m128i*>(store_masks[0][store_i].data())));
+                    if constexpr (DestinationColor == rl::Bitmap::Color::Ga)
+                    {
+                        stored = _mm_or_si128(stored, _mm_shuffle_epi8(alpha_lanes, _mm_loadu_si128(reinterpret_cast<const __m128i*>(store_masks[1][store_i].data()))));
+                    }
+                    if constexpr (store_size == 4)
+                    {
+                        const std::int32_t bytes = _mm_cvtsi128_si32(stored);
+                        std::memcpy(block, &bytes, 4);
+                    }
+                    else if constexpr (store_size == 8)
+                    {
+                        _mm_storel_epi64(reinterpret_cast<__m128i*>(block), stored);
+                    }
+                    else
+                    {
+                        _mm_storeu_si128(reinterpret_cast<__m128i*>(block + store_i * 16), stored);
+                    }
+                }
+            }
+            rl::detail::convert_gray_row<Depth, SourceColor, DestinationColor>(source + pixel_i * source_pixel_size, destination + pixel_i * destination_pixel_size, width - pixel_i, gray);
+        }
+    };
+
+    // indexed by depth * 4 + source color is rgba * 2 + destination color is ga, for octuple, sexdecuple and normalized
+    template<std::size_t ConverterI>
+    constexpr rl::Bitmap::gray_converter_t get_gray_converter() noexcept
+    {
+        constexpr auto depth = static_cast<rl::Bitmap::Depth>(ConverterI / 4);
+        constexpr auto source_color = ((ConverterI / 2) % 2 == 0) ? rl::Bitmap::Color::Rgb : rl::Bitmap::Color::Rgba;
+        constexpr auto destination_color = (ConverterI % 2 == 0) ? rl::Bitmap::Color::G : rl::Bitmap::Color::Ga;
+        return &gray_kernel<depth, source_color, destination_color>::convert_ssse3;
+    }
+
+    template<std::size_t... ConverterIs>
+    constexpr std::array<rl::Bitmap::gray_converter_t, sizeof...(ConverterIs)> make_gray_converters(std::index_sequence<ConverterIs...>) noexcept
+    {
+        return { get_gray_converter<ConverterIs>()... };
+    }
+#endif
+}
+
+rl::Bitmap::gray_converter_t rl::Bitmap::GetGrayConverter(rl::SimdLevel level, rl::Bitmap::Depth depth, rl::Bitmap::Color source_color, rl::Bitmap::Color destination_color) noexcept
+{
+    if (!get_is_gray_conversion(depth, source_color, depth, destination_color) || !rl::get_is_simd_level_supported(level))
+    {
+        return nullptr;
+    }
+#if defined(RL_SIMD_X86)
+    static constexpr auto gray_converters = make_gray_converters(std::make_index_sequence<12>());
+    if (level == rl::SimdLevel::Ssse3 || level == rl::SimdLevel::Avx2)
+    {
+        return
+            gray_converters[
+                static_cast<std::size_t>(depth) * 4 +
+                (source_color == rl::Bitmap::Color::Rgba ? 2 : 0) +
+                (destination_color == rl::Bitmap::Color::Ga ? 1 : 0)
+            ];
+    }
+#endif
+    return nullptr;
+}
+
+namespace
+{
+#if defined(RL_SIMD_X86)
+    // row converters are not given a gray mode, so their rgb rows turn gray with rl::Gray::Default like the scalar ones
+    template<rl::Bitmap::Depth Depth, rl::Bitmap::Color SourceColor, rl::Bitmap::Color DestinationColor>
+    void convert_default_gray_row(const rl::Bitmap::byte_t* source, rl::Bitmap::byte_t* destination, std::size_t width) noexcept
+    {
+        gray_kernel<Depth, SourceColor, DestinationColor>::convert_ssse3(source, destination, width, rl::gray_mode());
+    }
+
+    // indexed like the gray converters
+    template<std::size_t ConverterI>
+    constexpr rl::Bitmap::row_converter_t get_default_gray_converter() noexcept
+    {
+        return
+            &convert_default_gray_row<
+                static_cast<rl::Bitmap::Depth>(ConverterI / 4),
+                ((ConverterI / 2) % 2 == 0) ? rl::Bitmap::Color::Rgb : rl::Bitmap::Color::Rgba,
+                (ConverterI % 2 == 0) ? rl::Bitmap::Color::G : rl::Bitmap::Color::Ga
+            >;
+    }
+
+    template<std::size_t... ConverterIs>
+    constexpr std::array<rl::Bitmap::row_converter_t, sizeof...(ConverterIs)> make_default_gray_converters(std::index_sequence<ConverterIs...>) noexcept
+    {
+        return { get_default_gray_converter<ConverterIs>()... };
+    }
+#endif
+
+    rl::Bitmap::row_converter_t get_default_gray_converter(rl::SimdLevel level, rl::Bitmap::Depth depth, rl::Bitmap::Color source_color, rl::Bitmap::Color destination_color) noexcept
+    {
+        if (!get_is_gray_conversion(depth, source_color, depth, destination_color))
+        {
+            return nullptr;
+        }
+#if defined(RL_SIMD_X86)
+        static constexpr auto default_gray_converters = make_default_gray_converters(std::make_index_sequence<12>());
+        if (level == rl::SimdLevel::Ssse3 || level == rl::SimdLevel::Avx2)
+        {
+            return
+                default_gray_converters[
+                    static_cast<std::size_t>(depth) * 4 +
+                    (source_color == rl::Bitmap::Color::Rgba ? 2 : 0) +
+                    (destination_color == rl::Bitmap::Color::Ga ? 1 : 0)
+                ];
+        }
+#endif
+        return nullptr;
+    }
+
+    rl::Bitmap::row_converter_t get_shuffle_converter(rl::SimdLevel level, rl::Bitmap::Depth depth, rl::Bitmap::Color source_color, rl::Bitmap::Color destination_color) noexcept
+    {
+        switch (level)
+        {
+#if defined(RL_SIMD_X86)
+            case rl::SimdLevel::Ssse3:
+                return get_shuffle_converter<rl::SimdLevel::Ssse3>(depth, source_color, destination_color);
+            case rl::SimdLevel::Avx2:
+                return get_shuffle_converter<rl::SimdLevel::Avx2>(depth, source_color, destination_color);
+#endif
+#if defined(RL_SIMD_NEON)
+            case rl::SimdLevel::Neon:
+                return get_shuffle_converter<rl::SimdLevel::Neon>(depth, source_color, destination_color);
+#endif
+            default:
+                return nullptr;
+        }
+    }
+
+    rl::Bitmap::row_converter_t get_depth_converter(rl::SimdLevel level, rl::Bitmap::Depth source_depth, rl::Bitmap::Depth destination_depth, rl::Bitmap::Color color) noexcept
+    {
+        if (get_is_half_conversion(source_depth, color, destination_depth, color))
+        {
+            return get_half_converter(level, source_depth, color);
+        }
+        if (get_is_sexdecuple_conversion(source_depth, color, destination_depth, color))
+        {
+            return get_sexdecuple_converter(level, color);
+        }
+        const auto gather_converter = get_gather_converter(level, source_depth, color, destination_depth, color);
+        if (gather_converter != nullptr)
+        {
+            return gather_converter;
+        }
+        return get_arithmetic_converter(level, source_depth, destination_depth, color);
+    }
+
+    // conversions without a kernel of their own convert chunks of pixels to a format in between with one kernel, and
+    // from it with another. rgb turns gray before the depth changes like in the scalar converters, and other colors
+    // change on the side with fewer channels. depths without a kernel between them meet at normalized channels.
+    constexpr std::pair<rl::Bitmap::Depth, rl::Bitmap::Color> get_chunk_format(rl::Bitmap::Depth source_depth, rl::Bitmap::Color source_color, rl::Bitmap::Depth destination_depth, rl::Bitmap::Color destination_color) noexcept
+    {
+        if (source_color == destination_color)
+        {
+            return { rl::Bitmap::Depth::Normalized, source_color };
+        }
+        if (
+            (!get_is_gray(source_color) && get_is_gray(destination_color)) ||
+            rl::Bitmap::GetChannelCount(destination_color) < rl::Bitmap::GetChannelCount(source_color)
+        )
+        {
+            return { source_depth, destination_color };
+        }
+        return { destination_depth, source_color };
+    }
+
+    template<rl::SimdLevel Level, rl::Bitmap::Depth SourceDepth, rl::Bitmap::Color SourceColor, rl::Bitmap::Depth DestinationDepth, rl::Bitmap::Color DestinationColor>
+    void convert_chained_row(const rl::Bitmap::byte_t* source, rl::Bitmap::byte_t* destination, std::size_t width) noexcept
+    {
+        constexpr auto chunk_format = get_chunk_format(SourceDepth, SourceColor, DestinationDepth, DestinationColor);
+        constexpr std::size_t chunk_width = 64;
+        constexpr std::size_t source_pixel_size = rl::Bitmap::GetPixelSize(SourceDepth, SourceColor);
+        constexpr std::size_t destination_pixel_size = rl::Bitmap::GetPixelSize(DestinationDepth, DestinationColor);
+        // the kernels are picked once instead of once per row
+        static const auto first_converter = rl::Bitmap::GetRowConverter(Level, SourceDepth, SourceColor, chunk_format.first, chunk_format.second);
+        static const auto second_converter = rl::Bitmap::GetRowConverter(Level, chunk_format.first, chunk_format.second, DestinationDepth, DestinationColor);
+        std::array<rl::Bitmap::byte_t, chunk_width * rl::Bitmap::GetPixelSize(chunk_format.first, chunk_format.second)> chunk;
+        for (std::size_t chunk_x = 0; chunk_x < width; chunk_x += chunk_width)
+        {
+            const std::size_t chunk_pixel_count = std::min(chunk_width, width - chunk_x);
+            first_converter(source + chunk_x * source_pixel_size, chunk.data(), chunk_pixel_count);
+            second_converter(chunk.data(), destination + chunk_x * destination_pixel_size, chunk_pixel_count);
+        }
+    }
+
+    // indexed by source format index * format count + destination format index, like the scalar row converters
+    template<rl::SimdLevel Level, std::size_t ConverterI>
+    constexpr rl::Bitmap::row_converter_t get_chained_converter() noexcept
+    {
+        constexpr auto source_format_i = ConverterI / rl::detail::bitmap_format_count;
+        constexpr auto destination_format_i = ConverterI % rl::detail::bitmap_format_count;
+        constexpr auto source_depth = rl::detail::bitmap_depths[source_format_i / rl::detail::bitmap_color_count];
+        constexpr auto source_color = static_cast<rl::Bitmap::Color>(source_format_i % rl::detail::bitmap_color_count);
+        constexpr auto destination_depth = rl::detail::bitmap_depths[destination_format_i / rl::detail::bitmap_color_count];
+        constexpr auto destination_color = static_cast<rl::Bitmap::Color>(destination_format_i % rl::detail::bitmap_color_count);
+        constexpr auto chunk_format = get_chunk_format(source_depth, source_color, destination_depth, destination_color);
+        if constexpr (
+            source_depth == destination_depth ||
+            chunk_format == std::pair(source_depth, source_color) ||
+            chunk_format == std::pair(destination_depth, destination_color)
+        )
+        {
+            return nullptr;
+        }
+        else
+        {
+            return &convert_chained_row<Level, source_depth, source_color, destination_depth, destination_color>;
+        }
+    }
+
+    template<rl::SimdLevel Level, std::size_t... ConverterIs>
+    constexpr std::array<rl::Bitmap::row_converter_t, sizeof...(ConverterIs)> make_chained_converters(std::index_sequence<ConverterIs...>) noexcept
+    {
+        return { get_chained_converter<Level, ConverterIs>()... };
+    }
+
+    template<rl::SimdLevel Level>
+    rl::Bitmap::row_converter_t get_chained_converter(rl::Bitmap::Depth source_depth, rl::Bitmap::Color source_color, rl::Bitmap::Depth destination_depth, rl::Bitmap::Color destination_color) noexcept
+    {
+        static constexpr auto chained_converters = make_chained_converters<Level>(std::make_index_sequence<rl::detail::bitmap_format_count * rl::detail::bitmap_format_count>());
+        return
+            chained_converters[
+                rl::detail::get_bitmap_format_index(source_depth, source_color) * rl::detail::bitmap_format_count +
+                rl::detail::get_bitmap_format_index(destination_depth, destination_color)
+            ];
+    }
+
+    rl::Bitmap::row_converter_t get_chained_converter(rl::SimdLevel level, rl::Bitmap::Depth source_depth, rl::Bitmap::Color source_color, rl::Bitmap::Depth destination_depth, rl::Bitmap::Color destination_color) noexcept
+    {
+        rl::Bitmap::row_converter_t chained_converter = nullptr;
+        switch (level)
+        {
+#if defined(RL_SIMD_X86)
+            case rl::SimdLevel::Ssse3:
+                chained_converter = get_chained_converter<rl::SimdLevel::Ssse3>(source_depth, source_color, destination_depth, destination_color);
+                break;
+            case rl::SimdLevel::Avx2:
+                chained_converter = get_chained_converter<rl::SimdLevel::Avx2>(source_depth, source_color, destination_depth, destination_color);
+                break;
+#endif
+#if defined(RL_SIMD_NEON)
+            case rl::SimdLevel::Neon:
+                chained_converter = get_chained_converter<rl::SimdLevel::Neon>(source_depth, source_color, destination_depth, destination_color);
+                break;
+#endif
+            default:
+                break;
+        }
+        if (chained_converter == nullptr)
+        {
+            return nullptr;
+        }
+        // the scalar converters are faster than a chain with a scalar half
+        const auto [chunk_depth, chunk_color] = get_chunk_format(source_depth, source_color, destination_depth, destination_color);
+        if (
+            rl::Bitmap::GetRowConverter(level, source_depth, source_color, chunk_depth, chunk_color) == nullptr ||
+            rl::Bitmap::GetRowConverter(level, chunk_depth, chunk_color, destination_depth, destination_color) == nullptr
+        )
+        {
+            return nullptr;
+        }
+        return chained_converter;
+    }
+}
+
+rl::Bitmap::row_converter_t rl::Bitmap::GetRowConverter(rl::SimdLevel level, rl::Bitmap::Depth source_depth, rl::Bitmap::Color source_color, rl::Bitmap::Depth destination_depth, rl::Bitmap::Color destination_color) noexcept
+{
+    if (
+        (source_depth == destination_depth && source_color == destination_color) ||
+        rl::Bitmap::GetIsSubByte(source_depth) ||
+        rl::Bitmap::GetIsSubByte(destination_depth) ||
+        source_color == rl::Bitmap::Color::Indexed ||
+        destination_color == rl::Bitmap::Color::Indexed ||
+        !rl::get_is_simd_level_supported(level)
+    )
+    {
+        return nullptr;
+    }
+    if (source_depth == destination_depth)
+    {
+        return
+            get_is_gray_conversion(source_depth, source_color, destination_depth, destination_color) ?
+                get_default_gray_converter(level, source_depth, source_color, destination_color) :
+                get_shuffle_converter(level, source_depth, source_color, destination_color);
+    }
+    if (source_color == destination_color)
+    {
+        const auto depth_converter = get_depth_converter(level, source_depth, destination_depth, source_color);
+        if (depth_converter != nullptr)
+        {
+            return depth_converter;
+        }
+    }
+    return get_chained_converter(level, source_depth, source_color, destination_depth, destination_color);
+}
+
+rl::Bitmap::row_converter_t rl::Bitmap::get_linear_row_converter(rl::Bitmap::Depth source_depth, rl::Bitmap::Color source_color, rl::Bitmap::Depth destination_depth, rl::Bitmap::Color destination_color) noexcept
+{
+    return get_table_converter(source_depth, source_color, destination_depth, destination_color, true);
+}
+
+rl::Bitmap::row_converter_t rl::Bitmap::get_fastest_row_converter(const rl::Bitmap::byte_t* source, std::size_t source_extent, rl::Bitmap::Depth source_depth, rl::Bitmap::Color source_color, const rl::Bitmap::byte_t* destination, std::size_t destination_extent, rl::Bitmap::Depth destination_depth, rl::Bitmap::Color destination_color) noexcept
+{
+    const auto source_address = reinterpret_cast<std::uintptr_t>(source);
+    const auto destination_address = reinterpret_cast<std::uintptr_t>(destination);
+    const bool overlaps =
+        source_address < destination_address + destination_extent &&
+        destination_address < source_address + source_extent;
+    // the simd kernels can not convert in place, so overlapping memory always takes the scalar path
+    if (!overlaps)
+    {
+        const auto simd_converter =
+            rl::Bitmap::GetRowConverter(
+                rl::get_simd_level(),
+                source_depth,
+                source_color,
+                destination_depth,
+                destination_color
+            );
+        if (simd_converter != nullptr)
+        {
+            return simd_converter;
+        }
+    }
+    const auto table_converter =
+        get_table_converter(
+            source_depth,
+            source_color,
+            destination_depth,
+            destination_color
+        );
+    if (table_converter != nullptr)
+    {
+        return table_converter;
+    }
+    return
+        rl::Bitmap::GetRowConverter(
+            source_depth,
+            source_color,
+            destination_depth,
+            destination_color
+        );
+}
+
+namespace
+{
+    template<std::size_t ChannelSize>
+    void interleave_planes(const rl::Bitmap::byte_t* planes, std::size_t plane_offset, std::size_t channel_count, rl::Bitmap::byte_t* pixels, std::size_t width) noexcept
+    {
+        for (std::size_t channel_i = 0; channel_i < channel_count; channel_i++)
+        {
+            const rl::Bitmap::byte_t* plane = planes + channel_i * plane_offset;
+            rl::Bitmap::byte_t* pixel_channels = pixels + channel_i * ChannelSize;
+            for (std::size_t pixel_i = 0; pixel_i < width; pixel_i++)
+            {
+                std::memcpy(pixel_channels + pixel_i * channel_count * ChannelSize, plane + pixel_i * ChannelSize, ChannelSize);
+            }
+        }
+    }
+
+    template<std::size_t ChannelSize>
+    void deinterleave_planes(const rl::Bitmap::byte_t* pixels, std::size_t channel_count, rl::Bitmap::byte_t* planes, std::size_t plane_offset, std::size_t width) noexcept
+    {
+        for (std::size_t channel_i = 0; channel_i < channel_count; channel_i++)
+        {
+            rl::Bitmap::byte_t* plane = planes + channel_i * plane_offset;
+            const rl::Bitmap::byte_t* pixel_channels = pixels + channel_i * ChannelSize;
+            for (std::size_t pixel_i = 0; pixel_i < width; pixel_i++)
+            {
+                std::memcpy(plane + pixel_i * ChannelSize, pixel_channels + pixel_i * channel_count * ChannelSize, ChannelSize);
+            }
+        }
+    }
+
+    void interleave_planes(const rl::Bitmap::byte_t* planes, std::size_t plane_offset, rl::Bitmap::Depth depth, rl::Bitmap::Color color, rl::Bitmap::byte_t* pixels, std::size_t width) noexcept
+    {
+        const auto channel_count = rl::Bitmap::GetChannelCount(color);
+        switch (rl::Bitmap::GetChannelSize(depth))
+        {
+            case 1:
+                interleave_planes<1>(planes, plane_offset, channel_count, pixels, width);
+                break;
+            case 2:
+                interleave_planes<2>(planes, plane_offset, channel_count, pixels, width);
+                break;
+            case 4:
+                interleave_planes<4>(planes, plane_offset, channel_count, pixels, width);
+                break;
+        }
+    }
+
+    void deinterleave_planes(const rl::Bitmap::byte_t* pixels, rl::Bitmap::Depth depth, rl::Bitmap::Color color, rl::Bitmap::byte_t* planes, std::size_t plane_offset, std::size_t width) noexcept
+    {
+        const auto channel_count = rl::Bitmap::GetChannelCount(color);
+        switch (rl::Bitmap::GetChannelSize(depth))
+        {
+            case 1:
+                deinterleave_planes<1>(pixels, channel_count, planes, plane_offset, width);
+                break;
+            case 2:
+                deinterleave_planes<2>(pixels, channel_count, planes, plane_offset, width);
+                break;
+            case 4:
+                deinterleave_planes<4>(pixels, channel_count, planes, plane_offset, width);
+                break;
+        }
+    }
+}
+
+void rl::Bitmap::Row::Blit(const rl::Bitmap::Row::View& row, rl::Bitmap::Blend blend, std::optional<rl::gray_mode> gray_o)
+{
+    if (row.GetWidth() != this->width)
+    {
+        throw rl::runtime_error("blit row has different width");
+    }
+    // the default mode is only read by blits that turn colors gray without being given a mode
+    const bool is_gray_conversion = !get_is_gray(row.GetColor()) && get_is_gray(this->color);
+    this->blit(row, blend, (gray_o.has_value() || !is_gray_conversion) ? gray_o.value_or(rl::gray_mode()) : rl::get_gray());
+}
+
+void rl::Bitmap::Row::blit(const rl::Bitmap::Row::View& row, rl::Bitmap::Blend blend, const rl::gray_mode& gray)
+{
+    if (rl::Bitmap::GetIsSubByte(row.GetDepth()) || rl::Bitmap::GetIsSubByte(this->depth))
+    {
+        this->blit_sub_byte(row, blend, gray);
+        return;
+    }
+    if (row.GetColor() == rl::Bitmap::Color::Indexed || this->color == rl::Bitmap::Color::Indexed)
+    {
+        this->blit_indexed(row, blend, gray);
+        return;
+    }
+    if (row.GetSpace() != this->space)
+    {
+        this->blit_space(row, blend, gray);
+        return;
+    }
+    if (blend != rl::Bitmap::Blend::Replace)
+    {
+        this->blit_blended(row, blend, gray);
+        return;
+    }
+    if (rl::Bitmap::get_is_alpha_conversion(row.GetColor(), row.GetIsPremultiplied(), this->GetIsPremultiplied()))
+    {
+        this->blit_alpha(row, gray);
+        return;
+    }
+    if (!get_is_gray(row.GetColor()) && get_is_gray(this->color))
+    {
+        this->blit_gray(row, gray);
+        return;
+    }
+    if (row.GetLayout() == rl::Bitmap::Layout::Planar || this->layout == rl::Bitmap::Layout::Planar)
+    {
+        this->blit_planar(row);
+        return;
+    }
+    const auto converter =
+        rl::Bitmap::get_fastest_row_converter(
+            row.GetData(),
+            row.GetSize(),
+            row.GetDepth(),
+            row.GetColor(),
+            this->data,
+            this->GetSize(),
+            this->depth,
+            this->color
+        );
+    converter(row.GetData(), this->data, this->width);
+}
+
+void rl::Bitmap::Row::blit_gray(const rl::Bitmap::Row::View& row, const rl::gray_mode& gray)
+{
+    const auto get_converter =
+        [&](const rl::Bitmap::byte_t* source, rl::Bitmap::byte_t* destination, std::size_t width, rl::Bitmap::Color color)
+        {
+            // the kernels read whole blocks of the source, so they only write rows that do not overlap it or that start
+            // at the same address
+            const auto source_address = reinterpret_cast<std::uintptr_t>(source);
+            const auto destination_address = reinterpret_cast<std::uintptr_t>(destination);
+            const bool overlaps =
+                source_address < destination_address + rl::Bitmap::GetRowSize(width, row.GetDepth(), color) &&
+                destination_address < source_address + rl::Bitmap::GetRowSize(width, row.GetDepth(), row.GetColor());
+            const auto simd_converter =
+                (!overlaps || source == destination) ?
+                    rl::Bitmap::GetGrayConverter(rl::get_simd_level(), row.GetDepth(), row.GetColor(), color) :
+                    nullptr;
+            return
+                (simd_converter != nullptr) ?
+                    simd_converter :
+                    rl::Bitmap::GetGrayConverter(row.GetDepth(), row.GetColor(), color);
+        };
+    // rows of the same depth turn gray straight into this row unless one of them is planar
+    if (
+        row.GetDepth() == this->depth &&
+        row.GetLayout() != rl::Bitmap::Layout::Planar &&
+        this->layout != rl::Bitmap::Layout::Planar
+    )
+    {
+        get_converter(row.GetData(), this->data, this->width, this->color)(row.GetData(), this->data, this->width, gray);
+        return;
+    }
+    const auto gray_color = (row.GetColor() == rl::Bitmap::Color::Rgba) ? rl::Bitmap::Color::Ga : rl::Bitmap::Color::G;
+    // the others turn gray in linear chunks of the source depth before their depth, color or layout changes, like the
+    // row converters do
+    constexpr std::size_t chunk_width = 64;
+    constexpr std::size_t max_pixel_size = 16;
+    std::array<rl::Bitmap::byte_t, chunk_width * max_pixel_size> chunk;
+    for (std::size_t chunk_x = 0; chunk_x < this->width; chunk_x += chunk_width)
+    {
+        const std::size_t width = std::min(chunk_width, this->width - chunk_x);
+        const rl::Bitmap::byte_t* source_pixels = row.GetData(chunk_x, 0);
+        if (row.GetLayout() == rl::Bitmap::Layout::Planar)
+        {
+            interleave_planes(source_pixels, row.GetPlaneOffset(), row.GetDepth(), row.GetColor(), chunk.data(), width);
+            source_pixels = chunk.data();
+        }
+        get_converter(source_pixels, chunk.data(), width, gray_color)(source_pixels, chunk.data(), width, gray);
+        rl::Bitmap::Row(this->GetData(chunk_x, 0), width, this->depth, this->color, this->layout, this->plane_offset, this->alpha, {}, this->space).blit(
+            rl::Bitmap::Row::View(chunk.data(), width, row.GetDepth(), gray_color, rl::Bitmap::Layout::Linear, std::nullopt, row.GetAlpha(), {}, row.GetSpace()),
+            rl::Bitmap::Blend::Replace,
+            gray
+        );
+    }
+}
+
+void rl::Bitmap::Row::blit_planar(const rl::Bitmap::Row::View& row)
+{
+    const bool is_source_planar = row.GetLayout() == rl::Bitmap::Layout::Planar;
+    const bool is_destination_planar = this->layout == rl::Bitmap::Layout::Planar;
+    // planes of the same format copy straight over
+    if (is_source_planar && is_destination_planar && row.GetDepth() == this->depth && row.GetColor() == this->color)
+    {
+        for (std::size_t channel_i = 0; channel_i < rl::Bitmap::GetChannelCount(this->color); channel_i++)
+        {
+            std::memcpy(
+                this->data + channel_i * this->plane_offset,
+                row.GetData() + channel_i * row.GetPlaneOffset(),
+                rl::Bitmap::GetRowSize(this->width, this->depth, rl::Bitmap::Color::G)
+            );
+        }
+        return;
+    }
+    // interleave the planar side in chunks, so the conversion can go through the same row converters
+    constexpr std::size_t chunk_width = 64;
+    constexpr std::size_t max_pixel_size = 16;
+    std::array<rl::Bitmap::byte_t, chunk_width * max_pixel_size> source_chunk;
+    std::array<rl::Bitmap::byte_t, chunk_width * max_pixel_size> destination_chunk;
+    // one side of the conversion is always a chunk, so the rows given to the converter never overlap
+    const auto converter =
+        rl::Bitmap::get_fastest_row_converter(
+            source_chunk.data(),
+            source_chunk.size(),
+            row.GetDepth(),
+            row.GetColor(),
+            destination_chunk.data(),
+            destination_chunk.size(),
+            this->depth,
+            this->color
+        );
+    const std::size_t source_channel_size = rl::Bitmap::GetChannelSize(row.GetDepth());
+    const std::size_t destination_channel_size = rl::Bitmap::GetChannelSize(this->depth);
+    for (std::size_t chunk_x = 0; chunk_x < this->width; chunk_x += chunk_width)
+    {
+        const std::size_t width = std::min(chunk_width, this->width - chunk_x);
+        const rl::Bitmap::byte_t* source_pixels = nullptr;
+        if (is_source_planar)
+        {
+            interleave_planes(row.GetData() + chunk_x * source_channel_size, row.GetPlaneOffset(), row.GetDepth(), row.GetColor(), source_chunk.data(), width);
+            source_pixels = source_chunk.data();
+        }
+        else
+        {
+            source_pixels = row.GetData(chunk_x, 0);
+        }
+        rl::Bitmap::byte_t* destination_pixels = is_destination_planar ? destination_chunk.data() : this->GetData(chunk_x, 0);
+        converter(source_pixels, destination_pixels, width);
+        if (is_destination_planar)
+        {
+            deinterleave_planes(destination_chunk.data(), this->depth, this->color, this->data + chunk_x * destination_channel_size, this->plane_offset, width);
+        }
+    }
+}
+
+namespace
+{
+    // octuple channels blend with integer math rounded the same way in every kernel, so the simd kernels are bit exact
+    // with the scalar ones. the other depths blend in floats.
+    constexpr std::uint32_t div_255(std::uint32_t value) noexcept
+    {
+        // rounds value / 255 for values up to 255 * 255
+        value += 128;
+        return (value + (value >> 8)) >> 8;
+    }
+
+    template<rl::Bitmap::Blend Blend>
+    std::uint32_t blend_octuple(std::uint32_t source, std::uint32_t source_alpha, std::uint32_t destination, std::uint32_t destination_alpha) noexcept
+    {
+        const std::uint32_t inverse_alpha = 255 - source_alpha;
+        if constexpr (Blend == rl::Bitmap::Blend::Over)
+        {
+            // the alpha stays scaled by 255 until the end, so the division is the only rounding step
+            const std::uint32_t alpha = source_alpha * 255 + destination_alpha * inverse_alpha;
+            if (alpha == 0)
+            {
+                return 0;
+            }
+            const std::uint32_t numerator = source * source_alpha * 255 + destination * destination_alpha * inverse_alpha;
+            return static_cast<std::uint32_t>(static_cast<float>(numerator) / static_cast<float>(alpha) + 0.5f);
+        }
+        else if constexpr (Blend == rl::Bitmap::Blend::OverPremultiplied)
+        {
+            return std::min<std::uint32_t>(source + div_255(destination * inverse_alpha), 255);
+        }
+        else if constexpr (Blend == rl::Bitmap::Blend::Add)
+        {
+            return std::min<std::uint32_t>(destination + div_255(source * source_alpha), 255);
+        }
+        else
+        {
+            return div_255(destination * (inverse_alpha + div_255(source * source_alpha)));
+        }
+    }
+
+    template<rl::Bitmap::Blend Blend>
+    std::uint32_t blend_octuple_alpha(std::uint32_t source_alpha, std::uint32_t destination_alpha) noexcept
+    {
+        if constexpr (Blend == rl::Bitmap::Blend::Over || Blend == rl::Bitmap::Blend::OverPremultiplied)
+        {
+            return div_255(source_alpha * 255 + destination_alpha * (255 - source_alpha));
+        }
+        else if constexpr (Blend == rl::Bitmap::Blend::Add)
+        {
+            return std::min<std::uint32_t>(destination_alpha + source_alpha, 255);
+        }
+        else
+        {
+            return destination_alpha;
+        }
+    }
+
+    template<rl::Bitmap::Blend Blend>
+    float blend_normalized(float source, float source_alpha, float destination, float destination_alpha) noexcept
+    {
+        const float inverse_alpha = 1.0f - source_alpha;
+        if constexpr (Blend == rl::Bitmap::Blend::Over)
+        {
+            const float alpha = source_alpha + destination_alpha * inverse_alpha;
+            if (alpha <= 0.0f)
+            {
+                return 0.0f;
+            }
+            return (source * source_alpha + destination * destination_alpha * inverse_alpha) / alpha;
+        }
+        else if constexpr (Blend == rl::Bitmap::Blend::OverPremultiplied)
+        {
+            return source + destination * inverse_alpha;
+        }
+        else if constexpr (Blend == rl::Bitmap::Blend::Add)
+        {
+            return std::min(destination + source * source_alpha, 1.0f);
+        }
+        else
+        {
+            return destination * (inverse_alpha + source * source_alpha);
+        }
+    }
+
+    template<rl::Bitmap::Blend Blend>
+    float blend_normalized_alpha(float source_alpha, float destination_alpha) noexcept
+    {
+        if constexpr (Blend == rl::Bitmap::Blend::Over || Blend == rl::Bitmap::Blend::OverPremultiplied)
+        {
+            return source_alpha + destination_alpha * (1.0f - source_alpha);
+        }
+        else if constexpr (Blend == rl::Bitmap::Blend::Add)
+        {
+            return std::min(destination_alpha + source_alpha, 1.0f);
+        }
+        else
+        {
+            return destination_alpha;
+        }
+    }
+
+    template<rl::Bitmap::Depth Depth>
+    float load_normalized(const rl::Bitmap::byte_t* channel) noexcept
+    {
+        if constexpr (Depth == rl::Bitmap::Depth::Sexdecuple)
+        {
+            rl::Bitmap::sexdecuple_t value;
+            std::memcpy(&value, channel, sizeof(value));
+            return static_cast<float>(value) / 65535.0f;
+        }
+        else if constexpr (Depth == rl::Bitmap::Depth::Half)
+        {
+            rl::Bitmap::half_t value;
+            std::memcpy(&value, channel, sizeof(value));
+            return rl::detail::half_to_float(value);
+        }
+        else
+        {
+            rl::Bitmap::normalized_t value;
+            std::memcpy(&value, channel, sizeof(value));
+            return value;
+        }
+    }
+
+    template<rl::Bitmap::Depth Depth>
+    void store_normalized(float value, rl::Bitmap::byte_t* channel) noexcept
+    {
+        if constexpr (Depth == rl::Bitmap::Depth::Sexdecuple)
+        {
+            const auto sexdecuple = static_cast<rl::Bitmap::sexdecuple_t>(std::clamp(value, 0.0f, 1.0f) * 65535.0f + 0.5f);
+            std::memcpy(channel, &sexdecuple, sizeof(sexdecuple));
+        }
+        else if constexpr (Depth == rl::Bitmap::Depth::Half)
+        {
+            const rl::Bitmap::half_t half = rl::detail::float_to_half(value);
+            std::memcpy(channel, &half, sizeof(half));
+        }
+        else
+        {
+            const rl::Bitmap::normalized_t normalized = value;
+            std::memcpy(channel, &normalized, sizeof(normalized));
+        }
+    }
+
+    template<rl::Bitmap::Blend Blend, rl::Bitmap::Depth Depth, rl::Bitmap::Color Color>
+    void blend_row(const rl::Bitmap::byte_t* source, rl::Bitmap::byte_t* destination, std::size_t width) noexcept
+    {
+        constexpr std::size_t color_channel_count = get_is_gray(Color) ? 1 : 3;
+        constexpr std::size_t channel_size = rl::Bitmap::GetChannelSize(Depth);
+        constexpr std::size_t source_pixel_size = (color_channel_count + 1) * channel_size;
+        constexpr std::size_t destination_pixel_size = rl::Bitmap::GetPixelSize(Depth, Color);
+        for (std::size_t pixel_i = 0; pixel_i < width; pixel_i++)
+        {
+            const auto* source_pixel = source + pixel_i * source_pixel_size;
+            auto* destination_pixel = destination + pixel_i * destination_pixel_size;
+            if constexpr (Depth == rl::Bitmap::Depth::Octuple)
+            {
+                const auto* source_channels = reinterpret_cast<const std::uint8_t*>(source_pixel);
+                auto* destination_channels = reinterpret_cast<std::uint8_t*>(destination_pixel);
+                const std::uint32_t source_alpha = source_channels[color_channel_count];
+                const std::uint32_t destination_alpha = get_has_alpha(Color) ? destination_channels[color_channel_count] : 255;
+                for (std::size_t channel_i = 0; channel_i < color_channel_count; channel_i++)
+                {
+                    destination_channels[channel_i] =
+                        static_cast<std::uint8_t>(
+                            blend_octuple<Blend>(source_channels[channel_i], source_alpha, destination_channels[channel_i], destination_alpha)
+                        );
+                }
+                if constexpr (get_has_alpha(Color))
+                {
+                    destination_channels[color_channel_count] = static_cast<std::uint8_t>(blend_octuple_alpha<Blend>(source_alpha, destination_alpha));
+                }
+            }
+            else
+            {
+                const float source_alpha = load_normalized<Depth>(source_pixel + color_channel_count * channel_size);
+                const float destination_alpha = get_has_alpha(Color) ? load_normalized<Depth>(destination_pixel + color_channel_count * channel_size) : 1.0f;
+                for (std::size_t channel_i = 0; channel_i < color_channel_count; channel_i++)
+                {
+                    store_normalized<Depth>(
+                        blend_normalized<Blend>(
+                            load_normalized<Depth>(source_pixel + channel_i * channel_size),
+                            source_alpha,
+                            load_normalized<Depth>(destination_pixel + channel_i * channel_size),
+                            destination_alpha
+                        ),
+                        destination_pixel + channel_i * channel_size
+                    );
+                }
+                if constexpr (get_has_alpha(Color))
+                {
+                    store_normalized<Depth>(blend_normalized_alpha<Blend>(source_alpha, destination_alpha), destination_pixel + color_channel_count * channel_size);
+                }
+            }
+        }
+    }
+
+#if defined(RL_SIMD_X86)
+    RL_TARGET_AVX2 inline __m256i div_255_avx2(__m256i value) noexcept
+    {
+        value = _mm256_add_epi32(value, _mm256_set1_epi32(128));
+        return _mm256_srli_epi32(_mm256_add_epi32(value, _mm256_srli_epi32(value, 8)), 8);
+    }
+
+    template<rl::Bitmap::Blend Blend, rl::Bitmap::Color Color>
+    RL_TARGET_AVX2 void blend_octuple_row_avx2(const rl::Bitmap::byte_t* source, rl::Bitmap::byte_t* destination, std::size_t width) noexcept
+    {
+        // eight channels at a time, widened to 32 bits so the products can not overflow. the source and destination
+        // have the same layout, so each lane blends the same channel of both.
+        constexpr std::size_t pixel_size = rl::Bitmap::GetChannelCount(Color);
+        constexpr std::size_t block_width = 8 / pixel_size;
+        constexpr int alpha_shuffle = (Color == rl::Bitmap::Color::Rgba) ? _MM_SHUFFLE(3, 3, 3, 3) : _MM_SHUFFLE(3, 3, 1, 1);
+        const __m256i alpha_mask =
+            (Color == rl::Bitmap::Color::Rgba) ?
+                _mm256_setr_epi32(0, 0, 0, -1, 0, 0, 0, -1) :
+                _mm256_setr_epi32(0, -1, 0, -1, 0, -1, 0, -1);
+        const __m256i max = _mm256_set1_epi32(255);
+        std::size_t pixel_i = 0;
+        for (; pixel_i + block_width <= width; pixel_i += block_width)
+        {
+            auto* destination_block = destination + pixel_i * pixel_size;
+            const __m256i source_channels = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(source + pixel_i * pixel_size)));
+            const __m256i destination_channels = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(destination_block)));
+            const __m256i source_alpha = _mm256_shuffle_epi32(source_channels, alpha_shuffle);
+            const __m256i destination_alpha = _mm256_shuffle_epi32(destination_channels, alpha_shuffle);
+            const __m256i inverse_alpha = _mm256_sub_epi32(max, source_alpha);
+            __m256i colors;
+            __m256i alphas;
+            if constexpr (Blend == rl::Bitmap::Blend::Over)
+            {
+                const __m256i alpha = _mm256_add_epi32(_mm256_mullo_epi32(source_alpha, max), _mm256_mullo_epi32(destination_alpha, inverse_alpha));
+                const __m256i numerator =
+                    _mm256_add_epi32(
+                        _mm256_mullo_epi32(_mm256_mullo_epi32(source_channels, source_alpha), max),
+                        _mm256_mullo_epi32(_mm256_mullo_epi32(destination_channels, destination_alpha), inverse_alpha)
+                    );
+                const __m256 quotient = _mm256_add_ps(_mm256_div_ps(_mm256_cvtepi32_ps(numerator), _mm256_cvtepi32_ps(alpha)), _mm256_set1_ps(0.5f));
+                // fully transparent results divide by zero, and become zero like in the scalar kernel
+                colors = _mm256_andnot_si256(_mm256_cmpeq_epi32(alpha, _mm256_setzero_si256()), _mm256_cvttps_epi32(quotient));
+                alphas = div_255_avx2(alpha);
+            }
+            else if constexpr (Blend == rl::Bitmap::Blend::OverPremultiplied)
+            {
+                // the color formula gives the alpha formula on the alpha lanes
+                colors = _mm256_min_epi32(_mm256_add_epi32(source_channels, div_255_avx2(_mm256_mullo_epi32(destination_channels, inverse_alpha))), max);
+                alphas = colors;
+            }
+            else if constexpr (Blend == rl::Bitmap::Blend::Add)
+            {
+                colors = _mm256_min_epi32(_mm256_add_epi32(destination_channels, div_255_avx2(_mm256_mullo_epi32(source_channels, source_alpha))), max);
+                alphas = _mm256_min_epi32(_mm256_add_epi32(destination_channels, source_channels), max);
+            }
+            else
+            {
+                const __m256i factor = _mm256_add_epi32(inverse_alpha, div_255_avx2(_mm256_mullo_epi32(source_channels, source_alpha)));
+                colors = div_255_avx2(_mm256_mullo_epi32(destination_channels, factor));
+                alphas = destination_channels;
+            }
+            __m256i pixels = _mm256_blendv_epi8(colors, alphas, alpha_mask);
+            // the packs work within 128 bit lanes, leaving four channels at the start of each lane
+            pixels = _mm256_packus_epi32(pixels, pixels);
+            pixels = _mm256_packus_epi16(pixels, pixels);
+            const std::uint32_t low = static_cast<std::uint32_t>(_mm_cvtsi128_si32(_mm256_castsi256_si128(pixels)));
+            const std::uint32_t high = static_cast<std::uint32_t>(_mm_cvtsi128_si32(_mm256_extracti128_si256(pixels, 1)));
+            std::memcpy(destination_block, &low, sizeof(low));
+            std::memcpy(destination_block + sizeof(low), &high, sizeof(high));
+        }
+        blend_row<Blend, rl::Bitmap::Depth::Octuple, Color>(source + pixel_i * pixel_size, destination + pixel_i * pixel_size, width - pixel_i);
+    }
+#endif
+
+    template<rl::Bitmap::Blend Blend, rl::Bitmap::Depth Depth>
+    rl::Bitmap::row_blender_t get_row_blender(rl::Bitmap::Color color) noexcept
+    {
+#if defined(RL_SIMD_X86)
+        if constexpr (Depth == rl::Bitmap::Depth::Octuple)
+        {
+            if (rl::get_simd_level() == rl::SimdLevel::Avx2)
+            {
+                switch (color)
+                {
+                    case rl::Bitmap::Color::Ga:
+                        return &blend_octuple_row_avx2<Blend, rl::Bitmap::Color::Ga>;
+                    case rl::Bitmap::Color::Rgba:
+                        return &blend_octuple_row_avx2<Blend, rl::Bitmap::Color::Rgba>;
+                    default:
+                        break;
+                }
+            }
+        }
+#endif
+        switch (color)
+        {
+            case rl::Bitmap::Color::G:
+                return &blend_row<Blend, Depth, rl::Bitmap::Color::G>;
+            case rl::Bitmap::Color::Ga:
+                return &blend_row<Blend, Depth, rl::Bitmap::Color::Ga>;
+            case rl::Bitmap::Color::Rgb:
+                return &blend_row<Blend, Depth, rl::Bitmap::Color::Rgb>;
+            case rl::Bitmap::Color::Rgba:
+                return &blend_row<Blend, Depth, rl::Bitmap::Color::Rgba>;
+            case rl::Bitmap::Color::Indexed:
+                // indexed rows blend the colors of their palette
+                return nullptr;
+        }
+        return nullptr;
+    }
+
+    template<rl::Bitmap::Blend Blend>
+    rl::Bitmap::row_blender_t get_row_blender(rl::Bitmap::Depth depth, rl::Bitmap::Color color) noexcept
+    {
+        switch (depth)
+        {
+            case rl::Bitmap::Depth::Octuple:
+                return get_row_blender<Blend, rl::Bitmap::Depth::Octuple>(color);
+            case rl::Bitmap::Depth::Sexdecuple:
+                return get_row_blender<Blend, rl::Bitmap::Depth::Sexdecuple>(color);
+            case rl::Bitmap::Depth::Normalized:
+                return get_row_blender<Blend, rl::Bitmap::Depth::Normalized>(color);
+            case rl::Bitmap::Depth::Half:
+                return get_row_blender<Blend, rl::Bitmap::Depth::Half>(color);
+            case rl::Bitmap::Depth::Single:
+            case rl::Bitmap::Depth::Duple:
+            case rl::Bitmap::Depth::Quadruple:
+                // sub-byte rows blend through octuple chunks
+                return nullptr;
+        }
+        return nullptr;
+    }
+}
+
+rl::Bitmap::row_blender_t rl::Bitmap::get_row_blender(rl::Bitmap::Blend blend, rl::Bitmap::Depth depth, rl::Bitmap::Color color) noexcept
+{
+    switch (blend)
+    {
+        case rl::Bitmap::Blend::Over:
+            return ::get_row_blender<rl::Bitmap::Blend::Over>(depth, color);
+        case rl::Bitmap::Blend::OverPremultiplied:
+            return ::get_row_blender<rl::Bitmap::Blend::OverPremultiplied>(depth, color);
+        case rl::Bitmap::Blend::Add:
+            return ::get_row_blender<rl::Bitmap::Blend::Add>(depth, color);
+        case rl::Bitmap::Blend::Multiply:
+            return ::get_row_blender<rl::Bitmap::Blend::Multiply>(depth, color);
+        default:
+            return nullptr;
+    }
+}
+
+void rl::Bitmap::Row::blit_blended(const rl::Bitmap::Row::View& row, rl::Bitmap::Blend blend, const rl::gray_mode& gray)
+{
+    // the source is converted to the depth of this row with an alpha channel, so every blend can see the source alpha
+    const auto blend_color = get_is_gray(this->color) ? rl::Bitmap::Color::Ga : rl::Bitmap::Color::Rgba;
+    const auto blender = rl::Bitmap::get_row_blender(blend, this->depth, this->color);
+    const bool is_source_blendable =
+        row.GetLayout() != rl::Bitmap::Layout::Planar &&
+        row.GetDepth() == this->depth &&
+        row.GetColor() == blend_color;
+    const bool is_destination_planar = this->layout == rl::Bitmap::Layout::Planar;
+    constexpr std::size_t chunk_width = 64;
+    constexpr std::size_t max_pixel_size = 16;
+    std::array<rl::Bitmap::byte_t, chunk_width * max_pixel_size> source_chunk;
+    std::array<rl::Bitmap::byte_t, chunk_width * max_pixel_size> destination_chunk;
+    const std::size_t destination_channel_size = rl::Bitmap::GetChannelSize(this->depth);
+    for (std::size_t chunk_x = 0; chunk_x < this->width; chunk_x += chunk_width)
+    {
+        const std::size_t width = std::min(chunk_width, this->width - chunk_x);
+        const rl::Bitmap::byte_t* source_pixels = nullptr;
+        if (is_source_blendable)
+        {
+            source_pixels = row.GetData(chunk_x, 0);
+        }
+        else
+        {
+            // the blends work on the stored values, so the chunk keeps the alpha of the source
+            rl::Bitmap::Row(source_chunk.data(), width, this->depth, blend_color, rl::Bitmap::Layout::Linear, std::nullopt, row.GetAlpha()).blit(
+                rl::Bitmap::Row::View(
+                    row.GetData(chunk_x, 0),
+                    width,
+                    row.GetDepth(),
+                    row.GetColor(),
+                    row.GetLayout(),
+                    row.GetPlaneOffset(),
+                    row.GetAlpha()
+                ),
+                rl::Bitmap::Blend::Replace,
+                gray
+            );
+            source_pixels = source_chunk.data();
+        }
+        if (is_destination_planar)
+        {
+            rl::Bitmap::byte_t* planes = this->data + chunk_x * destination_channel_size;
+            interleave_planes(planes, this->plane_offset, this->depth, this->color, destination_chunk.data(), width);
+            blender(source_pixels, destination_chunk.data(), width);
+            deinterleave_planes(destination_chunk.data(), this->depth, this->color, planes, this->plane_offset, width);
+        }
+        else
+        {
+            blender(source_pixels, this->GetData(chunk_x, 0), width);
+        }
+    }
+}
+
+namespace
+{
+    template<rl::Bitmap::Depth Depth, std::size_t ChannelCount, bool Premultiply>
+    void convert_alpha_row(rl::Bitmap::byte_t* data, std::size_t width) noexcept
+    {
+        constexpr std::size_t channel_size = rl::Bitmap::GetChannelSize(Depth);
+        for (std::size_t pixel_i = 0; pixel_i < width; pixel_i++)
+        {
+            auto* pixel = data + pixel_i * ChannelCount * channel_size;
+            if constexpr (Depth == rl::Bitmap::Depth::Normalized || Depth == rl::Bitmap::Depth::Half)
+            {
+                rl::Bitmap::normalized_t channels[ChannelCount];
+                rl::detail::load_channels<Depth>(pixel, channels, ChannelCount);
+                const float alpha = channels[ChannelCount - 1];
+                for (std::size_t channel_i = 0; channel_i + 1 < ChannelCount; channel_i++)
+                {
+                    if constexpr (Premultiply)
+                    {
+                        channels[channel_i] *= alpha;
+                    }
+                    else
+                    {
+                        channels[channel_i] = (alpha > 0.0f) ? channels[channel_i] / alpha : 0.0f;
+                    }
+                }
+                rl::detail::store_channels<Depth>(channels, pixel, ChannelCount);
+            }
+            else
+            {
+                // integer channels round to the nearest value
+                using channel_t = std::conditional_t<Depth == rl::Bitmap::Depth::Octuple, rl::Bitmap::octuple_t, rl::Bitmap::sexdecuple_t>;
+                constexpr std::uint64_t max = std::numeric_limits<channel_t>::max();
+                channel_t channels[ChannelCount];
+                std::memcpy(channels, pixel, sizeof(channels));
+                const std::uint64_t alpha = channels[ChannelCount - 1];
+                for (std::size_t channel_i = 0; channel_i + 1 < ChannelCount; channel_i++)
+                {
+                    if constexpr (Premultiply)
+                    {
+                        channels[channel_i] = static_cast<channel_t>((channels[channel_i] * alpha + max / 2) / max);
+                    }
+                    else
+                    {
+                        channels[channel_i] =
+                            (alpha == 0) ?
+                                0 :
+                                static_cast<channel_t>(std::min((channels[channel_i] * max + alpha / 2) / alpha, max));
+                    }
+                }
+                std::memcpy(pixel, channels, sizeof(channels));
+            }
+        }
+    }
+
+    template<bool Premultiply>
+    void convert_alpha_row(rl::Bitmap::byte_t* data, std::size_t width, rl::Bitmap::Depth depth, rl::Bitmap::Color color) noexcept
+    {
+        if (color != rl::Bitmap::Color::Ga && color != rl::Bitmap::Color::Rgba)
+        {
+            return;
+        }
+        const bool is_gray = color == rl::Bitmap::Color::Ga;
+        switch (depth)
+        {
+            case rl::Bitmap::Depth::Octuple:
+                is_gray ?
+                    convert_alpha_row<rl::Bitmap::Depth::Octuple, 2, Premultiply>(data, width) :
+                    convert_alpha_row<rl::Bitmap::Depth::Octuple, 4, Premultiply>(data, width);
+                break;
+            case rl::Bitmap::Depth::Sexdecuple:
+                is_gray ?
+                    convert_alpha_row<rl::Bitmap::Depth::Sexdecuple, 2, Premultiply>(data, width) :
+                    convert_alpha_row<rl::Bitmap::Depth::Sexdecuple, 4, Premultiply>(data, width);
+                break;
+            case rl::Bitmap::Depth::Normalized:
+                is_gray ?
+                    convert_alpha_row<rl::Bitmap::Depth::Normalized, 2, Premultiply>(data, width) :
+                    convert_alpha_row<rl::Bitmap::Depth::Normalized, 4, Premultiply>(data, width);
+                break;
+            case rl::Bitmap::Depth::Half:
+                is_gray ?
+                    convert_alpha_row<rl::Bitmap::Depth::Half, 2, Premultiply>(data, width) :
+                    convert_alpha_row<rl::Bitmap::Depth::Half, 4, Premultiply>(data, width);
+                break;
+            case rl::Bitmap::Depth::Single:
+            case rl::Bitmap::Depth::Duple:
+            case rl::Bitmap::Depth::Quadruple:
+                // the alpha of sub-byte rows is converted in octuple chunks
+                break;
+        }
+    }
+}
+
+void rl::Bitmap::premultiply_row(rl::Bitmap::byte_t* data, std::size_t width, rl::Bitmap::Depth depth, rl::Bitmap::Color color) noexcept
+{
+    convert_alpha_row<true>(data, width, depth, color);
+}
+
+void rl::Bitmap::unpremultiply_row(rl::Bitmap::byte_t* data, std::size_t width, rl::Bitmap::Depth depth, rl::Bitmap::Color color) noexcept
+{
+    convert_alpha_row<false>(data, width, depth, color);
+}
+
+void rl::Bitmap::Row::blit_alpha(const rl::Bitmap::Row::View& row, const rl::gray_mode& gray)
+{
+    // the alpha is converted on a chunk with the color of the premultiplied side so the chunk always has the alpha
+    // channel. the depth enum is not ordered by precision, so any side with more than 8 bits per channel converts in
+    // normalized, which holds sexdecuple and half channels without loss.
+    const auto get_is_octuple_or_less = [](rl::Bitmap::Depth depth)
+    {
+        return depth == rl::Bitmap::Depth::Octuple || rl::Bitmap::GetIsSubByte(depth);
+    };
+    const auto chunk_depth =
+        (get_is_octuple_or_less(row.GetDepth()) && get_is_octuple_or_less(this->depth)) ?
+            rl::Bitmap::Depth::Octuple :
+            rl::Bitmap::Depth::Normalized;
+    const auto chunk_color = row.GetIsPremultiplied() ? row.GetColor() : this->color;
+    constexpr std::size_t chunk_width = 64;
+    constexpr std::size_t max_pixel_size = 16;
+    std::array<rl::Bitmap::byte_t, chunk_width * max_pixel_size> chunk;
+    for (std::size_t chunk_x = 0; chunk_x < this->width; chunk_x += chunk_width)
+    {
+        const std::size_t width = std::min(chunk_width, this->width - chunk_x);
+        rl::Bitmap::Row(chunk.data(), width, chunk_depth, chunk_color).blit(
+            rl::Bitmap::Row::View(
+                row.GetData(chunk_x, 0),
+                width,
+                row.GetDepth(),
+                row.GetColor(),
+                row.GetLayout(),
+                row.GetPlaneOffset()
+            ),
+            rl::Bitmap::Blend::Replace,
+            gray
+        );
+        if (row.GetIsPremultiplied())
+        {
+            rl::Bitmap::unpremultiply_row(chunk.data(), width, chunk_depth, chunk_color);
+        }
+        else
+        {
+            rl::Bitmap::premultiply_row(chunk.data(), width, chunk_depth, chunk_color);
+        }
+        rl::Bitmap::Row(this->GetData(chunk_x, 0), width, this->depth, this->color, this->layout, this->plane_offset).blit(
+            rl::Bitmap::Row::View(chunk.data(), width, chunk_depth, chunk_color),
+            rl::Bitmap::Blend::Replace,
+            gray
+        );
+    }
+}
+
+namespace
+{
+    using palette_table_t = std::array<std::uint32_t, 256>;
+
+    // the palette as straight rgba octuple pixels packed in 32 bits, with transparent black past its end
+    palette_table_t make_palette_table(rl::Bitmap::palette_t palette) noexcept
+    {
+        palette_table_t table = {};
+        const std::size_t color_count = std::min(palette.size(), table.size());
+        for (std::size_t color_i = 0; color_i < color_count; color_i++)
+        {
+            const std::array<rl::Bitmap::octuple_t, 4> channels = { palette[color_i].r, palette[color_i].g, palette[color_i].b, palette[color_i].a };
+            std::memcpy(&table[color_i], channels.data(), sizeof(std::uint32_t));
+        }
+        return table;
+    }
+
+#if defined(RL_SIMD_X86)
+    // gathers 8 palette colors at once. rgb rows pack the 8 gathered pixels down to 24 bytes. returns the number of
+    // pixels expanded.
+    RL_TARGET_AVX2 std::size_t expand_indexes_avx2(const std::uint8_t* indexes, rl::Bitmap::byte_t* destination, std::size_t width, bool has_alpha, const palette_table_t& table) noexcept
+    {
+        const __m256i pack_shuffle =
+            _mm256_setr_epi8(
+                0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1,
+                0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1
+            );
+        const __m256i pack_permute = _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 7, 7);
+        std::size_t x = 0;
+        for (; x + 8 <= width; x += 8)
+        {
+            const __m256i lanes = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(indexes + x)));
+            const __m256i pixels = _mm256_i32gather_epi32(reinterpret_cast<const int*>(table.data()), lanes, 4);
+            if (has_alpha)
+            {
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(destination + x * 4), pixels);
+            }
+            else
+            {
+                const __m256i packed = _mm256_permutevar8x32_epi32(_mm256_shuffle_epi8(pixels, pack_shuffle), pack_permute);
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + x * 3), _mm256_castsi256_si128(packed));
+                _mm_storel_epi64(reinterpret_cast<__m128i*>(destination + x * 3 + 16), _mm256_extracti128_si256(packed, 1));
+            }
+        }
+        return x;
+    }
+#endif
+
+    // writes the palette colors of a row of indexes as straight rgb or rgba octuple pixels
+    void expand_indexes(const std::uint8_t* indexes, rl::Bitmap::byte_t* destination, std::size_t width, bool has_alpha, const palette_table_t& table) noexcept
+    {
+        const std::size_t pixel_size = has_alpha ? 4 : 3;
+        std::size_t x = 0;
+#if defined(RL_SIMD_X86)
+        if (rl::get_simd_level() == rl::SimdLevel::Avx2)
+        {
+            x = expand_indexes_avx2(indexes, destination, width, has_alpha, table);
+        }
+#endif
+        for (; x < width; x++)
+        {
+            std::memcpy(destination + x * pixel_size, &table[indexes[x]], pixel_size);
+        }
+    }
+
+    // the packed colors of a palette sorted for exact lookups. repeated colors map to their first index.
+    struct palette_lookup
+    {
+        std::array<std::pair<std::uint32_t, std::uint8_t>, 256> colors = {};
+        std::size_t color_count = 0;
+        palette_table_t table = {};
+    };
+
+    palette_lookup make_palette_lookup(rl::Bitmap::palette_t palette) noexcept
+    {
+        palette_lookup lookup;
+        lookup.table = make_palette_table(palette);
+        lookup.color_count = std::min(palette.size(), lookup.colors.size());
+        for (std::size_t color_i = 0; color_i < lookup.color_count; color_i++)
+        {
+            lookup.colors[color_i] = { lookup.table[color_i], static_cast<std::uint8_t>(color_i) };
+        }
+        std::sort(lookup.colors.begin(), lookup.colors.begin() + lookup.color_count);
+        return lookup;
+    }
+
+    // the index of the palette color equal to the pixel, or else the nearest one by squared distance
+    std::uint8_t get_palette_index(const palette_lookup& lookup, std::uint32_t pixel) noexcept
+    {
+        const auto colors_end = lookup.colors.begin() + lookup.color_count;
+        const auto color_it =
+            std::lower_bound(
+                lookup.colors.begin(),
+                colors_end,
+                pixel,
+                [](const std::pair<std::uint32_t, std::uint8_t>& color, std::uint32_t pixel)
+                {
+                    return color.first < pixel;
+                }
+            );
+        if (color_it != colors_end && color_it->first == pixel)
+        {
+            return color_it->second;
+        }
+        std::uint8_t nearest_index = 0;
+        std::uint32_t nearest_distance = std::numeric_limits<std::uint32_t>::max();
+        for (std::size_t color_i = 0; color_i < lookup.color_count; color_i++)
+        {
+            std::uint32_t distance = 0;
+            for (std::size_t channel_i = 0; channel_i < 4; channel_i++)
+            {
+                const int difference =
+                    static_cast<int>((pixel >> (channel_i * 8)) & 0xFF) -
+                    static_cast<int>((lookup.table[color_i] >> (channel_i * 8)) & 0xFF);
+                distance += static_cast<std::uint32_t>(difference * difference);
+            }
+            if (distance < nearest_distance)
+            {
+                nearest_distance = distance;
+                nearest_index = static_cast<std::uint8_t>(color_i);
+            }
+        }
+        return nearest_index;
+    }
+}
+
+void rl::Bitmap::Row::blit_indexed(const rl::Bitmap::Row::View& row, rl::Bitmap::Blend blend, const rl::gray_mode& gray)
+{
+    const bool is_source_indexed = row.GetColor() == rl::Bitmap::Color::Indexed;
+    const bool is_destination_indexed = this->color == rl::Bitmap::Color::Indexed;
+    if (is_destination_indexed && blend != rl::Bitmap::Blend::Replace)
+    {
+        throw rl::runtime_error("blend into indexed row");
+    }
+    if (is_source_indexed && is_destination_indexed)
+    {
+        std::memmove(this->data, row.GetData(), this->width);
+        return;
+    }
+    // the other side goes through chunks of straight rgba octuple pixels
+    constexpr std::size_t chunk_width = 64;
+    std::array<std::uint32_t, chunk_width> chunk;
+    auto* chunk_data = reinterpret_cast<rl::Bitmap::byte_t*>(chunk.data());
+    if (is_source_indexed)
+    {
+        const auto table = make_palette_table(row.GetPalette());
+        // straight rgb and rgba octuple rows are written straight from the palette
+        const bool is_direct =
+            blend == rl::Bitmap::Blend::Replace &&
+            row.GetSpace() == this->space &&
+            this->depth == rl::Bitmap::Depth::Octuple &&
+            this->layout != rl::Bitmap::Layout::Planar &&
+            (this->color == rl::Bitmap::Color::Rgb || (this->color == rl::Bitmap::Color::Rgba && !this->GetIsPremultiplied()));
+        if (is_direct)
+        {
+            expand_indexes(reinterpret_cast<const std::uint8_t*>(row.GetData()), this->data, this->width, this->color == rl::Bitmap::Color::Rgba, table);
+            return;
+        }
+        for (std::size_t chunk_x = 0; chunk_x < this->width; chunk_x += chunk_width)
+        {
+            const std::size_t width = std::min(chunk_width, this->width - chunk_x);
+            expand_indexes(reinterpret_cast<const std::uint8_t*>(row.GetData(chunk_x, 0)), chunk_data, width, true, table);
+            rl::Bitmap::Row(this->GetData(chunk_x, 0), width, this->depth, this->color, this->layout, this->plane_offset, this->alpha, {}, this->space).blit(
+                rl::Bitmap::Row::View(chunk_data, width, rl::Bitmap::Depth::Octuple, rl::Bitmap::Color::Rgba, rl::Bitmap::Layout::Linear, std::nullopt, rl::Bitmap::Alpha::Straight, {}, row.GetSpace()),
+                blend,
+                gray
+            );
+        }
+        return;
+    }
+    const auto lookup = make_palette_lookup(this->palette);
+    auto* indexes = reinterpret_cast<std::uint8_t*>(this->data);
+    // neighbouring pixels often have the same color, so the last match is kept
+    std::uint32_t last_pixel = 0;
+    std::uint8_t last_index = get_palette_index(lookup, last_pixel);
+    for (std::size_t chunk_x = 0; chunk_x < this->width; chunk_x += chunk_width)
+    {
+        const std::size_t width = std::min(chunk_width, this->width - chunk_x);
+        rl::Bitmap::Row(chunk_data, width, rl::Bitmap::Depth::Octuple, rl::Bitmap::Color::Rgba, rl::Bitmap::Layout::Linear, std::nullopt, rl::Bitmap::Alpha::Straight, {}, this->space).blit(
+            rl::Bitmap::Row::View(row.GetData(chunk_x, 0), width, row.GetDepth(), row.GetColor(), row.GetLayout(), row.GetPlaneOffset(), row.GetAlpha(), {}, row.GetSpace()),
+            rl::Bitmap::Blend::Replace,
+            gray
+        );
+        for (std::size_t x = 0; x < width; x++)
+        {
+            if (chunk[x] != last_pixel)
+            {
+                last_pixel = chunk[x];
+                last_index = get_palette_index(lookup, last_pixel);
+            }
+            indexes[chunk_x + x] = last_index;
+        }
+    }
+}
+
+namespace
+{
+    // sub-byte channels are stored as integers up to their max value. color channels scale between that and 255 like
+    // pngs do, indexes are copied as they are and only keep the bits that fit.
+    constexpr std::uint8_t get_sub_byte_max(std::size_t bit_depth) noexcept
+    {
+        return static_cast<std::uint8_t>((1u << bit_depth) - 1);
+    }
+
+    constexpr std::uint8_t unpack_sample(std::uint8_t value, std::size_t bit_depth, bool is_scaled) noexcept
+    {
+        return is_scaled ? static_cast<std::uint8_t>(value * (255 / get_sub_byte_max(bit_depth))) : value;
+    }
+
+    constexpr std::uint8_t pack_sample(std::uint8_t value, std::size_t bit_depth, bool is_scaled) noexcept
+    {
+        const std::uint32_t max = get_sub_byte_max(bit_depth);
+        // rounds value * max / 255, which never lands halfway
+        return static_cast<std::uint8_t>(is_scaled ? (value * max + 127) / 255 : value & max);
+    }
+
+#if defined(RL_SIMD_X86)
+    // unpacks 16 bytes at a time. returns the number of samples unpacked.
+    RL_TARGET_SSSE3 std::size_t unpack_samples_ssse3(const rl::Bitmap::byte_t* source, std::size_t count, std::size_t bit_depth, bool is_scaled, std::uint8_t* destination) noexcept
+    {
+        const std::size_t block_count = 128 / bit_depth;
+        std::size_t sample_i = 0;
+        if (bit_depth == 1)
+        {
+            // every byte is spread over 8 lanes, and each lane keeps its own bit
+            const __m128i bits = _mm_setr_epi8(-128, 64, 32, 16, 8, 4, 2, 1, -128, 64, 32, 16, 8, 4, 2, 1);
+            const __m128i spread_step = _mm_set1_epi8(2);
+            const __m128i ones = _mm_set1_epi8(1);
+            for (; sample_i + block_count <= count; sample_i += block_count)
+            {
+                const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + sample_i / 8));
+                __m128i spread = _mm_setr_epi8(0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1);
+                for (std::size_t pair_i = 0; pair_i < 8; pair_i++)
+                {
+                    __m128i samples = _mm_cmpeq_epi8(_mm_and_si128(_mm_shuffle_epi8(bytes, spread), bits), bits);
+                    if (!is_scaled)
+                    {
+                        samples = _mm_and_si128(samples, ones);
+                    }
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + sample_i + pair_i * 16), samples);
+                    spread = _mm_add_epi8(spread, spread_step);
+                }
+            }
+            return sample_i;
+        }
+        const std::uint8_t max = get_sub_byte_max(bit_depth);
+        const __m128i mask = _mm_set1_epi8(static_cast<char>(max));
+        // the scaled value of every sample fits a 16 entry table
+        std::array<std::uint8_t, 16> scale_table = {};
+        for (std::size_t value = 0; value <= max; value++)
+        {
+            scale_table[value] = unpack_sample(static_cast<std::uint8_t>(value), bit_depth, is_scaled);
+        }
+        const __m128i scale = _mm_loadu_si128(reinterpret_cast<const __m128i*>(scale_table.data()));
+        for (; sample_i + block_count <= count; sample_i += block_count)
+        {
+            const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + sample_i * bit_depth / 8));
+            std::uint8_t* samples = destination + sample_i;
+            if (bit_depth == 4)
+            {
+                const __m128i high = _mm_shuffle_epi8(scale, _mm_and_si128(_mm_srli_epi16(bytes, 4), mask));
+                const __m128i low = _mm_shuffle_epi8(scale, _mm_and_si128(bytes, mask));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(samples), _mm_unpacklo_epi8(high, low));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(samples + 16), _mm_unpackhi_epi8(high, low));
+            }
+            else
+            {
+                const __m128i first = _mm_shuffle_epi8(scale, _mm_and_si128(_mm_srli_epi16(bytes, 6), mask));
+                const __m128i second = _mm_shuffle_epi8(scale, _mm_and_si128(_mm_srli_epi16(bytes, 4), mask));
+                const __m128i third = _mm_shuffle_epi8(scale, _mm_and_si128(_mm_srli_epi16(bytes, 2), mask));
+                const __m128i fourth = _mm_shuffle_epi8(scale, _mm_and_si128(bytes, mask));
+                const __m128i low_front = _mm_unpacklo_epi8(first, second);
+                const __m128i low_back = _mm_unpacklo_epi8(third, fourth);
+                const __m128i high_front = _mm_unpackhi_epi8(first, second);
+                const __m128i high_back = _mm_unpackhi_epi8(third, fourth);
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(samples), _mm_unpacklo_epi16(low_front, low_back));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(samples + 16), _mm_unpackhi_epi16(low_front, low_back));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(samples + 32), _mm_unpacklo_epi16(high_front, high_back));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(samples + 48), _mm_unpackhi_epi16(high_front, high_back));
+            }
+        }
+        return sample_i;
+    }
+
+    // rounds 16 octuple samples to the max value of a sub-byte depth, or masks 16 indexes to it
+    RL_TARGET_SSSE3 inline __m128i quantize_samples_ssse3(__m128i samples, std::size_t bit_depth, bool is_scaled) noexcept
+    {
+        const std::uint8_t max = get_sub_byte_max(bit_depth);
+        if (!is_scaled)
+        {
+            return _mm_and_si128(samples, _mm_set1_epi8(static_cast<char>(max)));
+        }
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i maxes = _mm_set1_epi16(max);
+        const __m128i half = _mm_set1_epi16(128);
+        const auto quantize =
+            [&](__m128i values)
+            {
+                // the same rounded division by 255 as the blend kernels
+                values = _mm_add_epi16(_mm_mullo_epi16(values, maxes), half);
+                return _mm_srli_epi16(_mm_add_epi16(values, _mm_srli_epi16(values, 8)), 8);
+            };
+        return _mm_packus_epi16(quantize(_mm_unpacklo_epi8(samples, zero)), quantize(_mm_unpackhi_epi8(samples, zero)));
+    }
+
+    // packs 16 samples of 2 bits into the low bytes of 4 32 bit lanes
+    RL_TARGET_SSSE3 inline __m128i pack_duple_samples_ssse3(__m128i samples, bool is_scaled) noexcept
+    {
+        const __m128i pair_weights = _mm_set1_epi16(0x0104);
+        const __m128i quad_weights = _mm_set1_epi32(0x00010010);
+        return _mm_madd_epi16(_mm_maddubs_epi16(quantize_samples_ssse3(samples, 2, is_scaled), pair_weights), quad_weights);
+    }
+
+    // packs 16 whole bytes at a time. returns the number of samples packed.
+    RL_TARGET_SSSE3 std::size_t pack_samples_ssse3(const std::uint8_t* source, std::size_t count, std::size_t bit_depth, bool is_scaled, rl::Bitmap::byte_t* destination) noexcept
+    {
+        const std::size_t block_count = 128 / bit_depth;
+        std::size_t sample_i = 0;
+        for (; sample_i + block_count <= count; sample_i += block_count)
+        {
+            const std::uint8_t* samples = source + sample_i;
+            rl::Bitmap::byte_t* bytes = destination + sample_i * bit_depth / 8;
+            const auto load =
+                [&](std::size_t offset)
+                {
+                    return _mm_loadu_si128(reinterpret_cast<const __m128i*>(samples + offset));
+                };
+            if (bit_depth == 1)
+            {
+                // the sign bit of each byte is its bit, reversed within every 8 bytes so the first sample is the
+                // most significant
+                const __m128i reverse = _mm_setr_epi8(7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8);
+                for (std::size_t pair_i = 0; pair_i < 8; pair_i++)
+                {
+                    __m128i values = load(pair_i * 16);
+                    if (!is_scaled)
+                    {
+                        values = _mm_slli_epi16(values, 7);
+                    }
+                    const auto mask = static_cast<std::uint16_t>(_mm_movemask_epi8(_mm_shuffle_epi8(values, reverse)));
+                    std::memcpy(bytes + pair_i * 2, &mask, sizeof(mask));
+                }
+            }
+            else if (bit_depth == 2)
+            {
+                const __m128i front = _mm_packs_epi32(pack_duple_samples_ssse3(load(0), is_scaled), pack_duple_samples_ssse3(load(16), is_scaled));
+                const __m128i back = _mm_packs_epi32(pack_duple_samples_ssse3(load(32), is_scaled), pack_duple_samples_ssse3(load(48), is_scaled));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(bytes), _mm_packus_epi16(front, back));
+            }
+            else
+            {
+                const __m128i pair_weights = _mm_set1_epi16(0x0110);
+                const __m128i front = _mm_maddubs_epi16(quantize_samples_ssse3(load(0), bit_depth, is_scaled), pair_weights);
+                const __m128i back = _mm_maddubs_epi16(quantize_samples_ssse3(load(16), bit_depth, is_scaled), pair_weights);
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(bytes), _mm_packus_epi16(front, back));
+            }
+        }
+        return sample_i;
+    }
+#endif
+
+    bool get_is_sub_byte_simd() noexcept
+    {
+        const auto level = rl::get_simd_level();
+        return level == rl::SimdLevel::Ssse3 || level == rl::SimdLevel::Avx2;
+    }
+
+    // unpacks count samples that start on a whole byte to one byte each
+    void unpack_samples(const rl::Bitmap::byte_t* source, std::size_t count, std::size_t bit_depth, bool is_scaled, std::uint8_t* destination) noexcept
+    {
+        std::size_t sample_i = 0;
+#if defined(RL_SIMD_X86)
+        if (get_is_sub_byte_simd())
+        {
+            sample_i = unpack_samples_ssse3(source, count, bit_depth, is_scaled, destination);
+        }
+#endif
+        const std::uint8_t max = get_sub_byte_max(bit_depth);
+        const auto* bytes = reinterpret_cast<const std::uint8_t*>(source);
+        for (; sample_i < count; sample_i++)
+        {
+            const std::size_t bit_i = sample_i * bit_depth;
+            const auto value = static_cast<std::uint8_t>((bytes[bit_i / 8] >> (8 - bit_depth - bit_i % 8)) & max);
+            destination[sample_i] = unpack_sample(value, bit_depth, is_scaled);
+        }
+    }
+
+    // packs count samples into bytes that start on a whole byte. the bits after the last sample are left as they are.
+    void pack_samples(const std::uint8_t* source, std::size_t count, std::size_t bit_depth, bool is_scaled, rl::Bitmap::byte_t* destination) noexcept
+    {
+        std::size_t sample_i = 0;
+#if defined(RL_SIMD_X86)
+        if (get_is_sub_byte_simd())
+        {
+            sample_i = pack_samples_ssse3(source, count, bit_depth, is_scaled, destination);
+        }
+#endif
+        const std::uint8_t max = get_sub_byte_max(bit_depth);
+        auto* bytes = reinterpret_cast<std::uint8_t*>(destination);
+        for (; sample_i < count; sample_i++)
+        {
+            const std::size_t bit_i = sample_i * bit_depth;
+            const std::size_t shift = 8 - bit_depth - bit_i % 8;
+            std::uint8_t& byte = bytes[bit_i / 8];
+            byte = static_cast<std::uint8_t>((byte & ~(max << shift)) | (pack_sample(source[sample_i], bit_depth, is_scaled) << shift));
+        }
+    }
+
+    // copies bit_count bits that start on a whole byte, leaving the bits after them as they are
+    void copy_bits(const rl::Bitmap::byte_t* source, rl::Bitmap::byte_t* destination, std::size_t bit_count) noexcept
+    {
+        std::memmove(destination, source, bit_count / 8);
+        if (bit_count % 8 != 0)
+        {
+            const auto mask = static_cast<std::uint8_t>(0xFF00 >> (bit_count % 8));
+            const auto source_byte = std::to_integer<std::uint8_t>(source[bit_count / 8]);
+            const auto destination_byte = std::to_integer<std::uint8_t>(destination[bit_count / 8]);
+            destination[bit_count / 8] = static_cast<rl::Bitmap::byte_t>((destination_byte & ~mask) | (source_byte & mask));
+        }
+    }
+
+    // unpacks or packs every channel of a row. planar rows unpack each plane to a plane of the chunk, other rows unpack
+    // their interleaved channels as they are.
+    template<typename F>
+    void for_each_sub_byte_plane(rl::Bitmap::Color color, rl::Bitmap::Layout layout, std::size_t width, const F& transfer)
+    {
+        const std::size_t channel_count = rl::Bitmap::GetChannelCount(color);
+        if (layout == rl::Bitmap::Layout::Planar)
+        {
+            for (std::size_t channel_i = 0; channel_i < channel_count; channel_i++)
+            {
+                transfer(channel_i, width);
+            }
+            return;
+        }
+        transfer(0, width * channel_count);
+    }
+}
+
+void rl::Bitmap::Row::blit_sub_byte(const rl::Bitmap::Row::View& row, rl::Bitmap::Blend blend, const rl::gray_mode& gray)
+{
+    const bool is_source_sub_byte = rl::Bitmap::GetIsSubByte(row.GetDepth());
+    const bool is_destination_sub_byte = rl::Bitmap::GetIsSubByte(this->depth);
+    // rows of the same format copy their bits straight over
+    if (
+        blend == rl::Bitmap::Blend::Replace &&
+        row.GetDepth() == this->depth &&
+        row.GetColor() == this->color &&
+        row.GetLayout() == this->layout &&
+        (row.GetSpace() == this->space || row.GetColor() == rl::Bitmap::Color::Indexed) &&
+        !rl::Bitmap::get_is_alpha_conversion(row.GetColor(), row.GetIsPremultiplied(), this->GetIsPremultiplied())
+    )
+    {
+        for_each_sub_byte_plane(
+            this->color,
+            this->layout,
+            this->width,
+            [&](std::size_t plane_i, std::size_t count)
+            {
+                copy_bits(row.GetData() + plane_i * row.GetPlaneOffset(), this->data + plane_i * this->plane_offset, count * this->GetBitDepth());
+            }
+        );
+        return;
+    }
+    // chunks of whole bytes, so every chunk of a sub-byte row starts on a whole byte
+    constexpr std::size_t chunk_width = 256;
+    constexpr std::size_t max_channel_count = 4;
+    std::array<std::uint8_t, chunk_width * max_channel_count> source_chunk;
+    std::array<std::uint8_t, chunk_width * max_channel_count> destination_chunk;
+    const bool is_source_scaled = row.GetColor() != rl::Bitmap::Color::Indexed;
+    const bool is_destination_scaled = this->color != rl::Bitmap::Color::Indexed;
+    // nearest colors are only looked for in the part of the palette the indexes can reach
+    const auto destination_palette =
+        is_destination_sub_byte ?
+            this->palette.first(std::min<std::size_t>(this->palette.size(), std::size_t{1} << this->GetBitDepth())) :
+            this->palette;
+    const auto get_chunk_plane_offset =
+        [&](rl::Bitmap::Layout layout)
+        {
+            return (layout == rl::Bitmap::Layout::Planar) ? std::optional<std::size_t>(chunk_width) : std::nullopt;
+        };
+    for (std::size_t chunk_x = 0; chunk_x < this->width; chunk_x += chunk_width)
+    {
+        const std::size_t width = std::min(chunk_width, this->width - chunk_x);
+        rl::Bitmap::Row::View source(row.GetData(chunk_x, 0), width, row.GetDepth(), row.GetColor(), row.GetLayout(), row.GetPlaneOffset(), row.GetAlpha(), row.GetPalette(), row.GetSpace());
+        if (is_source_sub_byte)
+        {
+            for_each_sub_byte_plane(
+                row.GetColor(),
+                row.GetLayout(),
+                width,
+                [&](std::size_t plane_i, std::size_t count)
+                {
+                    unpack_samples(source.GetData() + plane_i * row.GetPlaneOffset(), count, row.GetBitDepth(), is_source_scaled, source_chunk.data() + plane_i * chunk_width);
+                }
+            );
+            source =
+                rl::Bitmap::Row::View(
+                    reinterpret_cast<const rl::Bitmap::byte_t*>(source_chunk.data()),
+                    width,
+                    rl::Bitmap::Depth::Octuple,
+                    row.GetColor(),
+                    row.GetLayout(),
+                    get_chunk_plane_offset(row.GetLayout()),
+                    row.GetAlpha(),
+                    row.GetPalette(),
+                    row.GetSpace()
+                );
+        }
+        rl::Bitmap::Row destination(this->GetData(chunk_x, 0), width, this->depth, this->color, this->layout, this->plane_offset, this->alpha, this->palette, this->space);
+        if (!is_destination_sub_byte)
+        {
+            destination.blit(source, blend, gray);
+            continue;
+        }
+        rl::Bitmap::Row chunk(
+            reinterpret_cast<rl::Bitmap::byte_t*>(destination_chunk.data()),
+            width,
+            rl::Bitmap::Depth::Octuple,
+            this->color,
+            this->layout,
+            get_chunk_plane_offset(this->layout),
+            this->alpha,
+            destination_palette,
+            this->space
+        );
+        const auto transfer_destination =
+            [&](bool is_pack)
+            {
+                for_each_sub_byte_plane(
+                    this->color,
+                    this->layout,
+                    width,
+                    [&](std::size_t plane_i, std::size_t count)
+                    {
+                        rl::Bitmap::byte_t* plane = destination.GetData() + plane_i * this->plane_offset;
+                        std::uint8_t* chunk_plane = destination_chunk.data() + plane_i * chunk_width;
+                        if (is_pack)
+                        {
+                            pack_samples(chunk_plane, count, this->GetBitDepth(), is_destination_scaled, plane);
+                        }
+                        else
+                        {
+                            unpack_samples(plane, count, this->GetBitDepth(), is_destination_scaled, chunk_plane);
+                        }
+                    }
+                );
+            };
+        // blends need the pixels they blend onto
+        if (blend != rl::Bitmap::Blend::Replace)
+        {
+            transfer_destination(false);
+        }
+        chunk.blit(source, blend, gray);
+        transfer_destination(true);
+    }
+}
+
+namespace
+{
+    // log2 of a positive float from its exponent and the atanh series of its mantissa, which is moved into
+    // [sqrt(1/2), sqrt(2)] so the series converges quickly
+    float log2_polynomial(float value) noexcept
+    {
+        const auto bits = std::bit_cast<std::uint32_t>(value);
+        float exponent = static_cast<float>(static_cast<std::int32_t>(bits >> 23) - 127);
+        float mantissa = std::bit_cast<float>((bits & 0x007fffff) | 0x3f800000);
+        if (mantissa > 1.41421356f)
+        {
+            mantissa *= 0.5f;
+            exponent += 1.0f;
+        }
+        // ln(m) = 2 (t + t^3 / 3 + t^5 / 5 + ...) where t = (m - 1) / (m + 1)
+        const float t = (mantissa - 1.0f) / (mantissa + 1.0f);
+        const float t2 = t * t;
+        const float series = ((((t2 * (2.0f / 11.0f) + 2.0f / 9.0f) * t2 + 2.0f / 7.0f) * t2 + 2.0f / 5.0f) * t2 + 2.0f / 3.0f) * t2 + 2.0f;
+        return exponent + t * series * 1.44269504f;
+    }
+
+    // 2^value from the bits of its nearest whole power and the taylor series of the rest, which is in [-1/2, 1/2]
+    float exp2_polynomial(float value) noexcept
+    {
+        value = std::max(-126.0f, std::min(127.0f, value));
+        const float whole = std::floor(value + 0.5f);
+        const float x = (value - whole) * 0.693147181f;
+        const float series = ((((((x * (1.0f / 5040.0f) + 1.0f / 720.0f) * x + 1.0f / 120.0f) * x + 1.0f / 24.0f) * x + 1.0f / 6.0f) * x + 0.5f) * x + 1.0f) * x + 1.0f;
+        return series * std::bit_cast<float>(static_cast<std::uint32_t>(static_cast<std::int32_t>(whole) + 127) << 23);
+    }
+
+    float decode_srgb(float value) noexcept
+    {
+        return (value <= 0.04045f) ? value / 12.92f : exp2_polynomial(log2_polynomial((value + 0.055f) / 1.055f) * 2.4f);
+    }
+
+    float encode_srgb(float value) noexcept
+    {
+        return (value <= 0.0031308f) ? value * 12.92f : exp2_polynomial(log2_polynomial(value) * (1.0f / 2.4f)) * 1.055f - 0.055f;
+    }
+
+    // decodes or encodes the colors of the values first to last of a row of straight normalized pixels in place, leaving
+    // the alpha linear
+    template<bool IsDecode>
+    void code_srgb_values(float* data, std::size_t first, std::size_t last, std::size_t channel_count, bool has_alpha) noexcept
+    {
+        for (std::size_t value_i = first; value_i < last; value_i++)
+        {
+            if (!has_alpha || value_i % channel_count != channel_count - 1)
+            {
+                data[value_i] = IsDecode ? decode_srgb(data[value_i]) : encode_srgb(data[value_i]);
+            }
+        }
+    }
+
+#if defined(RL_SIMD_X86)
+    // the same operations as the scalar functions, so both give the same floats
+    RL_TARGET_AVX2 inline __m256 log2_polynomial_avx2(__m256 value) noexcept
+    {
+        const __m256i bits = _mm256_castps_si256(value);
+        __m256 exponent = _mm256_cvtepi32_ps(_mm256_sub_epi32(_mm256_srli_epi32(bits, 23), _mm256_set1_epi32(127)));
+        __m256 mantissa = _mm256_castsi256_ps(_mm256_or_si256(_mm256_and_si256(bits, _mm256_set1_epi32(0x007fffff)), _mm256_set1_epi32(0x3f800000)));
+        const __m256 is_large = _mm256_cmp_ps(mantissa, _mm256_set1_ps(1.41421356f), _CMP_GT_OQ);
+        mantissa = _mm256_blendv_ps(mantissa, _mm256_mul_ps(mantissa, _mm256_set1_ps(0.5f)), is_large);
+        exponent = _mm256_add_ps(exponent, _mm256_and_ps(is_large, _mm256_set1_ps(1.0f)));
+        const __m256 t = _mm256_div_ps(_mm256_sub_ps(mantissa, _mm256_set1_ps(1.0f)), _mm256_add_ps(mantissa, _mm256_set1_ps(1.0f)));
+        const __m256 t2 = _mm256_mul_ps(t, t);
+        __m256 series = _mm256_add_ps(_mm256_mul_ps(t2, _mm256_set1_ps(2.0f / 11.0f)), _mm256_set1_ps(2.0f / 9.0f));
+        series = _mm256_add_ps(_mm256_mul_ps(series, t2), _mm256_set1_ps(2.0f / 7.0f));
+        series = _mm256_add_ps(_mm256_mul_ps(series, t2), _mm256_set1_ps(2.0f / 5.0f));
+        series = _mm256_add_ps(_mm256_mul_ps(series, t2), _mm256_set1_ps(2.0f / 3.0f));
+        series = _mm256_add_ps(_mm256_mul_ps(series, t2), _mm256_set1_ps(2.0f));
+        return _mm256_add_ps(exponent, _mm256_mul_ps(_mm256_mul_ps(t, series), _mm256_set1_ps(1.44269504f)));
+    }
+
+    RL_TARGET_AVX2 inline __m256 exp2_polynomial_avx2(__m256 value) noexcept
+    {
+        value = _mm256_max_ps(_mm256_min_ps(value, _mm256_set1_ps(127.0f)), _mm256_set1_ps(-126.0f));
+        const __m256 whole = _mm256_floor_ps(_mm256_add_ps(value, _mm256_set1_ps(0.5f)));
+        const __m256 x = _mm256_mul_ps(_mm256_sub_ps(value, whole), _mm256_set1_ps(0.693147181f));
+        __m256 series = _mm256_add_ps(_mm256_mul_ps(x, _mm256_set1_ps(1.0f / 5040.0f)), _mm256_set1_ps(1.0f / 720.0f));
+        series = _mm256_add_ps(_mm256_mul_ps(series, x), _mm256_set1_ps(1.0f / 120.0f));
+        series = _mm256_add_ps(_mm256_mul_ps(series, x), _mm256_set1_ps(1.0f / 24.0f));
+        series = _mm256_add_ps(_mm256_mul_ps(series, x), _mm256_set1_ps(1.0f / 6.0f));
+        series = _mm256_add_ps(_mm256_mul_ps(series, x), _mm256_set1_ps(0.5f));
+        series = _mm256_add_ps(_mm256_mul_ps(series, x), _mm256_set1_ps(1.0f));
+        series = _mm256_add_ps(_mm256_mul_ps(series, x), _mm256_set1_ps(1.0f));
+        const __m256 power = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_add_epi32(_mm256_cvtps_epi32(whole), _mm256_set1_epi32(127)), 23));
+        return _mm256_mul_ps(series, power);
+    }
+
+    template<bool IsDecode>
+    RL_TARGET_AVX2 inline __m256 code_srgb_avx2(__m256 value) noexcept
+    {
+        if constexpr (IsDecode)
+        {
+            const __m256 curve = exp2_polynomial_avx2(_mm256_mul_ps(log2_polynomial_avx2(_mm256_div_ps(_mm256_add_ps(value, _mm256_set1_ps(0.055f)), _mm256_set1_ps(1.055f))), _mm256_set1_ps(2.4f)));
+            return _mm256_blendv_ps(curve, _mm256_div_ps(value, _mm256_set1_ps(12.92f)), _mm256_cmp_ps(value, _mm256_set1_ps(0.04045f), _CMP_LE_OQ));
+        }
+        else
+        {
+            const __m256 curve = _mm256_sub_ps(_mm256_mul_ps(exp2_polynomial_avx2(_mm256_mul_ps(log2_polynomial_avx2(value), _mm256_set1_ps(1.0f / 2.4f))), _mm256_set1_ps(1.055f)), _mm256_set1_ps(0.055f));
+            return _mm256_blendv_ps(curve, _mm256_mul_ps(value, _mm256_set1_ps(12.92f)), _mm256_cmp_ps(value, _mm256_set1_ps(0.0031308f), _CMP_LE_OQ));
+        }
+    }
+
+    template<bool IsDecode, std::size_t ChannelCount>
+    RL_TARGET_AVX2 void code_srgb_row_avx2(float* data, std::size_t width) noexcept
+    {
+        constexpr bool has_alpha = ChannelCount == 2 || ChannelCount == 4;
+        // the alpha lanes of eight values, which line up with every eight values of ga and rgba rows
+        constexpr int alpha_mask = (ChannelCount == 2) ? 0xaa : 0x88;
+        const std::size_t count = width * ChannelCount;
+        std::size_t value_i = 0;
+        for (; value_i + 8 <= count; value_i += 8)
+        {
+            const __m256 values = _mm256_loadu_ps(data + value_i);
+            __m256 coded = code_srgb_avx2<IsDecode>(values);
+            if constexpr (has_alpha)
+            {
+                coded = _mm256_blend_ps(coded, values, alpha_mask);
+            }
+            _mm256_storeu_ps(data + value_i, coded);
+        }
+        code_srgb_values<IsDecode>(data, value_i, count, ChannelCount, has_alpha);
+    }
+#endif
+
+    template<bool IsDecode>
+    void code_srgb_row(float* data, std::size_t width, rl::Bitmap::Color color) noexcept
+    {
+#if defined(RL_SIMD_X86)
+        if (rl::get_simd_level() == rl::SimdLevel::Avx2)
+        {
+            switch (color)
+            {
+                case rl::Bitmap::Color::G:
+                    code_srgb_row_avx2<IsDecode, 1>(data, width);
+                    return;
+                case rl::Bitmap::Color::Ga:
+                    code_srgb_row_avx2<IsDecode, 2>(data, width);
+                    return;
+                case rl::Bitmap::Color::Rgb:
+                    code_srgb_row_avx2<IsDecode, 3>(data, width);
+                    return;
+                case rl::Bitmap::Color::Rgba:
+                    code_srgb_row_avx2<IsDecode, 4>(data, width);
+                    return;
+                default:
+                    return;
+            }
+        }
+#endif
+        const std::size_t channel_count = rl::Bitmap::GetChannelCount(color);
+        code_srgb_values<IsDecode>(data, 0, width * channel_count, channel_count, get_has_alpha(color));
+    }
+}
+
+void rl::Bitmap::Row::blit_space(const rl::Bitmap::Row::View& row, rl::Bitmap::Blend blend, const rl::gray_mode& gray)
+{
+    const bool is_decode = this->space == rl::Bitmap::Space::Linear;
+    const bool is_straight = !row.GetIsPremultiplied() && !this->GetIsPremultiplied();
+    // straight integer rows decode into floating point rows through the linear tables, with nothing else to pay for
+    if (
+        is_decode &&
+        is_straight &&
+        blend == rl::Bitmap::Blend::Replace &&
+        row.GetLayout() != rl::Bitmap::Layout::Planar &&
+        this->layout != rl::Bitmap::Layout::Planar
+    )
+    {
+        const auto converter = rl::Bitmap::get_linear_row_converter(row.GetDepth(), row.GetColor(), this->depth, this->color);
+        if (converter != nullptr)
+        {
+            converter(row.GetData(), this->data, this->width);
+            return;
+        }
+    }
+    // the others go through chunks of straight normalized pixels of the source color, so premultiplied colors are coded
+    // without their alpha. integer sources are still decoded through the tables.
+    const auto chunk_depth = rl::Bitmap::Depth::Normalized;
+    const auto chunk_color = row.GetColor();
+    const auto table_converter =
+        (is_decode && !row.GetIsPremultiplied() && row.GetLayout() != rl::Bitmap::Layout::Planar) ?
+            rl::Bitmap::get_linear_row_converter(row.GetDepth(), row.GetColor(), chunk_depth, chunk_color) :
+            nullptr;
+    constexpr std::size_t chunk_width = 64;
+    constexpr std::size_t max_channel_count = 4;
+    std::array<rl::Bitmap::normalized_t, chunk_width * max_channel_count> chunk;
+    auto* chunk_data = reinterpret_cast<rl::Bitmap::byte_t*>(chunk.data());
+    for (std::size_t chunk_x = 0; chunk_x < this->width; chunk_x += chunk_width)
+    {
+        const std::size_t width = std::min(chunk_width, this->width - chunk_x);
+        if (table_converter != nullptr)
+        {
+            table_converter(row.GetData(chunk_x, 0), chunk_data, width);
+        }
+        else
+        {
+            rl::Bitmap::Row(chunk_data, width, chunk_depth, chunk_color).blit(
+                rl::Bitmap::Row::View(
+                    row.GetData(chunk_x, 0),
+                    width,
+                    row.GetDepth(),
+                    row.GetColor(),
+                    row.GetLayout(),
+                    row.GetPlaneOffset(),
+                    row.GetAlpha()
+                ),
+                rl::Bitmap::Blend::Replace,
+                gray
+            );
+            if (is_decode)
+            {
+                code_srgb_row<true>(chunk.data(), width, chunk_color);
+            }
+            else
+            {
+                code_srgb_row<false>(chunk.data(), width, chunk_color);
+            }
+        }
+        rl::Bitmap::Row(this->GetData(chunk_x, 0), width, this->depth, this->color, this->layout, this->plane_offset, this->alpha).blit(
+            rl::Bitmap::Row::View(chunk_data, width, chunk_depth, chunk_color),
+            blend,
+            gray
+        );
+    }
+}
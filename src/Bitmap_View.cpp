@@ -22,9 +22,37 @@
 
 #include <rla/Bitmap.hpp>
 #include <rla/Image.hpp>
+#include <rla/Executor.hpp>
+#include <rla/simd.hpp>
 #include <rld/except.hpp>
 #include "libpng_ext.hpp"
+#include "row_bands.hpp"
+#include "simd_target.hpp"
 #include <png.h>
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+namespace
+{
+    // pngs have no floating point depth, and only gray and palette pngs have sub-byte depths
+    rl::Bitmap::Depth get_write_depth(rl::Bitmap::Depth depth, rl::Bitmap::Color color) noexcept
+    {
+        if (depth == rl::Bitmap::Depth::Normalized || depth == rl::Bitmap::Depth::Half)
+        {
+            return rl::Bitmap::Depth::Sexdecuple;
+        }
+        if (rl::Bitmap::GetIsSubByte(depth) && color != rl::Bitmap::Color::G && color != rl::Bitmap::Color::Indexed)
+        {
+            return rl::Bitmap::Depth::Octuple;
+        }
+        return depth;
+    }
+}
 
 void rl::Bitmap::View::Save(std::string_view path, std::size_t page)
 {
@@ -32,6 +60,15 @@ void rl::Bitmap::View::Save(std::string_view path, std::size_t page)
     {
         throw rl::runtime_error("save page out of bitmap");
     }
+    // libpng reads whole rows, so copy the tiles into a linear image first
+    if (this->layout != rl::Bitmap::Layout::Linear)
+    {
+        rl::Image linear(this->width, this->height, 1, this->depth, this->color, rl::Bitmap::Layout::Linear, 1, std::nullopt, this->alpha, this->space);
+        linear.SetPalette(this->palette);
+        linear.Blit(this->GetBitmapView(0, 0, page, this->width, this->height, 1), 0, 0, 0);
+        linear.Save(path);
+        return;
+    }
     png_structp png_ptr = nullptr;
     png_infop info_ptr = nullptr;
     std::ofstream file;
@@ -44,10 +81,12 @@ void rl::Bitmap::View::Save(std::string_view path, std::size_t page)
         }
         rl::libpng_set_write_fn(png_ptr, file);
         const auto png_color = rl::bitmap_color_to_libpng_color(this->color);
-        // if the depth is normalized, need to convert each row while writing to a depth that libpng supports
-        if (this->depth == rl::Bitmap::Depth::Normalized)
+        const auto write_depth = get_write_depth(this->depth, this->color);
+        // pngs store straight alpha and srgb colors, so premultiplied bitmaps unpremultiply and linear bitmaps encode
+        // each row while it is written. the palettes of indexed bitmaps are written as they are.
+        const bool is_encoded = this->space == rl::Bitmap::Space::Linear && this->color != rl::Bitmap::Color::Indexed;
+        if (this->GetIsPremultiplied() || is_encoded)
         {
-            const auto write_depth = rl::Bitmap::Depth::Sexdecuple;
             rl::Image::Row convert_row(this->width, write_depth, this->color);
             png_set_IHDR(
                 png_ptr,
@@ -58,14 +97,36 @@ void rl::Bitmap::View::Save(std::string_view path, std::size_t page)
                 png_color,
                 PNG_INTERLACE_NONE, PNG_COMPRESSION_TYPE_BASE, PNG_FILTER_TYPE_BASE
             );
+            png_write_info(png_ptr, info_ptr);
+            rl::libpng_write_configure(png_ptr);
             for (std::size_t row_i = 0; row_i < this->height; row_i++)
             {
-                const auto source_row = this->GetRowView(row_i, page);
-                convert_row.Blit(source_row);
+                convert_row.Blit(this->GetRowView(row_i, page));
+                png_write_row(png_ptr, reinterpret_cast<png_const_bytep>(convert_row.GetData()));
+            }
+        }
+        // if libpng does not support the depth, need to convert each row while writing to a depth that it does
+        else if (write_depth != this->depth)
+        {
+            rl::Image::Row convert_row(this->width, write_depth, this->color);
+            png_set_IHDR(
+                png_ptr,
+                info_ptr,
+                static_cast<png_uint_32>(this->width),
+                static_cast<png_uint_32>(this->height),
+                rl::Bitmap::GetBitDepth(write_depth),
+                png_color,
+                PNG_INTERLACE_NONE, PNG_COMPRESSION_TYPE_BASE, PNG_FILTER_TYPE_BASE
+            );
+            png_write_info(png_ptr, info_ptr);
+            rl::libpng_write_configure(png_ptr);
+            for (std::size_t row_i = 0; row_i < this->height; row_i++)
+            {
+                convert_row.Blit(this->GetRowView(row_i, page));
                 png_write_row(png_ptr, reinterpret_cast<png_const_bytep>(convert_row.GetData()));
             }
         }
-        else // if (this->depth != rl::Bitmap::Depth::Normalized)
+        else // if (write_depth == this->depth)
         {
             png_set_IHDR(
                 png_ptr,
@@ -76,17 +137,392 @@ void rl::Bitmap::View::Save(std::string_view path, std::size_t page)
                 png_color,
                 PNG_INTERLACE_NONE, PNG_COMPRESSION_TYPE_BASE, PNG_FILTER_TYPE_BASE
             );
+            // indexed bitmaps write their indexes with their palette
+            if (this->color == rl::Bitmap::Color::Indexed)
+            {
+                // sub-byte indexes only reach the start of the palette
+                rl::libpng_write_palette(png_ptr, info_ptr, this->palette.first(std::min<std::size_t>(this->palette.size(), std::size_t{1} << this->GetBitDepth())));
+            }
+            png_write_info(png_ptr, info_ptr);
+            rl::libpng_write_configure(png_ptr);
             for (std::size_t row_i = 0; row_i < this->height; row_i++)
             {
                 const auto source_row = this->GetRowView(row_i, page);
                 png_write_row(png_ptr, reinterpret_cast<png_const_bytep>(source_row.GetData()));
             }
         }
+        png_write_end(png_ptr, nullptr);
         rl::libpng_write_close(png_ptr, info_ptr, file);
     }
-    catch(const std::exception& e)
+    catch(...)
     {
         rl::libpng_write_close(png_ptr, info_ptr, file);
-        throw e;
+        throw;
+    }
+}
+
+void rl::Bitmap::View::Save(const rl::ExecutionPolicy& policy, std::string_view path, std::size_t page)
+{
+    // only depths libpng does not support, premultiplied alpha and linear colors need converting before writing
+    const auto write_depth = get_write_depth(this->depth, this->color);
+    const bool is_encoded = this->space == rl::Bitmap::Space::Linear && this->color != rl::Bitmap::Color::Indexed;
+    if (
+        (write_depth == this->depth && !this->GetIsPremultiplied() && !is_encoded && this->layout == rl::Bitmap::Layout::Linear) ||
+        policy.GetIsSerial(this->GetPageSize())
+    )
+    {
+        this->Save(path, page);
+        return;
+    }
+    if (page >= this->GetPageCount())
+    {
+        throw rl::runtime_error("save page out of bitmap");
+    }
+    // convert the whole page up front in parallel, then write the converted page
+    rl::Image converted(this->width, this->height, 1, write_depth, this->color);
+    converted.SetPalette(this->palette);
+    converted.Blit(policy, this->GetBitmapView(0, 0, page, this->width, this->height, 1), 0, 0, 0);
+    converted.Save(path);
+}
+
+namespace
+{
+    // the statistics of a band of rows. zero pixels skipped as zero bytes are only counted, and land in the first bins
+    // when the bands are merged.
+    struct statistics_band
+    {
+        std::array<std::array<std::size_t, 256>, 4> histograms = {};
+        std::array<double, 4> minimums = {};
+        std::array<double, 4> maximums = {};
+        std::array<double, 4> sums = {};
+        std::size_t zero_count = 0;
+        std::size_t non_zero_count = 0;
+        std::size_t left = std::numeric_limits<std::size_t>::max();
+        std::size_t top = std::numeric_limits<std::size_t>::max();
+        std::size_t right = 0;
+        std::size_t bottom = 0;
+
+        statistics_band() noexcept
+        {
+            this->minimums.fill(std::numeric_limits<double>::infinity());
+            this->maximums.fill(-std::numeric_limits<double>::infinity());
+        }
+    };
+
+    std::size_t get_float_bin(float value) noexcept
+    {
+        // nans land in the first bin
+        return
+            !(value > 0.0f) ?
+                0 :
+                static_cast<std::size_t>(std::min(value, 1.0f) * 255.0f + 0.5f);
+    }
+
+    template<rl::Bitmap::Depth D>
+    struct statistics_channel;
+
+    template<>
+    struct statistics_channel<rl::Bitmap::Depth::Octuple>
+    {
+        using type = rl::Bitmap::octuple_t;
+        static double get_value(type channel) noexcept { return channel; }
+        static std::size_t get_bin(type channel) noexcept { return channel; }
+    };
+
+    template<>
+    struct statistics_channel<rl::Bitmap::Depth::Sexdecuple>
+    {
+        using type = rl::Bitmap::sexdecuple_t;
+        static double get_value(type channel) noexcept { return channel; }
+        static std::size_t get_bin(type channel) noexcept { return channel >> 8; }
+    };
+
+    template<>
+    struct statistics_channel<rl::Bitmap::Depth::Normalized>
+    {
+        using type = rl::Bitmap::normalized_t;
+        static double get_value(type channel) noexcept { return channel; }
+        static std::size_t get_bin(type channel) noexcept { return get_float_bin(channel); }
+    };
+
+    template<>
+    struct statistics_channel<rl::Bitmap::Depth::Half>
+    {
+        using type = rl::Bitmap::half_t;
+        static double get_value(type channel) noexcept { return rl::detail::half_to_float(channel); }
+        static std::size_t get_bin(type channel) noexcept { return get_float_bin(rl::detail::half_to_float(channel)); }
+    };
+
+#if defined(RL_SIMD_X86)
+    RL_TARGET_AVX2 std::size_t get_zero_size_avx2(const rl::Bitmap::byte_t* data, std::size_t size) noexcept
+    {
+        std::size_t byte_i = 0;
+        for (; byte_i + 32 <= size; byte_i += 32)
+        {
+            const __m256i bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + byte_i));
+            const auto zero_mask = static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(bytes, _mm256_setzero_si256())));
+            if (zero_mask != 0xFFFFFFFF)
+            {
+                return byte_i + static_cast<std::size_t>(std::countr_one(zero_mask));
+            }
+        }
+        return byte_i;
+    }
+#endif
+
+    // the number of zero bytes at the start of the data
+    std::size_t get_zero_size(const rl::Bitmap::byte_t* data, std::size_t size, bool is_avx2) noexcept
+    {
+        std::size_t byte_i = 0;
+#if defined(RL_SIMD_X86)
+        if (is_avx2)
+        {
+            byte_i = get_zero_size_avx2(data, size);
+            if (byte_i + 32 <= size)
+            {
+                return byte_i;
+            }
+        }
+#endif
+        for (; byte_i + 8 <= size; byte_i += 8)
+        {
+            std::uint64_t word = 0;
+            std::memcpy(&word, data + byte_i, sizeof(word));
+            if (word != 0)
+            {
+                break;
+            }
+        }
+        while (byte_i < size && data[byte_i] == rl::Bitmap::byte_t{0})
+        {
+            byte_i++;
+        }
+        return byte_i;
+    }
+
+    // the pixels gathered one at a time after each search for zero bytes, so that dense rows do not search again at
+    // every pixel.
+    constexpr std::size_t statistics_run_width = 32;
+
+    using statistics_row_t = void (*)(const rl::Bitmap::byte_t* row, std::size_t width, std::size_t y, bool is_avx2, statistics_band& band) noexcept;
+
+    // zero pixels are skipped with a search for zero bytes, and octuple channels only fill their histograms, which
+    // hold their minimums, maximums and sums exactly.
+    template<rl::Bitmap::Depth D, rl::Bitmap::Color C>
+    void add_row_statistics(const rl::Bitmap::byte_t* row, std::size_t width, std::size_t y, bool is_avx2, statistics_band& band) noexcept
+    {
+        using channel_t = typename statistics_channel<D>::type;
+        constexpr std::size_t channel_count = rl::Bitmap::GetChannelCount(C);
+        constexpr std::size_t pixel_size = channel_count * sizeof(channel_t);
+        constexpr bool is_alpha = C == rl::Bitmap::Color::Ga || C == rl::Bitmap::Color::Rgba;
+        std::size_t left = width;
+        std::size_t right = 0;
+        std::size_t x = 0;
+        while (x < width)
+        {
+            const std::size_t zero_width = get_zero_size(row + x * pixel_size, (width - x) * pixel_size, is_avx2) / pixel_size;
+            band.zero_count += zero_width;
+            x += zero_width;
+            const std::size_t run_end = std::min(width, x + statistics_run_width);
+            for (; x < run_end; x++)
+            {
+                channel_t channels[channel_count];
+                std::memcpy(channels, row + x * pixel_size, pixel_size);
+                bool is_non_zero = false;
+                for (std::size_t channel_i = 0; channel_i < channel_count; channel_i++)
+                {
+                    band.histograms[channel_i][statistics_channel<D>::get_bin(channels[channel_i])]++;
+                    const double value = statistics_channel<D>::get_value(channels[channel_i]);
+                    if constexpr (D != rl::Bitmap::Depth::Octuple)
+                    {
+                        band.minimums[channel_i] = value < band.minimums[channel_i] ? value : band.minimums[channel_i];
+                        band.maximums[channel_i] = value > band.maximums[channel_i] ? value : band.maximums[channel_i];
+                        band.sums[channel_i] += value;
+                    }
+                    if (!is_alpha || channel_i == channel_count - 1)
+                    {
+                        is_non_zero = is_non_zero || value != 0.0;
+                    }
+                }
+                if (is_non_zero)
+                {
+                    band.non_zero_count++;
+                    left = std::min(left, x);
+                    right = x + 1;
+                }
+            }
+        }
+        if (left < right)
+        {
+            band.left = std::min(band.left, left);
+            band.right = std::max(band.right, right);
+            band.top = std::min(band.top, y);
+            band.bottom = std::max(band.bottom, y + 1);
+        }
+    }
+
+    template<rl::Bitmap::Depth D>
+    statistics_row_t get_statistics_row(rl::Bitmap::Color color) noexcept
+    {
+        switch (color)
+        {
+            case rl::Bitmap::Color::G:
+                return add_row_statistics<D, rl::Bitmap::Color::G>;
+            case rl::Bitmap::Color::Ga:
+                return add_row_statistics<D, rl::Bitmap::Color::Ga>;
+            case rl::Bitmap::Color::Rgb:
+                return add_row_statistics<D, rl::Bitmap::Color::Rgb>;
+            case rl::Bitmap::Color::Rgba:
+                return add_row_statistics<D, rl::Bitmap::Color::Rgba>;
+            case rl::Bitmap::Color::Indexed:
+                return add_row_statistics<D, rl::Bitmap::Color::Indexed>;
+        }
+        return add_row_statistics<D, rl::Bitmap::Color::Rgb>;
+    }
+
+    statistics_row_t get_statistics_row(rl::Bitmap::Depth depth, rl::Bitmap::Color color) noexcept
+    {
+        switch (depth)
+        {
+            case rl::Bitmap::Depth::Sexdecuple:
+                return get_statistics_row<rl::Bitmap::Depth::Sexdecuple>(color);
+            case rl::Bitmap::Depth::Normalized:
+                return get_statistics_row<rl::Bitmap::Depth::Normalized>(color);
+            case rl::Bitmap::Depth::Half:
+                return get_statistics_row<rl::Bitmap::Depth::Half>(color);
+            default:
+                return get_statistics_row<rl::Bitmap::Depth::Octuple>(color);
+        }
+    }
+
+    void merge_statistics_band(statistics_band& band, const statistics_band& other, std::size_t channel_count) noexcept
+    {
+        for (std::size_t channel_i = 0; channel_i < channel_count; channel_i++)
+        {
+            for (std::size_t bin_i = 0; bin_i < 256; bin_i++)
+            {
+                band.histograms[channel_i][bin_i] += other.histograms[channel_i][bin_i];
+            }
+            band.minimums[channel_i] = std::min(band.minimums[channel_i], other.minimums[channel_i]);
+            band.maximums[channel_i] = std::max(band.maximums[channel_i], other.maximums[channel_i]);
+            band.sums[channel_i] += other.sums[channel_i];
+        }
+        band.zero_count += other.zero_count;
+        band.non_zero_count += other.non_zero_count;
+        band.left = std::min(band.left, other.left);
+        band.top = std::min(band.top, other.top);
+        band.right = std::max(band.right, other.right);
+        band.bottom = std::max(band.bottom, other.bottom);
+    }
+}
+
+rl::Bitmap::statistics rl::Bitmap::View::GetStatistics() const
+{
+    return this->get_statistics(nullptr);
+}
+
+rl::Bitmap::statistics rl::Bitmap::View::GetStatistics(const rl::ExecutionPolicy& policy) const
+{
+    return this->get_statistics(&policy);
+}
+
+rl::Bitmap::statistics rl::Bitmap::View::get_statistics(const rl::ExecutionPolicy* policy_p) const
+{
+    if (this->width == 0 || this->height == 0 || this->page_count == 0)
+    {
+        return {};
+    }
+    // tiles and planes are copied into a linear image first, and sub-byte channels are unpacked to octuple ones
+    if (this->layout != rl::Bitmap::Layout::Linear || rl::Bitmap::GetIsSubByte(this->depth))
+    {
+        rl::Image linear(
+            this->width,
+            this->height,
+            this->page_count,
+            rl::Bitmap::GetIsSubByte(this->depth) ? rl::Bitmap::Depth::Octuple : this->depth,
+            this->color,
+            rl::Bitmap::Layout::Linear,
+            1,
+            std::nullopt,
+            this->alpha,
+            this->space
+        );
+        linear.SetPalette(this->palette);
+        if (policy_p == nullptr)
+        {
+            linear.Blit(*this, 0, 0, 0);
+        }
+        else
+        {
+            linear.Blit(*policy_p, *this, 0, 0, 0);
+        }
+        return linear.GetBitmapView().get_statistics(policy_p);
+    }
+    const std::size_t channel_count = this->GetChannelCount();
+    const statistics_row_t add_row = get_statistics_row(this->depth, this->color);
+    const bool is_avx2 = rl::get_simd_level() == rl::SimdLevel::Avx2;
+    const std::size_t row_count = this->height * this->page_count;
+    const auto add_rows =
+        [&](std::size_t first_row_i, std::size_t last_row_i, statistics_band& band)
+        {
+            for (std::size_t row_i = first_row_i; row_i < last_row_i; row_i++)
+            {
+                add_row(this->GetData(0, row_i % this->height, row_i / this->height), this->width, row_i % this->height, is_avx2, band);
+            }
+        };
+    // each band of rows gathers its own statistics, which are merged in order afterwards
+    const std::size_t statistics_size = this->GetPageSize() * this->page_count;
+    const std::size_t band_size = rl::get_row_band_size(policy_p, statistics_size, row_count);
+    std::vector<statistics_band> bands((row_count + band_size - 1) / band_size);
+    rl::run_row_bands(
+        policy_p,
+        statistics_size,
+        row_count,
+        [&](std::size_t first_row_i, std::size_t last_row_i)
+        {
+            add_rows(first_row_i, last_row_i, bands[first_row_i / band_size]);
+        }
+    );
+    statistics_band band;
+    for (const auto& other : bands)
+    {
+        merge_statistics_band(band, other, channel_count);
+    }
+    const std::size_t pixel_count = row_count * this->width;
+    rl::Bitmap::statistics statistics;
+    for (std::size_t channel_i = 0; channel_i < channel_count; channel_i++)
+    {
+        auto& histogram = statistics.histograms[channel_i];
+        histogram = band.histograms[channel_i];
+        histogram[0] += band.zero_count;
+        if (this->depth == rl::Bitmap::Depth::Octuple)
+        {
+            // every octuple value has its own bin
+            const auto first = std::find_if(histogram.begin(), histogram.end(), [](std::size_t count) { return count != 0; });
+            const auto last = std::find_if(histogram.rbegin(), histogram.rend(), [](std::size_t count) { return count != 0; });
+            statistics.minimums[channel_i] = static_cast<double>(first - histogram.begin());
+            statistics.maximums[channel_i] = static_cast<double>(histogram.rend() - last - 1);
+            double sum = 0.0;
+            for (std::size_t bin_i = 0; bin_i < 256; bin_i++)
+            {
+                sum += static_cast<double>(bin_i) * static_cast<double>(histogram[bin_i]);
+            }
+            statistics.means[channel_i] = sum / static_cast<double>(pixel_count);
+            continue;
+        }
+        if (band.zero_count != 0)
+        {
+            band.minimums[channel_i] = std::min(band.minimums[channel_i], 0.0);
+            band.maximums[channel_i] = std::max(band.maximums[channel_i], 0.0);
+        }
+        statistics.minimums[channel_i] = band.minimums[channel_i];
+        statistics.maximums[channel_i] = band.maximums[channel_i];
+        statistics.means[channel_i] = band.sums[channel_i] / static_cast<double>(pixel_count);
+    }
+    statistics.non_zero_count = band.non_zero_count;
+    if (band.left < band.right)
+    {
+        statistics.non_zero_box_o = rl::cell_box2<int>(band.left, band.top, band.right - band.left, band.bottom - band.top);
     }
-}
\ No newline at end of file
+    return statistics;
+}
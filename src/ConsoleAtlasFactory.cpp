@@ -24,10 +24,41 @@
 #include "console_atlas_source_key.hpp"
 #include <rld/except.hpp>
 #include <rlm/cellular/shape_edges.hpp>
+#include <algorithm>
 #include <numeric>
 #include <unordered_map>
 
+namespace
+{
+    // fills the gutter around a glyph with copies of its edge pixels
+    void extrude_glyph(rl::Image& image, const rl::cell_box2<int>& box, std::size_t page, int gutter)
+    {
+        for (int gutter_i = 1; gutter_i <= gutter; gutter_i++)
+        {
+            image.Blit(image.GetBitmapView(box.x, box.y, page, 1, box.height, 1), box.x - gutter_i, box.y, page);
+            image.Blit(image.GetBitmapView(box.x + box.width - 1, box.y, page, 1, box.height, 1), box.x + box.width - 1 + gutter_i, box.y, page);
+        }
+        const int outer_x = box.x - gutter;
+        const int outer_width = box.width + gutter * 2;
+        for (int gutter_i = 1; gutter_i <= gutter; gutter_i++)
+        {
+            image.Blit(image.GetBitmapView(outer_x, box.y, page, outer_width, 1, 1), outer_x, box.y - gutter_i, page);
+            image.Blit(image.GetBitmapView(outer_x, box.y + box.height - 1, page, outer_width, 1, 1), outer_x, box.y + box.height - 1 + gutter_i, page);
+        }
+    }
+}
+
 rl::console_atlas rl::ConsoleAtlasFactory::Create(const rl::console_atlas::layout& layout)
+{
+    return this->create(layout, nullptr);
+}
+
+rl::console_atlas rl::ConsoleAtlasFactory::Create(const rl::ExecutionPolicy& policy, const rl::console_atlas::layout& layout)
+{
+    return this->create(layout, &policy);
+}
+
+rl::console_atlas rl::ConsoleAtlasFactory::create(const rl::console_atlas::layout& layout, const rl::ExecutionPolicy* policy_p)
 {
     this->png_images.clear();
     this->font_sources.clear();
@@ -38,8 +69,18 @@ rl::console_atlas rl::ConsoleAtlasFactory::Create(const rl::console_atlas::layou
     {
         throw rl::runtime_error("invalid console atlas tile dimensions");
     }
+    if (layout.gutter < 0)
+    {
+        throw rl::runtime_error("invalid console atlas gutter");
+    }
+    const bool is_distance_field = layout.color == rl::console_atlas::Color::GDistanceFieldFg;
+    if (is_distance_field && (!(layout.distance_field_spread > 0.0f) || layout.distance_field_scale <= 0))
+    {
+        throw rl::runtime_error("invalid console atlas distance field");
+    }
     atlas.tile_width = layout.tile_width;
     atlas.tile_height = layout.tile_height;
+    atlas.color = layout.color;
     if (layout.faces.empty())
     {
         return atlas;
@@ -97,12 +138,22 @@ rl::console_atlas rl::ConsoleAtlasFactory::Create(const rl::console_atlas::layou
             rl::console_atlas_source_key source_key;
             source_key.letterboxed = face.letterboxed;
             source_key.top_left = glyph_layout.top_left;
+            source_key.size = rl::cell_vector2<int>{ tile_width, atlas.tile_height };
             source_key.source_i = glyph_layout.source_i;
             source_key.source = glyph_layout.source;
+            source_key.transform = glyph_layout.transform;
             if (glyph_layout.source == rl::console_atlas::layout::Source::Font)
             {
                 source_key.codepoint = glyph_layout.codepoint_o.value();
             }
+            else if (glyph_layout.size_o.has_value())
+            {
+                if (glyph_layout.size_o->x <= 0 || glyph_layout.size_o->y <= 0)
+                {
+                    throw rl::runtime_error("invalid console atlas glyph dimensions");
+                }
+                source_key.size = glyph_layout.size_o.value();
+            }
             if (source_map.contains(source_key))
             {
                 this->glyph_identifiers.push_back(source_map.at(source_key));
@@ -112,13 +163,134 @@ rl::console_atlas rl::ConsoleAtlasFactory::Create(const rl::console_atlas::layou
                 const auto actual_source_i = this->pack_boxes.size();
                 source_map[source_key] = actual_source_i;
                 this->glyph_identifiers.push_back(actual_source_i);
-                this->pack_boxes.emplace_back(this->pack_boxes.size(), tile_width, atlas.tile_height);
+                this->pack_boxes.emplace_back(this->pack_boxes.size(), tile_width + layout.gutter * 2, atlas.tile_height + layout.gutter * 2);
                 source_vector.push_back(source_key);
             }
         }
     }
+    rl::Image turned;
+    // bakes a source glyph into a destination bitmap. bitmap and png tiles are resampled to fill it when their size
+    // differs from it, while font glyphs are blit at the size they are rendered at, cut to the destination. blank font
+    // glyphs such as spaces have no pixels, so they leave the destination as it is.
+    const auto bake_glyph =
+        [&](const rl::console_atlas_source_key& source, rl::Bitmap destination)
+        {
+            const bool is_transposed = rl::Bitmap::GetIsTransposed(source.transform);
+            if (source.source == rl::console_atlas::layout::Source::Font)
+            {
+                // transposed glyphs are rendered at the turned size so they fit the box once turned
+                auto& font = this->font_sources[source.source_i];
+                if (is_transposed)
+                {
+                    font.SetPixelSizes(static_cast<int>(destination.GetHeight()), static_cast<int>(destination.GetWidth()));
+                }
+                else
+                {
+                    font.SetPixelSizes(static_cast<int>(destination.GetWidth()), static_cast<int>(destination.GetHeight()));
+                }
+                font.LoadChar(source.codepoint);
+                const auto glyph = font.GetCharBitmap();
+                if (glyph.GetIsEmpty() || glyph.GetHeight() == 0)
+                {
+                    return;
+                }
+                const std::size_t max_width = is_transposed ? destination.GetHeight() : destination.GetWidth();
+                const std::size_t max_height = is_transposed ? destination.GetWidth() : destination.GetHeight();
+                destination.Blit(
+                    glyph.GetBitmapView(0, 0, 0, std::min(glyph.GetWidth(), max_width), std::min(glyph.GetHeight(), max_height), 1),
+                    source.transform,
+                    0,
+                    0,
+                    0
+                );
+                return;
+            }
+            const rl::Bitmap::View view =
+                (source.source == rl::console_atlas::layout::Source::Bitmap) ?
+                    layout.bitmap_sources[source.source_i].GetBitmapView(source.top_left.x, source.top_left.y, 0, source.size.x, source.size.y, 1) :
+                    png_images[source.source_i].GetBitmapView(source.top_left.x, source.top_left.y, 0, source.size.x, source.size.y, 1);
+            const std::size_t turned_width = is_transposed ? view.GetHeight() : view.GetWidth();
+            const std::size_t turned_height = is_transposed ? view.GetWidth() : view.GetHeight();
+            if (turned_width == destination.GetWidth() && turned_height == destination.GetHeight())
+            {
+                destination.Blit(view, source.transform, 0, 0, 0);
+            }
+            else if (source.transform != rl::Bitmap::Transform::None)
+            {
+                // tiles are turned before they are resampled, so the filter sees the tile the way it ends up
+                turned.Create(turned_width, turned_height, 1, view.GetDepth(), view.GetColor(), rl::Bitmap::Layout::Linear, 1, std::nullopt, view.GetAlpha(), view.GetSpace());
+                turned.SetPalette(view.GetPalette());
+                turned.Blit(view, source.transform, 0, 0, 0);
+                destination.Resample(turned, layout.filter);
+            }
+            else
+            {
+                destination.Resample(view, layout.filter);
+            }
+        };
+    // trimmed and distance field glyphs are baked into tiles first, since trimmed boxes are only known once glyphs are
+    // baked and distance fields are generated for every glyph at once. glyphs without any non-zero pixels are trimmed
+    // to one cleared pixel.
+    const bool is_staged = layout.trimmed || is_distance_field;
+    rl::Image tiles;
+    std::vector<rl::cell_box2<int>> trim_boxes;
+    if (is_staged)
+    {
+        const auto get_tile_width =
+            [&](std::size_t box_i)
+            {
+                return
+                    source_vector[box_i].letterboxed ?
+                        atlas.tile_width / 2 :
+                        atlas.tile_width;
+            };
+        // font glyphs do not fill their tiles, so the tiles are cleared unless distance fields overwrite them
+        const auto transparent = rl::color_rgba<rl::Bitmap::normalized_t>(0.0f, 0.0f, 0.0f, 0.0f);
+        if (is_distance_field)
+        {
+            tiles.Create(atlas.tile_width, atlas.tile_height, source_vector.size(), rl::Bitmap::Depth::Octuple, rl::Bitmap::Color::G);
+            // the space around letterboxed glyphs is cleared so it does not reach into their fields
+            const int scale = layout.distance_field_scale;
+            rl::Image scaled_tiles(atlas.tile_width * scale, atlas.tile_height * scale, source_vector.size(), rl::Bitmap::Depth::Octuple, rl::Bitmap::Color::G, transparent);
+            for (std::size_t box_i = 0; box_i < source_vector.size(); box_i++)
+            {
+                bake_glyph(source_vector[box_i], scaled_tiles.GetBitmap(0, 0, box_i, get_tile_width(box_i) * scale, atlas.tile_height * scale, 1));
+            }
+            const float scaled_spread = layout.distance_field_spread * static_cast<float>(scale);
+            if (policy_p != nullptr)
+            {
+                tiles.GenerateDistanceField(*policy_p, scaled_tiles, scaled_spread);
+            }
+            else
+            {
+                tiles.GenerateDistanceField(scaled_tiles, scaled_spread);
+            }
+        }
+        else
+        {
+            tiles.Create(atlas.tile_width, atlas.tile_height, source_vector.size(), rl::Bitmap::Depth::Octuple, rl::Bitmap::Color::G, transparent);
+            for (std::size_t box_i = 0; box_i < source_vector.size(); box_i++)
+            {
+                bake_glyph(source_vector[box_i], tiles.GetBitmap(0, 0, box_i, get_tile_width(box_i), atlas.tile_height, 1));
+            }
+        }
+        trim_boxes.reserve(source_vector.size());
+        for (std::size_t box_i = 0; box_i < source_vector.size(); box_i++)
+        {
+            const auto tile_box = rl::cell_box2<int>(0, 0, get_tile_width(box_i), atlas.tile_height);
+            const auto& trim_box =
+                trim_boxes.emplace_back(
+                    layout.trimmed ?
+                        tiles.GetBitmapView(0, 0, box_i, tile_box.width, tile_box.height, 1).GetStatistics().non_zero_box_o.value_or(rl::cell_box2<int>(0, 0, 1, 1)) :
+                        tile_box
+                );
+            this->pack_boxes[box_i].box.width = trim_box.width + layout.gutter * 2;
+            this->pack_boxes[box_i].box.height = trim_box.height + layout.gutter * 2;
+        }
+    }
     this->packer.Pack(this->pack_boxes);
-    atlas.image.Create(this->packer.GetWidth(), this->packer.GetHeight(), this->packer.GetPageCount(), rl::Bitmap::Depth::Octuple, rl::Bitmap::Color::G);
+    // the space between glyphs is cleared, since it is sampled by filtering and mips
+    atlas.image.Create(this->packer.GetWidth(), this->packer.GetHeight(), this->packer.GetPageCount(), rl::Bitmap::Depth::Octuple, rl::Bitmap::Color::G, rl::color_rgba<rl::Bitmap::normalized_t>(0.0f, 0.0f, 0.0f, 0.0f));
     std::sort(
         this->pack_boxes.begin(),
         this->pack_boxes.end(),
@@ -127,27 +299,31 @@ rl::console_atlas rl::ConsoleAtlasFactory::Create(const rl::console_atlas::layou
             return a.identifier < b.identifier;
         }
     );
+    for (auto& pack_box : this->pack_boxes)
+    {
+        pack_box.box.x += layout.gutter;
+        pack_box.box.y += layout.gutter;
+        pack_box.box.width -= layout.gutter * 2;
+        pack_box.box.height -= layout.gutter * 2;
+    }
     for (std::size_t box_i = 0; box_i < this->pack_boxes.size(); box_i++)
     {
         const auto& pack_box = this->pack_boxes[box_i];
-        const auto& source = source_vector[box_i];
-        rl::Bitmap::View view;
-        if (source.source == rl::console_atlas::layout::Source::Bitmap)
-        {
-            view = layout.bitmap_sources[source.source_i].GetBitmapView(source.top_left.x, source.top_left.y, 0, pack_box.box.width, pack_box.box.height, 1);
-        }
-        else if (source.source == rl::console_atlas::layout::Source::Png)
+        if (is_staged)
         {
-            view = png_images[source.source_i].GetBitmapView(source.top_left.x, source.top_left.y, 0, pack_box.box.width, pack_box.box.height, 1);
+            const auto& trim_box = trim_boxes[box_i];
+            atlas.image.Blit(tiles.GetBitmapView(trim_box.x, trim_box.y, box_i, trim_box.width, trim_box.height, 1), pack_box.box.x, pack_box.box.y, pack_box.page);
         }
-        else if (source.source == rl::console_atlas::layout::Source::Font)
+        else
         {
-            auto& font = this->font_sources[source.source_i];
-            font.SetPixelSizes(pack_box.box.width, pack_box.box.height);
-            font.LoadChar(source.codepoint);
-            view = font.GetCharBitmap();
+            bake_glyph(source_vector[box_i], atlas.image.GetBitmap(pack_box.box.x, pack_box.box.y, pack_box.page, pack_box.box.width, pack_box.box.height, 1));
         }
-        atlas.image.Blit(view, pack_box.box.x, pack_box.box.y, pack_box.page);
+        extrude_glyph(atlas.image, pack_box.box, pack_box.page, layout.gutter);
+    }
+    if (layout.mipmapped)
+    {
+        // gray atlases store stencil coverage or distances, which are averaged without gamma
+        atlas.image.GenerateMips(std::nullopt, false);
     }
     std::size_t glyph_identifier_i = 0;
     for (std::size_t face_i = 0; face_i < layout.faces.size(); face_i++)
@@ -156,25 +332,32 @@ rl::console_atlas rl::ConsoleAtlasFactory::Create(const rl::console_atlas::layou
         auto& face = atlas.faces[face_i];
         const std::size_t coordinates_per_stpqp = 5;
         face.texture_coordinates.reserve(face_layout.glyphs.size() * coordinates_per_stpqp);
+        face.glyph_offsets.reserve(face_layout.glyphs.size());
         for (const auto& glyph_layout : face_layout.glyphs)
         {
             const auto identifer = this->glyph_identifiers[glyph_identifier_i];
-            const auto& pack_box = this->pack_boxes[glyph_identifier_i];
+            glyph_identifier_i++;
+            const auto& pack_box = this->pack_boxes[identifer];
+            face.glyph_offsets.push_back(
+                is_staged ?
+                    rl::cell_vector2<int>{ trim_boxes[identifer].x, trim_boxes[identifer].y } :
+                    rl::cell_vector2<int>{ 0, 0 }
+            );
             face.texture_coordinates.push_back( // s
-                static_cast<float>(atlas.image.GetWidth()) /
-                static_cast<float>(rl::left_x(pack_box.box))
+                static_cast<float>(rl::left_x(pack_box.box)) /
+                static_cast<float>(atlas.image.GetWidth())
             );
             face.texture_coordinates.push_back( // t
-                static_cast<float>(atlas.image.GetWidth()) /
-                static_cast<float>(rl::right_x(pack_box.box))
+                static_cast<float>(rl::right_x(pack_box.box)) /
+                static_cast<float>(atlas.image.GetWidth())
             );
             face.texture_coordinates.push_back( // p
-                static_cast<float>(atlas.image.GetHeight()) /
-                static_cast<float>(rl::top_y(pack_box.box))
+                static_cast<float>(rl::top_y(pack_box.box)) /
+                static_cast<float>(atlas.image.GetHeight())
             );
             face.texture_coordinates.push_back( // q
-                static_cast<float>(atlas.image.GetHeight()) /
-                static_cast<float>(rl::bottom_y(pack_box.box))
+                static_cast<float>(rl::bottom_y(pack_box.box)) /
+                static_cast<float>(atlas.image.GetHeight())
             );
             face.texture_coordinates.push_back(static_cast<float>(pack_box.page));
         }
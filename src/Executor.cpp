@@ -0,0 +1,192 @@
+// SPDX-FileCopyrightText: 2023 Daniel Aimé Valcour <fosssweeper@gmail.com>
+//
+// SPDX-License-Identifier: MIT
+
+/*
+    Copyright (c) 2023 Daniel Aimé Valcour
+    Permission is hereby granted, free of charge, to any person obtaining a copy of
+    this software and associated documentation files (the "Software"), to deal in
+    the Software without restriction, including without limitation the rights to
+    use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+    the Software, and to permit persons to whom the Software is furnished to do so,
+    subject to the following conditions:
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+    FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+    COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+    IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+    CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include <rla/Executor.hpp>
+#include <algorithm>
+#include <atomic>
+
+namespace
+{
+    // set while the current thread runs tasks, so nested runs do not wait on the workers they are running on
+    thread_local bool is_running_task = false;
+}
+
+struct rl::Executor::job_t
+{
+    const std::function<void(std::size_t)>* task = nullptr;
+    std::size_t task_count = 0;
+    std::atomic<std::size_t> next_task = 0;
+    std::atomic<std::size_t> done_task_count = 0;
+    std::mutex exception_mutex;
+    std::exception_ptr exception;
+};
+
+void rl::Executor::run_tasks(rl::Executor::job_t& job) noexcept
+{
+    const bool was_running_task = is_running_task;
+    is_running_task = true;
+    for (
+        std::size_t task_i = job.next_task.fetch_add(1, std::memory_order_relaxed);
+        task_i < job.task_count;
+        task_i = job.next_task.fetch_add(1, std::memory_order_relaxed)
+    )
+    {
+        try
+        {
+            (*job.task)(task_i);
+        }
+        catch (...)
+        {
+            std::lock_guard<std::mutex> lock(job.exception_mutex);
+            if (!job.exception)
+            {
+                job.exception = std::current_exception();
+            }
+        }
+        job.done_task_count.fetch_add(1, std::memory_order_acq_rel);
+    }
+    is_running_task = was_running_task;
+}
+
+void rl::Executor::work() noexcept
+{
+    std::size_t seen_generation = 0;
+    std::unique_lock<std::mutex> lock(this->mutex);
+    while (true)
+    {
+        this->work_condition.wait(lock, [&] { return this->stopping || this->generation != seen_generation; });
+        if (this->stopping)
+        {
+            return;
+        }
+        seen_generation = this->generation;
+        // the job may already be finished if this worker woke up late
+        if (this->job == nullptr)
+        {
+            continue;
+        }
+        auto& job = *this->job;
+        this->active_worker_count++;
+        lock.unlock();
+        rl::Executor::run_tasks(job);
+        lock.lock();
+        this->active_worker_count--;
+        this->done_condition.notify_all();
+    }
+}
+
+rl::Executor::Executor(std::size_t thread_count)
+{
+    if (thread_count == 0)
+    {
+        thread_count = std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+    }
+    this->workers.reserve(thread_count - 1);
+    for (std::size_t worker_i = 1; worker_i < thread_count; worker_i++)
+    {
+        this->workers.emplace_back([this] { this->work(); });
+    }
+}
+
+rl::Executor::~Executor() noexcept
+{
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->stopping = true;
+    }
+    this->work_condition.notify_all();
+    for (auto& worker : this->workers)
+    {
+        worker.join();
+    }
+}
+
+std::size_t rl::Executor::GetThreadCount() const noexcept
+{
+    return this->workers.size() + 1;
+}
+
+void rl::Executor::Run(std::size_t task_count, const std::function<void(std::size_t)>& task)
+{
+    if (task_count == 0)
+    {
+        return;
+    }
+    if (task_count == 1 || this->workers.empty() || is_running_task)
+    {
+        for (std::size_t task_i = 0; task_i < task_count; task_i++)
+        {
+            task(task_i);
+        }
+        return;
+    }
+    std::lock_guard<std::mutex> run_lock(this->run_mutex);
+    rl::Executor::job_t job;
+    job.task = &task;
+    job.task_count = task_count;
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->job = &job;
+        this->generation++;
+    }
+    this->work_condition.notify_all();
+    rl::Executor::run_tasks(job);
+    {
+        std::unique_lock<std::mutex> lock(this->mutex);
+        // wait for the workers to finish their tasks and let go of the job
+        this->done_condition.wait(
+            lock,
+            [&]
+            {
+                return job.done_task_count.load(std::memory_order_acquire) == task_count && this->active_worker_count == 0;
+            }
+        );
+        this->job = nullptr;
+    }
+    if (job.exception)
+    {
+        std::rethrow_exception(job.exception);
+    }
+}
+
+rl::Executor& rl::Executor::GetDefault()
+{
+    static rl::Executor executor;
+    return executor;
+}
+
+rl::Executor& rl::ExecutionPolicy::GetExecutor() const
+{
+    return (this->executor != nullptr) ? *this->executor : rl::Executor::GetDefault();
+}
+
+bool rl::ExecutionPolicy::GetIsSerial(std::size_t byte_count) const
+{
+    return byte_count < this->serial_threshold || this->GetExecutor().GetThreadCount() == 1;
+}
+
+std::size_t rl::ExecutionPolicy::GetBandSize(std::size_t row_count) const
+{
+    // a few bands per thread so threads that finish early can pick up the slack
+    const std::size_t band_count = this->GetExecutor().GetThreadCount() * 4;
+    return std::max<std::size_t>((row_count + band_count - 1) / band_count, 1);
+}
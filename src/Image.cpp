@@ -21,64 +21,439 @@
 */
 
 #include <rla/Image.hpp>
+#include <rla/Executor.hpp>
 #include <rla/Png.hpp>
 #include <rla/color_conversion.hpp>
+#include <rla/simd.hpp>
+#include <rld/except.hpp>
+#include "row_bands.hpp"
+#include "simd_target.hpp"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
 #include <cstring>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace
+{
+    rl::Bitmap::byte_t* allocate_data(std::size_t capacity, std::size_t alignment)
+    {
+        return static_cast<rl::Bitmap::byte_t*>(::operator new[](capacity, std::align_val_t(alignment)));
+    }
+
+    void deallocate_data(rl::Bitmap::byte_t* data, std::size_t alignment) noexcept
+    {
+        ::operator delete[](data, std::align_val_t(alignment));
+    }
+
+    constexpr bool get_is_power_of_two(std::size_t value) noexcept
+    {
+        return value != 0 && (value & (value - 1)) == 0;
+    }
+
+    struct image_offsets
+    {
+        std::size_t row_offset = 0;
+        std::size_t page_offset = 0;
+        std::size_t plane_offset = 0;
+    };
+
+    image_offsets get_image_offsets(std::size_t width, std::size_t height, rl::Bitmap::Depth depth, rl::Bitmap::Color color, rl::Bitmap::Layout layout, std::size_t row_alignment, std::optional<std::size_t> row_offset_o)
+    {
+        if (!get_is_power_of_two(row_alignment))
+        {
+            throw rl::runtime_error("row alignment not a power of two");
+        }
+        std::size_t row_size = 0;
+        std::size_t row_count = height;
+        switch (layout)
+        {
+            case rl::Bitmap::Layout::Linear:
+                row_size = rl::Bitmap::GetRowSize(width, depth, color);
+                break;
+            case rl::Bitmap::Layout::Tiled:
+                row_size = rl::Bitmap::GetTileRowSize(width, depth, color);
+                row_count = (height + rl::Bitmap::GetTileWidth() - 1) / rl::Bitmap::GetTileWidth();
+                break;
+            case rl::Bitmap::Layout::Planar:
+                row_size = rl::Bitmap::GetRowSize(width, depth, rl::Bitmap::Color::G);
+                row_count = height * rl::Bitmap::GetChannelCount(color);
+                break;
+        }
+        const auto row_offset = row_offset_o.value_or((row_size + row_alignment - 1) & ~(row_alignment - 1));
+        if (row_offset < row_size)
+        {
+            throw rl::runtime_error("row offset smaller than row size");
+        }
+        if (row_offset % row_alignment != 0)
+        {
+            throw rl::runtime_error("row offset not a multiple of row alignment");
+        }
+        image_offsets offsets;
+        offsets.row_offset = row_offset;
+        offsets.plane_offset = (layout == rl::Bitmap::Layout::Planar) ? row_offset * height : 0;
+        offsets.page_offset = row_offset * row_count;
+        return offsets;
+    }
+
+    constexpr std::size_t get_mip_size(std::size_t size, std::size_t level) noexcept
+    {
+        return std::max<std::size_t>(size >> level, 1);
+    }
+
+    // mip levels start aligned to the rows and to their channels
+    constexpr std::size_t get_mip_alignment(std::size_t row_alignment) noexcept
+    {
+        return std::max<std::size_t>(row_alignment, sizeof(float));
+    }
+
+    // keyed pngs without alpha load with alpha by default, so their keyed pixels can be transparent. keyed palette pngs
+    // load as rgba, since clearing an index does not make it transparent.
+    rl::Bitmap::Color get_load_color(const rl::Png& png, const std::optional<rl::Bitmap::color_key>& color_key_o) noexcept
+    {
+        const auto color = rl::to_bitmap_color(png.GetColor());
+        if (!color_key_o.has_value() || color_key_o->mode != rl::Bitmap::color_key::Mode::Transparent)
+        {
+            return color;
+        }
+        switch (color)
+        {
+            case rl::Bitmap::Color::G:
+                return rl::Bitmap::Color::Ga;
+            case rl::Bitmap::Color::Rgb:
+            case rl::Bitmap::Color::Indexed:
+                return rl::Bitmap::Color::Rgba;
+            default:
+                return color;
+        }
+    }
+
+    // sub-byte pngs keep their depth when they keep their gray or indexed color
+    rl::Bitmap::Depth get_load_depth(const rl::Png& png, rl::Bitmap::Color color) noexcept
+    {
+        const auto depth = rl::Bitmap::GetDepth(png.GetBitDepth());
+        if (rl::Bitmap::GetIsSubByte(depth) && color != rl::to_bitmap_color(png.GetColor()))
+        {
+            return rl::Bitmap::Depth::Octuple;
+        }
+        return depth;
+    }
+
+    // premultiplies the colors of a row of straight floats by their alpha, so the colors of transparent pixels do not
+    // bleed into the levels below
+    void prepare_mip_row(float* row, std::size_t width, std::size_t channel_count, bool has_alpha) noexcept
+    {
+        if (!has_alpha)
+        {
+            return;
+        }
+        const std::size_t color_count = channel_count - 1;
+        for (std::size_t pixel_i = 0; pixel_i < width; pixel_i++)
+        {
+            float* pixel = row + pixel_i * channel_count;
+            for (std::size_t channel_i = 0; channel_i < color_count; channel_i++)
+            {
+                pixel[channel_i] *= pixel[color_count];
+            }
+        }
+    }
+
+    void finish_mip_row(float* row, std::size_t width, std::size_t channel_count, bool has_alpha) noexcept
+    {
+        const std::size_t color_count = has_alpha ? channel_count - 1 : channel_count;
+        for (std::size_t pixel_i = 0; pixel_i < width; pixel_i++)
+        {
+            float* pixel = row + pixel_i * channel_count;
+            const float alpha = has_alpha ? pixel[color_count] : 1.0f;
+            for (std::size_t channel_i = 0; channel_i < color_count; channel_i++)
+            {
+                pixel[channel_i] = (alpha > 0.0f) ? std::clamp(pixel[channel_i] / alpha, 0.0f, 1.0f) : 0.0f;
+            }
+        }
+    }
+
+    void add_row(float* destination, const float* source, std::size_t count) noexcept
+    {
+        for (std::size_t value_i = 0; value_i < count; value_i++)
+        {
+            destination[value_i] += source[value_i];
+        }
+    }
+
+#if defined(RL_SIMD_X86)
+    RL_TARGET_AVX2 void add_row_avx2(float* destination, const float* source, std::size_t count) noexcept
+    {
+        std::size_t value_i = 0;
+        for (; value_i + 8 <= count; value_i += 8)
+        {
+            _mm256_storeu_ps(destination + value_i, _mm256_add_ps(_mm256_loadu_ps(destination + value_i), _mm256_loadu_ps(source + value_i)));
+        }
+        add_row(destination + value_i, source + value_i, count - value_i);
+    }
+#endif
+
+    template<std::size_t ChannelCount>
+    void halve_row(const float* source, float* destination, std::size_t source_width, std::size_t destination_width) noexcept
+    {
+        for (std::size_t x = 0; x < destination_width; x++)
+        {
+            const float* left = source + std::min(x * 2, source_width - 1) * ChannelCount;
+            const float* right = source + std::min(x * 2 + 1, source_width - 1) * ChannelCount;
+            for (std::size_t channel_i = 0; channel_i < ChannelCount; channel_i++)
+            {
+                destination[x * ChannelCount + channel_i] = (left[channel_i] + right[channel_i]) * 0.25f;
+            }
+        }
+    }
+
+    void halve_row(const float* source, float* destination, std::size_t source_width, std::size_t destination_width, std::size_t channel_count) noexcept
+    {
+        switch (channel_count)
+        {
+            case 1:
+                halve_row<1>(source, destination, source_width, destination_width);
+                break;
+            case 2:
+                halve_row<2>(source, destination, source_width, destination_width);
+                break;
+            case 3:
+                halve_row<3>(source, destination, source_width, destination_width);
+                break;
+            case 4:
+                halve_row<4>(source, destination, source_width, destination_width);
+                break;
+        }
+    }
+
+    // writes rows of the destination level from 2x2 blocks of the source level. rows are counted across the pages.
+    void downsample_mip_rows(const rl::Bitmap::View& source, const rl::Bitmap& destination, bool is_srgb, std::size_t first_row, std::size_t last_row)
+    {
+        const bool is_avx2 = rl::get_simd_level() == rl::SimdLevel::Avx2;
+        const std::size_t channel_count = source.GetChannelCount();
+        const bool has_alpha = source.GetColor() == rl::Bitmap::Color::Ga || source.GetColor() == rl::Bitmap::Color::Rgba;
+        const std::size_t source_count = source.GetWidth() * channel_count;
+        std::vector<float> source_rows(source_count * 2);
+        std::vector<float> destination_row(destination.GetWidth() * channel_count);
+        const auto filter_depth = rl::Bitmap::Depth::Normalized;
+        const auto filter_alpha = rl::Bitmap::Alpha::Straight;
+        // the rows are blit in linear light, so srgb levels are decoded and encoded by the blits
+        const auto filter_space = is_srgb ? rl::Bitmap::Space::Linear : source.GetSpace();
+        rl::Bitmap::Row top_row(reinterpret_cast<rl::Bitmap::byte_t*>(source_rows.data()), source.GetWidth(), filter_depth, source.GetColor(), rl::Bitmap::Layout::Linear, std::nullopt, filter_alpha, {}, filter_space);
+        rl::Bitmap::Row bottom_row(reinterpret_cast<rl::Bitmap::byte_t*>(source_rows.data() + source_count), source.GetWidth(), filter_depth, source.GetColor(), rl::Bitmap::Layout::Linear, std::nullopt, filter_alpha, {}, filter_space);
+        const rl::Bitmap::Row::View filter_row(reinterpret_cast<const rl::Bitmap::byte_t*>(destination_row.data()), destination.GetWidth(), filter_depth, source.GetColor(), rl::Bitmap::Layout::Linear, std::nullopt, filter_alpha, {}, filter_space);
+        for (std::size_t row_i = first_row; row_i < last_row; row_i++)
+        {
+            const std::size_t page = row_i / destination.GetHeight();
+            const std::size_t y = row_i % destination.GetHeight();
+            top_row.Blit(source.GetRowView(std::min(y * 2, source.GetHeight() - 1), page));
+            bottom_row.Blit(source.GetRowView(std::min(y * 2 + 1, source.GetHeight() - 1), page));
+            prepare_mip_row(source_rows.data(), source.GetWidth() * 2, channel_count, has_alpha);
+#if defined(RL_SIMD_X86)
+            if (is_avx2)
+            {
+                add_row_avx2(source_rows.data(), source_rows.data() + source_count, source_count);
+            }
+            else
+#endif
+            {
+                add_row(source_rows.data(), source_rows.data() + source_count, source_count);
+            }
+            halve_row(source_rows.data(), destination_row.data(), source.GetWidth(), destination.GetWidth(), channel_count);
+            finish_mip_row(destination_row.data(), destination.GetWidth(), channel_count, has_alpha);
+            destination.GetRow(y, page).Blit(filter_row);
+        }
+    }
+}
+
+std::size_t rl::Image::get_used_size() const noexcept
+{
+    if (this->mip_count > 1)
+    {
+        return this->get_mip_start(this->mip_count);
+    }
+    return
+        rl::Bitmap::get_extent(
+            this->width,
+            this->height,
+            this->page_count,
+            this->depth,
+            this->color,
+            this->row_offset,
+            this->page_offset,
+            this->layout,
+            this->plane_offset
+        );
+}
+
+std::size_t rl::Image::get_mip_start(std::size_t level) const
+{
+    if (level == 0)
+    {
+        return 0;
+    }
+    const auto mip_alignment = get_mip_alignment(this->row_alignment);
+    std::size_t start =
+        rl::Bitmap::get_extent(
+            this->width,
+            this->height,
+            this->page_count,
+            this->depth,
+            this->color,
+            this->row_offset,
+            this->page_offset,
+            this->layout,
+            this->plane_offset
+        );
+    for (std::size_t mip_i = 1; mip_i < level; mip_i++)
+    {
+        const auto mip_width = get_mip_size(this->width, mip_i);
+        const auto mip_height = get_mip_size(this->height, mip_i);
+        const auto offsets = get_image_offsets(mip_width, mip_height, this->depth, this->color, this->layout, this->row_alignment, std::nullopt);
+        start = (start + mip_alignment - 1) & ~(mip_alignment - 1);
+        start +=
+            rl::Bitmap::get_extent(
+                mip_width,
+                mip_height,
+                this->page_count,
+                this->depth,
+                this->color,
+                offsets.row_offset,
+                offsets.page_offset,
+                this->layout,
+                offsets.plane_offset
+            );
+    }
+    return (start + mip_alignment - 1) & ~(mip_alignment - 1);
+}
+
+void rl::Image::generate_mips(std::optional<std::size_t> mip_count_o, bool is_srgb, const rl::ExecutionPolicy* policy_p)
+{
+    const auto max_mip_count = rl::Image::GetMaxMipCount(this->width, this->height);
+    const auto mip_count = mip_count_o.value_or(max_mip_count);
+    if (mip_count == 0 || mip_count > max_mip_count)
+    {
+        throw rl::runtime_error("invalid mip count");
+    }
+    // averaged colors are not in the palette
+    if (this->color == rl::Bitmap::Color::Indexed && mip_count > 1)
+    {
+        throw rl::runtime_error("mips of indexed image");
+    }
+    this->mip_count = 1;
+    if (mip_count == 1 || this->GetIsEmpty() || this->page_count == 0)
+    {
+        return;
+    }
+    this->reserve_data(this->get_mip_start(mip_count), 1);
+    this->mip_count = mip_count;
+    for (std::size_t mip_i = 1; mip_i < mip_count; mip_i++)
+    {
+        const auto source = this->GetMipView(mip_i - 1);
+        const auto destination = this->GetMip(mip_i);
+        // tiled rows are not contiguous, so tiled levels are downsampled through linear images
+        rl::Image linear_source;
+        rl::Image linear_destination;
+        rl::Bitmap::View row_source = source;
+        rl::Bitmap row_destination = destination;
+        if (this->layout == rl::Bitmap::Layout::Tiled)
+        {
+            linear_source.Create(source.GetWidth(), source.GetHeight(), this->page_count, this->depth, this->color, rl::Bitmap::Layout::Linear, 1, std::nullopt, this->alpha, this->space);
+            linear_source.Blit(source, 0, 0, 0);
+            linear_destination.Create(destination.GetWidth(), destination.GetHeight(), this->page_count, this->depth, this->color, rl::Bitmap::Layout::Linear, 1, std::nullopt, this->alpha, this->space);
+            row_source = linear_source;
+            row_destination = linear_destination.GetBitmap();
+        }
+        rl::run_row_bands(
+            policy_p,
+            source.GetSize(),
+            row_destination.GetHeight() * this->page_count,
+            [&](std::size_t first_row, std::size_t last_row)
+            {
+                downsample_mip_rows(row_source, row_destination, is_srgb, first_row, last_row);
+            }
+        );
+        if (this->layout == rl::Bitmap::Layout::Tiled)
+        {
+            this->GetMip(mip_i).Blit(linear_destination, 0, 0, 0);
+        }
+    }
+}
 
 void rl::Image::shrink_data()
 {
-    if (this->GetSize() == 0 && this->data != nullptr)
+    const auto used_size = this->get_used_size();
+    if (used_size == 0 && this->data != nullptr)
     {
-        delete[] this->data;
-        this->data = nullptr;
+        this->free_data();
     }
-    else if (this->capacity < this->GetSize())
+    else if (this->capacity > used_size)
     {
-        rl::Bitmap::byte_t* new_data = new rl::Bitmap::byte_t[this->GetSize()];
-        std::memcpy(new_data, this->data, this->GetSize());
-        delete[] this->data;
+        rl::Bitmap::byte_t* new_data = allocate_data(used_size, this->alignment);
+        std::memcpy(new_data, this->data, used_size);
+        deallocate_data(this->data, this->alignment);
         this->data = new_data;
-        this->capacity = this->GetSize();
+        this->capacity = used_size;
     }
 }
 
-void rl::Image::reserve_data(std::size_t capacity)
+void rl::Image::reserve_data(std::size_t capacity, std::size_t alignment)
 {
-    if (capacity > this->capacity)
+    if (!get_is_power_of_two(alignment))
+    {
+        throw rl::runtime_error("image alignment not a power of two");
+    }
+    alignment = std::max(alignment, this->alignment);
+    if (capacity > this->capacity || alignment != this->alignment)
     {
-        rl::Bitmap::byte_t* new_data = new rl::Bitmap::byte_t[capacity];
-        std::memcpy(new_data, this->data, this->GetSize());
-        delete[] this->data;
+        capacity = std::max(capacity, this->capacity);
+        rl::Bitmap::byte_t* new_data = allocate_data(capacity, alignment);
+        if (this->data != nullptr)
+        {
+            std::memcpy(new_data, this->data, this->get_used_size());
+            deallocate_data(this->data, this->alignment);
+        }
         this->data = new_data;
         this->capacity = capacity;
+        this->alignment = alignment;
     }
 }
 
 void rl::Image::free_data() noexcept
 {
-    delete[] this->data;
+    if (this->data != nullptr)
+    {
+        deallocate_data(this->data, this->alignment);
+    }
     this->capacity = 0;
     this->data = nullptr;
 }
 
-rl::Image::Image(const rl::Png& png, std::optional<rl::Bitmap::Depth> depth_o, std::optional<rl::Bitmap::Color> color_o)
+rl::Image::Image(const rl::Png& png, std::optional<rl::Bitmap::Depth> depth_o, std::optional<rl::Bitmap::Color> color_o, rl::Bitmap::Alpha alpha, std::optional<rl::Bitmap::color_key> color_key_o, rl::Bitmap::Space space, std::optional<rl::gray_mode> gray_o)
 {
-    this->Load(png, depth_o, color_o);
+    this->Load(png, depth_o, color_o, alpha, color_key_o, space, gray_o);
 }
 
-rl::Image::Image(std::string_view path, std::optional<rl::Bitmap::Depth> depth_o, std::optional<rl::Bitmap::Color> color_o)
+rl::Image::Image(std::string_view path, std::optional<rl::Bitmap::Depth> depth_o, std::optional<rl::Bitmap::Color> color_o, rl::Bitmap::Alpha alpha, std::optional<rl::Bitmap::color_key> color_key_o, rl::Bitmap::Space space, std::optional<rl::gray_mode> gray_o)
 {
-    this->Load(path, depth_o, color_o);
+    this->Load(path, depth_o, color_o, alpha, color_key_o, space, gray_o);
 }
 
 rl::Image::Image(std::size_t capacity)
 {
-    this->reserve_data(capacity);
+    this->reserve_data(capacity, 1);
 }
 
-rl::Image::Image(std::size_t width, std::size_t height, std::size_t page_count, rl::Bitmap::Depth depth, rl::Bitmap::Color color)
+rl::Image::Image(std::size_t width, std::size_t height, std::size_t page_count, rl::Bitmap::Depth depth, rl::Bitmap::Color color, rl::Bitmap::Layout layout, std::size_t row_alignment, std::optional<std::size_t> row_offset_o, rl::Bitmap::Alpha alpha, rl::Bitmap::Space space)
 {
-    this->Create(width, height, page_count, depth, color);
+    this->Create(width, height, page_count, depth, color, layout, row_alignment, row_offset_o, alpha, space);
+}
+
+rl::Image::Image(std::size_t width, std::size_t height, std::size_t page_count, rl::Bitmap::Depth depth, rl::Bitmap::Color color, const rl::color_rgba<rl::Bitmap::normalized_t>& fill, rl::Bitmap::Layout layout, std::size_t row_alignment, std::optional<std::size_t> row_offset_o, rl::Bitmap::Alpha alpha, rl::Bitmap::Space space)
+{
+    this->Create(width, height, page_count, depth, color, fill, layout, row_alignment, row_offset_o, alpha, space);
 }
 
 rl::Image::~Image() noexcept
@@ -86,6 +461,15 @@ rl::Image::~Image() noexcept
     this->free_data();
 }
 
+void rl::Image::clear_skipped(const std::optional<rl::Bitmap::color_key>& color_key_o) noexcept
+{
+    // the pixels a key skips are zero instead of whatever the data held before
+    if (color_key_o.has_value() && color_key_o->mode == rl::Bitmap::color_key::Mode::Skip && this->data != nullptr)
+    {
+        std::memset(this->data, 0, this->get_used_size());
+    }
+}
+
 void rl::Image::Clear() noexcept
 {
     this->width = 0;
@@ -93,6 +477,16 @@ void rl::Image::Clear() noexcept
     this->page_count = 0;
     this->depth = rl::Bitmap::Depth::Default;
     this->color = rl::Bitmap::Color::Default;
+    this->row_offset = 0;
+    this->page_offset = 0;
+    this->layout = rl::Bitmap::Layout::Default;
+    this->plane_offset = 0;
+    this->alpha = rl::Bitmap::Alpha::Default;
+    this->space = rl::Bitmap::Space::Default;
+    this->row_alignment = 1;
+    this->mip_count = 1;
+    this->palette_colors.clear();
+    this->palette = {};
 }
 
 void rl::Image::ShrinkToFit()
@@ -100,48 +494,242 @@ void rl::Image::ShrinkToFit()
     this->shrink_data();
 }
 
-void rl::Image::Reserve(std::size_t capacity)
+void rl::Image::Reserve(std::size_t capacity, std::size_t alignment)
+{
+    this->reserve_data(capacity, alignment);
+}
+
+std::size_t rl::Image::GetCapacity() const noexcept
 {
-    this->reserve_data(capacity);
+    return this->capacity;
 }
 
-void rl::Image::Create(std::size_t width, std::size_t height, std::size_t page_count, rl::Bitmap::Depth depth, rl::Bitmap::Color color)
+std::size_t rl::Image::GetAlignment() const noexcept
 {
+    return this->alignment;
+}
+
+void rl::Image::Create(std::size_t width, std::size_t height, std::size_t page_count, rl::Bitmap::Depth depth, rl::Bitmap::Color color, rl::Bitmap::Layout layout, std::size_t row_alignment, std::optional<std::size_t> row_offset_o, rl::Bitmap::Alpha alpha, rl::Bitmap::Space space)
+{
+    if (color == rl::Bitmap::Color::Indexed && depth != rl::Bitmap::Depth::Octuple && !rl::Bitmap::GetIsSubByte(depth))
+    {
+        throw rl::runtime_error("indexed image depth not octuple or sub-byte");
+    }
+    const auto offsets = get_image_offsets(width, height, depth, color, layout, row_alignment, row_offset_o);
     this->Clear();
-    const auto size = 
-        rl::Bitmap::GetSize(
-            width,
-            height,
-            page_count,
-            depth,
-            color
-        );
-    this->reserve_data(size);
+    this->reserve_data(offsets.page_offset * page_count, row_alignment);
     this->width = width;
     this->height = height;
     this->page_count = page_count;
     this->color = color;
     this->depth = depth;
+    this->layout = layout;
+    this->alpha = alpha;
+    this->space = space;
+    this->row_alignment = row_alignment;
+    this->row_offset = offsets.row_offset;
+    this->plane_offset = offsets.plane_offset;
+    this->page_offset = offsets.page_offset;
+}
+
+void rl::Image::Create(std::size_t width, std::size_t height, std::size_t page_count, rl::Bitmap::Depth depth, rl::Bitmap::Color color, const rl::color_rgba<rl::Bitmap::normalized_t>& fill, rl::Bitmap::Layout layout, std::size_t row_alignment, std::optional<std::size_t> row_offset_o, rl::Bitmap::Alpha alpha, rl::Bitmap::Space space)
+{
+    if (color == rl::Bitmap::Color::Indexed)
+    {
+        throw rl::runtime_error("fill of indexed image without palette");
+    }
+    this->Create(width, height, page_count, depth, color, layout, row_alignment, row_offset_o, alpha, space);
+    // transparent black is zero in every other format, so it is cleared with the padding in one go
+    if (fill.r == 0.0f && fill.g == 0.0f && fill.b == 0.0f && fill.a == 0.0f)
+    {
+        std::memset(this->data, 0, this->page_offset * this->page_count);
+        return;
+    }
+    this->Fill(fill);
+}
+
+void rl::Image::ConvertLayout(rl::Bitmap::Layout layout)
+{
+    if (layout == this->layout)
+    {
+        return;
+    }
+    rl::Image converted(this->width, this->height, this->page_count, this->depth, this->color, layout, this->row_alignment, std::nullopt, this->alpha, this->space);
+    converted.Blit(*this, 0, 0, 0);
+    if (this->mip_count > 1)
+    {
+        converted.reserve_data(converted.get_mip_start(this->mip_count), 1);
+        converted.mip_count = this->mip_count;
+        for (std::size_t mip_i = 1; mip_i < this->mip_count; mip_i++)
+        {
+            converted.GetMip(mip_i).Blit(this->GetMipView(mip_i), 0, 0, 0);
+        }
+    }
+    std::swap(this->data, converted.data);
+    std::swap(this->capacity, converted.capacity);
+    std::swap(this->alignment, converted.alignment);
+    this->layout = converted.layout;
+    this->row_offset = converted.row_offset;
+    this->page_offset = converted.page_offset;
+    this->plane_offset = converted.plane_offset;
 }
 
-void rl::Image::Load(const rl::Png& png, std::optional<rl::Bitmap::Depth> depth_o, std::optional<rl::Bitmap::Color> color_o)
+void rl::Image::SetPalette(rl::Bitmap::palette_t palette)
 {
+    if (palette.size() > 256)
+    {
+        throw rl::runtime_error("palette larger than 256 colors");
+    }
+    this->palette_colors.assign(palette.begin(), palette.end());
+    this->palette = this->palette_colors;
+}
+
+bool rl::Image::ConvertToIndexed()
+{
+    if (this->color == rl::Bitmap::Color::Indexed)
+    {
+        return true;
+    }
+    auto palette_o = rl::Bitmap::FindPalette(*this, 256);
+    if (!palette_o.has_value())
+    {
+        return false;
+    }
+    rl::Image converted(this->width, this->height, this->page_count, rl::Bitmap::Depth::Octuple, rl::Bitmap::Color::Indexed, this->layout, this->row_alignment);
+    converted.SetPalette(palette_o.value());
+    converted.Blit(*this, 0, 0, 0);
+    std::swap(this->data, converted.data);
+    std::swap(this->capacity, converted.capacity);
+    std::swap(this->alignment, converted.alignment);
+    std::swap(this->palette_colors, converted.palette_colors);
+    this->depth = converted.depth;
+    this->color = converted.color;
+    this->alpha = converted.alpha;
+    this->space = converted.space;
+    this->row_offset = converted.row_offset;
+    this->page_offset = converted.page_offset;
+    this->plane_offset = converted.plane_offset;
+    this->palette = this->palette_colors;
+    this->mip_count = 1;
+    return true;
+}
+
+void rl::Image::Load(const rl::Png& png, std::optional<rl::Bitmap::Depth> depth_o, std::optional<rl::Bitmap::Color> color_o, rl::Bitmap::Alpha alpha, std::optional<rl::Bitmap::color_key> color_key_o, rl::Bitmap::Space space, std::optional<rl::gray_mode> gray_o)
+{
+    this->load(png, depth_o, color_o, alpha, color_key_o, space, gray_o, nullptr);
+}
+
+void rl::Image::Load(std::string_view path, std::optional<rl::Bitmap::Depth> depth_o, std::optional<rl::Bitmap::Color> color_o, rl::Bitmap::Alpha alpha, std::optional<rl::Bitmap::color_key> color_key_o, rl::Bitmap::Space space, std::optional<rl::gray_mode> gray_o)
+{
+    const auto png = rl::Png(path);
+    this->load(png, depth_o, color_o, alpha, color_key_o, space, gray_o, nullptr);
+}
+
+void rl::Image::Load(const rl::ExecutionPolicy& policy, const rl::Png& png, std::optional<rl::Bitmap::Depth> depth_o, std::optional<rl::Bitmap::Color> color_o, rl::Bitmap::Alpha alpha, std::optional<rl::Bitmap::color_key> color_key_o, rl::Bitmap::Space space, std::optional<rl::gray_mode> gray_o)
+{
+    this->load(png, depth_o, color_o, alpha, color_key_o, space, gray_o, &policy);
+}
+
+void rl::Image::Load(const rl::ExecutionPolicy& policy, std::string_view path, std::optional<rl::Bitmap::Depth> depth_o, std::optional<rl::Bitmap::Color> color_o, rl::Bitmap::Alpha alpha, std::optional<rl::Bitmap::color_key> color_key_o, rl::Bitmap::Space space, std::optional<rl::gray_mode> gray_o)
+{
+    const auto png = rl::Png(path);
+    this->load(png, depth_o, color_o, alpha, color_key_o, space, gray_o, &policy);
+}
+
+void rl::Image::load(const rl::Png& png, std::optional<rl::Bitmap::Depth> depth_o, std::optional<rl::Bitmap::Color> color_o, rl::Bitmap::Alpha alpha, std::optional<rl::Bitmap::color_key> color_key_o, rl::Bitmap::Space space, std::optional<rl::gray_mode> gray_o, const rl::ExecutionPolicy* policy_p)
+{
+    // pngs without a palette are loaded as rgba and then indexed with the colors they have
+    if (color_o == rl::Bitmap::Color::Indexed && png.GetColor() != rl::Png::Color::Palette)
+    {
+        this->load(png, rl::Bitmap::Depth::Octuple, rl::Bitmap::Color::Rgba, alpha, color_key_o, space, gray_o, policy_p);
+        if (!this->ConvertToIndexed())
+        {
+            throw rl::runtime_error("indexed png with more than 256 colors");
+        }
+        return;
+    }
+    const auto color = color_o.value_or(get_load_color(png, color_key_o));
     this->Create(
         png.GetWidth(),
         png.GetHeight(),
         1,
         depth_o.value_or(
-            rl::Bitmap::GetDepth(png.GetBitDepth())
+            get_load_depth(png, color)
         ),
-        color_o.value_or(
-            rl::to_bitmap_color(png.GetColor())
-        )
+        color,
+        rl::Bitmap::Layout::Default,
+        1,
+        std::nullopt,
+        alpha,
+        space
     );
-    this->Blit(png, 0, 0, 0);
+    if (this->color == rl::Bitmap::Color::Indexed)
+    {
+        this->SetPalette(png.GetPalette());
+    }
+    this->clear_skipped(color_key_o);
+    if (policy_p == nullptr)
+    {
+        this->Blit(png, 0, 0, 0, color_key_o, gray_o);
+    }
+    else
+    {
+        this->Blit(*policy_p, png, 0, 0, 0, color_key_o, gray_o);
+    }
 }
 
-void rl::Image::Load(std::string_view path, std::optional<rl::Bitmap::Depth> depth_o, std::optional<rl::Bitmap::Color> color_o)
+std::size_t rl::Image::GetMaxMipCount(std::size_t width, std::size_t height) noexcept
 {
-    const auto png = rl::Png(path);
-    this->Load(png, depth_o, color_o);
-}
\ No newline at end of file
+    return static_cast<std::size_t>(std::bit_width(std::max<std::size_t>(std::max(width, height), 1)));
+}
+
+std::size_t rl::Image::GetMipCount() const noexcept
+{
+    return this->mip_count;
+}
+
+rl::Bitmap rl::Image::GetMip(std::size_t level)
+{
+    if (level >= this->mip_count)
+    {
+        throw rl::runtime_error("mip level out of range");
+    }
+    if (level == 0)
+    {
+        return this->GetBitmap();
+    }
+    const auto mip_width = get_mip_size(this->width, level);
+    const auto mip_height = get_mip_size(this->height, level);
+    const auto offsets = get_image_offsets(mip_width, mip_height, this->depth, this->color, this->layout, this->row_alignment, std::nullopt);
+    return
+        rl::Bitmap(
+            this->data + this->get_mip_start(level),
+            mip_width,
+            mip_height,
+            this->page_count,
+            this->depth,
+            this->color,
+            offsets.row_offset,
+            offsets.page_offset,
+            this->layout,
+            offsets.plane_offset,
+            this->alpha,
+            this->palette,
+            this->space
+        );
+}
+
+rl::Bitmap::View rl::Image::GetMipView(std::size_t level) const
+{
+    return const_cast<rl::Image*>(this)->GetMip(level);
+}
+
+void rl::Image::GenerateMips(std::optional<std::size_t> mip_count_o, bool is_srgb)
+{
+    this->generate_mips(mip_count_o, is_srgb, nullptr);
+}
+
+void rl::Image::GenerateMips(const rl::ExecutionPolicy& policy, std::optional<std::size_t> mip_count_o, bool is_srgb)
+{
+    this->generate_mips(mip_count_o, is_srgb, &policy);
+}
@@ -44,7 +44,10 @@ void rl::Image::Row::reserve_data(std::size_t capacity)
     if (capacity > this->capacity)
     {
         rl::Bitmap::byte_t* new_data = new rl::Bitmap::byte_t[capacity];
-        std::memcpy(new_data, this->data, this->GetSize());
+        if (this->data != nullptr)
+        {
+            std::memcpy(new_data, this->data, this->GetSize());
+        }
         delete[] this->data;
         this->data = new_data;
         this->capacity = capacity;
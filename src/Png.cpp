@@ -49,12 +49,13 @@ void rl::Png::Load(std::string_view path)
     png_uint_32 png_width, png_height;
     int png_bit_depth, png_color_type;
     rl::libpng_read_file_info(png_ptr, info_ptr, png_width, png_height, png_bit_depth, png_color_type);
+    this->palette = rl::libpng_read_palette(png_ptr, info_ptr);
     rl::libpng_read_close(png_ptr, info_ptr, file);
     this->path = path;
     this->width = static_cast<std::size_t>(png_width);
     this->height = static_cast<std::size_t>(png_height);
     this->color = rl::libpng_color_to_png_color(png_color_type);
-    this->bit_depth = static_cast<std::size_t>(bit_depth);
+    this->bit_depth = static_cast<std::size_t>(png_bit_depth);
 }
 
 bool rl::Png::GetIsLoaded() const noexcept
@@ -90,4 +91,9 @@ void rl::Png::Clear() noexcept
 rl::Png::Color rl::Png::GetColor() const noexcept
 {
     return this->color;
-}
\ No newline at end of file
+}
+
+std::span<const rl::color_rgba<std::uint8_t>> rl::Png::GetPalette() const noexcept
+{
+    return this->palette;
+}
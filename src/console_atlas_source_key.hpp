@@ -33,18 +33,22 @@ namespace rl
     {
         std::size_t source_i;
         rl::cell_vector2<int> top_left;
+        rl::cell_vector2<int> size;
         bool letterboxed;
         rl::console_atlas::layout::Source source;
         int codepoint;
+        rl::Bitmap::Transform transform;
 
         bool operator==(const rl::console_atlas_source_key& that) const
         {
             return
                 this->source_i == that.source_i &&
                 this->top_left == that.top_left &&
+                this->size == that.size &&
                 this->letterboxed == that.letterboxed &&
                 this->source == that.source &&
-                this->codepoint == that.codepoint;
+                this->codepoint == that.codepoint &&
+                this->transform == that.transform;
         }
     };
 }
@@ -60,9 +64,11 @@ namespace std
                 rl::hash_combine(
                     std::hash<std::size_t>{}(source.source_i),
                     std::hash<rl::cell_vector2<int>>{}(source.top_left),
+                    std::hash<rl::cell_vector2<int>>{}(source.size),
                     std::hash<bool>{}(source.letterboxed),
                     std::hash<int>{}(static_cast<int>(source.source)),
-                    std::hash<int>{}(source.codepoint)
+                    std::hash<int>{}(source.codepoint),
+                    std::hash<int>{}(static_cast<int>(source.transform))
                 );
         }
     };
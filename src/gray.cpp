@@ -0,0 +1,71 @@
+// SPDX-FileCopyrightText: 2023 Daniel Aimé Valcour <fosssweeper@gmail.com>
+//
+// SPDX-License-Identifier: MIT
+
+/*
+    Copyright (c) 2023 Daniel Aimé Valcour
+    Permission is hereby granted, free of charge, to any person obtaining a copy of
+    this software and associated documentation files (the "Software"), to deal in
+    the Software without restriction, including without limitation the rights to
+    use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+    the Software, and to permit persons to whom the Software is furnished to do so,
+    subject to the following conditions:
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+    FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+    COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+    IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+    CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include <rla/gray.hpp>
+#include <mutex>
+
+namespace
+{
+    // the mode is replaced as a whole, so a blit never reads the weights of one mode with the kind of another
+    struct default_gray
+    {
+        std::mutex mutex;
+        rl::gray_mode gray;
+    };
+
+    default_gray& get_default_gray() noexcept
+    {
+        static default_gray gray;
+        return gray;
+    }
+}
+
+rl::color_rgb<float> rl::get_gray_weights(const rl::gray_mode& gray) noexcept
+{
+    switch (gray.gray)
+    {
+        case rl::Gray::Rec709:
+            return rl::color_rgb<float>(0.2126f, 0.7152f, 0.0722f);
+        case rl::Gray::Rec601:
+            return rl::color_rgb<float>(0.299f, 0.587f, 0.114f);
+        case rl::Gray::Average:
+            return rl::color_rgb<float>(1.0f / 3.0f, 1.0f / 3.0f, 1.0f / 3.0f);
+        case rl::Gray::Custom:
+            return gray.custom_weights;
+        default:
+            return rl::color_rgb<float>(0.0f, 0.0f, 0.0f);
+    }
+}
+
+rl::gray_mode rl::get_gray()
+{
+    auto& default_gray = get_default_gray();
+    const std::lock_guard lock(default_gray.mutex);
+    return default_gray.gray;
+}
+
+void rl::set_gray(const rl::gray_mode& gray)
+{
+    auto& default_gray = get_default_gray();
+    const std::lock_guard lock(default_gray.mutex);
+    default_gray.gray = gray;
+}
@@ -21,11 +21,17 @@
 */
 
 #include "libpng_ext.hpp"
+#include <rla/gray.hpp>
+#include <rla/simd.hpp>
 #include <rld/except.hpp>
 #include <rld/log.hpp>
 #include <png.h>
 #include <fstream>
+#include <algorithm>
 #include <array>
+#include <bit>
+#include <cstddef>
+#include <utility>
 #include <string>
 
 rl::Png::Color rl::libpng_color_to_png_color(int png_color) noexcept
@@ -58,6 +64,8 @@ int rl::bitmap_color_to_libpng_color(rl::Bitmap::Color color) noexcept
       return PNG_COLOR_TYPE_RGB;
     case rl::Bitmap::Color::Rgba:
       return PNG_COLOR_TYPE_RGBA;
+    case rl::Bitmap::Color::Indexed:
+      return PNG_COLOR_TYPE_PALETTE;
     }
     return PNG_COLOR_TYPE_RGB;
 }
@@ -70,14 +78,14 @@ void rl::libpng_read_close(png_structp& png_ptr, png_infop& info_ptr, std::ifstr
 
 void rl::libpng_read_open(std::string_view path, png_structp& png_ptr, png_infop& info_ptr, std::ifstream& file)
 {
-    file.open(path.data(), std::ios::in);
+    file.open(path.data(), std::ios::in | std::ios::binary);
     std::array<png_byte, RL_PNG_SIGNATURE_SIZE> signature;
     file.read((char*)signature.data(), signature.size());
     if (!file.good())
     {
         throw rl::runtime_error("libpng file open failure");
     }
-    if (!png_sig_cmp(signature.data(), 0, RL_PNG_SIGNATURE_SIZE))
+    if (png_sig_cmp(signature.data(), 0, RL_PNG_SIGNATURE_SIZE) != 0)
     {
         throw rl::runtime_error("libpng png invalid file signiture");
     }
@@ -133,8 +141,74 @@ void rl::libpng_read_file_info(png_structp& png_ptr, png_infop& info_ptr, png_ui
   );
 }
 
-void rl::libpng_read_configure(png_structp& png_ptr, png_infop& info_ptr, int png_bit_depth, int png_color_type, rl::Bitmap::Depth depth, rl::Bitmap::Color color)
+namespace
 {
+    // libpng hands 16 bit channels to user transforms in the big endian order of pngs. png_set_swap only swaps pngs that
+    // are 16 bit in the file, not ones expanded to 16 bit, so the rows are swapped to the order of the host here.
+    void swap_row_to_host(png_row_infop row_info, png_bytep data) noexcept
+    {
+        if constexpr (std::endian::native == std::endian::little)
+        {
+            if (row_info->bit_depth != 16)
+            {
+                return;
+            }
+            for (std::size_t byte_i = 0; byte_i + 1 < row_info->rowbytes; byte_i += 2)
+            {
+                std::swap(data[byte_i], data[byte_i + 1]);
+            }
+        }
+    }
+
+    void swap_transform(png_structp /*png_ptr*/, png_row_infop row_info, png_bytep data)
+    {
+        swap_row_to_host(row_info, data);
+    }
+
+    // turns the rgb rows that libpng has finished transforming gray, once they are in the order of the host
+    void rgb_to_gray_transform(png_structp png_ptr, png_row_infop row_info, png_bytep data)
+    {
+        swap_row_to_host(row_info, data);
+        if (row_info->color_type != PNG_COLOR_TYPE_RGB && row_info->color_type != PNG_COLOR_TYPE_RGB_ALPHA)
+        {
+            return;
+        }
+        const auto depth = (row_info->bit_depth == 16) ? rl::Bitmap::Depth::Sexdecuple : rl::Bitmap::Depth::Octuple;
+        const auto source_color = (row_info->color_type == PNG_COLOR_TYPE_RGB_ALPHA) ? rl::Bitmap::Color::Rgba : rl::Bitmap::Color::Rgb;
+        const auto color = (source_color == rl::Bitmap::Color::Rgba) ? rl::Bitmap::Color::Ga : rl::Bitmap::Color::G;
+        const std::size_t width = row_info->width;
+        // the gray kernels and the scalar gray converters both shrink rows in place
+        auto converter = rl::Bitmap::GetGrayConverter(rl::get_simd_level(), depth, source_color, color);
+        if (converter == nullptr)
+        {
+            converter = rl::Bitmap::GetGrayConverter(depth, source_color, color);
+        }
+        const auto& gray = *static_cast<const rl::gray_mode*>(png_get_user_transform_ptr(png_ptr));
+        auto* row_data = reinterpret_cast<rl::Bitmap::byte_t*>(data);
+        converter(row_data, row_data, width, gray);
+        row_info->color_type = (color == rl::Bitmap::Color::Ga) ? PNG_COLOR_TYPE_GRAY_ALPHA : PNG_COLOR_TYPE_GRAY;
+        row_info->channels = static_cast<png_byte>(rl::Bitmap::GetChannelCount(color));
+        row_info->pixel_depth = static_cast<png_byte>(row_info->bit_depth * row_info->channels);
+        row_info->rowbytes = width * row_info->pixel_depth / 8;
+    }
+}
+
+void rl::libpng_read_configure(png_structp& png_ptr, png_infop& info_ptr, int png_bit_depth, int png_color_type, rl::Bitmap::Depth depth, rl::Bitmap::Color color, const rl::gray_mode& gray)
+{
+  // sub-byte bitmaps only read pngs with their bit depth and color, which need no transformations
+  if (rl::Bitmap::GetIsSubByte(depth))
+  {
+    return;
+  }
+  // indexed bitmaps read the indexes of palette pngs as they are, unpacked to one byte each
+  if (color == rl::Bitmap::Color::Indexed)
+  {
+    if (png_bit_depth < 8)
+    {
+      png_set_packing(png_ptr);
+    }
+    return;
+  }
   // the following is taken from png_wrapper.h (https://github.com/Journeyman-dev/png_wrapper.h/)
   // if alpha channel not wanted, strip it if the image has one.
   if ((png_color_type & PNG_COLOR_MASK_ALPHA) && color != rl::Bitmap::Color::Ga && color != rl::Bitmap::Color::Rgba)
@@ -198,11 +272,15 @@ void rl::libpng_read_configure(png_structp& png_ptr, png_infop& info_ptr, int pn
     )
   )
   {
-    // negative weights causes default calculation to be used  ((6969 * R + 23434 * G + 2365 *
-    // B)/32768)
-    png_set_rgb_to_gray_fixed(
-        png_ptr, 1, -1.0,
-        -1.0);  // error action 1 causes no waring warning if image was not actually gray
+    // libpng only turns rgb gray with fixed weights of its own, so the rows are turned gray by the gray converters with
+    // the mode of the load after every other transformation, which gives the same grays as blits into gray bitmaps
+    png_set_read_user_transform_fn(png_ptr, rgb_to_gray_transform);
+    png_set_user_transform_info(png_ptr, const_cast<rl::gray_mode*>(&gray), (depth == rl::Bitmap::Depth::Sexdecuple) ? 16 : 8, (color == rl::Bitmap::Color::Ga) ? 2 : 1);
+  }
+  // 16 bit rows are put in the order of the host before anything does math on their channels
+  else if (depth == rl::Bitmap::Depth::Sexdecuple && std::endian::native == std::endian::little)
+  {
+    png_set_read_user_transform_fn(png_ptr, swap_transform);
   }
   if ((color == rl::Bitmap::Color::Rgb || color == rl::Bitmap::Color::Rgba) &&
     (png_color_type == PNG_COLOR_TYPE_GRAY || png_color_type == PNG_COLOR_TYPE_GRAY_ALPHA))
@@ -211,9 +289,64 @@ void rl::libpng_read_configure(png_structp& png_ptr, png_infop& info_ptr, int pn
   }
 }
 
+std::vector<rl::color_rgba<std::uint8_t>> rl::libpng_read_palette(png_structp& png_ptr, png_infop& info_ptr)
+{
+    std::vector<rl::color_rgba<std::uint8_t>> palette;
+    png_colorp png_colors = nullptr;
+    int color_count = 0;
+    if (
+        png_get_color_type(png_ptr, info_ptr) != PNG_COLOR_TYPE_PALETTE ||
+        png_get_PLTE(png_ptr, info_ptr, &png_colors, &color_count) == 0
+    )
+    {
+        return palette;
+    }
+    palette.reserve(static_cast<std::size_t>(color_count));
+    for (int color_i = 0; color_i < color_count; color_i++)
+    {
+        palette.emplace_back(png_colors[color_i].red, png_colors[color_i].green, png_colors[color_i].blue, 255);
+    }
+    png_bytep png_alphas = nullptr;
+    int alpha_count = 0;
+    if (png_get_tRNS(png_ptr, info_ptr, &png_alphas, &alpha_count, nullptr) != 0 && png_alphas != nullptr)
+    {
+        for (int alpha_i = 0; alpha_i < std::min(alpha_count, color_count); alpha_i++)
+        {
+            palette[alpha_i].a = png_alphas[alpha_i];
+        }
+    }
+    return palette;
+}
+
+void rl::libpng_write_palette(png_structp& png_ptr, png_infop& info_ptr, rl::Bitmap::palette_t palette)
+{
+    if (palette.empty() || palette.size() > PNG_MAX_PALETTE_LENGTH)
+    {
+        throw rl::runtime_error("invalid indexed png palette size");
+    }
+    std::array<png_color, PNG_MAX_PALETTE_LENGTH> png_colors;
+    std::array<png_byte, PNG_MAX_PALETTE_LENGTH> png_alphas;
+    // the transparency chunk only needs to reach the last color that is not opaque
+    int alpha_count = 0;
+    for (std::size_t color_i = 0; color_i < palette.size(); color_i++)
+    {
+        png_colors[color_i] = { palette[color_i].r, palette[color_i].g, palette[color_i].b };
+        png_alphas[color_i] = palette[color_i].a;
+        if (palette[color_i].a != 255)
+        {
+            alpha_count = static_cast<int>(color_i) + 1;
+        }
+    }
+    png_set_PLTE(png_ptr, info_ptr, png_colors.data(), static_cast<int>(palette.size()));
+    if (alpha_count > 0)
+    {
+        png_set_tRNS(png_ptr, info_ptr, png_alphas.data(), alpha_count, nullptr);
+    }
+}
+
 void rl::libpng_write_open(std::string_view path, png_structp& png_ptr, png_infop& info_ptr, std::ofstream& file)
 {
-    file.open(path.data(), std::ios::out | std::ios::trunc);
+    file.open(path.data(), std::ios::out | std::ios::trunc | std::ios::binary);
     png_ptr = png_create_write_struct(
         PNG_LIBPNG_VER_STRING,
         nullptr,
@@ -237,6 +370,15 @@ void rl::libpng_write_open(std::string_view path, png_structp& png_ptr, png_info
     }
 }
 
+void rl::libpng_write_configure(png_structp& png_ptr)
+{
+    // pngs store 16 bit channels big endian, so rows in the order of a little endian host are swapped as they are written
+    if constexpr (std::endian::native == std::endian::little)
+    {
+        png_set_swap(png_ptr);
+    }
+}
+
 void rl::libpng_write_close(png_structp& png_ptr, png_infop& info_ptr, std::ofstream& file)
 {
   png_destroy_write_struct(&png_ptr, &info_ptr);
@@ -25,8 +25,11 @@
 #include <rla/Png.hpp>
 #include <rla/Bitmap.hpp>
 #include <png.h>
+#include <rlm/color/color_rgba.hpp>
+#include <cstdint>
 #include <fstream>
 #include <string>
+#include <vector>
 
 #define RL_PNG_SIGNATURE_SIZE 8
 
@@ -38,8 +41,14 @@ namespace rl
     void libpng_read_open(std::string_view path, png_structp& png_ptr, png_infop& info_ptr, std::ifstream& file);
     void libpng_set_read_fn(png_structp& png_ptr, std::ifstream& file);
     void libpng_read_file_info(png_structp& png_ptr, png_infop& info_ptr, png_uint_32& png_width, png_uint_32& png_height, int& png_bit_depth, int& png_color_type);
-    void libpng_read_configure(png_structp& png_ptr, png_infop& info_ptr, int png_bit_depth, int png_color_type, rl::Bitmap::Depth depth, rl::Bitmap::Color color);
+    // colors read into gray turn gray with the gray mode, which has to outlive the reading of the rows.
+    void libpng_read_configure(png_structp& png_ptr, png_infop& info_ptr, int png_bit_depth, int png_color_type, rl::Bitmap::Depth depth, rl::Bitmap::Color color, const rl::gray_mode& gray);
+    // the palette of a palette png with the alpha of its transparency chunk, or an empty palette for other pngs.
+    std::vector<rl::color_rgba<std::uint8_t>> libpng_read_palette(png_structp& png_ptr, png_infop& info_ptr);
+    void libpng_write_palette(png_structp& png_ptr, png_infop& info_ptr, rl::Bitmap::palette_t palette);
     void libpng_write_open(std::string_view path, png_structp& png_ptr, png_infop& info_ptr, std::ofstream& file);
+    // call after png_write_info, since libpng only swaps the bytes of pngs it knows are 16 bit.
+    void libpng_write_configure(png_structp& png_ptr);
     void libpng_write_close(png_structp& png_ptr, png_infop& info_ptr, std::ofstream& file);
     void libpng_set_write_fn(png_structp& png_ptr, std::ofstream& file);
 }
\ No newline at end of file
@@ -0,0 +1,63 @@
+// SPDX-FileCopyrightText: 2023 Daniel Aimé Valcour <fosssweeper@gmail.com>
+//
+// SPDX-License-Identifier: MIT
+
+/*
+    Copyright (c) 2023 Daniel Aimé Valcour
+    Permission is hereby granted, free of charge, to any person obtaining a copy of
+    this software and associated documentation files (the "Software"), to deal in
+    the Software without restriction, including without limitation the rights to
+    use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+    the Software, and to permit persons to whom the Software is furnished to do so,
+    subject to the following conditions:
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+    FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+    COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+    IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+    CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#pragma once
+
+#include <rla/Executor.hpp>
+#include <algorithm>
+#include <cstddef>
+
+namespace rl
+{
+    // the number of rows per band when splitting row_count rows that touch byte_count bytes across the policy. the
+    // rows of serial operations are one band. bands start on a multiple of band_alignment rows.
+    inline std::size_t get_row_band_size(const rl::ExecutionPolicy* policy_p, std::size_t byte_count, std::size_t row_count, std::size_t band_alignment = 1)
+    {
+        if (policy_p == nullptr || policy_p->GetIsSerial(byte_count))
+        {
+            return std::max<std::size_t>(row_count, 1);
+        }
+        const std::size_t band_size = policy_p->GetBandSize(row_count);
+        return (band_size + band_alignment - 1) / band_alignment * band_alignment;
+    }
+
+    // calls run_rows(first_row, last_row) for every band of rows, on the executor of the policy when the rows are not
+    // serial and on the calling thread otherwise.
+    template<typename F>
+    void run_row_bands(const rl::ExecutionPolicy* policy_p, std::size_t byte_count, std::size_t row_count, const F& run_rows, std::size_t band_alignment = 1)
+    {
+        const std::size_t band_size = rl::get_row_band_size(policy_p, byte_count, row_count, band_alignment);
+        if (band_size >= row_count)
+        {
+            run_rows(0, row_count);
+            return;
+        }
+        policy_p->GetExecutor().Run(
+            (row_count + band_size - 1) / band_size,
+            [&](std::size_t band_i)
+            {
+                run_rows(band_i * band_size, std::min(band_i * band_size + band_size, row_count));
+            }
+        );
+    }
+}
@@ -0,0 +1,125 @@
+// SPDX-FileCopyrightText: 2023 Daniel Aimé Valcour <fosssweeper@gmail.com>
+//
+// SPDX-License-Identifier: MIT
+
+/*
+    Copyright (c) 2023 Daniel Aimé Valcour
+    Permission is hereby granted, free of charge, to any person obtaining a copy of
+    this software and associated documentation files (the "Software"), to deal in
+    the Software without restriction, including without limitation the rights to
+    use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+    the Software, and to permit persons to whom the Software is furnished to do so,
+    subject to the following conditions:
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+    FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+    COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+    IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+    CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include <rla/simd.hpp>
+#include <atomic>
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#include <immintrin.h>
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#include <cpuid.h>
+#endif
+
+namespace
+{
+    rl::SimdLevel detect_simd_level() noexcept
+    {
+#if defined(__aarch64__) || defined(_M_ARM64)
+        // neon is mandatory on aarch64
+        return rl::SimdLevel::Neon;
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+        __builtin_cpu_init();
+        // the avx2 level also converts half floats with f16c, which every avx2 cpu has
+        unsigned int eax = 0;
+        unsigned int ebx = 0;
+        unsigned int ecx = 0;
+        unsigned int edx = 0;
+        const bool has_f16c = __get_cpuid(1, &eax, &ebx, &ecx, &edx) != 0 && (ecx & bit_F16C) != 0;
+        if (__builtin_cpu_supports("avx2") && has_f16c)
+        {
+            return rl::SimdLevel::Avx2;
+        }
+        if (__builtin_cpu_supports("ssse3"))
+        {
+            return rl::SimdLevel::Ssse3;
+        }
+        return rl::SimdLevel::Scalar;
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+        int cpu_info[4];
+        __cpuid(cpu_info, 0);
+        const int max_leaf = cpu_info[0];
+        if (max_leaf < 1)
+        {
+            return rl::SimdLevel::Scalar;
+        }
+        __cpuid(cpu_info, 1);
+        const bool has_ssse3 = (cpu_info[2] & (1 << 9)) != 0;
+        const bool has_osxsave = (cpu_info[2] & (1 << 27)) != 0;
+        const bool has_avx = (cpu_info[2] & (1 << 28)) != 0;
+        const bool has_f16c = (cpu_info[2] & (1 << 29)) != 0;
+        if (max_leaf >= 7 && has_osxsave && has_avx && has_f16c)
+        {
+            // the os must save the ymm registers on context switches for avx2 to be usable
+            const bool os_saves_ymm = (_xgetbv(0) & 0x6) == 0x6;
+            __cpuidex(cpu_info, 7, 0);
+            const bool has_avx2 = (cpu_info[1] & (1 << 5)) != 0;
+            if (os_saves_ymm && has_avx2)
+            {
+                return rl::SimdLevel::Avx2;
+            }
+        }
+        return has_ssse3 ? rl::SimdLevel::Ssse3 : rl::SimdLevel::Scalar;
+#else
+        return rl::SimdLevel::Scalar;
+#endif
+    }
+
+    std::atomic<rl::SimdLevel>& active_simd_level() noexcept
+    {
+        static std::atomic<rl::SimdLevel> level(rl::get_supported_simd_level());
+        return level;
+    }
+}
+
+rl::SimdLevel rl::get_supported_simd_level() noexcept
+{
+    static const rl::SimdLevel supported_level = detect_simd_level();
+    return supported_level;
+}
+
+bool rl::get_is_simd_level_supported(rl::SimdLevel level) noexcept
+{
+    const auto supported_level = rl::get_supported_simd_level();
+    if (level == rl::SimdLevel::Scalar || level == supported_level)
+    {
+        return true;
+    }
+    // the x86 levels are supersets of each other
+    return
+        level == rl::SimdLevel::Ssse3 &&
+        supported_level == rl::SimdLevel::Avx2;
+}
+
+rl::SimdLevel rl::get_simd_level() noexcept
+{
+    return active_simd_level().load(std::memory_order_relaxed);
+}
+
+bool rl::set_simd_level(rl::SimdLevel level) noexcept
+{
+    if (!rl::get_is_simd_level_supported(level))
+    {
+        return false;
+    }
+    active_simd_level().store(level, std::memory_order_relaxed);
+    return true;
+}
@@ -0,0 +1,485 @@
+// SPDX-FileCopyrightText: 2023 Daniel Aimé Valcour <fosssweeper@gmail.com>
+//
+// SPDX-License-Identifier: MIT
+
+/*
+    Copyright (c) 2023 Daniel Aimé Valcour
+    Permission is hereby granted, free of charge, to any person obtaining a copy of
+    this software and associated documentation files (the "Software"), to deal in
+    the Software without restriction, including without limitation the rights to
+    use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+    the Software, and to permit persons to whom the Software is furnished to do so,
+    subject to the following conditions:
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+    FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+    COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+    IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+    CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include <catch2/catch_all.hpp>
+#include <rla/Bitmap.hpp>
+#include <rla/Image.hpp>
+#include <rla/Executor.hpp>
+#include <rla/simd.hpp>
+#include <rld/except.hpp>
+#include "test_images.hpp"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+
+namespace
+{
+    rl::Image blend_pixel(rl::Bitmap::Blend blend, std::array<std::uint8_t, 4> source_pixel, std::array<std::uint8_t, 4> destination_pixel)
+    {
+        rl::Image source(1, 1, 1, rl::Bitmap::Depth::Octuple, rl::Bitmap::Color::Rgba);
+        rl::Image destination(1, 1, 1, rl::Bitmap::Depth::Octuple, rl::Bitmap::Color::Rgba);
+        std::memcpy(source.GetData(), source_pixel.data(), 4);
+        std::memcpy(destination.GetData(), destination_pixel.data(), 4);
+        destination.Blit(source, 0, 0, 0, blend);
+        return destination;
+    }
+
+    bool get_is_pixel(const rl::Image& image, std::array<std::uint8_t, 4> pixel)
+    {
+        return std::memcmp(image.GetData(), pixel.data(), 4) == 0;
+    }
+}
+
+// clang-format off
+
+TEST_CASE("A same format rl::Bitmap::Blit copies the bytes of the source unchanged")
+{
+    rl::Image source(5, 3, 2, rl::Bitmap::Depth::Sexdecuple, rl::Bitmap::Color::Ga);
+    rl::test::fill_test_image(source);
+    const auto check_blit = [&](rl::Image& destination, std::size_t x, std::size_t y, std::size_t page)
+    {
+        for (std::size_t blit_page = 0; blit_page < source.GetPageCount(); blit_page++)
+        {
+            for (std::size_t blit_y = 0; blit_y < source.GetHeight(); blit_y++)
+            {
+                for (std::size_t byte_i = 0; byte_i < source.GetRowSize(); byte_i++)
+                {
+                    CHECK(destination.GetData(x, y + blit_y, page + blit_page, 0)[byte_i] == source.GetData(0, blit_y, blit_page, 0)[byte_i]);
+                }
+            }
+        }
+    };
+    SECTION("Whole pages are copied when the rows and pages are packed")
+    {
+        rl::Image destination(5, 3, 2, rl::Bitmap::Depth::Sexdecuple, rl::Bitmap::Color::Ga);
+        destination.Blit(source, 0, 0, 0);
+        check_blit(destination, 0, 0, 0);
+    }
+    SECTION("Each page is copied when only the rows are packed")
+    {
+        rl::Image destination(5, 4, 3, rl::Bitmap::Depth::Sexdecuple, rl::Bitmap::Color::Ga);
+        destination.Blit(source, 0, 1, 1);
+        check_blit(destination, 0, 1, 1);
+    }
+    SECTION("Each row is copied when the rows are not packed")
+    {
+        rl::Image destination(9, 6, 2, rl::Bitmap::Depth::Sexdecuple, rl::Bitmap::Color::Ga);
+        rl::test::fill_test_image(destination);
+        const auto before = *destination.GetData(3, 2, 0, 0);
+        destination.Blit(source, 4, 2, 0);
+        check_blit(destination, 4, 2, 0);
+        CHECK(*destination.GetData(3, 2, 0, 0) == before);
+    }
+}
+
+TEST_CASE("A parallel rl::Bitmap::Blit matches the serial rl::Bitmap::Blit")
+{
+    rl::Executor executor(4);
+    const auto policy = rl::ExecutionPolicy{ &executor, 0 };
+    const auto source_depth = GENERATE(rl::Bitmap::Depth::Octuple, rl::Bitmap::Depth::Normalized);
+    const auto destination_depth = GENERATE(rl::Bitmap::Depth::Octuple, rl::Bitmap::Depth::Sexdecuple);
+    rl::Image source(7, 13, 3, source_depth, rl::Bitmap::Color::Rgb);
+    rl::test::fill_test_image(source);
+    if (source_depth == rl::Bitmap::Depth::Normalized)
+    {
+        // keep the floats in range
+        for (std::size_t value_i = 0; value_i < source.GetSize() / sizeof(rl::Bitmap::normalized_t); value_i++)
+        {
+            reinterpret_cast<rl::Bitmap::normalized_t*>(source.GetData())[value_i] = static_cast<float>(value_i % 101) / 100.0f;
+        }
+    }
+    rl::Image serial(10, 15, 4, destination_depth, rl::Bitmap::Color::Rgba);
+    rl::Image parallel(10, 15, 4, destination_depth, rl::Bitmap::Color::Rgba);
+    std::memset(serial.GetData(), 0, serial.GetSize());
+    std::memset(parallel.GetData(), 0, parallel.GetSize());
+    serial.Blit(source, 2, 1, 1);
+    parallel.Blit(policy, source, 2, 1, 1);
+    CHECK(std::memcmp(serial.GetData(), parallel.GetData(), serial.GetSize()) == 0);
+    CHECK_THROWS(parallel.Blit(policy, source, 4, 1, 1));
+}
+
+TEST_CASE("A rl::Bitmap::Blit between linear and tiled layouts keeps every pixel")
+{
+    const auto destination_color = GENERATE(rl::Bitmap::Color::Rgb, rl::Bitmap::Color::Rgba);
+    rl::Image source(21, 11, 2, rl::Bitmap::Depth::Octuple, rl::Bitmap::Color::Rgb);
+    rl::test::fill_test_image(source);
+    rl::Image linear(27, 19, 3, rl::Bitmap::Depth::Octuple, destination_color);
+    rl::Image tiled(27, 19, 3, rl::Bitmap::Depth::Octuple, destination_color, rl::Bitmap::Layout::Tiled);
+    CHECK(tiled.GetRowOffset() == rl::Bitmap::GetTileRowSize(27, rl::Bitmap::Depth::Octuple, destination_color));
+    std::memset(linear.GetData(), 0, linear.GetSize());
+    std::memset(tiled.GetData(), 0, tiled.GetSize());
+    linear.Blit(source, 3, 5, 1);
+    tiled.Blit(source, 3, 5, 1);
+    for (std::size_t page = 0; page < linear.GetPageCount(); page++)
+    {
+        for (std::size_t y = 0; y < linear.GetHeight(); y++)
+        {
+            for (std::size_t x = 0; x < linear.GetWidth(); x++)
+            {
+                CHECK(std::memcmp(linear.GetData(x, y, page, 0), tiled.GetData(x, y, page, 0), linear.GetPixelSize()) == 0);
+            }
+        }
+    }
+    SECTION("Tiled views must start at a tile")
+    {
+        CHECK_THROWS(tiled.GetBitmapView(3, 0, 0, 8, 8, 1));
+        CHECK_THROWS(tiled.GetRowView(0, 0));
+        const auto view = tiled.GetBitmapView(8, 8, 1, 16, 8, 1);
+        CHECK(view.GetData(1, 2, 0, 0) == tiled.GetData(9, 10, 1, 0));
+    }
+    SECTION("Whole tiles blit between tiled images")
+    {
+        rl::Image tiled_source(16, 8, 1, rl::Bitmap::Depth::Octuple, rl::Bitmap::Color::Rgb, rl::Bitmap::Layout::Tiled);
+        tiled_source.Blit(source.GetBitmapView(0, 0, 0, 16, 8, 1), 0, 0, 0);
+        linear.Blit(source.GetBitmapView(0, 0, 0, 16, 8, 1), 8, 8, 2);
+        tiled.Blit(tiled_source, 8, 8, 2);
+        for (std::size_t y = 0; y < linear.GetHeight(); y++)
+        {
+            for (std::size_t x = 0; x < linear.GetWidth(); x++)
+            {
+                CHECK(std::memcmp(linear.GetData(x, y, 2, 0), tiled.GetData(x, y, 2, 0), linear.GetPixelSize()) == 0);
+            }
+        }
+    }
+    SECTION("A tiled image converts back into the linear image")
+    {
+        tiled.ConvertLayout(rl::Bitmap::Layout::Linear);
+        CHECK(tiled.GetLayout() == rl::Bitmap::Layout::Linear);
+        CHECK(tiled.GetRowOffset() == linear.GetRowOffset());
+        CHECK(std::memcmp(tiled.GetData(), linear.GetData(), linear.GetSize()) == 0);
+        linear.ConvertLayout(rl::Bitmap::Layout::Tiled);
+        linear.ConvertLayout(rl::Bitmap::Layout::Linear);
+        CHECK(std::memcmp(tiled.GetData(), linear.GetData(), linear.GetSize()) == 0);
+    }
+}
+
+TEST_CASE("A rl::Bitmap::Row::Blit between planar and interleaved rows matches the interleaved conversion")
+{
+    const auto source_depth = GENERATE(rl::Bitmap::Depth::Octuple, rl::Bitmap::Depth::Sexdecuple);
+    const auto source_color = GENERATE(rl::Bitmap::Color::G, rl::Bitmap::Color::Ga, rl::Bitmap::Color::Rgb, rl::Bitmap::Color::Rgba);
+    const auto destination_depth = GENERATE(rl::Bitmap::Depth::Octuple, rl::Bitmap::Depth::Normalized);
+    const auto destination_color = GENERATE(rl::Bitmap::Color::G, rl::Bitmap::Color::Rgb, rl::Bitmap::Color::Rgba);
+    rl::Image source(100, 3, 1, source_depth, source_color);
+    rl::test::fill_test_image(source);
+    rl::Image expected(100, 3, 1, destination_depth, destination_color);
+    expected.Blit(source, 0, 0, 0);
+    rl::Image planar_source(100, 3, 1, source_depth, source_color, rl::Bitmap::Layout::Planar);
+    rl::Image planar_destination(100, 3, 1, destination_depth, destination_color, rl::Bitmap::Layout::Planar);
+    rl::Image destination(100, 3, 1, destination_depth, destination_color);
+    planar_source.Blit(source, 0, 0, 0);
+    planar_destination.Blit(planar_source, 0, 0, 0);
+    destination.Blit(planar_destination, 0, 0, 0);
+    CHECK(std::memcmp(destination.GetData(), expected.GetData(), expected.GetSize()) == 0);
+    planar_destination.Blit(source, 0, 0, 0);
+    planar_destination.GetRow(1, 0).Blit(source.GetRowView(1, 0));
+    destination.GetRow(2, 0).Blit(planar_destination.GetRowView(2, 0));
+    destination.Blit(planar_destination.GetBitmapView(0, 0, 0, 100, 2, 1), 0, 0, 0);
+    CHECK(std::memcmp(destination.GetData(), expected.GetData(), expected.GetSize()) == 0);
+}
+
+TEST_CASE("A plane of a planar rl::Bitmap is viewed as a gray rl::Bitmap without copying")
+{
+    rl::Image source(9, 4, 2, rl::Bitmap::Depth::Sexdecuple, rl::Bitmap::Color::Rgba);
+    rl::test::fill_test_image(source);
+    rl::Image planar(9, 4, 2, rl::Bitmap::Depth::Sexdecuple, rl::Bitmap::Color::Rgba, rl::Bitmap::Layout::Planar);
+    planar.Blit(source, 0, 0, 0);
+    CHECK(planar.GetPlaneOffset() == 72);
+    CHECK_THROWS(source.GetPlaneView(0));
+    CHECK_THROWS(planar.GetPlaneView(4));
+    const auto alpha = planar.GetPlaneView(3);
+    CHECK(alpha.GetColor() == rl::Bitmap::Color::G);
+    CHECK(alpha.GetData(5, 2, 1, 0) == planar.GetData(5, 2, 1, 3));
+    rl::Image alpha_copy(9, 4, 2, rl::Bitmap::Depth::Sexdecuple, rl::Bitmap::Color::G);
+    alpha_copy.Blit(alpha, 0, 0, 0);
+    for (std::size_t page = 0; page < 2; page++)
+    {
+        for (std::size_t y = 0; y < 4; y++)
+        {
+            for (std::size_t x = 0; x < 9; x++)
+            {
+                CHECK(std::memcmp(alpha_copy.GetData(x, y, page, 0), source.GetData(x, y, page, 3), 2) == 0);
+            }
+        }
+    }
+    auto green = planar.GetPlane(1);
+    *reinterpret_cast<rl::Bitmap::sexdecuple_t*>(green.GetData(1, 1, 1, 0)) = 1234;
+    CHECK(*reinterpret_cast<rl::Bitmap::sexdecuple_t*>(planar.GetData(1, 1, 1, 1)) == 1234);
+}
+
+TEST_CASE("A blended rl::Bitmap::Blit combines the source with the destination")
+{
+    CHECK(get_is_pixel(blend_pixel(rl::Bitmap::Blend::Replace, {255, 0, 0, 128}, {0, 0, 255, 255}), {255, 0, 0, 128}));
+    CHECK(get_is_pixel(blend_pixel(rl::Bitmap::Blend::Over, {255, 0, 0, 128}, {0, 0, 255, 255}), {128, 0, 127, 255}));
+    CHECK(get_is_pixel(blend_pixel(rl::Bitmap::Blend::Over, {255, 0, 0, 0}, {0, 0, 0, 0}), {0, 0, 0, 0}));
+    CHECK(get_is_pixel(blend_pixel(rl::Bitmap::Blend::Over, {200, 100, 50, 255}, {0, 0, 255, 17}), {200, 100, 50, 255}));
+    CHECK(get_is_pixel(blend_pixel(rl::Bitmap::Blend::OverPremultiplied, {128, 0, 0, 128}, {0, 0, 255, 255}), {128, 0, 127, 255}));
+    CHECK(get_is_pixel(blend_pixel(rl::Bitmap::Blend::Add, {255, 100, 0, 255}, {10, 200, 30, 40}), {255, 255, 30, 255}));
+    CHECK(get_is_pixel(blend_pixel(rl::Bitmap::Blend::Add, {255, 255, 255, 0}, {10, 20, 30, 40}), {10, 20, 30, 40}));
+    CHECK(get_is_pixel(blend_pixel(rl::Bitmap::Blend::Multiply, {128, 255, 0, 255}, {255, 100, 100, 40}), {128, 100, 0, 40}));
+    CHECK(get_is_pixel(blend_pixel(rl::Bitmap::Blend::Multiply, {0, 0, 0, 0}, {255, 100, 100, 40}), {255, 100, 100, 40}));
+}
+
+TEST_CASE("Every simd row blender matches the scalar row blender")
+{
+    const auto blend = GENERATE(rl::Bitmap::Blend::Over, rl::Bitmap::Blend::OverPremultiplied, rl::Bitmap::Blend::Add, rl::Bitmap::Blend::Multiply);
+    const auto color = GENERATE(rl::Bitmap::Color::Ga, rl::Bitmap::Color::Rgba);
+    rl::Image source(37, 5, 1, rl::Bitmap::Depth::Octuple, color);
+    for (std::size_t byte_i = 0; byte_i < source.GetSize(); byte_i++)
+    {
+        // every fourth pixel is fully transparent or opaque to cover the edge cases
+        source.GetData()[byte_i] = static_cast<rl::Bitmap::byte_t>((byte_i * 89 + byte_i / 13) % 256);
+    }
+    source.GetData(3, 0, 0, 1)[0] = rl::Bitmap::byte_t{0};
+    source.GetData(7, 0, 0, 1)[0] = rl::Bitmap::byte_t{255};
+    rl::Image scalar(37, 5, 1, rl::Bitmap::Depth::Octuple, color);
+    rl::test::fill_test_image(scalar);
+    scalar.GetData(3, 0, 0, 1)[0] = rl::Bitmap::byte_t{0};
+    rl::Image simd(37, 5, 1, rl::Bitmap::Depth::Octuple, color);
+    simd.Blit(scalar, 0, 0, 0);
+    REQUIRE(rl::set_simd_level(rl::SimdLevel::Scalar));
+    scalar.Blit(source, 0, 0, 0, blend);
+    rl::set_simd_level(rl::get_supported_simd_level());
+    simd.Blit(source, 0, 0, 0, blend);
+    CHECK(std::memcmp(scalar.GetData(), simd.GetData(), scalar.GetSize()) == 0);
+}
+
+TEST_CASE("A blended rl::Bitmap::Blit converts the source to the destination format first")
+{
+    const auto blend = GENERATE(rl::Bitmap::Blend::Over, rl::Bitmap::Blend::OverPremultiplied, rl::Bitmap::Blend::Add, rl::Bitmap::Blend::Multiply);
+    const auto destination_depth = GENERATE(rl::Bitmap::Depth::Octuple, rl::Bitmap::Depth::Sexdecuple, rl::Bitmap::Depth::Normalized);
+    const auto destination_color = GENERATE(rl::Bitmap::Color::G, rl::Bitmap::Color::Ga, rl::Bitmap::Color::Rgb, rl::Bitmap::Color::Rgba);
+    rl::Image source(70, 3, 2, rl::Bitmap::Depth::Octuple, rl::Bitmap::Color::Rgba);
+    rl::test::fill_test_image(source);
+    if (blend == rl::Bitmap::Blend::OverPremultiplied)
+    {
+        // premultiplied colors are never above their alpha
+        for (std::size_t byte_i = 0; byte_i < source.GetSize(); byte_i += 4)
+        {
+            for (std::size_t channel_i = 0; channel_i < 3; channel_i++)
+            {
+                source.GetData()[byte_i + channel_i] = std::min(source.GetData()[byte_i + channel_i], source.GetData()[byte_i + 3]);
+            }
+        }
+    }
+    rl::Image octuple_destination(72, 4, 3, rl::Bitmap::Depth::Octuple, destination_color);
+    rl::test::fill_test_image(octuple_destination);
+    rl::Image destination(72, 4, 3, destination_depth, destination_color);
+    destination.Blit(octuple_destination, 0, 0, 0);
+    rl::Image planar_destination(72, 4, 3, destination_depth, destination_color, rl::Bitmap::Layout::Planar);
+    planar_destination.Blit(destination, 0, 0, 0);
+    rl::Image converted_source(70, 3, 2, destination_depth, destination_color);
+    converted_source.Blit(source, 0, 0, 0);
+    octuple_destination.Blit(source, 1, 1, 1, blend);
+    destination.Blit(source, 1, 1, 1, blend);
+    planar_destination.Blit(source, 1, 1, 1, blend);
+    rl::Image blended(72, 4, 3, rl::Bitmap::Depth::Octuple, destination_color);
+    rl::Image planar_blended(72, 4, 3, rl::Bitmap::Depth::Octuple, destination_color);
+    blended.Blit(destination, 0, 0, 0);
+    planar_blended.Blit(planar_destination, 0, 0, 0);
+    CHECK(std::memcmp(blended.GetData(), planar_blended.GetData(), blended.GetSize()) == 0);
+    for (std::size_t byte_i = 0; byte_i < blended.GetSize(); byte_i++)
+    {
+        // the depths round at different steps, but never by more than one
+        const auto difference = static_cast<int>(blended.GetData()[byte_i]) - static_cast<int>(octuple_destination.GetData()[byte_i]);
+        CHECK(std::abs(difference) <= 1);
+    }
+}
+
+TEST_CASE("A blended rl::Bitmap::Blit of an opaque source is the same as a replacing rl::Bitmap::Blit")
+{
+    const auto blend = GENERATE(rl::Bitmap::Blend::Over, rl::Bitmap::Blend::OverPremultiplied);
+    const auto destination_depth = GENERATE(rl::Bitmap::Depth::Octuple, rl::Bitmap::Depth::Sexdecuple);
+    rl::Image source(13, 9, 1, rl::Bitmap::Depth::Octuple, rl::Bitmap::Color::Rgb);
+    rl::test::fill_test_image(source);
+    rl::Image replaced(16, 16, 1, destination_depth, rl::Bitmap::Color::Rgba, rl::Bitmap::Layout::Tiled);
+    rl::test::fill_test_image(replaced);
+    rl::Image blended(16, 16, 1, destination_depth, rl::Bitmap::Color::Rgba, rl::Bitmap::Layout::Tiled);
+    blended.Blit(replaced, 0, 0, 0);
+    replaced.Blit(source, 2, 3, 0);
+    blended.Blit(source, 2, 3, 0, blend);
+    CHECK(std::memcmp(replaced.GetData(), blended.GetData(), replaced.GetSize()) == 0);
+}
+
+TEST_CASE("A parallel blended rl::Bitmap::Blit matches the serial blended rl::Bitmap::Blit")
+{
+    rl::Executor executor(4);
+    const auto policy = rl::ExecutionPolicy{ &executor, 0 };
+    rl::Image source(33, 20, 2, rl::Bitmap::Depth::Octuple, rl::Bitmap::Color::Rgba);
+    rl::test::fill_test_image(source);
+    rl::Image serial(40, 25, 2, rl::Bitmap::Depth::Octuple, rl::Bitmap::Color::Rgba);
+    rl::test::fill_test_image(serial);
+    rl::Image parallel(40, 25, 2, rl::Bitmap::Depth::Octuple, rl::Bitmap::Color::Rgba);
+    parallel.Blit(serial, 0, 0, 0);
+    serial.Blit(source, 3, 4, 0, rl::Bitmap::Blend::Over);
+    parallel.Blit(policy, source, 3, 4, 0, rl::Bitmap::Blend::Over);
+    CHECK(std::memcmp(serial.GetData(), parallel.GetData(), serial.GetSize()) == 0);
+}
+
+TEST_CASE("A rl::Bitmap::Blit between straight and premultiplied alpha converts the colors")
+{
+    rl::Image straight(2, 1, 1, rl::Bitmap::Depth::Octuple, rl::Bitmap::Color::Rgba);
+    const std::uint8_t straight_pixels[] = {200, 100, 50, 128, 10, 20, 30, 0};
+    std::memcpy(straight.GetData(), straight_pixels, sizeof(straight_pixels));
+    rl::Image premultiplied(2, 1, 1, rl::Bitmap::Depth::Octuple, rl::Bitmap::Color::Rgba, rl::Bitmap::Layout::Default, 1, std::nullopt, rl::Bitmap::Alpha::Premultiplied);
+    premultiplied.Blit(straight, 0, 0, 0);
+    const std::uint8_t premultiplied_pixels[] = {100, 50, 25, 128, 0, 0, 0, 0};
+    CHECK(std::memcmp(premultiplied.GetData(), premultiplied_pixels, sizeof(premultiplied_pixels)) == 0);
+    SECTION("Unpremultiplying drops the colors of transparent pixels")
+    {
+        rl::Image unpremultiplied(2, 1, 1, rl::Bitmap::Depth::Octuple, rl::Bitmap::Color::Rgb);
+        unpremultiplied.Blit(premultiplied, 0, 0, 0);
+        const std::uint8_t unpremultiplied_pixels[] = {199, 100, 50, 0, 0, 0};
+        CHECK(std::memcmp(unpremultiplied.GetData(), unpremultiplied_pixels, sizeof(unpremultiplied_pixels)) == 0);
+    }
+    SECTION("Premultiplied bitmaps of the same alpha copy without converting")
+    {
+        rl::Image copy(2, 1, 1, rl::Bitmap::Depth::Octuple, rl::Bitmap::Color::Rgba, rl::Bitmap::Layout::Default, 1, std::nullopt, rl::Bitmap::Alpha::Premultiplied);
+        copy.Blit(premultiplied, 0, 0, 0);
+        CHECK(std::memcmp(copy.GetData(), premultiplied_pixels, sizeof(premultiplied_pixels)) == 0);
+    }
+    SECTION("Opaque sources are the same premultiplied")
+    {
+        rl::Image rgb(2, 1, 1, rl::Bitmap::Depth::Octuple, rl::Bitmap::Color::Rgb);
+        std::memcpy(rgb.GetData(), straight_pixels, 6);
+        premultiplied.Blit(rgb, 0, 0, 0);
+        CHECK(std::memcmp(premultiplied.GetData(), straight_pixels, 3) == 0);
+    }
+}
+
+TEST_CASE("A premultiplying rl::Bitmap::Blit matches across depths, colors and layouts")
+{
+    const auto destination_depth = GENERATE(rl::Bitmap::Depth::Octuple, rl::Bitmap::Depth::Sexdecuple, rl::Bitmap::Depth::Normalized);
+    const auto destination_color = GENERATE(rl::Bitmap::Color::Ga, rl::Bitmap::Color::Rgba);
+    const auto destination_layout = GENERATE(rl::Bitmap::Layout::Linear, rl::Bitmap::Layout::Tiled, rl::Bitmap::Layout::Planar);
+    rl::Image source(70, 3, 2, rl::Bitmap::Depth::Sexdecuple, rl::Bitmap::Color::Rgba);
+    rl::test::fill_test_image(source);
+    rl::Image premultiplied(70, 3, 2, destination_depth, destination_color, destination_layout, 1, std::nullopt, rl::Bitmap::Alpha::Premultiplied);
+    premultiplied.Blit(source, 0, 0, 0);
+    // the same premultiplication done by hand in floats
+    rl::Image normalized(70, 3, 2, rl::Bitmap::Depth::Normalized, destination_color);
+    normalized.Blit(source, 0, 0, 0);
+    rl::Image converted(70, 3, 2, rl::Bitmap::Depth::Normalized, destination_color, rl::Bitmap::Layout::Default, 1, std::nullopt, rl::Bitmap::Alpha::Premultiplied);
+    converted.Blit(premultiplied, 0, 0, 0);
+    const std::size_t channel_count = rl::Bitmap::GetChannelCount(destination_color);
+    const float tolerance = (destination_depth == rl::Bitmap::Depth::Octuple) ? 1.0f / 255.0f : 1.0f / 65535.0f;
+    for (std::size_t page = 0; page < 2; page++)
+    {
+        for (std::size_t y = 0; y < 3; y++)
+        {
+            for (std::size_t x = 0; x < 70; x++)
+            {
+                const auto* expected = reinterpret_cast<const float*>(normalized.GetData(x, y, page, 0));
+                const auto* actual = reinterpret_cast<const float*>(converted.GetData(x, y, page, 0));
+                const float alpha = expected[channel_count - 1];
+                for (std::size_t channel_i = 0; channel_i + 1 < channel_count; channel_i++)
+                {
+                    CHECK(std::abs(actual[channel_i] - expected[channel_i] * alpha) <= tolerance);
+                }
+                CHECK(std::abs(actual[channel_count - 1] - alpha) <= tolerance);
+            }
+        }
+    }
+}
+
+TEST_CASE("A color keyed rl::Bitmap::Blit makes the keyed pixels transparent or skips them")
+{
+    const auto source_depth = GENERATE(rl::Bitmap::Depth::Octuple, rl::Bitmap::Depth::Sexdecuple, rl::Bitmap::Depth::Normalized);
+    const auto source_color = GENERATE(rl::Bitmap::Color::Rgb, rl::Bitmap::Color::Rgba);
+    const auto source_layout = GENERATE(rl::Bitmap::Layout::Linear, rl::Bitmap::Layout::Tiled, rl::Bitmap::Layout::Planar);
+    const auto simd_level = GENERATE(rl::SimdLevel::Scalar, rl::get_supported_simd_level());
+    const auto level = rl::get_simd_level();
+    rl::set_simd_level(simd_level);
+    // every third pixel is magenta
+    rl::Image pattern(45, 3, 1, rl::Bitmap::Depth::Octuple, rl::Bitmap::Color::Rgba);
+    for (std::size_t pixel_i = 0; pixel_i < 45 * 3; pixel_i++)
+    {
+        const std::uint8_t magenta[] = { 255, 0, 255, 255 };
+        const std::uint8_t other[] = { static_cast<std::uint8_t>(pixel_i), 10, 255, 200 };
+        std::memcpy(pattern.GetData() + pixel_i * 4, (pixel_i % 3 == 0) ? magenta : other, 4);
+    }
+    rl::Image source(45, 3, 1, source_depth, source_color, source_layout);
+    source.Blit(pattern, 0, 0, 0);
+    rl::Image expected(45, 3, 1, rl::Bitmap::Depth::Octuple, rl::Bitmap::Color::Rgba);
+    expected.Blit(source, 0, 0, 0);
+    const rl::Bitmap::color_key key{ rl::color_rgb<std::uint8_t>(255, 0, 255) };
+    SECTION("Keyed pixels are cleared")
+    {
+        rl::Image destination(45, 3, 1, rl::Bitmap::Depth::Octuple, rl::Bitmap::Color::Rgba);
+        destination.Blit(source, 0, 0, 0, rl::Bitmap::Blend::Replace, key);
+        for (std::size_t pixel_i = 0; pixel_i < 45 * 3; pixel_i++)
+        {
+            const std::uint8_t cleared[] = { 0, 0, 0, 0 };
+            const auto* expected_pixel = (pixel_i % 3 == 0) ? reinterpret_cast<const rl::Bitmap::byte_t*>(cleared) : expected.GetData() + pixel_i * 4;
+            CHECK(std::memcmp(destination.GetData() + pixel_i * 4, expected_pixel, 4) == 0);
+        }
+    }
+    SECTION("Keyed pixels are skipped")
+    {
+        rl::Image destination(45, 3, 1, rl::Bitmap::Depth::Octuple, rl::Bitmap::Color::Rgba, rl::Bitmap::Layout::Tiled);
+        rl::Image background(45, 3, 1, rl::Bitmap::Depth::Octuple, rl::Bitmap::Color::Rgba);
+        rl::test::fill_test_image(background);
+        destination.Blit(background, 0, 0, 0);
+        rl::Executor executor(4);
+        destination.Blit(rl::ExecutionPolicy{ &executor, 0 }, source, 0, 0, 0, rl::Bitmap::Blend::Replace, rl::Bitmap::color_key{ key.color, rl::Bitmap::color_key::Mode::Skip });
+        rl::Image result(45, 3, 1, rl::Bitmap::Depth::Octuple, rl::Bitmap::Color::Rgba);
+        result.Blit(destination, 0, 0, 0);
+        for (std::size_t pixel_i = 0; pixel_i < 45 * 3; pixel_i++)
+        {
+            const auto& expected_image = (pixel_i % 3 == 0) ? background : expected;
+            CHECK(std::memcmp(result.GetData() + pixel_i * 4, expected_image.GetData() + pixel_i * 4, 4) == 0);
+        }
+    }
+    SECTION("Blended keyed pixels are skipped")
+    {
+        rl::Image destination(45, 3, 1, rl::Bitmap::Depth::Octuple, rl::Bitmap::Color::Rgba);
+        rl::test::fill_test_image(destination);
+        rl::Image background(45, 3, 1, rl::Bitmap::Depth::Octuple, rl::Bitmap::Color::Rgba);
+        rl::test::fill_test_image(background);
+        rl::Image blended(45, 3, 1, rl::Bitmap::Depth::Octuple, rl::Bitmap::Color::Rgba);
+        rl::test::fill_test_image(blended);
+        blended.Blit(source, 0, 0, 0, rl::Bitmap::Blend::Over);
+        destination.Blit(source, 0, 0, 0, rl::Bitmap::Blend::Over, key);
+        for (std::size_t pixel_i = 0; pixel_i < 45 * 3; pixel_i++)
+        {
+            const auto& expected_image = (pixel_i % 3 == 0) ? background : blended;
+            CHECK(std::memcmp(destination.GetData() + pixel_i * 4, expected_image.GetData() + pixel_i * 4, 4) == 0);
+        }
+    }
+    rl::set_simd_level(level);
+}
+
+TEST_CASE("A color keyed rl::Bitmap::Blit of a broken png throws a rl::runtime_error")
+{
+    const auto path = (std::filesystem::temp_directory_path() / "rla_keyed_blit_test.png").string();
+    rl::test::make_noise_image(64, 64, 1, rl::Bitmap::Depth::Octuple, rl::Bitmap::Color::Rgba).Save(path);
+    // the header is kept, so the png opens and fails while its rows are read
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) / 2);
+    rl::Image destination(64, 64, 1, rl::Bitmap::Depth::Octuple, rl::Bitmap::Color::Rgba);
+    const rl::Bitmap::color_key key{ rl::color_rgb<std::uint8_t>(255, 0, 255) };
+    CHECK_THROWS_AS(destination.Blit(path, 0, 0, 0, key), rl::runtime_error);
+    CHECK_THROWS_AS(destination.Blit(path, 0, 0, 0), rl::runtime_error);
+    std::filesystem::remove(path);
+}
@@ -0,0 +1,137 @@
+// SPDX-FileCopyrightText: 2023 Daniel Aimé Valcour <fosssweeper@gmail.com>
+//
+// SPDX-License-Identifier: MIT
+
+/*
+    Copyright (c) 2023 Daniel Aimé Valcour
+    Permission is hereby granted, free of charge, to any person obtaining a copy of
+    this software and associated documentation files (the "Software"), to deal in
+    the Software without restriction, including without limitation the rights to
+    use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+    the Software, and to permit persons to whom the Software is furnished to do so,
+    subject to the following conditions:
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+    FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+    COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+    IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+    CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include <catch2/catch_all.hpp>
+#include <rla/Bitmap.hpp>
+#include <rla/Executor.hpp>
+#include <rla/Image.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+namespace
+{
+    // random pixels with full or no coverage, and a last page without any
+    rl::Image make_mask_image(std::size_t width, std::size_t height, std::size_t page_count)
+    {
+        rl::Image image(width, height, page_count, rl::Bitmap::Depth::Octuple, rl::Bitmap::Color::G);
+        std::memset(image.GetData(), 0, image.GetPageOffset() * page_count);
+        std::uint32_t state = 12345;
+        for (std::size_t page_i = 0; page_i + 1 < page_count; page_i++)
+        {
+            for (std::size_t y = 0; y < height; y++)
+            {
+                auto* row = reinterpret_cast<std::uint8_t*>(image.GetData(0, y, page_i));
+                for (std::size_t x = 0; x < width; x++)
+                {
+                    state = state * 1103515245 + 12345;
+                    row[x] = (state >> 16) % 10 < 3 ? 255 : 0;
+                }
+            }
+        }
+        return image;
+    }
+
+    // the field of a mask measured against every other pixel
+    float get_expected_field(const rl::Image& mask, std::size_t x, std::size_t y, std::size_t page, float spread)
+    {
+        const auto get_is_inside = [&](std::size_t other_x, std::size_t other_y)
+        {
+            return *reinterpret_cast<const std::uint8_t*>(mask.GetData(other_x, other_y, page)) >= 128;
+        };
+        const bool is_inside = get_is_inside(x, y);
+        float squared = std::numeric_limits<float>::infinity();
+        for (std::size_t other_y = 0; other_y < mask.GetHeight(); other_y++)
+        {
+            for (std::size_t other_x = 0; other_x < mask.GetWidth(); other_x++)
+            {
+                if (get_is_inside(other_x, other_y) != is_inside)
+                {
+                    const float offset_x = static_cast<float>(other_x) - static_cast<float>(x);
+                    const float offset_y = static_cast<float>(other_y) - static_cast<float>(y);
+                    squared = std::min(squared, offset_x * offset_x + offset_y * offset_y);
+                }
+            }
+        }
+        const float distance = is_inside ? std::sqrt(squared) - 0.5f : 0.5f - std::sqrt(squared);
+        return std::clamp(0.5f + distance / (2.0f * spread), 0.0f, 1.0f);
+    }
+}
+
+// clang-format off
+
+TEST_CASE("rl::Bitmap::GenerateDistanceField matches the distances to every other pixel")
+{
+    const auto mask = make_mask_image(23, 17, 3);
+    rl::Image field(23, 17, 3, rl::Bitmap::Depth::Normalized, rl::Bitmap::Color::G);
+    field.GenerateDistanceField(mask, 6.0f);
+    bool is_exact = true;
+    for (std::size_t page_i = 0; page_i < 3; page_i++)
+    {
+        for (std::size_t y = 0; y < 17; y++)
+        {
+            for (std::size_t x = 0; x < 23; x++)
+            {
+                const float value = *reinterpret_cast<const float*>(field.GetData(x, y, page_i));
+                is_exact = is_exact && std::abs(value - get_expected_field(mask, x, y, page_i, 6.0f)) <= 1e-6f;
+            }
+        }
+    }
+    CHECK(is_exact);
+    // a page without any coverage is outside everywhere
+    CHECK(*reinterpret_cast<const float*>(field.GetData(11, 8, 2)) == 0.0f);
+    rl::Executor executor(4);
+    const rl::ExecutionPolicy policy{ &executor, 0 };
+    rl::Image parallel_field(23, 17, 3, rl::Bitmap::Depth::Normalized, rl::Bitmap::Color::G);
+    parallel_field.GenerateDistanceField(policy, mask, 6.0f);
+    CHECK(std::memcmp(parallel_field.GetData(), field.GetData(), field.GetPageOffset() * 3) == 0);
+}
+
+TEST_CASE("rl::Bitmap::GenerateDistanceField scales the field of a large source")
+{
+    // a disc with a radius of 20 pixels, read from the alpha of its pixels
+    rl::Image disc(64, 64, 1, rl::Bitmap::Depth::Octuple, rl::Bitmap::Color::Ga);
+    for (std::size_t y = 0; y < 64; y++)
+    {
+        for (std::size_t x = 0; x < 64; x++)
+        {
+            const float offset_x = static_cast<float>(x) + 0.5f - 32.0f;
+            const float offset_y = static_cast<float>(y) + 0.5f - 32.0f;
+            auto* pixel = reinterpret_cast<std::uint8_t*>(disc.GetData(x, y, 0));
+            pixel[0] = 255;
+            pixel[1] = offset_x * offset_x + offset_y * offset_y <= 400.0f ? 255 : 0;
+        }
+    }
+    rl::Image field(16, 16, 1, rl::Bitmap::Depth::Octuple, rl::Bitmap::Color::G);
+    field.GenerateDistanceField(disc, 16.0f);
+    const auto get_value = [&](std::size_t x, std::size_t y) { return *reinterpret_cast<const std::uint8_t*>(field.GetData(x, y, 0)); };
+    CHECK(get_value(0, 0) == 0);
+    CHECK(get_value(7, 7) >= 240);
+    // the edge crosses the middle row five field pixels from the center
+    CHECK(get_value(2, 8) < 128);
+    CHECK(get_value(3, 8) > 128);
+    CHECK_THROWS(field.GenerateDistanceField(disc, 0.0f));
+}
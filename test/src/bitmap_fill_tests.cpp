@@ -0,0 +1,163 @@
+// SPDX-FileCopyrightText: 2023 Daniel Aimé Valcour <fosssweeper@gmail.com>
+//
+// SPDX-License-Identifier: MIT
+
+/*
+    Copyright (c) 2023 Daniel Aimé Valcour
+    Permission is hereby granted, free of charge, to any person obtaining a copy of
+    this software and associated documentation files (the "Software"), to deal in
+    the Software without restriction, including without limitation the rights to
+    use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+    the Software, and to permit persons to whom the Software is furnished to do so,
+    subject to the following conditions:
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+    FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+    COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+    IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+    CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include <catch2/catch_all.hpp>
+#include <rla/Bitmap.hpp>
+#include <rla/Executor.hpp>
+#include <rla/Image.hpp>
+#include <rla/simd.hpp>
+#include "test_images.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace
+{
+    // the bytes a fill should leave, made by blitting a normalized image of the color
+    void blit_color(rl::Image& image, const rl::color_rgba<float>& color, std::size_t x, std::size_t y, std::size_t page, std::size_t width, std::size_t height, std::size_t page_count)
+    {
+        rl::Image source(width, height, page_count, rl::Bitmap::Depth::Normalized, rl::Bitmap::Color::Rgba, rl::Bitmap::Layout::Linear, 1, std::nullopt, rl::Bitmap::Alpha::Straight, image.GetSpace());
+        auto* floats = reinterpret_cast<float*>(source.GetData());
+        for (std::size_t pixel_i = 0; pixel_i < width * height * page_count; pixel_i++)
+        {
+            floats[pixel_i * 4] = color.r;
+            floats[pixel_i * 4 + 1] = color.g;
+            floats[pixel_i * 4 + 2] = color.b;
+            floats[pixel_i * 4 + 3] = color.a;
+        }
+        image.Blit(source, x, y, page);
+    }
+}
+
+// clang-format off
+
+TEST_CASE("rl::Bitmap::Fill sets a rectangle of pages like a blit of the color")
+{
+    const auto simd_level = GENERATE(rl::SimdLevel::Scalar, rl::get_supported_simd_level());
+    const auto depth = GENERATE(rl::Bitmap::Depth::Octuple, rl::Bitmap::Depth::Sexdecuple, rl::Bitmap::Depth::Normalized, rl::Bitmap::Depth::Half, rl::Bitmap::Depth::Single, rl::Bitmap::Depth::Duple, rl::Bitmap::Depth::Quadruple);
+    const auto color = GENERATE(rl::Bitmap::Color::G, rl::Bitmap::Color::Ga, rl::Bitmap::Color::Rgb, rl::Bitmap::Color::Rgba);
+    const auto layout = GENERATE(rl::Bitmap::Layout::Linear, rl::Bitmap::Layout::Tiled, rl::Bitmap::Layout::Planar);
+    const auto alpha = GENERATE(rl::Bitmap::Alpha::Straight, rl::Bitmap::Alpha::Premultiplied);
+    rl::set_simd_level(simd_level);
+    const rl::color_rgba<float> fill_color(0.75f, 0.25f, 0.5f, 0.5f);
+    rl::Image filled(37, 21, 3, depth, color, layout, 1, std::nullopt, alpha);
+    std::memset(filled.GetData(), 0xab, filled.GetSize());
+    rl::Image expected(37, 21, 3, depth, color, layout, 1, std::nullopt, alpha);
+    std::memset(expected.GetData(), 0xab, expected.GetSize());
+    filled.Fill(fill_color, 8, 3, 1, 21, 13, 2);
+    blit_color(expected, fill_color, 8, 3, 1, 21, 13, 2);
+    CHECK(rl::test::get_bytes(filled) == rl::test::get_bytes(expected));
+    filled.Fill(fill_color, 16, 8, 0, 21, 13);
+    blit_color(expected, fill_color, 16, 8, 0, 21, 13, 1);
+    CHECK(rl::test::get_bytes(filled) == rl::test::get_bytes(expected));
+    filled.Fill(fill_color);
+    blit_color(expected, fill_color, 0, 0, 0, 37, 21, 3);
+    CHECK(rl::test::get_bytes(filled) == rl::test::get_bytes(expected));
+    rl::set_simd_level(rl::get_supported_simd_level());
+}
+
+TEST_CASE("rl::Bitmap::Fill maps the color to the nearest color of an indexed palette")
+{
+    const auto depth = GENERATE(rl::Bitmap::Depth::Octuple, rl::Bitmap::Depth::Duple);
+    const std::vector<rl::color_rgba<rl::Bitmap::octuple_t>> palette = { { 0, 0, 0, 255 }, { 255, 0, 0, 255 }, { 0, 255, 0, 255 } };
+    rl::Image indexed(19, 5, 1, depth, rl::Bitmap::Color::Indexed);
+    CHECK_THROWS(indexed.Fill(rl::color_rgba<float>(0.0f, 1.0f, 0.0f, 1.0f)));
+    indexed.SetPalette(palette);
+    indexed.Fill(rl::color_rgba<float>(0.0f, 0.0f, 0.0f, 1.0f));
+    indexed.Fill(rl::color_rgba<float>(0.0f, 0.9f, 0.0f, 1.0f), 4, 1, 0, 15, 3);
+    rl::Image octuple(19, 5, 1, rl::Bitmap::Depth::Octuple, rl::Bitmap::Color::Indexed);
+    octuple.Blit(indexed, 0, 0, 0);
+    for (std::size_t y = 0; y < 5; y++)
+    {
+        for (std::size_t x = 0; x < 19; x++)
+        {
+            const bool is_filled = x >= 4 && y >= 1 && y < 4;
+            CHECK(std::to_integer<int>(*octuple.GetData(x, y, 0, 0)) == (is_filled ? 2 : 0));
+        }
+    }
+}
+
+TEST_CASE("rl::Bitmap::Fill throws for rectangles out of the bitmap or not aligned to bytes")
+{
+    rl::Image image(16, 16, 2, rl::Bitmap::Depth::Single, rl::Bitmap::Color::G);
+    CHECK_THROWS(image.Fill(rl::color_rgba<float>(1.0f, 1.0f, 1.0f, 1.0f), 8, 0, 0, 9, 1));
+    CHECK_THROWS(image.Fill(rl::color_rgba<float>(1.0f, 1.0f, 1.0f, 1.0f), 0, 0, 1, 1, 1, 2));
+    CHECK_THROWS(image.Fill(rl::color_rgba<float>(1.0f, 1.0f, 1.0f, 1.0f), 3, 0, 0, 1, 1));
+    CHECK_NOTHROW(image.Fill(rl::color_rgba<float>(1.0f, 1.0f, 1.0f, 1.0f), 8, 0, 0, 5, 16, 2));
+}
+
+TEST_CASE("rl::Bitmap::Fill with a policy fills like a serial fill")
+{
+    const auto layout = GENERATE(rl::Bitmap::Layout::Linear, rl::Bitmap::Layout::Tiled, rl::Bitmap::Layout::Planar);
+    rl::Executor executor(4);
+    const auto policy = rl::ExecutionPolicy{ &executor, 0 };
+    const rl::color_rgba<float> fill_color(0.2f, 0.4f, 0.6f, 0.8f);
+    rl::Image serial(301, 203, 2, rl::Bitmap::Depth::Sexdecuple, rl::Bitmap::Color::Rgba, layout);
+    std::memset(serial.GetData(), 0, serial.GetSize());
+    rl::Image parallel(301, 203, 2, rl::Bitmap::Depth::Sexdecuple, rl::Bitmap::Color::Rgba, layout);
+    std::memset(parallel.GetData(), 0, parallel.GetSize());
+    serial.Fill(fill_color, 8, 16, 0, 280, 160, 2);
+    parallel.Fill(policy, fill_color, 8, 16, 0, 280, 160, 2);
+    CHECK(rl::test::get_bytes(serial) == rl::test::get_bytes(parallel));
+    serial.Fill(fill_color);
+    parallel.Fill(policy, fill_color);
+    CHECK(rl::test::get_bytes(serial) == rl::test::get_bytes(parallel));
+}
+
+TEST_CASE("rl::Bitmap::Fill streams large fills")
+{
+    const auto simd_level = GENERATE(rl::SimdLevel::Scalar, rl::get_supported_simd_level());
+    rl::set_simd_level(simd_level);
+    rl::Image image(2048, 1100, 1, rl::Bitmap::Depth::Octuple, rl::Bitmap::Color::Rgba);
+    image.Fill(rl::color_rgba<float>(1.0f, 0.0f, 0.0f, 1.0f));
+    const std::uint8_t red[] = { 255, 0, 0, 255 };
+    bool is_red = true;
+    for (std::size_t pixel_i = 0; pixel_i < 2048 * 1100; pixel_i++)
+    {
+        is_red = is_red && std::memcmp(image.GetData() + pixel_i * 4, red, 4) == 0;
+    }
+    CHECK(is_red);
+    rl::set_simd_level(rl::get_supported_simd_level());
+}
+
+TEST_CASE("rl::Image::Create zeroes or fills the pixels")
+{
+    rl::Image image(7, 5, 2, rl::Bitmap::Depth::Half, rl::Bitmap::Color::Rgb, rl::color_rgba<float>(0.0f, 0.0f, 0.0f, 0.0f), rl::Bitmap::Layout::Linear, 16);
+    CHECK(rl::test::get_bytes(image) == std::vector<std::uint8_t>(image.GetPageOffset() * image.GetPageCount(), 0));
+    image.Create(7, 5, 2, rl::Bitmap::Depth::Normalized, rl::Bitmap::Color::Ga, rl::color_rgba<float>(0.5f, 0.5f, 0.5f, 0.25f), rl::Bitmap::Layout::Tiled);
+    for (std::size_t page = 0; page < 2; page++)
+    {
+        for (std::size_t y = 0; y < 5; y++)
+        {
+            for (std::size_t x = 0; x < 7; x++)
+            {
+                const auto* channels = reinterpret_cast<const float*>(image.GetData(x, y, page, 0));
+                CHECK(channels[0] == 0.5f);
+                CHECK(channels[1] == 0.25f);
+            }
+        }
+    }
+    // indexed images are created without a palette, so there is no color to fill them with
+    CHECK_THROWS(image.Create(7, 5, 2, rl::Bitmap::Depth::Octuple, rl::Bitmap::Color::Indexed, rl::color_rgba<float>(0.0f, 0.0f, 0.0f, 0.0f)));
+    CHECK_THROWS(image.Create(7, 5, 2, rl::Bitmap::Depth::Octuple, rl::Bitmap::Color::Indexed, rl::color_rgba<float>(1.0f, 0.0f, 0.0f, 1.0f)));
+}
@@ -0,0 +1,305 @@
+// SPDX-FileCopyrightText: 2023 Daniel Aimé Valcour <fosssweeper@gmail.com>
+//
+// SPDX-License-Identifier: MIT
+
+/*
+    Copyright (c) 2023 Daniel Aimé Valcour
+    Permission is hereby granted, free of charge, to any person obtaining a copy of
+    this software and associated documentation files (the "Software"), to deal in
+    the Software without restriction, including without limitation the rights to
+    use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+    the Software, and to permit persons to whom the Software is furnished to do so,
+    subject to the following conditions:
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+    FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+    COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+    IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+    CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include <catch2/catch_all.hpp>
+#include <rla/Bitmap.hpp>
+#include <rla/Image.hpp>
+#include <rla/Png.hpp>
+#include <rla/simd.hpp>
+#include "test_images.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <limits>
+#include <vector>
+
+namespace
+{
+    std::vector<float> get_floats(const rl::Image& image)
+    {
+        rl::Image normalized(image.GetWidth(), image.GetHeight(), image.GetPageCount(), rl::Bitmap::Depth::Normalized, image.GetColor(), rl::Bitmap::Layout::Linear, 1, std::nullopt, image.GetAlpha());
+        normalized.Blit(image, 0, 0, 0);
+        const auto* floats = reinterpret_cast<const float*>(normalized.GetData());
+        return std::vector<float>(floats, floats + normalized.GetSize() / sizeof(float));
+    }
+
+    void fill_floats(rl::Image& image)
+    {
+        auto* floats = reinterpret_cast<float*>(image.GetData());
+        for (std::size_t channel_i = 0; channel_i < image.GetSize() / sizeof(float); channel_i++)
+        {
+            floats[channel_i] = static_cast<float>((channel_i * 7919) % 1000) / 999.0f;
+        }
+    }
+
+    rl::Bitmap::half_t to_half(float value)
+    {
+        rl::Image normalized(1, 1, 1, rl::Bitmap::Depth::Normalized, rl::Bitmap::Color::G);
+        std::memcpy(normalized.GetData(), &value, sizeof(value));
+        rl::Image half(1, 1, 1, rl::Bitmap::Depth::Half, rl::Bitmap::Color::G);
+        half.Blit(normalized, 0, 0, 0);
+        rl::Bitmap::half_t bits;
+        std::memcpy(&bits, half.GetData(), sizeof(bits));
+        return bits;
+    }
+    // the distance between a positive normal half and the next one up
+    float get_half_ulp(float value)
+    {
+        return std::ldexp(1.0f, std::ilogb(value) - 10);
+    }
+}
+
+// clang-format off
+
+TEST_CASE("rl::Bitmap half depth has 16 bit channels")
+{
+    CHECK(rl::Bitmap::GetChannelSize(rl::Bitmap::Depth::Half) == 2);
+    CHECK(rl::Bitmap::GetBitDepth(rl::Bitmap::Depth::Half) == 16);
+    CHECK(rl::Bitmap::GetPixelSize(rl::Bitmap::Depth::Half, rl::Bitmap::Color::Rgba) == 8);
+    CHECK(rl::Bitmap::GetRowSize(5, rl::Bitmap::Depth::Half, rl::Bitmap::Color::Rgb) == 30);
+    CHECK_FALSE(rl::Bitmap::GetIsSubByte(rl::Bitmap::Depth::Half));
+}
+
+TEST_CASE("Half floats round to the nearest even binary16 value")
+{
+    const auto simd_level = GENERATE(rl::SimdLevel::Scalar, rl::get_supported_simd_level());
+    const auto level = rl::get_simd_level();
+    rl::set_simd_level(simd_level);
+    CHECK(to_half(0.0f) == 0x0000);
+    CHECK(to_half(-0.0f) == 0x8000);
+    CHECK(to_half(1.0f) == 0x3c00);
+    CHECK(to_half(-2.0f) == 0xc000);
+    CHECK(to_half(65504.0f) == 0x7bff);
+    CHECK(to_half(65519.0f) == 0x7bff);
+    CHECK(to_half(65520.0f) == 0x7c00);
+    CHECK(to_half(std::numeric_limits<float>::infinity()) == 0x7c00);
+    CHECK(to_half(std::ldexp(1.0f, -14)) == 0x0400);
+    CHECK(to_half(std::ldexp(1.0f, -24)) == 0x0001);
+    CHECK(to_half(std::ldexp(1.0f, -25)) == 0x0000);
+    CHECK(to_half(std::ldexp(3.0f, -25)) == 0x0002);
+    CHECK(to_half(1.0f + std::ldexp(1.0f, -11)) == 0x3c00);
+    CHECK(to_half(1.0f + std::ldexp(3.0f, -11)) == 0x3c02);
+    CHECK((to_half(std::numeric_limits<float>::quiet_NaN()) & 0x7e00) == 0x7e00);
+    rl::set_simd_level(level);
+}
+
+TEST_CASE("Half rl::Bitmap::Blit converts every half exactly, with every simd level")
+{
+    const auto simd_level = GENERATE(rl::SimdLevel::Scalar, rl::get_supported_simd_level());
+    const auto level = rl::get_simd_level();
+    rl::set_simd_level(simd_level);
+    // every half value once, in rows with a scalar tail
+    rl::Image half(251, 262, 1, rl::Bitmap::Depth::Half, rl::Bitmap::Color::G);
+    auto* halves = reinterpret_cast<rl::Bitmap::half_t*>(half.GetData());
+    for (std::size_t half_i = 0; half_i < half.GetWidth() * half.GetHeight(); half_i++)
+    {
+        halves[half_i] = static_cast<rl::Bitmap::half_t>(half_i);
+    }
+    rl::Image normalized(251, 262, 1, rl::Bitmap::Depth::Normalized, rl::Bitmap::Color::G);
+    normalized.Blit(half, 0, 0, 0);
+    rl::Image roundtrip(251, 262, 1, rl::Bitmap::Depth::Half, rl::Bitmap::Color::G);
+    roundtrip.Blit(normalized, 0, 0, 0);
+    const auto* floats = reinterpret_cast<const float*>(normalized.GetData());
+    const auto* roundtrip_halves = reinterpret_cast<const rl::Bitmap::half_t*>(roundtrip.GetData());
+    bool is_exact = true;
+    for (std::size_t half_i = 0; half_i < 65536; half_i++)
+    {
+        const bool is_nan = (half_i & 0x7c00) == 0x7c00 && (half_i & 0x03ff) != 0;
+        if (is_nan)
+        {
+            is_exact = is_exact && std::isnan(floats[half_i]) && (roundtrip_halves[half_i] & 0x7e00) == 0x7e00;
+        }
+        else
+        {
+            is_exact = is_exact && roundtrip_halves[half_i] == half_i;
+        }
+    }
+    CHECK(is_exact);
+    CHECK(floats[0x3c00] == 1.0f);
+    CHECK(floats[0x0001] == std::ldexp(1.0f, -24));
+    CHECK(floats[0xfbff] == -65504.0f);
+    SECTION("Octuple pixels survive a roundtrip through half pixels")
+    {
+        rl::Image octuple(256, 1, 1, rl::Bitmap::Depth::Octuple, rl::Bitmap::Color::Rgb);
+        auto* bytes = reinterpret_cast<std::uint8_t*>(octuple.GetData());
+        for (std::size_t byte_i = 0; byte_i < octuple.GetSize(); byte_i++)
+        {
+            bytes[byte_i] = static_cast<std::uint8_t>(byte_i / 3);
+        }
+        rl::Image rgba(256, 1, 1, rl::Bitmap::Depth::Half, rl::Bitmap::Color::Rgba, rl::Bitmap::Layout::Planar);
+        rgba.Blit(octuple, 0, 0, 0);
+        rl::Image converted(256, 1, 1, rl::Bitmap::Depth::Octuple, rl::Bitmap::Color::Rgb);
+        converted.Blit(rgba, 0, 0, 0);
+        CHECK(rl::test::get_bytes(converted) == rl::test::get_bytes(octuple));
+    }
+    rl::set_simd_level(level);
+}
+
+TEST_CASE("Half rl::Bitmap::Blit blends and converts alpha like normalized bitmaps")
+{
+    const auto blend = GENERATE(rl::Bitmap::Blend::Over, rl::Bitmap::Blend::OverPremultiplied, rl::Bitmap::Blend::Add, rl::Bitmap::Blend::Multiply);
+    rl::Image source(67, 3, 1, rl::Bitmap::Depth::Normalized, rl::Bitmap::Color::Rgba);
+    fill_floats(source);
+    rl::Image expected(67, 3, 1, rl::Bitmap::Depth::Normalized, rl::Bitmap::Color::Rgba);
+    fill_floats(expected);
+    std::reverse(reinterpret_cast<float*>(expected.GetData()), reinterpret_cast<float*>(expected.GetData()) + expected.GetSize() / sizeof(float));
+    rl::Image destination(67, 3, 1, rl::Bitmap::Depth::Half, rl::Bitmap::Color::Rgba);
+    destination.Blit(expected, 0, 0, 0);
+    rl::Image half_source(67, 3, 1, rl::Bitmap::Depth::Half, rl::Bitmap::Color::Rgba);
+    half_source.Blit(source, 0, 0, 0);
+    expected.Blit(source, 0, 0, 0, blend);
+    destination.Blit(half_source, 0, 0, 0, blend);
+    const auto expected_floats = get_floats(expected);
+    const auto floats = get_floats(destination);
+    bool is_close = true;
+    for (std::size_t channel_i = 0; channel_i < floats.size(); channel_i++)
+    {
+        is_close = is_close && std::abs(floats[channel_i] - expected_floats[channel_i]) <= 0.002f;
+    }
+    CHECK(is_close);
+    SECTION("Premultiplied half bitmaps premultiply their colors")
+    {
+        rl::Image premultiplied(67, 3, 1, rl::Bitmap::Depth::Half, rl::Bitmap::Color::Rgba, rl::Bitmap::Layout::Linear, 1, std::nullopt, rl::Bitmap::Alpha::Premultiplied);
+        premultiplied.Blit(source, 0, 0, 0);
+        const auto* source_floats = reinterpret_cast<const float*>(source.GetData());
+        const auto premultiplied_floats = get_floats(premultiplied);
+        bool is_premultiplied = true;
+        for (std::size_t pixel_i = 0; pixel_i < 67 * 3; pixel_i++)
+        {
+            const float alpha = source_floats[pixel_i * 4 + 3];
+            is_premultiplied = is_premultiplied && std::abs(premultiplied_floats[pixel_i * 4] - source_floats[pixel_i * 4] * alpha) <= 0.001f;
+        }
+        CHECK(is_premultiplied);
+    }
+}
+
+TEST_CASE("Half rl::Bitmap::Blit premultiplies and unpremultiplies without losing the precision of the other depth")
+{
+    const std::size_t width = 256;
+    SECTION("Sexdecuple to premultiplied half and back")
+    {
+        rl::Image source(width, 1, 1, rl::Bitmap::Depth::Sexdecuple, rl::Bitmap::Color::Rgba);
+        auto* source_channels = reinterpret_cast<std::uint16_t*>(source.GetData());
+        for (std::size_t pixel_i = 0; pixel_i < width; pixel_i++)
+        {
+            for (std::size_t channel_i = 0; channel_i < 3; channel_i++)
+            {
+                source_channels[pixel_i * 4 + channel_i] = static_cast<std::uint16_t>((pixel_i * 7919 + channel_i * 104729) % 65536);
+            }
+            source_channels[pixel_i * 4 + 3] = static_cast<std::uint16_t>(16384 + (pixel_i * 6607) % 49152);
+        }
+        rl::Image premultiplied(width, 1, 1, rl::Bitmap::Depth::Half, rl::Bitmap::Color::Rgba, rl::Bitmap::Layout::Linear, 1, std::nullopt, rl::Bitmap::Alpha::Premultiplied);
+        premultiplied.Blit(source, 0, 0, 0);
+        const auto half_floats = get_floats(premultiplied);
+        // the colors are rounded to half once, after premultiplying
+        bool is_premultiplied_once = true;
+        for (std::size_t pixel_i = 0; pixel_i < width; pixel_i++)
+        {
+            const double alpha = source_channels[pixel_i * 4 + 3] / 65535.0;
+            for (std::size_t channel_i = 0; channel_i < 3; channel_i++)
+            {
+                const double exact = source_channels[pixel_i * 4 + channel_i] / 65535.0 * alpha;
+                is_premultiplied_once = is_premultiplied_once && (exact < 0.001 || std::abs(half_floats[pixel_i * 4 + channel_i] - exact) <= get_half_ulp(static_cast<float>(exact)) * 0.501);
+            }
+        }
+        CHECK(is_premultiplied_once);
+        rl::Image straight(width, 1, 1, rl::Bitmap::Depth::Sexdecuple, rl::Bitmap::Color::Rgba);
+        straight.Blit(premultiplied, 0, 0, 0);
+        const auto* straight_channels = reinterpret_cast<const std::uint16_t*>(straight.GetData());
+        // the colors are divided by the alpha of the half without being rounded to half again
+        bool is_unpremultiplied_exactly = true;
+        for (std::size_t pixel_i = 0; pixel_i < width; pixel_i++)
+        {
+            for (std::size_t channel_i = 0; channel_i < 3; channel_i++)
+            {
+                const double expected = std::min(half_floats[pixel_i * 4 + channel_i] / static_cast<double>(half_floats[pixel_i * 4 + 3]), 1.0) * 65535.0;
+                is_unpremultiplied_exactly = is_unpremultiplied_exactly && std::abs(straight_channels[pixel_i * 4 + channel_i] - expected) <= 1.0;
+            }
+        }
+        CHECK(is_unpremultiplied_exactly);
+    }
+    SECTION("Normalized to premultiplied half and back")
+    {
+        rl::Image source(width, 1, 1, rl::Bitmap::Depth::Normalized, rl::Bitmap::Color::Rgba);
+        fill_floats(source);
+        auto* source_floats = reinterpret_cast<float*>(source.GetData());
+        for (std::size_t pixel_i = 0; pixel_i < width; pixel_i++)
+        {
+            source_floats[pixel_i * 4 + 3] = 0.25f + source_floats[pixel_i * 4 + 3] * 0.75f;
+        }
+        rl::Image premultiplied(width, 1, 1, rl::Bitmap::Depth::Half, rl::Bitmap::Color::Rgba, rl::Bitmap::Layout::Linear, 1, std::nullopt, rl::Bitmap::Alpha::Premultiplied);
+        premultiplied.Blit(source, 0, 0, 0);
+        const auto half_floats = get_floats(premultiplied);
+        bool is_premultiplied_once = true;
+        for (std::size_t pixel_i = 0; pixel_i < width; pixel_i++)
+        {
+            for (std::size_t channel_i = 0; channel_i < 3; channel_i++)
+            {
+                const double exact = static_cast<double>(source_floats[pixel_i * 4 + channel_i]) * source_floats[pixel_i * 4 + 3];
+                is_premultiplied_once = is_premultiplied_once && (exact < 0.001 || std::abs(half_floats[pixel_i * 4 + channel_i] - exact) <= get_half_ulp(static_cast<float>(exact)) * 0.501);
+            }
+        }
+        CHECK(is_premultiplied_once);
+        rl::Image straight(width, 1, 1, rl::Bitmap::Depth::Normalized, rl::Bitmap::Color::Rgba);
+        straight.Blit(premultiplied, 0, 0, 0);
+        const auto* straight_floats = reinterpret_cast<const float*>(straight.GetData());
+        bool is_unpremultiplied_exactly = true;
+        for (std::size_t pixel_i = 0; pixel_i < width; pixel_i++)
+        {
+            for (std::size_t channel_i = 0; channel_i < 3; channel_i++)
+            {
+                const double expected = half_floats[pixel_i * 4 + channel_i] / static_cast<double>(half_floats[pixel_i * 4 + 3]);
+                is_unpremultiplied_exactly = is_unpremultiplied_exactly && std::abs(straight_floats[pixel_i * 4 + channel_i] - expected) <= 0.000001;
+            }
+        }
+        CHECK(is_unpremultiplied_exactly);
+    }
+}
+
+TEST_CASE("Half rl::Image saves and loads 16 bit pngs")
+{
+    const auto path = (std::filesystem::temp_directory_path() / "rla_half_test.png").string();
+    const auto layout = GENERATE(rl::Bitmap::Layout::Linear, rl::Bitmap::Layout::Tiled);
+    rl::Image normalized(45, 13, 1, rl::Bitmap::Depth::Normalized, rl::Bitmap::Color::Rgba);
+    fill_floats(normalized);
+    rl::Image half(45, 13, 1, rl::Bitmap::Depth::Half, rl::Bitmap::Color::Rgba, layout);
+    half.Blit(normalized, 0, 0, 0);
+    half.Save(path);
+    CHECK(rl::Png(path).GetBitDepth() == 16);
+    rl::Image loaded(path, rl::Bitmap::Depth::Half);
+    CHECK(loaded.GetDepth() == rl::Bitmap::Depth::Half);
+    const auto floats = get_floats(loaded);
+    const auto expected_floats = get_floats(half);
+    bool is_close = true;
+    for (std::size_t channel_i = 0; channel_i < floats.size(); channel_i++)
+    {
+        is_close = is_close && std::abs(floats[channel_i] - expected_floats[channel_i]) <= 0.0005f;
+    }
+    CHECK(is_close);
+    rl::Image tiled(45, 13, 1, rl::Bitmap::Depth::Half, rl::Bitmap::Color::Rgba, rl::Bitmap::Layout::Tiled);
+    tiled.Blit(path, 0, 0, 0);
+    CHECK(get_floats(tiled) == floats);
+    std::filesystem::remove(path);
+}
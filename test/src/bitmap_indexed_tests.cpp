@@ -0,0 +1,274 @@
+// SPDX-FileCopyrightText: 2023 Daniel Aimé Valcour <fosssweeper@gmail.com>
+//
+// SPDX-License-Identifier: MIT
+
+/*
+    Copyright (c) 2023 Daniel Aimé Valcour
+    Permission is hereby granted, free of charge, to any person obtaining a copy of
+    this software and associated documentation files (the "Software"), to deal in
+    the Software without restriction, including without limitation the rights to
+    use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+    the Software, and to permit persons to whom the Software is furnished to do so,
+    subject to the following conditions:
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+    FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+    COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+    IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+    CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include <catch2/catch_all.hpp>
+#include <rla/Bitmap.hpp>
+#include <rla/Image.hpp>
+#include <rla/Executor.hpp>
+#include <rla/simd.hpp>
+#include "test_images.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <vector>
+
+namespace
+{
+    const std::vector<rl::color_rgba<std::uint8_t>> test_palette = {
+        rl::color_rgba<std::uint8_t>(255, 0, 255, 255),
+        rl::color_rgba<std::uint8_t>(10, 20, 30, 255),
+        rl::color_rgba<std::uint8_t>(200, 100, 50, 128),
+        rl::color_rgba<std::uint8_t>(0, 0, 0, 0),
+        rl::color_rgba<std::uint8_t>(1, 2, 3, 4)
+    };
+
+    // indexes past the end of the palette are in the pattern too
+    void fill_indexes(rl::Image& image)
+    {
+        auto* indexes = reinterpret_cast<std::uint8_t*>(image.GetData());
+        for (std::size_t byte_i = 0; byte_i < image.GetSize(); byte_i++)
+        {
+            indexes[byte_i] = static_cast<std::uint8_t>((byte_i * 7 + 3) % (test_palette.size() + 1));
+        }
+    }
+
+    // the straight rgba pixels of the indexes of a linear indexed image
+    void expand_indexes(rl::Image& destination, const rl::Image& indexed)
+    {
+        destination.Create(indexed.GetWidth(), indexed.GetHeight(), indexed.GetPageCount(), rl::Bitmap::Depth::Octuple, rl::Bitmap::Color::Rgba);
+        const auto* indexes = reinterpret_cast<const std::uint8_t*>(indexed.GetData());
+        auto* pixels = reinterpret_cast<std::uint8_t*>(destination.GetData());
+        for (std::size_t pixel_i = 0; pixel_i < indexed.GetSize(); pixel_i++)
+        {
+            const auto color = (indexes[pixel_i] < test_palette.size()) ? test_palette[indexes[pixel_i]] : rl::color_rgba<std::uint8_t>(0, 0, 0, 0);
+            const std::uint8_t channels[] = { color.r, color.g, color.b, color.a };
+            std::memcpy(pixels + pixel_i * 4, channels, 4);
+        }
+    }
+
+    // the padding of tiled images is not written by blits, so images of any layout are compared as linear images
+    bool get_is_same_pixels(const rl::Image& a, const rl::Image& b)
+    {
+        rl::Image linear_a(a.GetWidth(), a.GetHeight(), a.GetPageCount(), a.GetDepth(), a.GetColor(), rl::Bitmap::Layout::Linear, 1, std::nullopt, a.GetAlpha());
+        linear_a.Blit(a, 0, 0, 0);
+        rl::Image linear_b(b.GetWidth(), b.GetHeight(), b.GetPageCount(), b.GetDepth(), b.GetColor(), rl::Bitmap::Layout::Linear, 1, std::nullopt, b.GetAlpha());
+        linear_b.Blit(b, 0, 0, 0);
+        return rl::test::get_is_same(linear_a, linear_b);
+    }
+}
+
+// clang-format off
+
+TEST_CASE("An indexed rl::Bitmap::Blit expands the palette into every format")
+{
+    const auto depth = GENERATE(rl::Bitmap::Depth::Octuple, rl::Bitmap::Depth::Sexdecuple, rl::Bitmap::Depth::Normalized);
+    const auto color = GENERATE(rl::Bitmap::Color::G, rl::Bitmap::Color::Ga, rl::Bitmap::Color::Rgb, rl::Bitmap::Color::Rgba);
+    const auto layout = GENERATE(rl::Bitmap::Layout::Linear, rl::Bitmap::Layout::Tiled, rl::Bitmap::Layout::Planar);
+    const auto alpha = GENERATE(rl::Bitmap::Alpha::Straight, rl::Bitmap::Alpha::Premultiplied);
+    const auto simd_level = GENERATE(rl::SimdLevel::Scalar, rl::get_supported_simd_level());
+    const auto level = rl::get_simd_level();
+    rl::set_simd_level(simd_level);
+    rl::Image indexed(45, 3, 2, rl::Bitmap::Depth::Octuple, rl::Bitmap::Color::Indexed);
+    indexed.SetPalette(test_palette);
+    fill_indexes(indexed);
+    rl::Image rgba;
+    expand_indexes(rgba, indexed);
+    rl::Image expected(45, 3, 2, depth, color, layout, 1, std::nullopt, alpha);
+    expected.Blit(rgba, 0, 0, 0);
+    rl::Image expanded(45, 3, 2, depth, color, layout, 1, std::nullopt, alpha);
+    expanded.Blit(indexed, 0, 0, 0);
+    CHECK(get_is_same_pixels(expanded, expected));
+    rl::Executor executor(4);
+    rl::Image parallel(45, 3, 2, depth, color, layout, 1, std::nullopt, alpha);
+    parallel.Blit(rl::ExecutionPolicy{ &executor, 0 }, indexed, 0, 0, 0);
+    CHECK(get_is_same_pixels(parallel, expected));
+    rl::set_simd_level(level);
+}
+
+TEST_CASE("An indexed rl::Bitmap::Blit blends the palette colors")
+{
+    rl::Image indexed(45, 3, 1, rl::Bitmap::Depth::Octuple, rl::Bitmap::Color::Indexed);
+    indexed.SetPalette(test_palette);
+    fill_indexes(indexed);
+    rl::Image rgba;
+    expand_indexes(rgba, indexed);
+    rl::Image expected(45, 3, 1, rl::Bitmap::Depth::Octuple, rl::Bitmap::Color::Rgb);
+    std::memset(expected.GetData(), 90, expected.GetSize());
+    expected.Blit(rgba, 0, 0, 0, rl::Bitmap::Blend::Over);
+    rl::Image blended(45, 3, 1, rl::Bitmap::Depth::Octuple, rl::Bitmap::Color::Rgb);
+    std::memset(blended.GetData(), 90, blended.GetSize());
+    blended.Blit(indexed, 0, 0, 0, rl::Bitmap::Blend::Over);
+    CHECK(rl::test::get_is_same(blended, expected));
+}
+
+TEST_CASE("A rl::Bitmap::Blit into an indexed rl::Bitmap maps colors to the nearest palette color")
+{
+    rl::Image rgb(4, 1, 1, rl::Bitmap::Depth::Octuple, rl::Bitmap::Color::Rgba);
+    const std::uint8_t pixels[] = { 10, 20, 30, 255, 250, 5, 250, 255, 200, 100, 50, 128, 2, 2, 2, 3 };
+    std::memcpy(rgb.GetData(), pixels, sizeof(pixels));
+    rl::Image indexed(4, 1, 1, rl::Bitmap::Depth::Octuple, rl::Bitmap::Color::Indexed);
+    indexed.SetPalette(test_palette);
+    indexed.Blit(rgb, 0, 0, 0);
+    const std::uint8_t expected[] = { 1, 0, 2, 4 };
+    CHECK(std::memcmp(indexed.GetData(), expected, sizeof(expected)) == 0);
+    CHECK_THROWS(indexed.Blit(rgb, 0, 0, 0, rl::Bitmap::Blend::Over));
+    rl::Image unpaletted(4, 1, 1, rl::Bitmap::Depth::Octuple, rl::Bitmap::Color::Indexed);
+    CHECK_THROWS(unpaletted.Blit(rgb, 0, 0, 0));
+    SECTION("Indexes copy straight over between indexed bitmaps")
+    {
+        rl::Image copy(4, 1, 1, rl::Bitmap::Depth::Octuple, rl::Bitmap::Color::Indexed, rl::Bitmap::Layout::Tiled);
+        copy.Blit(indexed, 0, 0, 0);
+        rl::Image linear(4, 1, 1, rl::Bitmap::Depth::Octuple, rl::Bitmap::Color::Indexed);
+        linear.Blit(copy, 0, 0, 0);
+        CHECK(std::memcmp(linear.GetData(), expected, sizeof(expected)) == 0);
+    }
+}
+
+TEST_CASE("Swapping the palette of an indexed rl::Bitmap changes its colors without touching its pixels")
+{
+    rl::Image indexed(45, 3, 1, rl::Bitmap::Depth::Octuple, rl::Bitmap::Color::Indexed);
+    indexed.SetPalette(test_palette);
+    fill_indexes(indexed);
+    std::vector<rl::color_rgba<std::uint8_t>> swapped(test_palette.rbegin(), test_palette.rend());
+    const rl::Bitmap::View swapped_view(indexed.GetData(), 45, 3, 1, rl::Bitmap::Depth::Octuple, rl::Bitmap::Color::Indexed, std::nullopt, std::nullopt, rl::Bitmap::Layout::Linear, std::nullopt, rl::Bitmap::Alpha::Straight, swapped);
+    rl::Image rgba(45, 3, 1, rl::Bitmap::Depth::Octuple, rl::Bitmap::Color::Rgba);
+    rgba.Blit(swapped_view, 0, 0, 0);
+    const auto* indexes = reinterpret_cast<const std::uint8_t*>(indexed.GetData());
+    for (std::size_t pixel_i = 0; pixel_i < 45 * 3; pixel_i++)
+    {
+        const auto color = (indexes[pixel_i] < swapped.size()) ? swapped[indexes[pixel_i]] : rl::color_rgba<std::uint8_t>(0, 0, 0, 0);
+        const std::uint8_t expected[] = { color.r, color.g, color.b, color.a };
+        CHECK(std::memcmp(rgba.GetData() + pixel_i * 4, expected, 4) == 0);
+    }
+}
+
+TEST_CASE("A color keyed indexed rl::Bitmap::Blit keys the indexes of the key color")
+{
+    rl::Image indexed(45, 3, 1, rl::Bitmap::Depth::Octuple, rl::Bitmap::Color::Indexed);
+    indexed.SetPalette(test_palette);
+    fill_indexes(indexed);
+    rl::Image rgba;
+    expand_indexes(rgba, indexed);
+    rl::Image keyed(45, 3, 1, rl::Bitmap::Depth::Octuple, rl::Bitmap::Color::Rgba);
+    keyed.Blit(indexed, 0, 0, 0, rl::Bitmap::Blend::Replace, rl::Bitmap::color_key{ rl::color_rgb<std::uint8_t>(255, 0, 255) });
+    const auto* indexes = reinterpret_cast<const std::uint8_t*>(indexed.GetData());
+    for (std::size_t pixel_i = 0; pixel_i < 45 * 3; pixel_i++)
+    {
+        const std::uint8_t cleared[] = { 0, 0, 0, 0 };
+        const auto* expected_pixel = (indexes[pixel_i] == 0) ? reinterpret_cast<const rl::Bitmap::byte_t*>(cleared) : rgba.GetData() + pixel_i * 4;
+        CHECK(std::memcmp(keyed.GetData() + pixel_i * 4, expected_pixel, 4) == 0);
+    }
+}
+
+TEST_CASE("rl::Bitmap::FindPalette finds the exact colors of a rl::Bitmap")
+{
+    rl::Image rgb(45, 3, 1, rl::Bitmap::Depth::Sexdecuple, rl::Bitmap::Color::Rgb, rl::Bitmap::Layout::Tiled);
+    rl::Image pattern(45, 3, 1, rl::Bitmap::Depth::Octuple, rl::Bitmap::Color::Rgb);
+    auto* pixels = reinterpret_cast<std::uint8_t*>(pattern.GetData());
+    for (std::size_t pixel_i = 0; pixel_i < 45 * 3; pixel_i++)
+    {
+        const std::uint8_t value = static_cast<std::uint8_t>(pixel_i % 3 * 100);
+        const std::uint8_t pixel[] = { value, 7, value };
+        std::memcpy(pixels + pixel_i * 3, pixel, 3);
+    }
+    rgb.Blit(pattern, 0, 0, 0);
+    const auto palette_o = rl::Bitmap::FindPalette(rgb);
+    REQUIRE(palette_o.has_value());
+    REQUIRE(palette_o->size() == 3);
+    CHECK(((*palette_o)[1].r == 100 && (*palette_o)[1].g == 7 && (*palette_o)[1].b == 100 && (*palette_o)[1].a == 255));
+    CHECK_FALSE(rl::Bitmap::FindPalette(rgb, 2).has_value());
+    SECTION("An rl::Image is converted to indexed without changing its pixels")
+    {
+        REQUIRE(rgb.ConvertToIndexed());
+        CHECK(rgb.GetColor() == rl::Bitmap::Color::Indexed);
+        CHECK(rgb.GetLayout() == rl::Bitmap::Layout::Tiled);
+        CHECK(rgb.GetPalette().size() == 3);
+        rl::Image expanded(45, 3, 1, rl::Bitmap::Depth::Octuple, rl::Bitmap::Color::Rgb);
+        expanded.Blit(rgb, 0, 0, 0);
+        CHECK(rl::test::get_is_same(expanded, pattern));
+        CHECK_THROWS(rgb.GenerateMips());
+    }
+    SECTION("An rl::Image with too many colors is not converted")
+    {
+        rl::Image many(300, 1, 1, rl::Bitmap::Depth::Octuple, rl::Bitmap::Color::Ga);
+        for (std::size_t pixel_i = 0; pixel_i < 300; pixel_i++)
+        {
+            const std::uint8_t pixel[] = { static_cast<std::uint8_t>(pixel_i), static_cast<std::uint8_t>(pixel_i / 256) };
+            std::memcpy(many.GetData() + pixel_i * 2, pixel, 2);
+        }
+        CHECK_FALSE(many.ConvertToIndexed());
+        CHECK(many.GetColor() == rl::Bitmap::Color::Ga);
+    }
+}
+
+TEST_CASE("An indexed rl::Image saves and loads as a palette png")
+{
+    const auto path = (std::filesystem::temp_directory_path() / "rla_indexed_test.png").string();
+    rl::Image indexed(45, 3, 1, rl::Bitmap::Depth::Octuple, rl::Bitmap::Color::Indexed);
+    indexed.SetPalette(test_palette);
+    fill_indexes(indexed);
+    // indexes past the end of the palette can not be saved
+    auto* indexes = reinterpret_cast<std::uint8_t*>(indexed.GetData());
+    for (std::size_t pixel_i = 0; pixel_i < 45 * 3; pixel_i++)
+    {
+        indexes[pixel_i] %= test_palette.size();
+    }
+    indexed.Save(path);
+    SECTION("Palette pngs load indexed")
+    {
+        rl::Image loaded(path);
+        REQUIRE(loaded.GetColor() == rl::Bitmap::Color::Indexed);
+        REQUIRE(loaded.GetPalette().size() == test_palette.size());
+        for (std::size_t color_i = 0; color_i < test_palette.size(); color_i++)
+        {
+            const auto& color = loaded.GetPalette()[color_i];
+            CHECK((color.r == test_palette[color_i].r && color.g == test_palette[color_i].g && color.b == test_palette[color_i].b && color.a == test_palette[color_i].a));
+        }
+        CHECK(rl::test::get_is_same(loaded, indexed));
+    }
+    SECTION("Palette pngs load expanded into other formats")
+    {
+        rl::Image rgba;
+        expand_indexes(rgba, indexed);
+        rl::Image loaded(path, std::nullopt, rl::Bitmap::Color::Rgba);
+        CHECK(rl::test::get_is_same(loaded, rgba));
+        rl::Image tiled(45, 3, 1, rl::Bitmap::Depth::Octuple, rl::Bitmap::Color::Indexed, rl::Bitmap::Layout::Tiled);
+        tiled.SetPalette(test_palette);
+        tiled.Blit(path, 0, 0, 0);
+        rl::Image linear(45, 3, 1, rl::Bitmap::Depth::Octuple, rl::Bitmap::Color::Indexed);
+        linear.Blit(tiled, 0, 0, 0);
+        CHECK(rl::test::get_is_same(linear, indexed));
+    }
+    SECTION("Truecolor pngs load indexed with their exact palette")
+    {
+        rl::Image rgba;
+        expand_indexes(rgba, indexed);
+        rgba.Save(path);
+        rl::Image loaded(path, std::nullopt, rl::Bitmap::Color::Indexed);
+        REQUIRE(loaded.GetColor() == rl::Bitmap::Color::Indexed);
+        rl::Image expanded(45, 3, 1, rl::Bitmap::Depth::Octuple, rl::Bitmap::Color::Rgba);
+        expanded.Blit(loaded, 0, 0, 0);
+        CHECK(rl::test::get_is_same(expanded, rgba));
+    }
+    std::filesystem::remove(path);
+}
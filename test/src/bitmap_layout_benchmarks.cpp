@@ -0,0 +1,70 @@
+// SPDX-FileCopyrightText: 2023 Daniel Aimé Valcour <fosssweeper@gmail.com>
+//
+// SPDX-License-Identifier: MIT
+
+/*
+    Copyright (c) 2023 Daniel Aimé Valcour
+    Permission is hereby granted, free of charge, to any person obtaining a copy of
+    this software and associated documentation files (the "Software"), to deal in
+    the Software without restriction, including without limitation the rights to
+    use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+    the Software, and to permit persons to whom the Software is furnished to do so,
+    subject to the following conditions:
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+    FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+    COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+    IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+    CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include <catch2/catch_all.hpp>
+#include <rla/Bitmap.hpp>
+#include <rla/Image.hpp>
+#include <cstddef>
+#include <cstring>
+
+// clang-format off
+
+// the benchmarks are hidden from the default run. run them with the [benchmark] tag.
+TEST_CASE("Glyph sized sub rect blits are benchmarked in linear and tiled layouts", "[.][benchmark]")
+{
+    const std::size_t atlas_width = 2048;
+    const std::size_t glyph_width = 16;
+    const auto layout = GENERATE(rl::Bitmap::Layout::Linear, rl::Bitmap::Layout::Tiled);
+    rl::Image source(atlas_width, atlas_width, 1, rl::Bitmap::Depth::Octuple, rl::Bitmap::Color::Rgba, layout);
+    rl::Image destination(atlas_width, atlas_width, 1, rl::Bitmap::Depth::Octuple, rl::Bitmap::Color::Rgba, layout);
+    std::memset(source.GetData(), 0x7f, source.GetSize());
+    const std::size_t glyphs_per_row = atlas_width / glyph_width;
+    const char* layout_name = (layout == rl::Bitmap::Layout::Linear) ? "linear" : "tiled";
+    BENCHMARK(std::string("copy glyphs ") + layout_name)
+    {
+        for (std::size_t glyph_i = 0; glyph_i < glyphs_per_row * glyphs_per_row; glyph_i++)
+        {
+            const std::size_t glyph_x = (glyph_i % glyphs_per_row) * glyph_width;
+            const std::size_t glyph_y = (glyph_i / glyphs_per_row) * glyph_width;
+            destination.Blit(source.GetBitmapView(glyph_x, glyph_y, 0, glyph_width, glyph_width, 1), atlas_width - glyph_x - glyph_width, glyph_y, 0);
+        }
+        return destination.GetData()[0];
+    };
+    rl::Image gray(atlas_width, atlas_width, 1, rl::Bitmap::Depth::Octuple, rl::Bitmap::Color::G, layout);
+    BENCHMARK(std::string("convert glyphs ") + layout_name)
+    {
+        for (std::size_t glyph_i = 0; glyph_i < glyphs_per_row * glyphs_per_row; glyph_i++)
+        {
+            const std::size_t glyph_x = (glyph_i % glyphs_per_row) * glyph_width;
+            const std::size_t glyph_y = (glyph_i / glyphs_per_row) * glyph_width;
+            source.Blit(gray.GetBitmapView(glyph_x, glyph_y, 0, glyph_width, glyph_width, 1), glyph_x, glyph_y, 0);
+        }
+        return source.GetData()[0];
+    };
+    BENCHMARK(std::string("convert layout ") + layout_name)
+    {
+        rl::Image converted(atlas_width, atlas_width, 1, rl::Bitmap::Depth::Octuple, rl::Bitmap::Color::Rgba,
+            (layout == rl::Bitmap::Layout::Linear) ? rl::Bitmap::Layout::Tiled : rl::Bitmap::Layout::Linear);
+        converted.Blit(source, 0, 0, 0);
+        return converted.GetData()[0];
+    };
+}
@@ -0,0 +1,106 @@
+// SPDX-FileCopyrightText: 2023 Daniel Aimé Valcour <fosssweeper@gmail.com>
+//
+// SPDX-License-Identifier: MIT
+
+/*
+    Copyright (c) 2023 Daniel Aimé Valcour
+    Permission is hereby granted, free of charge, to any person obtaining a copy of
+    this software and associated documentation files (the "Software"), to deal in
+    the Software without restriction, including without limitation the rights to
+    use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+    the Software, and to permit persons to whom the Software is furnished to do so,
+    subject to the following conditions:
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+    FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+    COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+    IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+    CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include <catch2/catch_all.hpp>
+#include <rla/Bitmap.hpp>
+#include <rla/Executor.hpp>
+#include <rla/Image.hpp>
+#include "test_images.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace
+{
+    // the pixels of an image in a linear image, so images of every layout compare the same. sub-byte pixels are unpacked
+    // to octuple ones, so the bits after the last pixel of a row are not compared.
+    std::vector<std::uint8_t> get_linear_bytes(const rl::Image& image)
+    {
+        const auto depth = rl::Bitmap::GetIsSubByte(image.GetDepth()) ? rl::Bitmap::Depth::Octuple : image.GetDepth();
+        rl::Image linear(image.GetWidth(), image.GetHeight(), image.GetPageCount(), depth, image.GetColor(), rl::Bitmap::Layout::Linear, 1, std::nullopt, image.GetAlpha());
+        linear.Blit(image, 0, 0, 0);
+        const auto* bytes = reinterpret_cast<const std::uint8_t*>(linear.GetData());
+        return std::vector<std::uint8_t>(bytes, bytes + linear.GetPageOffset() * linear.GetPageCount());
+    }
+
+    // the bytes a move should leave, made by copying the source through another image
+    std::vector<std::uint8_t> get_expected_bytes(const rl::Image& image, std::size_t x, std::size_t y, std::size_t page, std::size_t width, std::size_t height, std::size_t page_count, std::size_t destination_x, std::size_t destination_y, std::size_t destination_page)
+    {
+        rl::Image linear(image.GetWidth(), image.GetHeight(), image.GetPageCount(), image.GetDepth(), image.GetColor(), rl::Bitmap::Layout::Linear, 1, std::nullopt, image.GetAlpha());
+        linear.Blit(image, 0, 0, 0);
+        rl::Image copy(width, height, page_count, image.GetDepth(), image.GetColor(), rl::Bitmap::Layout::Linear, 1, std::nullopt, image.GetAlpha());
+        copy.Blit(linear.GetBitmapView(x, y, page, width, height, page_count), 0, 0, 0);
+        linear.Blit(copy, destination_x, destination_y, destination_page);
+        return get_linear_bytes(linear);
+    }
+}
+
+// clang-format off
+
+TEST_CASE("rl::Bitmap::Move moves overlapping rectangles like a copy through another image")
+{
+    const auto depth = GENERATE(rl::Bitmap::Depth::Octuple, rl::Bitmap::Depth::Sexdecuple, rl::Bitmap::Depth::Normalized, rl::Bitmap::Depth::Half, rl::Bitmap::Depth::Single, rl::Bitmap::Depth::Duple, rl::Bitmap::Depth::Quadruple);
+    const auto color = GENERATE(rl::Bitmap::Color::G, rl::Bitmap::Color::Ga, rl::Bitmap::Color::Rgb, rl::Bitmap::Color::Rgba);
+    const auto layout = GENERATE(rl::Bitmap::Layout::Linear, rl::Bitmap::Layout::Tiled, rl::Bitmap::Layout::Planar);
+    // forward and backward moves across pages, a horizontal scroll within the rows and a vertical scroll of whole pages
+    const auto move = GENERATE(
+        std::array<std::size_t, 9>{ 8, 3, 0, 21, 13, 2, 16, 5, 1 },
+        std::array<std::size_t, 9>{ 16, 5, 1, 21, 13, 2, 8, 3, 0 },
+        std::array<std::size_t, 9>{ 8, 3, 0, 29, 13, 3, 0, 3, 0 },
+        std::array<std::size_t, 9>{ 0, 3, 0, 29, 13, 3, 8, 3, 0 },
+        std::array<std::size_t, 9>{ 0, 1, 0, 37, 20, 3, 0, 0, 0 },
+        std::array<std::size_t, 9>{ 0, 0, 0, 37, 20, 3, 0, 1, 0 },
+        std::array<std::size_t, 9>{ 0, 0, 0, 16, 21, 1, 16, 0, 2 }
+    );
+    auto image = rl::test::make_noise_image(37, 21, 3, depth, color, layout, rl::Bitmap::Alpha::Premultiplied);
+    const auto expected = get_expected_bytes(image, move[0], move[1], move[2], move[3], move[4], move[5], move[6], move[7], move[8]);
+    image.Move(move[0], move[1], move[2], move[3], move[4], move[5], move[6], move[7], move[8]);
+    CHECK(get_linear_bytes(image) == expected);
+}
+
+TEST_CASE("rl::Bitmap::Move with a policy matches the serial move")
+{
+    rl::Executor executor(4);
+    const rl::ExecutionPolicy policy{ &executor, 0 };
+    const auto layout = GENERATE(rl::Bitmap::Layout::Linear, rl::Bitmap::Layout::Tiled, rl::Bitmap::Layout::Planar);
+    const auto move = GENERATE(
+        std::array<std::size_t, 9>{ 0, 1, 0, 97, 66, 4, 0, 0, 0 },
+        std::array<std::size_t, 9>{ 0, 0, 0, 40, 67, 4, 48, 0, 0 },
+        std::array<std::size_t, 9>{ 3, 2, 0, 90, 60, 2, 5, 7, 2 }
+    );
+    auto image = rl::test::make_noise_image(97, 67, 4, rl::Bitmap::Depth::Octuple, rl::Bitmap::Color::Rgba, layout, rl::Bitmap::Alpha::Premultiplied);
+    const auto expected = get_expected_bytes(image, move[0], move[1], move[2], move[3], move[4], move[5], move[6], move[7], move[8]);
+    image.Move(policy, move[0], move[1], move[2], move[3], move[4], move[5], move[6], move[7], move[8]);
+    CHECK(get_linear_bytes(image) == expected);
+}
+
+TEST_CASE("rl::Bitmap::Move throws for rectangles out of the bitmap and unaligned sub-byte moves")
+{
+    rl::Image image(16, 8, 2, rl::Bitmap::Depth::Single, rl::Bitmap::Color::G);
+    CHECK_THROWS(image.Move(0, 0, 0, 16, 8, 1, 1, 0, 0));
+    CHECK_THROWS(image.Move(0, 0, 0, 8, 8, 2, 0, 0, 1));
+    CHECK_THROWS(image.Move(0, 0, 0, 8, 4, 1, 3, 0, 0));
+    CHECK_THROWS(image.Move(4, 0, 0, 8, 4, 1, 0, 0, 0));
+    CHECK_NOTHROW(image.Move(0, 0, 0, 8, 4, 1, 8, 4, 1));
+    CHECK_NOTHROW(image.Move(0, 0, 0, 0, 0, 0, 16, 8, 2));
+}
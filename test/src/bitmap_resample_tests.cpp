@@ -0,0 +1,220 @@
+// SPDX-FileCopyrightText: 2023 Daniel Aimé Valcour <fosssweeper@gmail.com>
+//
+// SPDX-License-Identifier: MIT
+
+/*
+    Copyright (c) 2023 Daniel Aimé Valcour
+    Permission is hereby granted, free of charge, to any person obtaining a copy of
+    this software and associated documentation files (the "Software"), to deal in
+    the Software without restriction, including without limitation the rights to
+    use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+    the Software, and to permit persons to whom the Software is furnished to do so,
+    subject to the following conditions:
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+    FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+    COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+    IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+    CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include <catch2/catch_all.hpp>
+#include <rla/Bitmap.hpp>
+#include <rla/Image.hpp>
+#include <rla/Executor.hpp>
+#include <rla/simd.hpp>
+#include "test_images.hpp"
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace
+{
+    // images are resampled into linear images, so the bytes of different layouts can be compared
+    void resample(rl::Image& destination, const rl::Bitmap::View& source, std::size_t width, std::size_t height, rl::Bitmap::Filter filter, rl::Bitmap::Layout layout = rl::Bitmap::Layout::Linear)
+    {
+        rl::Image resampled(width, height, source.GetPageCount(), source.GetDepth(), source.GetColor(), layout);
+        resampled.Resample(source, filter);
+        destination.Create(width, height, source.GetPageCount(), source.GetDepth(), source.GetColor());
+        destination.Blit(resampled, 0, 0, 0);
+    }
+}
+
+// clang-format off
+
+TEST_CASE("rl::Bitmap::Resample keeps the pixels of a source of the same size")
+{
+    rl::Image source(7, 5, 2, rl::Bitmap::Depth::Octuple, rl::Bitmap::Color::Rgba);
+    rl::test::fill_test_image(source);
+    for (const auto filter : { rl::Bitmap::Filter::Box, rl::Bitmap::Filter::Bilinear, rl::Bitmap::Filter::Lanczos3 })
+    {
+        rl::Image destination;
+        resample(destination, source, 7, 5, filter);
+        CHECK(rl::test::get_is_same(destination, source));
+    }
+}
+
+TEST_CASE("A box rl::Bitmap::Resample to half size averages each 2x2 block")
+{
+    rl::Image source(4, 4, 1, rl::Bitmap::Depth::Normalized, rl::Bitmap::Color::G);
+    auto* values = reinterpret_cast<float*>(source.GetData());
+    for (std::size_t value_i = 0; value_i < 16; value_i++)
+    {
+        values[value_i] = static_cast<float>(value_i) / 16.0f;
+    }
+    rl::Image destination;
+    resample(destination, source, 2, 2, rl::Bitmap::Filter::Box);
+    const auto* results = reinterpret_cast<const float*>(destination.GetData());
+    const std::array<float, 4> expected = { 2.5f / 16.0f, 4.5f / 16.0f, 10.5f / 16.0f, 12.5f / 16.0f };
+    for (std::size_t value_i = 0; value_i < 4; value_i++)
+    {
+        CHECK(std::abs(results[value_i] - expected[value_i]) <= 1e-6f);
+    }
+}
+
+TEST_CASE("rl::Bitmap::Resample keeps a constant image constant")
+{
+    for (const auto depth : { rl::Bitmap::Depth::Octuple, rl::Bitmap::Depth::Sexdecuple, rl::Bitmap::Depth::Normalized })
+    {
+        for (const auto color : { rl::Bitmap::Color::G, rl::Bitmap::Color::Ga, rl::Bitmap::Color::Rgb, rl::Bitmap::Color::Rgba })
+        {
+            rl::Image source(9, 6, 1, depth, color);
+            rl::Image pixel(1, 1, 1, rl::Bitmap::Depth::Octuple, rl::Bitmap::Color::Rgba);
+            const std::array<std::uint8_t, 4> value = { 200, 100, 50, 255 };
+            std::memcpy(pixel.GetData(), value.data(), 4);
+            for (std::size_t y = 0; y < source.GetHeight(); y++)
+            {
+                for (std::size_t x = 0; x < source.GetWidth(); x++)
+                {
+                    source.Blit(pixel, x, y, 0);
+                }
+            }
+            for (const auto filter : { rl::Bitmap::Filter::Box, rl::Bitmap::Filter::Bilinear, rl::Bitmap::Filter::Lanczos3 })
+            {
+                for (const auto size : { std::array<std::size_t, 2>{ 4, 3 }, std::array<std::size_t, 2>{ 20, 13 } })
+                {
+                    rl::Image destination;
+                    resample(destination, source, size[0], size[1], filter);
+                    rl::Image expected(size[0], size[1], 1, depth, color);
+                    for (std::size_t y = 0; y < size[1]; y++)
+                    {
+                        for (std::size_t x = 0; x < size[0]; x++)
+                        {
+                            expected.Blit(rl::Bitmap::View(source.GetData(), 1, 1, 1, depth, color), x, y, 0);
+                        }
+                    }
+                    if (depth == rl::Bitmap::Depth::Normalized)
+                    {
+                        const auto* results = reinterpret_cast<const float*>(destination.GetData());
+                        const auto* expected_results = reinterpret_cast<const float*>(expected.GetData());
+                        for (std::size_t value_i = 0; value_i < destination.GetSize() / sizeof(float); value_i++)
+                        {
+                            CHECK(std::abs(results[value_i] - expected_results[value_i]) <= 1e-5f);
+                        }
+                    }
+                    else
+                    {
+                        CHECK(rl::test::get_is_same(destination, expected));
+                    }
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE("rl::Bitmap::Resample keeps float colors past one")
+{
+    rl::Image source(6, 4, 1, rl::Bitmap::Depth::Normalized, rl::Bitmap::Color::Rgba);
+    auto* values = reinterpret_cast<float*>(source.GetData());
+    for (std::size_t pixel_i = 0; pixel_i < 24; pixel_i++)
+    {
+        values[pixel_i * 4 + 0] = 4.0f;
+        values[pixel_i * 4 + 1] = 0.5f;
+        values[pixel_i * 4 + 2] = 16.0f;
+        values[pixel_i * 4 + 3] = 0.5f;
+    }
+    for (const auto depth : { rl::Bitmap::Depth::Normalized, rl::Bitmap::Depth::Half })
+    {
+        rl::Image straight(11, 9, 1, depth, rl::Bitmap::Color::Rgba);
+        straight.Resample(source, rl::Bitmap::Filter::Lanczos3);
+        rl::Image result(11, 9, 1, rl::Bitmap::Depth::Normalized, rl::Bitmap::Color::Rgba);
+        result.Blit(straight, 0, 0, 0);
+        const auto* results = reinterpret_cast<const float*>(result.GetData());
+        for (std::size_t pixel_i = 0; pixel_i < 11 * 9; pixel_i++)
+        {
+            CHECK(std::abs(results[pixel_i * 4 + 0] - 4.0f) <= 1e-3f);
+            CHECK(std::abs(results[pixel_i * 4 + 2] - 16.0f) <= 1e-2f);
+            CHECK(std::abs(results[pixel_i * 4 + 3] - 0.5f) <= 1e-3f);
+        }
+    }
+    // premultiplied colors are still kept at or below their alpha
+    rl::Image premultiplied(11, 9, 1, rl::Bitmap::Depth::Normalized, rl::Bitmap::Color::Rgba, rl::Bitmap::Layout::Linear, 1, std::nullopt, rl::Bitmap::Alpha::Premultiplied);
+    premultiplied.Resample(source, rl::Bitmap::Filter::Lanczos3);
+    const auto* results = reinterpret_cast<const float*>(premultiplied.GetData());
+    for (std::size_t pixel_i = 0; pixel_i < 11 * 9; pixel_i++)
+    {
+        CHECK(std::abs(results[pixel_i * 4 + 0] - 0.5f) <= 1e-5f);
+        CHECK(std::abs(results[pixel_i * 4 + 1] - 0.25f) <= 1e-5f);
+        CHECK(std::abs(results[pixel_i * 4 + 3] - 0.5f) <= 1e-5f);
+    }
+}
+
+TEST_CASE("A parallel rl::Bitmap::Resample matches a serial one")
+{
+    rl::Executor executor(4);
+    const auto policy = rl::ExecutionPolicy{ &executor, 0 };
+    rl::Image source(61, 47, 2, rl::Bitmap::Depth::Sexdecuple, rl::Bitmap::Color::Rgb);
+    rl::test::fill_test_image(source);
+    for (const auto filter : { rl::Bitmap::Filter::Box, rl::Bitmap::Filter::Bilinear, rl::Bitmap::Filter::Lanczos3 })
+    {
+        rl::Image serial;
+        resample(serial, source, 23, 90, filter);
+        rl::Image parallel(23, 90, 2, rl::Bitmap::Depth::Sexdecuple, rl::Bitmap::Color::Rgb);
+        parallel.Resample(policy, source, filter);
+        CHECK(rl::test::get_is_same(serial, parallel));
+    }
+}
+
+TEST_CASE("rl::Bitmap::Resample matches between layouts")
+{
+    rl::Image source(37, 29, 1, rl::Bitmap::Depth::Octuple, rl::Bitmap::Color::Ga);
+    rl::test::fill_test_image(source);
+    rl::Image tiled_source(37, 29, 1, rl::Bitmap::Depth::Octuple, rl::Bitmap::Color::Ga, rl::Bitmap::Layout::Tiled);
+    tiled_source.Blit(source, 0, 0, 0);
+    rl::Image linear;
+    resample(linear, source, 50, 11, rl::Bitmap::Filter::Lanczos3);
+    for (const auto layout : { rl::Bitmap::Layout::Tiled, rl::Bitmap::Layout::Planar })
+    {
+        rl::Image destination;
+        resample(destination, source, 50, 11, rl::Bitmap::Filter::Lanczos3, layout);
+        CHECK(rl::test::get_is_same(destination, linear));
+    }
+    rl::Image destination;
+    resample(destination, tiled_source, 50, 11, rl::Bitmap::Filter::Lanczos3);
+    CHECK(rl::test::get_is_same(destination, linear));
+}
+
+TEST_CASE("A simd rl::Bitmap::Resample matches a scalar one")
+{
+    rl::Image source(33, 17, 1, rl::Bitmap::Depth::Octuple, rl::Bitmap::Color::Rgba);
+    rl::test::fill_test_image(source);
+    rl::Image simd;
+    resample(simd, source, 14, 40, rl::Bitmap::Filter::Lanczos3);
+    const auto level = rl::get_simd_level();
+    rl::set_simd_level(rl::SimdLevel::Scalar);
+    rl::Image scalar;
+    resample(scalar, source, 14, 40, rl::Bitmap::Filter::Lanczos3);
+    rl::set_simd_level(level);
+    CHECK(rl::test::get_is_same(simd, scalar));
+}
+
+TEST_CASE("rl::Bitmap::Resample throws when the page counts are different")
+{
+    rl::Image source(4, 4, 2, rl::Bitmap::Depth::Octuple, rl::Bitmap::Color::G);
+    rl::Image destination(2, 2, 1, rl::Bitmap::Depth::Octuple, rl::Bitmap::Color::G);
+    CHECK_THROWS(destination.Resample(source));
+}
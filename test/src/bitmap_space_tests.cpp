@@ -0,0 +1,196 @@
+// SPDX-FileCopyrightText: 2023 Daniel Aimé Valcour <fosssweeper@gmail.com>
+//
+// SPDX-License-Identifier: MIT
+
+/*
+    Copyright (c) 2023 Daniel Aimé Valcour
+    Permission is hereby granted, free of charge, to any person obtaining a copy of
+    this software and associated documentation files (the "Software"), to deal in
+    the Software without restriction, including without limitation the rights to
+    use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+    the Software, and to permit persons to whom the Software is furnished to do so,
+    subject to the following conditions:
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+    FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+    COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+    IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+    CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include <catch2/catch_all.hpp>
+#include <rla/Bitmap.hpp>
+#include <rla/Image.hpp>
+#include <rla/simd.hpp>
+#include "test_images.hpp"
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <vector>
+
+namespace
+{
+    double decode_srgb(double value)
+    {
+        return (value <= 0.04045) ? value / 12.92 : std::pow((value + 0.055) / 1.055, 2.4);
+    }
+
+    double encode_srgb(double value)
+    {
+        return (value <= 0.0031308) ? value * 12.92 : 1.055 * std::pow(value, 1.0 / 2.4) - 0.055;
+    }
+
+}
+
+// clang-format off
+
+TEST_CASE("rl::Bitmap space defaults to srgb and is kept by views and rows")
+{
+    rl::Image image(4, 4, 1, rl::Bitmap::Depth::Normalized, rl::Bitmap::Color::Rgba, rl::Bitmap::Layout::Linear, 1, std::nullopt, rl::Bitmap::Alpha::Straight, rl::Bitmap::Space::Linear);
+    CHECK(rl::Image(4, 4, 1, rl::Bitmap::Depth::Octuple, rl::Bitmap::Color::Rgb).GetSpace() == rl::Bitmap::Space::Srgb);
+    CHECK(image.GetSpace() == rl::Bitmap::Space::Linear);
+    CHECK(image.GetBitmapView().GetSpace() == rl::Bitmap::Space::Linear);
+    CHECK(image.GetBitmap(1, 1, 0, 2, 2, 1).GetSpace() == rl::Bitmap::Space::Linear);
+    CHECK(image.GetRow(0, 0).GetSpace() == rl::Bitmap::Space::Linear);
+    CHECK(rl::Bitmap::Row::View(image.GetRow(0, 0)).GetSpace() == rl::Bitmap::Space::Linear);
+    image.Clear();
+    CHECK(image.GetSpace() == rl::Bitmap::Space::Srgb);
+}
+
+TEST_CASE("rl::Bitmap::Blit decodes integer srgb colors through the linear tables and keeps alpha linear")
+{
+    const auto simd_level = GENERATE(rl::SimdLevel::Scalar, rl::get_supported_simd_level());
+    const auto layout = GENERATE(rl::Bitmap::Layout::Linear, rl::Bitmap::Layout::Planar);
+    const auto level = rl::get_simd_level();
+    rl::set_simd_level(simd_level);
+    rl::Image srgb(256, 1, 1, rl::Bitmap::Depth::Octuple, rl::Bitmap::Color::Rgba);
+    for (std::size_t x = 0; x < 256; x++)
+    {
+        for (std::size_t channel_i = 0; channel_i < 4; channel_i++)
+        {
+            *reinterpret_cast<std::uint8_t*>(srgb.GetData(x, 0, 0, channel_i)) = static_cast<std::uint8_t>(x);
+        }
+    }
+    rl::Image linear(256, 1, 1, rl::Bitmap::Depth::Normalized, rl::Bitmap::Color::Rgba, layout, 1, std::nullopt, rl::Bitmap::Alpha::Straight, rl::Bitmap::Space::Linear);
+    linear.Blit(srgb, 0, 0, 0);
+    const auto linear_table = rl::Bitmap::GetNormalizedTable(rl::Bitmap::Depth::Octuple, true);
+    for (std::size_t x = 0; x < 256; x++)
+    {
+        CHECK(*reinterpret_cast<const float*>(linear.GetData(x, 0, 0, 0)) == linear_table[x]);
+        CHECK(*reinterpret_cast<const float*>(linear.GetData(x, 0, 0, 2)) == linear_table[x]);
+        CHECK(*reinterpret_cast<const float*>(linear.GetData(x, 0, 0, 3)) == static_cast<float>(x) / 255.0f);
+    }
+    rl::set_simd_level(level);
+}
+
+TEST_CASE("rl::Bitmap::Blit round trips srgb octuple colors through linear floats exactly")
+{
+    const auto simd_level = GENERATE(rl::SimdLevel::Scalar, rl::get_supported_simd_level());
+    const auto depth = GENERATE(rl::Bitmap::Depth::Normalized, rl::Bitmap::Depth::Half);
+    const auto color = GENERATE(rl::Bitmap::Color::G, rl::Bitmap::Color::Ga, rl::Bitmap::Color::Rgb, rl::Bitmap::Color::Rgba);
+    const auto level = rl::get_simd_level();
+    rl::set_simd_level(simd_level);
+    rl::Image srgb(251, 3, 1, rl::Bitmap::Depth::Octuple, color);
+    auto* bytes = reinterpret_cast<std::uint8_t*>(srgb.GetData());
+    for (std::size_t byte_i = 0; byte_i < srgb.GetSize(); byte_i++)
+    {
+        bytes[byte_i] = static_cast<std::uint8_t>(byte_i * 7);
+    }
+    rl::Image linear(251, 3, 1, depth, color, rl::Bitmap::Layout::Linear, 1, std::nullopt, rl::Bitmap::Alpha::Straight, rl::Bitmap::Space::Linear);
+    linear.Blit(srgb, 0, 0, 0);
+    rl::Image round_trip(251, 3, 1, rl::Bitmap::Depth::Octuple, color);
+    round_trip.Blit(linear, 0, 0, 0);
+    CHECK(rl::test::get_bytes(round_trip) == rl::test::get_bytes(srgb));
+    rl::set_simd_level(level);
+}
+
+TEST_CASE("rl::Bitmap::Blit decodes and encodes floats within a few ulps of the exact curves")
+{
+    const auto simd_level = GENERATE(rl::SimdLevel::Scalar, rl::get_supported_simd_level());
+    const auto level = rl::get_simd_level();
+    rl::set_simd_level(simd_level);
+    // ga rows check the alpha is left alone, with a scalar tail
+    constexpr std::size_t width = 4099;
+    rl::Image srgb(width, 1, 1, rl::Bitmap::Depth::Normalized, rl::Bitmap::Color::Ga);
+    auto* srgb_floats = reinterpret_cast<float*>(srgb.GetData());
+    for (std::size_t x = 0; x < width; x++)
+    {
+        srgb_floats[x * 2] = static_cast<float>(x) / static_cast<float>(width - 1);
+        srgb_floats[x * 2 + 1] = static_cast<float>(x % 17) / 16.0f;
+    }
+    rl::Image linear(width, 1, 1, rl::Bitmap::Depth::Normalized, rl::Bitmap::Color::Ga, rl::Bitmap::Layout::Linear, 1, std::nullopt, rl::Bitmap::Alpha::Straight, rl::Bitmap::Space::Linear);
+    linear.Blit(srgb, 0, 0, 0);
+    rl::Image encoded(width, 1, 1, rl::Bitmap::Depth::Normalized, rl::Bitmap::Color::Ga);
+    encoded.Blit(linear, 0, 0, 0);
+    const auto* linear_floats = reinterpret_cast<const float*>(linear.GetData());
+    const auto* encoded_floats = reinterpret_cast<const float*>(encoded.GetData());
+    for (std::size_t x = 0; x < width; x++)
+    {
+        const double value = srgb_floats[x * 2];
+        CHECK(std::abs(linear_floats[x * 2] - decode_srgb(value)) <= 1e-6);
+        CHECK(std::abs(encoded_floats[x * 2] - encode_srgb(linear_floats[x * 2])) <= 1e-6);
+        CHECK(std::abs(encoded_floats[x * 2] - value) <= 2e-6);
+        CHECK(linear_floats[x * 2 + 1] == srgb_floats[x * 2 + 1]);
+        CHECK(encoded_floats[x * 2 + 1] == srgb_floats[x * 2 + 1]);
+    }
+    rl::set_simd_level(level);
+}
+
+TEST_CASE("rl::Bitmap::Blit blends into linear bitmaps in linear light")
+{
+    rl::Image destination(2, 1, 1, rl::Bitmap::Depth::Normalized, rl::Bitmap::Color::G, rl::Bitmap::Layout::Linear, 1, std::nullopt, rl::Bitmap::Alpha::Straight, rl::Bitmap::Space::Linear);
+    reinterpret_cast<float*>(destination.GetData())[0] = 0.0f;
+    reinterpret_cast<float*>(destination.GetData())[1] = 0.0f;
+    // half transparent srgb white over black
+    rl::Image source(2, 1, 1, rl::Bitmap::Depth::Octuple, rl::Bitmap::Color::Ga);
+    const std::uint8_t source_bytes[] = { 255, 128, 255, 128 };
+    std::memcpy(source.GetData(), source_bytes, sizeof(source_bytes));
+    destination.Blit(source, 0, 0, 0, rl::Bitmap::Blend::Over);
+    CHECK(std::abs(reinterpret_cast<const float*>(destination.GetData())[0] - 128.0f / 255.0f) <= 1e-6f);
+    // which is lighter than the same blend in srgb once it is encoded
+    rl::Image srgb(2, 1, 1, rl::Bitmap::Depth::Octuple, rl::Bitmap::Color::G);
+    srgb.Blit(destination, 0, 0, 0);
+    CHECK(*reinterpret_cast<const std::uint8_t*>(srgb.GetData()) == 188);
+}
+
+TEST_CASE("rl::Bitmap::Blit decodes premultiplied srgb colors without their alpha")
+{
+    rl::Image srgb(1, 1, 1, rl::Bitmap::Depth::Octuple, rl::Bitmap::Color::Rgba, rl::Bitmap::Layout::Linear, 1, std::nullopt, rl::Bitmap::Alpha::Premultiplied);
+    const std::uint8_t srgb_bytes[] = { 100, 50, 0, 200 };
+    std::memcpy(srgb.GetData(), srgb_bytes, sizeof(srgb_bytes));
+    rl::Image linear(1, 1, 1, rl::Bitmap::Depth::Normalized, rl::Bitmap::Color::Rgba, rl::Bitmap::Layout::Linear, 1, std::nullopt, rl::Bitmap::Alpha::Straight, rl::Bitmap::Space::Linear);
+    linear.Blit(srgb, 0, 0, 0);
+    const auto* floats = reinterpret_cast<const float*>(linear.GetData());
+    CHECK(std::abs(floats[0] - decode_srgb(0.5)) <= 1e-6);
+    CHECK(std::abs(floats[1] - decode_srgb(0.25)) <= 1e-6);
+    CHECK(floats[2] == 0.0f);
+    CHECK(floats[3] == 200.0f / 255.0f);
+}
+
+TEST_CASE("Linear rl::Image loads and saves pngs as srgb")
+{
+    const auto depth = GENERATE(rl::Bitmap::Depth::Normalized, rl::Bitmap::Depth::Half, rl::Bitmap::Depth::Sexdecuple);
+    const auto path = (std::filesystem::temp_directory_path() / "rla_space_test.png").string();
+    rl::Image srgb(256, 2, 1, rl::Bitmap::Depth::Octuple, rl::Bitmap::Color::Rgb);
+    auto* bytes = reinterpret_cast<std::uint8_t*>(srgb.GetData());
+    for (std::size_t byte_i = 0; byte_i < srgb.GetSize(); byte_i++)
+    {
+        bytes[byte_i] = static_cast<std::uint8_t>(byte_i / 3);
+    }
+    srgb.Save(path);
+    rl::Image linear(path, depth, std::nullopt, rl::Bitmap::Alpha::Default, std::nullopt, rl::Bitmap::Space::Linear);
+    CHECK(linear.GetSpace() == rl::Bitmap::Space::Linear);
+    rl::Image expected(256, 2, 1, depth, rl::Bitmap::Color::Rgb, rl::Bitmap::Layout::Linear, 1, std::nullopt, rl::Bitmap::Alpha::Straight, rl::Bitmap::Space::Linear);
+    expected.Blit(srgb, 0, 0, 0);
+    CHECK(rl::test::get_bytes(linear) == rl::test::get_bytes(expected));
+    linear.Save(path);
+    rl::Image round_trip(path, rl::Bitmap::Depth::Sexdecuple);
+    rl::Image round_trip_octuple(256, 2, 1, rl::Bitmap::Depth::Octuple, rl::Bitmap::Color::Rgb);
+    round_trip_octuple.Blit(round_trip, 0, 0, 0);
+    CHECK(rl::test::get_bytes(round_trip_octuple) == rl::test::get_bytes(srgb));
+    std::filesystem::remove(path);
+}
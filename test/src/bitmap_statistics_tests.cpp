@@ -0,0 +1,244 @@
+// SPDX-FileCopyrightText: 2023 Daniel Aimé Valcour <fosssweeper@gmail.com>
+//
+// SPDX-License-Identifier: MIT
+
+/*
+    Copyright (c) 2023 Daniel Aimé Valcour
+    Permission is hereby granted, free of charge, to any person obtaining a copy of
+    this software and associated documentation files (the "Software"), to deal in
+    the Software without restriction, including without limitation the rights to
+    use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+    the Software, and to permit persons to whom the Software is furnished to do so,
+    subject to the following conditions:
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+    FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+    COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+    IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+    CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include <catch2/catch_all.hpp>
+#include <rla/Bitmap.hpp>
+#include <rla/Executor.hpp>
+#include <rla/Image.hpp>
+#include <rla/simd.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+namespace
+{
+    // noise in a rectangle of every page, with zero pixels around it
+    rl::Image make_sparse_image(std::size_t width, std::size_t height, std::size_t page_count, rl::Bitmap::Depth depth, rl::Bitmap::Color color)
+    {
+        rl::Image image(width, height, page_count, depth, color, rl::Bitmap::Layout::Linear);
+        std::memset(image.GetData(), 0, image.GetPageOffset() * page_count);
+        std::uint32_t state = 12345;
+        for (std::size_t page_i = 0; page_i < page_count; page_i++)
+        {
+            for (std::size_t y = 3; y < height - 2; y++)
+            {
+                auto* bytes = reinterpret_cast<std::uint8_t*>(image.GetData(5 + page_i, y, page_i));
+                for (std::size_t byte_i = 0; byte_i < image.GetPixelSize() * (width / 2); byte_i++)
+                {
+                    state = state * 1103515245 + 12345;
+                    // half and float noise is kept finite
+                    bytes[byte_i] = static_cast<std::uint8_t>(state >> 16) & 0x3f;
+                }
+            }
+        }
+        return image;
+    }
+
+    double get_channel(const rl::Bitmap::View& view, std::size_t x, std::size_t y, std::size_t page, std::size_t channel)
+    {
+        const auto* data = view.GetData(x, y, page, channel);
+        switch (view.GetDepth())
+        {
+            case rl::Bitmap::Depth::Sexdecuple:
+            {
+                std::uint16_t value = 0;
+                std::memcpy(&value, data, sizeof(value));
+                return value;
+            }
+            case rl::Bitmap::Depth::Normalized:
+            {
+                float value = 0.0f;
+                std::memcpy(&value, data, sizeof(value));
+                return value;
+            }
+            case rl::Bitmap::Depth::Half:
+            {
+                std::uint16_t value = 0;
+                std::memcpy(&value, data, sizeof(value));
+                return rl::detail::half_to_float(value);
+            }
+            default:
+                return std::to_integer<std::uint8_t>(*data);
+        }
+    }
+
+    std::size_t get_bin(rl::Bitmap::Depth depth, double value)
+    {
+        switch (depth)
+        {
+            case rl::Bitmap::Depth::Sexdecuple:
+                return static_cast<std::size_t>(value) >> 8;
+            case rl::Bitmap::Depth::Normalized:
+            case rl::Bitmap::Depth::Half:
+                return static_cast<std::size_t>(std::clamp(value, 0.0, 1.0) * 255.0 + 0.5);
+            default:
+                return static_cast<std::size_t>(value);
+        }
+    }
+
+    // the statistics of a linear view gathered one pixel at a time
+    rl::Bitmap::statistics get_expected_statistics(const rl::Bitmap::View& view)
+    {
+        rl::Bitmap::statistics statistics;
+        const std::size_t channel_count = view.GetChannelCount();
+        const bool is_alpha = view.GetColor() == rl::Bitmap::Color::Ga || view.GetColor() == rl::Bitmap::Color::Rgba;
+        statistics.minimums.fill(std::numeric_limits<double>::infinity());
+        statistics.maximums.fill(-std::numeric_limits<double>::infinity());
+        int left = std::numeric_limits<int>::max();
+        int top = std::numeric_limits<int>::max();
+        int right = 0;
+        int bottom = 0;
+        for (std::size_t page_i = 0; page_i < view.GetPageCount(); page_i++)
+        {
+            for (std::size_t y = 0; y < view.GetHeight(); y++)
+            {
+                for (std::size_t x = 0; x < view.GetWidth(); x++)
+                {
+                    bool is_non_zero = false;
+                    for (std::size_t channel_i = 0; channel_i < channel_count; channel_i++)
+                    {
+                        const double value = get_channel(view, x, y, page_i, channel_i);
+                        statistics.histograms[channel_i][get_bin(view.GetDepth(), value)]++;
+                        statistics.minimums[channel_i] = std::min(statistics.minimums[channel_i], value);
+                        statistics.maximums[channel_i] = std::max(statistics.maximums[channel_i], value);
+                        statistics.means[channel_i] += value;
+                        is_non_zero = is_non_zero || ((!is_alpha || channel_i == channel_count - 1) && value != 0.0);
+                    }
+                    if (is_non_zero)
+                    {
+                        statistics.non_zero_count++;
+                        left = std::min(left, static_cast<int>(x));
+                        top = std::min(top, static_cast<int>(y));
+                        right = std::max(right, static_cast<int>(x) + 1);
+                        bottom = std::max(bottom, static_cast<int>(y) + 1);
+                    }
+                }
+            }
+        }
+        for (std::size_t channel_i = 0; channel_i < 4; channel_i++)
+        {
+            if (channel_i >= channel_count)
+            {
+                statistics.minimums[channel_i] = 0.0;
+                statistics.maximums[channel_i] = 0.0;
+            }
+            statistics.means[channel_i] /= static_cast<double>(view.GetWidth() * view.GetHeight() * view.GetPageCount());
+        }
+        if (left < right)
+        {
+            statistics.non_zero_box_o = rl::cell_box2<int>(left, top, right - left, bottom - top);
+        }
+        return statistics;
+    }
+
+    void check_statistics(const rl::Bitmap::statistics& statistics, const rl::Bitmap::statistics& expected)
+    {
+        CHECK(statistics.histograms == expected.histograms);
+        CHECK(statistics.minimums == expected.minimums);
+        CHECK(statistics.maximums == expected.maximums);
+        for (std::size_t channel_i = 0; channel_i < 4; channel_i++)
+        {
+            CHECK(std::abs(statistics.means[channel_i] - expected.means[channel_i]) <= 1e-9 * std::max(1.0, expected.means[channel_i]));
+        }
+        CHECK(statistics.non_zero_count == expected.non_zero_count);
+        REQUIRE(statistics.non_zero_box_o.has_value() == expected.non_zero_box_o.has_value());
+        if (expected.non_zero_box_o.has_value())
+        {
+            CHECK(statistics.non_zero_box_o->x == expected.non_zero_box_o->x);
+            CHECK(statistics.non_zero_box_o->y == expected.non_zero_box_o->y);
+            CHECK(statistics.non_zero_box_o->width == expected.non_zero_box_o->width);
+            CHECK(statistics.non_zero_box_o->height == expected.non_zero_box_o->height);
+        }
+    }
+}
+
+// clang-format off
+
+TEST_CASE("rl::Bitmap::View::GetStatistics gathers the statistics of a few known pixels")
+{
+    rl::Image image(8, 4, 2, rl::Bitmap::Depth::Octuple, rl::Bitmap::Color::Ga);
+    std::memset(image.GetData(), 0, image.GetPageOffset() * 2);
+    auto* bytes = reinterpret_cast<std::uint8_t*>(image.GetData());
+    // a gray pixel without alpha does not count as non-zero
+    bytes[image.GetByteIndex(1, 1, 0, 0).value()] = 10;
+    bytes[image.GetByteIndex(6, 2, 0, 0).value()] = 200;
+    bytes[image.GetByteIndex(6, 2, 0, 1).value()] = 255;
+    bytes[image.GetByteIndex(2, 3, 1, 1).value()] = 64;
+    const auto statistics = image.GetStatistics();
+    CHECK(statistics.histograms[0][0] == 62);
+    CHECK(statistics.histograms[0][10] == 1);
+    CHECK(statistics.histograms[0][200] == 1);
+    CHECK(statistics.histograms[1][0] == 62);
+    CHECK(statistics.histograms[1][64] == 1);
+    CHECK(statistics.histograms[1][255] == 1);
+    CHECK(statistics.histograms[2][0] == 0);
+    CHECK(statistics.minimums[0] == 0.0);
+    CHECK(statistics.maximums[0] == 200.0);
+    CHECK(statistics.maximums[1] == 255.0);
+    CHECK(std::abs(statistics.means[0] - 210.0 / 64.0) <= 1e-12);
+    CHECK(statistics.non_zero_count == 2);
+    REQUIRE(statistics.non_zero_box_o.has_value());
+    CHECK(statistics.non_zero_box_o->x == 2);
+    CHECK(statistics.non_zero_box_o->y == 2);
+    CHECK(statistics.non_zero_box_o->width == 5);
+    CHECK(statistics.non_zero_box_o->height == 2);
+    rl::Image empty(8, 4, 1, rl::Bitmap::Depth::Normalized, rl::Bitmap::Color::Rgba);
+    std::memset(empty.GetData(), 0, empty.GetPageOffset());
+    CHECK_FALSE(empty.GetStatistics().non_zero_box_o.has_value());
+}
+
+TEST_CASE("rl::Bitmap::View::GetStatistics matches the statistics of every pixel")
+{
+    const auto depth = GENERATE(rl::Bitmap::Depth::Octuple, rl::Bitmap::Depth::Sexdecuple, rl::Bitmap::Depth::Normalized, rl::Bitmap::Depth::Half);
+    const auto color = GENERATE(rl::Bitmap::Color::G, rl::Bitmap::Color::Ga, rl::Bitmap::Color::Rgb, rl::Bitmap::Color::Rgba, rl::Bitmap::Color::Indexed);
+    const auto level = GENERATE(rl::SimdLevel::Scalar, rl::get_supported_simd_level());
+    if (depth != rl::Bitmap::Depth::Octuple && color == rl::Bitmap::Color::Indexed)
+    {
+        return;
+    }
+    rl::set_simd_level(level);
+    const auto image = make_sparse_image(83, 17, 3, depth, color);
+    const auto expected = get_expected_statistics(image);
+    check_statistics(image.GetStatistics(), expected);
+    rl::Executor executor(4);
+    const rl::ExecutionPolicy policy{ &executor, 0 };
+    check_statistics(image.GetStatistics(policy), expected);
+    rl::set_simd_level(rl::get_supported_simd_level());
+}
+
+TEST_CASE("rl::Bitmap::View::GetStatistics gathers tiled, planar and sub-byte views like linear ones")
+{
+    const auto depth = GENERATE(rl::Bitmap::Depth::Octuple, rl::Bitmap::Depth::Half, rl::Bitmap::Depth::Single, rl::Bitmap::Depth::Quadruple);
+    const auto color = GENERATE(rl::Bitmap::Color::G, rl::Bitmap::Color::Rgba);
+    const auto layout = GENERATE(rl::Bitmap::Layout::Linear, rl::Bitmap::Layout::Tiled, rl::Bitmap::Layout::Planar);
+    const auto source = make_sparse_image(37, 19, 2, depth, color);
+    rl::Image image(37, 19, 2, depth, color, layout);
+    image.Blit(source, 0, 0, 0);
+    // the linear view of octuple channels a blit would unpack to
+    rl::Image unpacked(37, 19, 2, rl::Bitmap::GetIsSubByte(depth) ? rl::Bitmap::Depth::Octuple : depth, color);
+    unpacked.Blit(source, 0, 0, 0);
+    check_statistics(image.GetStatistics(), get_expected_statistics(unpacked));
+    check_statistics(image.GetBitmapView(8, 0, 1, 16, 19, 1).GetStatistics(), get_expected_statistics(unpacked.GetBitmapView(8, 0, 1, 16, 19, 1)));
+}
@@ -0,0 +1,278 @@
+// SPDX-FileCopyrightText: 2023 Daniel Aimé Valcour <fosssweeper@gmail.com>
+//
+// SPDX-License-Identifier: MIT
+
+/*
+    Copyright (c) 2023 Daniel Aimé Valcour
+    Permission is hereby granted, free of charge, to any person obtaining a copy of
+    this software and associated documentation files (the "Software"), to deal in
+    the Software without restriction, including without limitation the rights to
+    use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+    the Software, and to permit persons to whom the Software is furnished to do so,
+    subject to the following conditions:
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+    FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+    COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+    IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+    CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include <catch2/catch_all.hpp>
+#include <rla/Bitmap.hpp>
+#include <rla/Image.hpp>
+#include <rla/Executor.hpp>
+#include <rla/Png.hpp>
+#include <rla/simd.hpp>
+#include "test_images.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <vector>
+
+namespace
+{
+    const std::vector<rl::color_rgba<std::uint8_t>> test_palette = {
+        rl::color_rgba<std::uint8_t>(0, 0, 0, 255),
+        rl::color_rgba<std::uint8_t>(255, 255, 255, 255),
+        rl::color_rgba<std::uint8_t>(200, 100, 50, 128),
+        rl::color_rgba<std::uint8_t>(0, 0, 0, 0),
+        rl::color_rgba<std::uint8_t>(1, 2, 3, 4)
+    };
+
+    std::uint8_t get_max(rl::Bitmap::Depth depth)
+    {
+        return static_cast<std::uint8_t>((1u << rl::Bitmap::GetBitDepth(depth)) - 1);
+    }
+
+    // every byte of a pattern, so every value of every depth is in it
+    void fill_bytes(rl::Image& image)
+    {
+        auto* bytes = reinterpret_cast<std::uint8_t*>(image.GetData());
+        for (std::size_t byte_i = 0; byte_i < image.GetSize(); byte_i++)
+        {
+            bytes[byte_i] = static_cast<std::uint8_t>(byte_i * 37 + 11);
+        }
+    }
+
+    // the raw values of every sample of an image of any layout, read bit by bit from a linear copy
+    std::vector<std::uint8_t> get_samples(const rl::Image& image)
+    {
+        rl::Image linear(image.GetWidth(), image.GetHeight(), image.GetPageCount(), image.GetDepth(), image.GetColor());
+        linear.Blit(image, 0, 0, 0);
+        const std::size_t bit_depth = linear.GetBitDepth();
+        const std::size_t row_count = linear.GetWidth() * linear.GetChannelCount();
+        std::vector<std::uint8_t> samples;
+        for (std::size_t page = 0; page < linear.GetPageCount(); page++)
+        {
+            for (std::size_t y = 0; y < linear.GetHeight(); y++)
+            {
+                const auto* row = reinterpret_cast<const std::uint8_t*>(linear.GetData(0, y, page));
+                for (std::size_t sample_i = 0; sample_i < row_count; sample_i++)
+                {
+                    const std::size_t bit_i = sample_i * bit_depth;
+                    samples.push_back(static_cast<std::uint8_t>((row[bit_i / 8] >> (8 - bit_depth - bit_i % 8)) & get_max(linear.GetDepth())));
+                }
+            }
+        }
+        return samples;
+    }
+
+}
+
+// clang-format off
+
+TEST_CASE("Sub-byte rl::Bitmap::Blit unpacks and packs every sub-byte depth")
+{
+    const auto depth = GENERATE(rl::Bitmap::Depth::Single, rl::Bitmap::Depth::Duple, rl::Bitmap::Depth::Quadruple);
+    const auto color = GENERATE(rl::Bitmap::Color::G, rl::Bitmap::Color::Rgb, rl::Bitmap::Color::Indexed);
+    const auto layout = GENERATE(rl::Bitmap::Layout::Linear, rl::Bitmap::Layout::Tiled, rl::Bitmap::Layout::Planar);
+    const auto simd_level = GENERATE(rl::SimdLevel::Scalar, rl::get_supported_simd_level());
+    const auto level = rl::get_simd_level();
+    rl::set_simd_level(simd_level);
+    const std::uint8_t max = get_max(depth);
+    // colors scale their values up to 255, indexes stay as they are
+    const bool is_scaled = color != rl::Bitmap::Color::Indexed;
+    rl::Image packed(301, 3, 2, depth, color);
+    fill_bytes(packed);
+    const auto samples = get_samples(packed);
+    rl::Image unpacked(301, 3, 2, rl::Bitmap::Depth::Octuple, color, layout);
+    unpacked.Blit(packed, 0, 0, 0);
+    const auto unpacked_samples = get_samples(unpacked);
+    REQUIRE(unpacked_samples.size() == samples.size());
+    bool is_unpacked = true;
+    for (std::size_t sample_i = 0; sample_i < samples.size(); sample_i++)
+    {
+        is_unpacked = is_unpacked && unpacked_samples[sample_i] == (is_scaled ? samples[sample_i] * (255 / max) : samples[sample_i]);
+    }
+    CHECK(is_unpacked);
+    rl::Image repacked(301, 3, 2, depth, color, layout);
+    repacked.Blit(unpacked, 0, 0, 0);
+    CHECK(get_samples(repacked) == samples);
+    rl::Executor executor(4);
+    rl::Image parallel(301, 3, 2, depth, color, layout);
+    parallel.Blit(rl::ExecutionPolicy{ &executor, 0 }, unpacked, 0, 0, 0);
+    CHECK(get_samples(parallel) == samples);
+    SECTION("Octuple values are rounded to the nearest sub-byte value, and indexes keep the bits that fit")
+    {
+        rl::Image octuple(301, 3, 2, rl::Bitmap::Depth::Octuple, color);
+        fill_bytes(octuple);
+        rl::Image quantized(301, 3, 2, depth, color, layout);
+        quantized.Blit(octuple, 0, 0, 0);
+        const auto octuple_samples = rl::test::get_bytes(octuple);
+        const auto quantized_samples = get_samples(quantized);
+        bool is_quantized = true;
+        for (std::size_t sample_i = 0; sample_i < octuple_samples.size(); sample_i++)
+        {
+            const std::uint32_t value = octuple_samples[sample_i];
+            const std::uint32_t expected = is_scaled ? (value * max + 127) / 255 : value & max;
+            is_quantized = is_quantized && quantized_samples[sample_i] == expected;
+        }
+        CHECK(is_quantized);
+    }
+    rl::set_simd_level(level);
+}
+
+TEST_CASE("Sub-byte rl::Bitmap sizes and byte indexes count bits")
+{
+    CHECK(rl::Bitmap::GetBitDepth(rl::Bitmap::Depth::Single)    == 1);
+    CHECK(rl::Bitmap::GetBitDepth(rl::Bitmap::Depth::Duple)     == 2);
+    CHECK(rl::Bitmap::GetBitDepth(rl::Bitmap::Depth::Quadruple) == 4);
+    CHECK(rl::Bitmap::GetDepth(2) == rl::Bitmap::Depth::Duple);
+    CHECK(rl::Bitmap::GetChannelSize(rl::Bitmap::Depth::Single) == 0);
+    CHECK(rl::Bitmap::GetRowSize(9,  rl::Bitmap::Depth::Single,    rl::Bitmap::Color::G)   == 2);
+    CHECK(rl::Bitmap::GetRowSize(9,  rl::Bitmap::Depth::Duple,     rl::Bitmap::Color::G)   == 3);
+    CHECK(rl::Bitmap::GetRowSize(9,  rl::Bitmap::Depth::Quadruple, rl::Bitmap::Color::Rgb) == 14);
+    CHECK(rl::Bitmap::GetPageSize(9, 3, rl::Bitmap::Depth::Single, rl::Bitmap::Color::G) == 6);
+    CHECK(rl::Bitmap::GetTileSize(rl::Bitmap::Depth::Single, rl::Bitmap::Color::G) == 8);
+    CHECK(rl::Bitmap::GetByteIndex(16, 2, 1, rl::Bitmap::Depth::Duple, rl::Bitmap::Color::G, 4, 8, 13, 1, 0, 0) == 7);
+    CHECK(rl::Bitmap::GetByteIndex(16, 16, 1, rl::Bitmap::Depth::Single, rl::Bitmap::Color::G, 16, 32, 9, 10, 0, 0, rl::Bitmap::Layout::Tiled) == 26);
+}
+
+TEST_CASE("Sub-byte rl::Bitmap::Blit only starts on whole bytes and leaves the bits around it")
+{
+    rl::Image destination(20, 2, 1, rl::Bitmap::Depth::Single, rl::Bitmap::Color::G);
+    std::memset(destination.GetData(), 0xFF, destination.GetSize());
+    rl::Image source(3, 2, 1, rl::Bitmap::Depth::Single, rl::Bitmap::Color::G);
+    std::memset(source.GetData(), 0x00, source.GetSize());
+    destination.Blit(source, 8, 0, 0);
+    const auto samples = get_samples(destination);
+    for (std::size_t sample_i = 0; sample_i < samples.size(); sample_i++)
+    {
+        const std::size_t x = sample_i % 20;
+        CHECK(samples[sample_i] == ((x >= 8 && x < 11) ? 0 : 1));
+    }
+    CHECK_THROWS(destination.Blit(source, 3, 0, 0));
+    CHECK_THROWS(destination.GetBitmapView(4, 0, 0, 4, 1, 1));
+    CHECK_NOTHROW(destination.GetBitmapView(16, 0, 0, 4, 1, 1));
+}
+
+TEST_CASE("Sub-byte indexed rl::Bitmap::Blit goes through the reachable part of the palette")
+{
+    rl::Image packed(45, 3, 1, rl::Bitmap::Depth::Duple, rl::Bitmap::Color::Indexed);
+    packed.SetPalette(test_palette);
+    fill_bytes(packed);
+    rl::Image octuple(45, 3, 1, rl::Bitmap::Depth::Octuple, rl::Bitmap::Color::Indexed);
+    octuple.SetPalette(test_palette);
+    octuple.Blit(packed, 0, 0, 0);
+    rl::Image expected(45, 3, 1, rl::Bitmap::Depth::Octuple, rl::Bitmap::Color::Rgba);
+    expected.Blit(octuple, 0, 0, 0);
+    rl::Image expanded(45, 3, 1, rl::Bitmap::Depth::Octuple, rl::Bitmap::Color::Rgba);
+    expanded.Blit(packed, 0, 0, 0);
+    CHECK(rl::test::get_bytes(expanded) == rl::test::get_bytes(expected));
+    // the nearest color of the last pixel is past what 1 bit indexes reach
+    rl::Image rgba(3, 1, 1, rl::Bitmap::Depth::Octuple, rl::Bitmap::Color::Rgba);
+    const std::uint8_t pixels[] = { 250, 250, 250, 255, 5, 5, 5, 255, 200, 100, 50, 128 };
+    std::memcpy(rgba.GetData(), pixels, sizeof(pixels));
+    rl::Image single(3, 1, 1, rl::Bitmap::Depth::Single, rl::Bitmap::Color::Indexed);
+    single.SetPalette(test_palette);
+    single.Blit(rgba, 0, 0, 0);
+    CHECK(get_samples(single) == std::vector<std::uint8_t>{ 1, 0, 0 });
+}
+
+TEST_CASE("Sub-byte rl::Bitmap::Blit keys and blends through octuple pixels")
+{
+    const auto depth = GENERATE(rl::Bitmap::Depth::Single, rl::Bitmap::Depth::Duple, rl::Bitmap::Depth::Quadruple);
+    rl::Image packed(45, 3, 1, depth, rl::Bitmap::Color::G);
+    fill_bytes(packed);
+    rl::Image octuple(45, 3, 1, rl::Bitmap::Depth::Octuple, rl::Bitmap::Color::G);
+    octuple.Blit(packed, 0, 0, 0);
+    SECTION("Keyed sub-byte sources key the value the key rounds to")
+    {
+        const rl::Bitmap::color_key key{ rl::color_rgb<std::uint8_t>(254, 254, 254) };
+        rl::Image expected(45, 3, 1, rl::Bitmap::Depth::Octuple, rl::Bitmap::Color::Ga);
+        expected.Blit(octuple, 0, 0, 0, rl::Bitmap::Blend::Replace, rl::Bitmap::color_key{ rl::color_rgb<std::uint8_t>(255, 255, 255) });
+        rl::Image keyed(45, 3, 1, rl::Bitmap::Depth::Octuple, rl::Bitmap::Color::Ga);
+        keyed.Blit(packed, 0, 0, 0, rl::Bitmap::Blend::Replace, key);
+        CHECK(rl::test::get_bytes(keyed) == rl::test::get_bytes(expected));
+    }
+    SECTION("Keyed blits into sub-byte bitmaps skip keyed pixels on any pixel")
+    {
+        rl::Image source(45, 3, 1, rl::Bitmap::Depth::Octuple, rl::Bitmap::Color::G);
+        auto* values = reinterpret_cast<std::uint8_t*>(source.GetData());
+        for (std::size_t pixel_i = 0; pixel_i < 45 * 3; pixel_i++)
+        {
+            values[pixel_i] = (pixel_i % 5 == 0) ? 0 : 255;
+        }
+        const rl::Bitmap::color_key key{ rl::color_rgb<std::uint8_t>(0, 0, 0), rl::Bitmap::color_key::Mode::Skip };
+        rl::Image expected(45, 3, 1, rl::Bitmap::Depth::Octuple, rl::Bitmap::Color::G);
+        expected.Blit(octuple, 0, 0, 0);
+        expected.Blit(source, 0, 0, 0, rl::Bitmap::Blend::Replace, key);
+        rl::Image packed_expected(45, 3, 1, depth, rl::Bitmap::Color::G);
+        packed_expected.Blit(expected, 0, 0, 0);
+        packed.Blit(source, 0, 0, 0, rl::Bitmap::Blend::Replace, key);
+        CHECK(get_samples(packed) == get_samples(packed_expected));
+    }
+    SECTION("Blends onto sub-byte bitmaps blend onto their unpacked pixels")
+    {
+        rl::Image source(45, 3, 1, rl::Bitmap::Depth::Octuple, rl::Bitmap::Color::Ga);
+        fill_bytes(source);
+        octuple.Blit(source, 0, 0, 0, rl::Bitmap::Blend::Over);
+        rl::Image packed_expected(45, 3, 1, depth, rl::Bitmap::Color::G);
+        packed_expected.Blit(octuple, 0, 0, 0);
+        packed.Blit(source, 0, 0, 0, rl::Bitmap::Blend::Over);
+        CHECK(get_samples(packed) == get_samples(packed_expected));
+    }
+}
+
+TEST_CASE("Sub-byte rl::Image saves and loads pngs without expanding them")
+{
+    const auto path = (std::filesystem::temp_directory_path() / "rla_sub_byte_test.png").string();
+    const auto depth = GENERATE(rl::Bitmap::Depth::Single, rl::Bitmap::Depth::Duple, rl::Bitmap::Depth::Quadruple);
+    const auto color = GENERATE(rl::Bitmap::Color::G, rl::Bitmap::Color::Indexed);
+    // every index of the depth has a color, so every sample can be saved
+    std::vector<rl::color_rgba<std::uint8_t>> palette;
+    for (std::size_t color_i = 0; color_i <= get_max(depth); color_i++)
+    {
+        const auto value = static_cast<std::uint8_t>(color_i * 16);
+        palette.push_back(rl::color_rgba<std::uint8_t>(value, 255 - value, value / 2, 255));
+    }
+    rl::Image packed(45, 3, 1, depth, color);
+    packed.SetPalette(palette);
+    fill_bytes(packed);
+    packed.Save(path);
+    CHECK(rl::Png(path).GetBitDepth() == rl::Bitmap::GetBitDepth(depth));
+    rl::Image loaded(path);
+    CHECK(loaded.GetDepth() == depth);
+    CHECK(loaded.GetColor() == color);
+    CHECK(get_samples(loaded) == get_samples(packed));
+    rl::Image octuple(45, 3, 1, rl::Bitmap::Depth::Octuple, color);
+    octuple.SetPalette(palette);
+    octuple.Blit(loaded, 0, 0, 0);
+    rl::Image loaded_octuple(path, rl::Bitmap::Depth::Octuple, color);
+    CHECK(rl::test::get_bytes(loaded_octuple) == rl::test::get_bytes(octuple));
+    rl::Image tiled(45, 3, 1, depth, color, rl::Bitmap::Layout::Tiled);
+    tiled.SetPalette(loaded.GetPalette());
+    tiled.Blit(path, 0, 0, 0);
+    CHECK(get_samples(tiled) == get_samples(loaded));
+    SECTION("Octuple pngs load packed into sub-byte bitmaps")
+    {
+        octuple.Save(path);
+        rl::Image repacked(path, depth, color);
+        CHECK(get_samples(repacked) == get_samples(loaded));
+    }
+    std::filesystem::remove(path);
+}
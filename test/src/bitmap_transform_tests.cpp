@@ -0,0 +1,212 @@
+// SPDX-FileCopyrightText: 2023 Daniel Aimé Valcour <fosssweeper@gmail.com>
+//
+// SPDX-License-Identifier: MIT
+
+/*
+    Copyright (c) 2023 Daniel Aimé Valcour
+    Permission is hereby granted, free of charge, to any person obtaining a copy of
+    this software and associated documentation files (the "Software"), to deal in
+    the Software without restriction, including without limitation the rights to
+    use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+    the Software, and to permit persons to whom the Software is furnished to do so,
+    subject to the following conditions:
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+    FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+    COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+    IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+    CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include <catch2/catch_all.hpp>
+#include <rla/Bitmap.hpp>
+#include <rla/Executor.hpp>
+#include <rla/Image.hpp>
+#include <rla/simd.hpp>
+#include "test_images.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace
+{
+    void fill_bytes(rl::Image& image)
+    {
+        auto* bytes = reinterpret_cast<std::uint8_t*>(image.GetData());
+        for (std::size_t byte_i = 0; byte_i < image.GetSize(); byte_i++)
+        {
+            bytes[byte_i] = static_cast<std::uint8_t>((byte_i * 7919) % 251);
+        }
+    }
+
+    // the source pixel that ends up at a destination pixel
+    void get_source_pixel(rl::Bitmap::Transform transform, std::size_t source_width, std::size_t source_height, std::size_t x, std::size_t y, std::size_t& source_x, std::size_t& source_y)
+    {
+        switch (transform)
+        {
+            case rl::Bitmap::Transform::FlipHorizontal:
+                source_x = source_width - 1 - x;
+                source_y = y;
+                return;
+            case rl::Bitmap::Transform::FlipVertical:
+                source_x = x;
+                source_y = source_height - 1 - y;
+                return;
+            case rl::Bitmap::Transform::Rotate90:
+                source_x = y;
+                source_y = source_height - 1 - x;
+                return;
+            case rl::Bitmap::Transform::Rotate180:
+                source_x = source_width - 1 - x;
+                source_y = source_height - 1 - y;
+                return;
+            case rl::Bitmap::Transform::Rotate270:
+                source_x = source_width - 1 - y;
+                source_y = x;
+                return;
+            case rl::Bitmap::Transform::Transpose:
+                source_x = y;
+                source_y = x;
+                return;
+            default:
+                source_x = x;
+                source_y = y;
+                return;
+        }
+    }
+
+    // true if the pixels the transform covers came from the right source pixels and the others were left alone
+    bool get_is_transformed(const rl::Image& source, const rl::Image& destination, const std::vector<std::uint8_t>& destination_bytes, rl::Bitmap::Transform transform, std::size_t x, std::size_t y, std::size_t page)
+    {
+        const bool is_transposed = rl::Bitmap::GetIsTransposed(transform);
+        const std::size_t width = is_transposed ? source.GetHeight() : source.GetWidth();
+        const std::size_t height = is_transposed ? source.GetWidth() : source.GetHeight();
+        const std::size_t pixel_size = source.GetPixelSize();
+        for (std::size_t destination_page = 0; destination_page < destination.GetPageCount(); destination_page++)
+        {
+            for (std::size_t destination_y = 0; destination_y < destination.GetHeight(); destination_y++)
+            {
+                for (std::size_t destination_x = 0; destination_x < destination.GetWidth(); destination_x++)
+                {
+                    const auto* pixel = destination.GetData(destination_x, destination_y, destination_page, 0);
+                    const bool is_covered =
+                        destination_x >= x && destination_x < x + width &&
+                        destination_y >= y && destination_y < y + height &&
+                        destination_page >= page && destination_page < page + source.GetPageCount();
+                    const std::uint8_t* expected_pixel = destination_bytes.data() + (pixel - destination.GetData());
+                    if (is_covered)
+                    {
+                        std::size_t source_x;
+                        std::size_t source_y;
+                        get_source_pixel(transform, source.GetWidth(), source.GetHeight(), destination_x - x, destination_y - y, source_x, source_y);
+                        expected_pixel = reinterpret_cast<const std::uint8_t*>(source.GetData(source_x, source_y, destination_page - page, 0));
+                    }
+                    if (std::memcmp(pixel, expected_pixel, pixel_size) != 0)
+                    {
+                        return false;
+                    }
+                }
+            }
+        }
+        return true;
+    }
+}
+
+// clang-format off
+
+TEST_CASE("rl::Bitmap::GetIsTransposed is true for the transforms that swap width and height")
+{
+    CHECK_FALSE(rl::Bitmap::GetIsTransposed(rl::Bitmap::Transform::None));
+    CHECK_FALSE(rl::Bitmap::GetIsTransposed(rl::Bitmap::Transform::FlipHorizontal));
+    CHECK_FALSE(rl::Bitmap::GetIsTransposed(rl::Bitmap::Transform::FlipVertical));
+    CHECK(rl::Bitmap::GetIsTransposed(rl::Bitmap::Transform::Rotate90));
+    CHECK_FALSE(rl::Bitmap::GetIsTransposed(rl::Bitmap::Transform::Rotate180));
+    CHECK(rl::Bitmap::GetIsTransposed(rl::Bitmap::Transform::Rotate270));
+    CHECK(rl::Bitmap::GetIsTransposed(rl::Bitmap::Transform::Transpose));
+}
+
+TEST_CASE("rl::Bitmap::Blit with a transform moves every pixel size")
+{
+    const auto simd_level = GENERATE(rl::SimdLevel::Scalar, rl::get_supported_simd_level());
+    const auto transform = GENERATE(rl::Bitmap::Transform::None, rl::Bitmap::Transform::FlipHorizontal, rl::Bitmap::Transform::FlipVertical, rl::Bitmap::Transform::Rotate90, rl::Bitmap::Transform::Rotate180, rl::Bitmap::Transform::Rotate270, rl::Bitmap::Transform::Transpose);
+    const auto format = GENERATE(
+        std::pair{ rl::Bitmap::Depth::Octuple, rl::Bitmap::Color::G },
+        std::pair{ rl::Bitmap::Depth::Octuple, rl::Bitmap::Color::Ga },
+        std::pair{ rl::Bitmap::Depth::Octuple, rl::Bitmap::Color::Rgb },
+        std::pair{ rl::Bitmap::Depth::Octuple, rl::Bitmap::Color::Rgba },
+        std::pair{ rl::Bitmap::Depth::Sexdecuple, rl::Bitmap::Color::Rgb },
+        std::pair{ rl::Bitmap::Depth::Sexdecuple, rl::Bitmap::Color::Rgba },
+        std::pair{ rl::Bitmap::Depth::Normalized, rl::Bitmap::Color::Rgb },
+        std::pair{ rl::Bitmap::Depth::Normalized, rl::Bitmap::Color::Rgba }
+    );
+    const auto size = GENERATE(std::pair<std::size_t, std::size_t>{ 37, 21 }, std::pair<std::size_t, std::size_t>{ 133, 70 });
+    rl::set_simd_level(simd_level);
+    rl::Image source(size.first, size.second, 2, format.first, format.second);
+    fill_bytes(source);
+    rl::Image destination(150, 150, 3, format.first, format.second, rl::Bitmap::Layout::Linear, 16);
+    std::memset(destination.GetData(), 0xab, destination.GetPageOffset() * destination.GetPageCount());
+    const auto destination_bytes = rl::test::get_bytes(destination);
+    destination.Blit(source, transform, 5, 3, 1);
+    CHECK(get_is_transformed(source, destination, destination_bytes, transform, 5, 3, 1));
+    rl::set_simd_level(rl::get_supported_simd_level());
+}
+
+TEST_CASE("rl::Bitmap::Blit with a transform converts like a blit")
+{
+    const auto transform = GENERATE(rl::Bitmap::Transform::FlipHorizontal, rl::Bitmap::Transform::Rotate90, rl::Bitmap::Transform::Rotate270);
+    const auto format = GENERATE(
+        std::pair{ rl::Bitmap::Depth::Duple, rl::Bitmap::Layout::Linear },
+        std::pair{ rl::Bitmap::Depth::Octuple, rl::Bitmap::Layout::Tiled },
+        std::pair{ rl::Bitmap::Depth::Sexdecuple, rl::Bitmap::Layout::Planar }
+    );
+    rl::Image source(19, 13, 1, rl::Bitmap::Depth::Octuple, rl::Bitmap::Color::Rgba);
+    fill_bytes(source);
+    rl::Image expected(40, 40, 1, rl::Bitmap::Depth::Octuple, rl::Bitmap::Color::Rgba);
+    std::memset(expected.GetData(), 0, expected.GetSize());
+    const auto expected_bytes = rl::test::get_bytes(expected);
+    expected.Blit(source, transform, 8, 8, 0);
+    REQUIRE(get_is_transformed(source, expected, expected_bytes, transform, 8, 8, 0));
+    // sub-byte, tiled and planar bitmaps are transformed like their octuple pixels converted
+    const rl::color_rgba<float> clear(0.0f, 0.0f, 0.0f, 0.0f);
+    rl::Image converted_source(19, 13, 1, format.first, rl::Bitmap::Color::Rgba, format.second);
+    converted_source.Blit(source, 0, 0, 0);
+    rl::Image transformed_converted(40, 40, 1, format.first, rl::Bitmap::Color::Rgba, clear, format.second);
+    transformed_converted.Blit(converted_source, transform, 8, 8, 0);
+    rl::Image converted_expected(40, 40, 1, format.first, rl::Bitmap::Color::Rgba, clear, format.second);
+    converted_expected.Blit(expected, 0, 0, 0);
+    CHECK(rl::test::get_bytes(transformed_converted) == rl::test::get_bytes(converted_expected));
+    // destinations of another format get the transformed pixels converted
+    rl::Image normalized(40, 40, 1, rl::Bitmap::Depth::Normalized, rl::Bitmap::Color::Rgba);
+    normalized.Blit(expected, 0, 0, 0);
+    rl::Image transformed(40, 40, 1, rl::Bitmap::Depth::Normalized, rl::Bitmap::Color::Rgba);
+    transformed.Blit(expected, 0, 0, 0);
+    transformed.Blit(source, transform, 8, 8, 0);
+    CHECK(rl::test::get_bytes(transformed) == rl::test::get_bytes(normalized));
+}
+
+TEST_CASE("rl::Bitmap::Blit with a transform and a policy transforms like a serial blit")
+{
+    const auto transform = GENERATE(rl::Bitmap::Transform::FlipVertical, rl::Bitmap::Transform::Rotate90, rl::Bitmap::Transform::Transpose);
+    rl::Executor executor(4);
+    const auto policy = rl::ExecutionPolicy{ &executor, 0 };
+    rl::Image source(301, 203, 2, rl::Bitmap::Depth::Octuple, rl::Bitmap::Color::Rgba);
+    fill_bytes(source);
+    rl::Image serial(310, 310, 2, rl::Bitmap::Depth::Octuple, rl::Bitmap::Color::Rgba);
+    std::memset(serial.GetData(), 0, serial.GetSize());
+    rl::Image parallel(310, 310, 2, rl::Bitmap::Depth::Octuple, rl::Bitmap::Color::Rgba);
+    std::memset(parallel.GetData(), 0, parallel.GetSize());
+    serial.Blit(source, transform, 1, 2, 0);
+    parallel.Blit(policy, source, transform, 1, 2, 0);
+    CHECK(rl::test::get_bytes(serial) == rl::test::get_bytes(parallel));
+}
+
+TEST_CASE("rl::Bitmap::Blit with a transform throws when the turned source does not fit")
+{
+    rl::Image source(10, 4, 1, rl::Bitmap::Depth::Octuple, rl::Bitmap::Color::G);
+    rl::Image destination(10, 8, 1, rl::Bitmap::Depth::Octuple, rl::Bitmap::Color::G);
+    CHECK_NOTHROW(destination.Blit(source, rl::Bitmap::Transform::FlipHorizontal, 0, 4, 0));
+    CHECK_THROWS(destination.Blit(source, rl::Bitmap::Transform::Rotate90, 0, 0, 0));
+}
@@ -31,13 +31,14 @@ TEST_CASE("A rl::Png::Color is converted into a rl::Bitmap::Color")
     CHECK(rl::to_bitmap_color(rl::Png::Color::Ga)      == rl::Bitmap::Color::Ga);
     CHECK(rl::to_bitmap_color(rl::Png::Color::Rgb)     == rl::Bitmap::Color::Rgb);
     CHECK(rl::to_bitmap_color(rl::Png::Color::Rgba)    == rl::Bitmap::Color::Rgba);
-    CHECK(rl::to_bitmap_color(rl::Png::Color::Palette) == rl::Bitmap::Color::Rgb);
+    CHECK(rl::to_bitmap_color(rl::Png::Color::Palette) == rl::Bitmap::Color::Indexed);
 }
 
 TEST_CASE("A rl::Bitmap::Color is converted into a rl::Png::Color")
 {
-    CHECK(rl::to_png_color(rl::Bitmap::Color::G)    == rl::Png::Color::G);
-    CHECK(rl::to_png_color(rl::Bitmap::Color::Ga)   == rl::Png::Color::Ga);
-    CHECK(rl::to_png_color(rl::Bitmap::Color::Rgb)  == rl::Png::Color::Rgb);
-    CHECK(rl::to_png_color(rl::Bitmap::Color::Rgba) == rl::Png::Color::Rgba);
+    CHECK(rl::to_png_color(rl::Bitmap::Color::G)       == rl::Png::Color::G);
+    CHECK(rl::to_png_color(rl::Bitmap::Color::Ga)      == rl::Png::Color::Ga);
+    CHECK(rl::to_png_color(rl::Bitmap::Color::Rgb)     == rl::Png::Color::Rgb);
+    CHECK(rl::to_png_color(rl::Bitmap::Color::Rgba)    == rl::Png::Color::Rgba);
+    CHECK(rl::to_png_color(rl::Bitmap::Color::Indexed) == rl::Png::Color::Palette);
 }
\ No newline at end of file
@@ -0,0 +1,188 @@
+// SPDX-FileCopyrightText: 2023 Daniel Aimé Valcour <fosssweeper@gmail.com>
+//
+// SPDX-License-Identifier: MIT
+
+/*
+    Copyright (c) 2023 Daniel Aimé Valcour
+    Permission is hereby granted, free of charge, to any person obtaining a copy of
+    this software and associated documentation files (the "Software"), to deal in
+    the Software without restriction, including without limitation the rights to
+    use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+    the Software, and to permit persons to whom the Software is furnished to do so,
+    subject to the following conditions:
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+    FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+    COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+    IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+    CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include <catch2/catch_all.hpp>
+#include <rla/ConsoleAtlasFactory.hpp>
+#include <rla/Image.hpp>
+#include <cmath>
+#include <cstddef>
+#include <optional>
+
+namespace
+{
+    struct glyph_position
+    {
+        std::size_t x;
+        std::size_t y;
+        std::size_t page;
+    };
+
+    // the top left of a glyph in the atlas image, found from its texture coordinates
+    glyph_position get_glyph_position(const rl::console_atlas& atlas, std::size_t face_i, std::size_t glyph_i)
+    {
+        const float* coordinates = atlas.faces[face_i].texture_coordinates.data() + glyph_i * 5;
+        return
+            glyph_position{
+                static_cast<std::size_t>(std::lround(coordinates[0] * static_cast<float>(atlas.image.GetWidth()))),
+                static_cast<std::size_t>(std::lround(coordinates[2] * static_cast<float>(atlas.image.GetHeight()))),
+                static_cast<std::size_t>(coordinates[4])
+            };
+    }
+
+    int get_pixel(const rl::console_atlas& atlas, const glyph_position& position, int x, int y)
+    {
+        return std::to_integer<int>(atlas.image.GetData(position.x + x, position.y + y, position.page, 0)[0]);
+    }
+
+    rl::console_atlas::layout::glyph make_bitmap_glyph(int x, int y)
+    {
+        rl::console_atlas::layout::glyph glyph;
+        glyph.source = rl::console_atlas::layout::Source::Bitmap;
+        glyph.source_i = 0;
+        glyph.top_left = rl::cell_vector2<int>{ x, y };
+        return glyph;
+    }
+
+    // two 4x4 tiles next to each other. the first has a 2x2 block of pixels at 1, 1 and the second is blank.
+    rl::Image make_tile_source()
+    {
+        rl::Image source(8, 4, 1, rl::Bitmap::Depth::Octuple, rl::Bitmap::Color::G, rl::color_rgba<rl::Bitmap::normalized_t>(0.0f, 0.0f, 0.0f, 0.0f));
+        source.GetData(1, 1, 0, 0)[0] = rl::Bitmap::byte_t{ 10 };
+        source.GetData(2, 1, 0, 0)[0] = rl::Bitmap::byte_t{ 20 };
+        source.GetData(1, 2, 0, 0)[0] = rl::Bitmap::byte_t{ 30 };
+        source.GetData(2, 2, 0, 0)[0] = rl::Bitmap::byte_t{ 40 };
+        return source;
+    }
+}
+
+// clang-format off
+
+TEST_CASE("rl::ConsoleAtlasFactory gives texture coordinates within the atlas image")
+{
+    const auto source = make_tile_source();
+    rl::console_atlas::layout layout;
+    layout.bitmap_sources.push_back(source.GetBitmapView());
+    layout.tile_width = 4;
+    layout.tile_height = 4;
+    layout.faces.push_back(rl::console_atlas::layout::face{ false, { make_bitmap_glyph(0, 0), make_bitmap_glyph(4, 0) } });
+    rl::ConsoleAtlasFactory factory;
+    const auto atlas = factory.Create(layout);
+    const auto& face = atlas.faces[0];
+    REQUIRE(face.texture_coordinates.size() == 10);
+    for (std::size_t glyph_i = 0; glyph_i < 2; glyph_i++)
+    {
+        const float* coordinates = face.texture_coordinates.data() + glyph_i * 5;
+        for (std::size_t coordinate_i = 0; coordinate_i < 4; coordinate_i++)
+        {
+            CHECK(std::isfinite(coordinates[coordinate_i]));
+            CHECK(coordinates[coordinate_i] >= 0.0f);
+            CHECK(coordinates[coordinate_i] <= 1.0f);
+        }
+        CHECK(coordinates[0] < coordinates[1]);
+        CHECK(coordinates[2] < coordinates[3]);
+    }
+    // untrimmed glyphs are not offset and keep their whole tile
+    CHECK(face.glyph_offsets[0] == rl::cell_vector2<int>{ 0, 0 });
+    CHECK(face.glyph_offsets[1] == rl::cell_vector2<int>{ 0, 0 });
+    const auto position = get_glyph_position(atlas, 0, 0);
+    for (int y = 0; y < 4; y++)
+    {
+        for (int x = 0; x < 4; x++)
+        {
+            CHECK(get_pixel(atlas, position, x, y) == std::to_integer<int>(source.GetData(x, y, 0, 0)[0]));
+        }
+    }
+}
+
+TEST_CASE("rl::ConsoleAtlasFactory trims glyphs to their non-zero pixels")
+{
+    const auto source = make_tile_source();
+    rl::console_atlas::layout layout;
+    layout.bitmap_sources.push_back(source.GetBitmapView());
+    layout.tile_width = 4;
+    layout.tile_height = 4;
+    layout.trimmed = true;
+    layout.gutter = 1;
+    layout.faces.push_back(rl::console_atlas::layout::face{ false, { make_bitmap_glyph(0, 0), make_bitmap_glyph(4, 0) } });
+    rl::ConsoleAtlasFactory factory;
+    const auto atlas = factory.Create(layout);
+    const auto& face = atlas.faces[0];
+    REQUIRE(face.glyph_offsets.size() == 2);
+    CHECK(face.glyph_offsets[0] == rl::cell_vector2<int>{ 1, 1 });
+    // blank glyphs are trimmed to one cleared pixel
+    CHECK(face.glyph_offsets[1] == rl::cell_vector2<int>{ 0, 0 });
+    CHECK(get_pixel(atlas, get_glyph_position(atlas, 0, 1), 0, 0) == 0);
+    const auto position = get_glyph_position(atlas, 0, 0);
+    CHECK(get_pixel(atlas, position, 0, 0) == 10);
+    CHECK(get_pixel(atlas, position, 1, 0) == 20);
+    CHECK(get_pixel(atlas, position, 0, 1) == 30);
+    CHECK(get_pixel(atlas, position, 1, 1) == 40);
+    // the gutter repeats the edge pixels, corners included
+    CHECK(get_pixel(atlas, position, -1, 0) == 10);
+    CHECK(get_pixel(atlas, position, 2, 1) == 40);
+    CHECK(get_pixel(atlas, position, 0, -1) == 10);
+    CHECK(get_pixel(atlas, position, 1, 2) == 40);
+    CHECK(get_pixel(atlas, position, -1, -1) == 10);
+    CHECK(get_pixel(atlas, position, 2, 2) == 40);
+    // the trimmed 2x2 glyph and its gutter are the only pixels that are set, so it was packed at its trimmed size
+    std::size_t set_count = 0;
+    for (std::size_t page = 0; page < atlas.image.GetPageCount(); page++)
+    {
+        for (std::size_t y = 0; y < atlas.image.GetHeight(); y++)
+        {
+            for (std::size_t x = 0; x < atlas.image.GetWidth(); x++)
+            {
+                set_count += atlas.image.GetData(x, y, page, 0)[0] != rl::Bitmap::byte_t{ 0 };
+            }
+        }
+    }
+    CHECK(set_count == 16);
+}
+
+TEST_CASE("rl::ConsoleAtlasFactory resamples bitmap tiles only when their size differs from the atlas tiles")
+{
+    const auto source = make_tile_source();
+    rl::console_atlas::layout layout;
+    layout.bitmap_sources.push_back(source.GetBitmapView());
+    layout.tile_width = 4;
+    layout.tile_height = 4;
+    auto scaled_glyph = make_bitmap_glyph(1, 1);
+    scaled_glyph.size_o = rl::cell_vector2<int>{ 1, 1 };
+    auto blank_glyph = make_bitmap_glyph(4, 0);
+    blank_glyph.size_o = rl::cell_vector2<int>{ 2, 2 };
+    layout.faces.push_back(rl::console_atlas::layout::face{ false, { make_bitmap_glyph(0, 0), scaled_glyph, blank_glyph } });
+    rl::ConsoleAtlasFactory factory;
+    const auto atlas = factory.Create(layout);
+    const auto tile_position = get_glyph_position(atlas, 0, 0);
+    const auto scaled_position = get_glyph_position(atlas, 0, 1);
+    const auto blank_position = get_glyph_position(atlas, 0, 2);
+    for (int y = 0; y < 4; y++)
+    {
+        for (int x = 0; x < 4; x++)
+        {
+            CHECK(get_pixel(atlas, tile_position, x, y) == std::to_integer<int>(source.GetData(x, y, 0, 0)[0]));
+            CHECK(get_pixel(atlas, scaled_position, x, y) == 10);
+            CHECK(get_pixel(atlas, blank_position, x, y) == 0);
+        }
+    }
+}
@@ -0,0 +1,68 @@
+// SPDX-FileCopyrightText: 2023 Daniel Aimé Valcour <fosssweeper@gmail.com>
+//
+// SPDX-License-Identifier: MIT
+
+/*
+    Copyright (c) 2023 Daniel Aimé Valcour
+    Permission is hereby granted, free of charge, to any person obtaining a copy of
+    this software and associated documentation files (the "Software"), to deal in
+    the Software without restriction, including without limitation the rights to
+    use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+    the Software, and to permit persons to whom the Software is furnished to do so,
+    subject to the following conditions:
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+    FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+    COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+    IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+    CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include <catch2/catch_all.hpp>
+#include <rla/Executor.hpp>
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+// clang-format off
+
+TEST_CASE("A rl::Executor runs every task exactly once")
+{
+    rl::Executor executor(4);
+    CHECK(executor.GetThreadCount() == 4);
+    std::vector<std::atomic<int>> runs(1000);
+    executor.Run(runs.size(), [&](std::size_t task_i) { runs[task_i]++; });
+    for (const auto& run : runs)
+    {
+        CHECK(run == 1);
+    }
+}
+
+TEST_CASE("A rl::Executor runs nested tasks serially")
+{
+    rl::Executor executor(3);
+    std::atomic<int> run_count = 0;
+    executor.Run(8, [&](std::size_t) { executor.Run(8, [&](std::size_t) { run_count++; }); });
+    CHECK(run_count == 64);
+}
+
+TEST_CASE("A rl::Executor rethrows an exception thrown by a task")
+{
+    rl::Executor executor(2);
+    CHECK_THROWS_AS(executor.Run(16, [](std::size_t task_i) { if (task_i == 7) throw std::runtime_error("task"); }), std::runtime_error);
+    std::atomic<int> run_count = 0;
+    executor.Run(16, [&](std::size_t) { run_count++; });
+    CHECK(run_count == 16);
+}
+
+TEST_CASE("A rl::ExecutionPolicy runs serially below its threshold")
+{
+    rl::Executor executor(2);
+    const auto policy = rl::ExecutionPolicy{ &executor, 1024 };
+    CHECK(policy.GetIsSerial(1023));
+    CHECK_FALSE(policy.GetIsSerial(1024));
+    rl::Executor single_executor(1);
+    CHECK(rl::ExecutionPolicy{ &single_executor, 0 }.GetIsSerial(1 << 30));
+}
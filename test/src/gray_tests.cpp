@@ -0,0 +1,161 @@
+// SPDX-FileCopyrightText: 2023 Daniel Aimé Valcour <fosssweeper@gmail.com>
+//
+// SPDX-License-Identifier: MIT
+
+/*
+    Copyright (c) 2023 Daniel Aimé Valcour
+    Permission is hereby granted, free of charge, to any person obtaining a copy of
+    this software and associated documentation files (the "Software"), to deal in
+    the Software without restriction, including without limitation the rights to
+    use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+    the Software, and to permit persons to whom the Software is furnished to do so,
+    subject to the following conditions:
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+    FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+    COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+    IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+    CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include <catch2/catch_all.hpp>
+#include <rla/Bitmap.hpp>
+#include <rla/Image.hpp>
+#include <rla/gray.hpp>
+#include <rla/simd.hpp>
+#include "test_images.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <vector>
+
+// clang-format off
+
+TEST_CASE("rl::Bitmap::Blit turns rgb gray with the weights of its gray mode")
+{
+    const auto simd_level = GENERATE(rl::SimdLevel::Scalar, rl::get_supported_simd_level());
+    rl::set_simd_level(simd_level);
+    // enough pixels for the simd kernels to convert some of them
+    rl::Image rgb(24, 1, 1, rl::Bitmap::Depth::Octuple, rl::Bitmap::Color::Rgb);
+    const std::array<std::uint8_t, 12> colors = { 255, 0, 0, 10, 200, 30, 3, 6, 9, 100, 100, 100 };
+    auto* rgb_bytes = reinterpret_cast<std::uint8_t*>(rgb.GetData());
+    for (std::size_t byte_i = 0; byte_i < rgb.GetSize(); byte_i++)
+    {
+        rgb_bytes[byte_i] = colors[byte_i % colors.size()];
+    }
+    const auto check_grays =
+        [&](std::optional<rl::gray_mode> gray_o, std::array<std::uint8_t, 4> expected)
+        {
+            rl::Image gray(24, 1, 1, rl::Bitmap::Depth::Octuple, rl::Bitmap::Color::G);
+            gray.Blit(rgb, 0, 0, 0, rl::Bitmap::Blend::Replace, std::nullopt, gray_o);
+            const auto bytes = rl::test::get_bytes(gray);
+            for (std::size_t pixel_i = 0; pixel_i < bytes.size(); pixel_i++)
+            {
+                CHECK(bytes[pixel_i] == expected[pixel_i % expected.size()]);
+            }
+        };
+    CHECK(rl::get_gray().gray == rl::Gray::Rec709);
+    check_grays(std::nullopt, { 54, 147, 6, 100 });
+    check_grays(rl::gray_mode{ rl::Gray::Rec601 }, { 76, 124, 5, 100 });
+    check_grays(rl::gray_mode{ rl::Gray::Average }, { 85, 80, 6, 100 });
+    check_grays(rl::gray_mode{ rl::Gray::Max }, { 255, 200, 9, 100 });
+    check_grays(rl::gray_mode{ rl::Gray::Custom, rl::color_rgb<float>(0.0f, 0.0f, 1.0f) }, { 0, 30, 9, 100 });
+    // weights that add up to more than one clamp
+    check_grays(rl::gray_mode{ rl::Gray::Custom, rl::color_rgb<float>(2.0f, 0.0f, 0.0f) }, { 255, 20, 6, 200 });
+    // blits that are not given a mode use the default one
+    rl::set_gray({ rl::Gray::Custom, rl::color_rgb<float>(0.0f, 0.0f, 1.0f) });
+    CHECK(rl::get_gray().gray == rl::Gray::Custom);
+    check_grays(std::nullopt, { 0, 30, 9, 100 });
+    check_grays(rl::gray_mode{ rl::Gray::Rec601 }, { 76, 124, 5, 100 });
+    // row converters are not given a mode and do not read the default one
+    const std::array<std::uint8_t, 3> red = { 255, 0, 0 };
+    std::uint8_t g = 0;
+    rl::Bitmap::GetRowConverter(rl::Bitmap::Depth::Octuple, rl::Bitmap::Color::Rgb, rl::Bitmap::Depth::Octuple, rl::Bitmap::Color::G)(
+        reinterpret_cast<const rl::Bitmap::byte_t*>(red.data()),
+        reinterpret_cast<rl::Bitmap::byte_t*>(&g),
+        1
+    );
+    CHECK(g == 54);
+    rl::set_gray({});
+    rl::set_simd_level(rl::get_supported_simd_level());
+}
+
+TEST_CASE("rl::Bitmap::GetGrayConverter kernels match the scalar converters in and out of place")
+{
+    const auto simd_level = GENERATE(rl::SimdLevel::Scalar, rl::get_supported_simd_level());
+    const auto depth = GENERATE(rl::Bitmap::Depth::Octuple, rl::Bitmap::Depth::Sexdecuple, rl::Bitmap::Depth::Normalized);
+    const auto source_color = GENERATE(rl::Bitmap::Color::Rgb, rl::Bitmap::Color::Rgba);
+    const auto destination_color = GENERATE(rl::Bitmap::Color::G, rl::Bitmap::Color::Ga);
+    const auto gray =
+        GENERATE(
+            rl::gray_mode{ rl::Gray::Rec709 },
+            rl::gray_mode{ rl::Gray::Rec601 },
+            rl::gray_mode{ rl::Gray::Average },
+            rl::gray_mode{ rl::Gray::Max },
+            rl::gray_mode{ rl::Gray::Custom, rl::color_rgb<float>(0.5f, 0.25f, 0.5f) }
+        );
+    const auto source = rl::test::make_noise_image(37, 1, 1, depth, source_color);
+    rl::Image expected(37, 1, 1, depth, destination_color);
+    rl::Bitmap::GetGrayConverter(depth, source_color, destination_color)(source.GetData(), expected.GetData(), 37, gray);
+    auto converter = rl::Bitmap::GetGrayConverter(simd_level, depth, source_color, destination_color);
+    if (converter == nullptr)
+    {
+        converter = rl::Bitmap::GetGrayConverter(depth, source_color, destination_color);
+    }
+    rl::Image converted(37, 1, 1, depth, destination_color);
+    converter(source.GetData(), converted.GetData(), 37, gray);
+    CHECK(rl::test::get_bytes(converted) == rl::test::get_bytes(expected));
+    auto in_place = rl::test::make_noise_image(37, 1, 1, depth, source_color);
+    converter(in_place.GetData(), in_place.GetData(), 37, gray);
+    const auto in_place_bytes = rl::test::get_bytes(in_place);
+    CHECK(std::vector<std::uint8_t>(in_place_bytes.begin(), in_place_bytes.begin() + expected.GetSize()) == rl::test::get_bytes(expected));
+}
+
+TEST_CASE("rl::Bitmap::Row::Blit turns rgb gray at the source depth with its gray mode")
+{
+    const auto source_layout = GENERATE(rl::Bitmap::Layout::Linear, rl::Bitmap::Layout::Planar);
+    const auto destination_depth = GENERATE(rl::Bitmap::Depth::Octuple, rl::Bitmap::Depth::Normalized, rl::Bitmap::Depth::Half);
+    const rl::gray_mode gray = { rl::Gray::Custom, rl::color_rgb<float>(0.0f, 1.0f, 0.0f) };
+    const auto source = rl::test::make_noise_image(70, 1, 1, rl::Bitmap::Depth::Octuple, rl::Bitmap::Color::Rgba);
+    // the expected grays are the green channels, turned gray at the source depth and then converted
+    rl::Image green(70, 1, 1, rl::Bitmap::Depth::Octuple, rl::Bitmap::Color::Ga);
+    for (std::size_t pixel_i = 0; pixel_i < 70; pixel_i++)
+    {
+        green.GetData()[pixel_i * 2] = source.GetData()[pixel_i * 4 + 1];
+        green.GetData()[pixel_i * 2 + 1] = source.GetData()[pixel_i * 4 + 3];
+    }
+    rl::Image expected(70, 1, 1, destination_depth, rl::Bitmap::Color::Ga);
+    expected.Blit(green, 0, 0, 0);
+    rl::Image laid_out(70, 1, 1, rl::Bitmap::Depth::Octuple, rl::Bitmap::Color::Rgba, source_layout);
+    laid_out.Blit(source, 0, 0, 0);
+    rl::Image converted(70, 1, 1, destination_depth, rl::Bitmap::Color::Ga);
+    converted.GetRow(0, 0).Blit(laid_out.GetRowView(0, 0), rl::Bitmap::Blend::Replace, gray);
+    CHECK(rl::test::get_bytes(converted) == rl::test::get_bytes(expected));
+}
+
+TEST_CASE("rl::Image loads rgb pngs into gray like a blit of the rgb png")
+{
+    const auto simd_level = GENERATE(rl::SimdLevel::Scalar, rl::get_supported_simd_level());
+    const auto color = GENERATE(rl::Bitmap::Color::G, rl::Bitmap::Color::Ga);
+    const auto gray =
+        GENERATE(
+            rl::gray_mode{ rl::Gray::Rec709 },
+            rl::gray_mode{ rl::Gray::Average },
+            rl::gray_mode{ rl::Gray::Max },
+            rl::gray_mode{ rl::Gray::Custom, rl::color_rgb<float>(0.0f, 0.0f, 1.0f) }
+        );
+    rl::set_simd_level(simd_level);
+    const auto path = (std::filesystem::temp_directory_path() / "rla_gray_test.png").string();
+    rl::test::make_noise_image(61, 1, 1, rl::Bitmap::Depth::Octuple, rl::Bitmap::Color::Rgba).Save(path);
+    const rl::Image loaded(path, rl::Bitmap::Depth::Octuple, color, rl::Bitmap::Alpha::Default, std::nullopt, rl::Bitmap::Space::Default, gray);
+    const rl::Image rgba(path, rl::Bitmap::Depth::Octuple, rl::Bitmap::Color::Rgba);
+    rl::Image expected(61, 1, 1, rl::Bitmap::Depth::Octuple, color);
+    expected.Blit(rgba, 0, 0, 0, rl::Bitmap::Blend::Replace, std::nullopt, gray);
+    CHECK(rl::test::get_bytes(loaded) == rl::test::get_bytes(expected));
+    std::filesystem::remove(path);
+    rl::set_simd_level(rl::get_supported_simd_level());
+}
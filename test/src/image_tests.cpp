@@ -0,0 +1,316 @@
+// SPDX-FileCopyrightText: 2023 Daniel Aimé Valcour <fosssweeper@gmail.com>
+//
+// SPDX-License-Identifier: MIT
+
+/*
+    Copyright (c) 2023 Daniel Aimé Valcour
+    Permission is hereby granted, free of charge, to any person obtaining a copy of
+    this software and associated documentation files (the "Software"), to deal in
+    the Software without restriction, including without limitation the rights to
+    use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+    the Software, and to permit persons to whom the Software is furnished to do so,
+    subject to the following conditions:
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+    FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+    COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+    IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+    CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include <catch2/catch_all.hpp>
+#include <rla/Bitmap.hpp>
+#include <rla/Image.hpp>
+#include <rla/Executor.hpp>
+#include <cmath>
+#include <cstddef>
+#include <cstdlib>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+
+// clang-format off
+
+TEST_CASE("An rl::Image is created with aligned rows")
+{
+    rl::Image image(10, 3, 2, rl::Bitmap::Depth::Octuple, rl::Bitmap::Color::Rgb, rl::Bitmap::Layout::Linear, 64);
+    CHECK(image.GetRowOffset() == 64);
+    CHECK(image.GetPageOffset() == 192);
+    CHECK(image.GetAlignment() >= 64);
+    CHECK(image.GetCapacity() >= 384);
+    for (std::size_t y = 0; y < 3; y++)
+    {
+        CHECK(reinterpret_cast<std::uintptr_t>(image.GetData(0, y, 1, 0)) % 64 == 0);
+    }
+    CHECK(image.GetData(1, 2, 1, 2) == image.GetData() + 192 + 128 + 3 + 2);
+    SECTION("The row offset is given by the caller")
+    {
+        image.Create(10, 3, 2, rl::Bitmap::Depth::Octuple, rl::Bitmap::Color::Rgb, rl::Bitmap::Layout::Linear, 1, 33);
+        CHECK(image.GetRowOffset() == 33);
+        CHECK(image.GetPageOffset() == 99);
+        CHECK_THROWS(image.Create(10, 3, 2, rl::Bitmap::Depth::Octuple, rl::Bitmap::Color::Rgb, rl::Bitmap::Layout::Linear, 1, 29));
+        CHECK_THROWS(image.Create(10, 3, 2, rl::Bitmap::Depth::Octuple, rl::Bitmap::Color::Rgb, rl::Bitmap::Layout::Linear, 16, 40));
+        CHECK_THROWS(image.Create(10, 3, 2, rl::Bitmap::Depth::Octuple, rl::Bitmap::Color::Rgb, rl::Bitmap::Layout::Linear, 24));
+    }
+    SECTION("Planar and tiled images align the rows of each plane and of tiles")
+    {
+        image.Create(10, 3, 2, rl::Bitmap::Depth::Octuple, rl::Bitmap::Color::Rgb, rl::Bitmap::Layout::Planar, 16);
+        CHECK(image.GetRowOffset() == 16);
+        CHECK(image.GetPlaneOffset() == 48);
+        CHECK(image.GetPageOffset() == 144);
+        image.Create(10, 3, 2, rl::Bitmap::Depth::Octuple, rl::Bitmap::Color::Rgb, rl::Bitmap::Layout::Tiled, 256);
+        CHECK(image.GetRowOffset() == 512);
+        CHECK(image.GetPageOffset() == 512);
+    }
+}
+
+TEST_CASE("Blits into and out of an rl::Image with padded rows skip the padding")
+{
+    rl::Image packed(10, 3, 2, rl::Bitmap::Depth::Sexdecuple, rl::Bitmap::Color::Ga);
+    for (std::size_t byte_i = 0; byte_i < packed.GetSize(); byte_i++)
+    {
+        packed.GetData()[byte_i] = static_cast<rl::Bitmap::byte_t>(byte_i * 5 + 1);
+    }
+    rl::Image padded(10, 3, 2, rl::Bitmap::Depth::Sexdecuple, rl::Bitmap::Color::Ga, rl::Bitmap::Layout::Linear, 64);
+    std::memset(padded.GetData(), 0xcd, padded.GetCapacity());
+    padded.Blit(packed, 0, 0, 0);
+    for (std::size_t page = 0; page < 2; page++)
+    {
+        for (std::size_t y = 0; y < 3; y++)
+        {
+            CHECK(std::memcmp(padded.GetData(0, y, page, 0), packed.GetData(0, y, page, 0), packed.GetRowSize()) == 0);
+            // the padding is left alone
+            CHECK(padded.GetData(0, y, page, 0)[packed.GetRowSize()] == rl::Bitmap::byte_t{ 0xcd });
+        }
+    }
+    rl::Image repacked(10, 3, 2, rl::Bitmap::Depth::Sexdecuple, rl::Bitmap::Color::Ga);
+    repacked.Blit(padded, 0, 0, 0);
+    CHECK(std::memcmp(repacked.GetData(), packed.GetData(), packed.GetSize()) == 0);
+    padded.ConvertLayout(rl::Bitmap::Layout::Tiled);
+    CHECK(padded.GetRowOffset() % 64 == 0);
+    padded.ConvertLayout(rl::Bitmap::Layout::Linear);
+    CHECK(padded.GetRowOffset() == 64);
+    repacked.Blit(padded, 0, 0, 0);
+    CHECK(std::memcmp(repacked.GetData(), packed.GetData(), packed.GetSize()) == 0);
+}
+
+TEST_CASE("An rl::Image is reserved with an alignment")
+{
+    rl::Image image;
+    image.Reserve(100, 256);
+    CHECK(image.GetCapacity() == 100);
+    CHECK(image.GetAlignment() == 256);
+    CHECK(reinterpret_cast<std::uintptr_t>(image.GetData()) % 256 == 0);
+    CHECK_THROWS(image.Reserve(100, 3));
+    image.Create(4, 4, 1, rl::Bitmap::Depth::Octuple, rl::Bitmap::Color::G);
+    image.ShrinkToFit();
+    CHECK(image.GetCapacity() == 16);
+    CHECK(image.GetAlignment() == 256);
+}
+
+TEST_CASE("A premultiplied rl::Image is premultiplied when loaded and unpremultiplied when saved")
+{
+    const auto path = (std::filesystem::temp_directory_path() / "rla_premultiplied_test.png").string();
+    const auto depth = GENERATE(rl::Bitmap::Depth::Octuple, rl::Bitmap::Depth::Normalized);
+    rl::Image straight(3, 1, 1, rl::Bitmap::Depth::Octuple, rl::Bitmap::Color::Rgba);
+    const std::uint8_t pixels[] = {200, 100, 50, 255, 200, 100, 50, 128, 200, 100, 50, 0};
+    std::memcpy(straight.GetData(), pixels, sizeof(pixels));
+    straight.Save(path);
+    rl::Image premultiplied(path, depth, std::nullopt, rl::Bitmap::Alpha::Premultiplied);
+    CHECK(premultiplied.GetIsPremultiplied());
+    rl::Image loaded(3, 1, 1, rl::Bitmap::Depth::Octuple, rl::Bitmap::Color::Rgba, rl::Bitmap::Layout::Default, 1, std::nullopt, rl::Bitmap::Alpha::Premultiplied);
+    loaded.Blit(premultiplied, 0, 0, 0);
+    const std::uint8_t expected[] = {200, 100, 50, 255, 100, 50, 25, 128, 0, 0, 0, 0};
+    CHECK(std::memcmp(loaded.GetData(), expected, sizeof(expected)) == 0);
+    premultiplied.Save(path);
+    rl::Image saved(path, rl::Bitmap::Depth::Octuple);
+    // the premultiplied colors lose some precision, and colors of transparent pixels are lost
+    for (std::size_t channel_i = 0; channel_i < 8; channel_i++)
+    {
+        CHECK(std::abs(static_cast<int>(saved.GetData()[channel_i]) - static_cast<int>(pixels[channel_i])) <= 1);
+    }
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("A premultiplied rl::Image round trips 16 bit pngs")
+{
+    const auto path = (std::filesystem::temp_directory_path() / "rla_premultiplied_16_test.png").string();
+    const auto depth = GENERATE(rl::Bitmap::Depth::Sexdecuple, rl::Bitmap::Depth::Normalized, rl::Bitmap::Depth::Half);
+    // half channels keep 11 bits
+    const int tolerance = (depth == rl::Bitmap::Depth::Half) ? 32 : 1;
+    rl::Image straight(3, 1, 1, rl::Bitmap::Depth::Sexdecuple, rl::Bitmap::Color::Rgba);
+    // the high and low bytes of the channels differ, so channels in the wrong byte order do not match
+    const std::uint16_t pixels[] = {51200, 25601, 12803, 65535, 51200, 25601, 12803, 32768, 51200, 25601, 12803, 0};
+    std::memcpy(straight.GetData(), pixels, sizeof(pixels));
+    straight.Save(path);
+    rl::Image premultiplied(path, depth, std::nullopt, rl::Bitmap::Alpha::Premultiplied);
+    rl::Image loaded(3, 1, 1, rl::Bitmap::Depth::Sexdecuple, rl::Bitmap::Color::Rgba, rl::Bitmap::Layout::Default, 1, std::nullopt, rl::Bitmap::Alpha::Premultiplied);
+    loaded.Blit(premultiplied, 0, 0, 0);
+    const std::uint16_t expected[] = {51200, 25601, 12803, 65535, 25600, 12801, 6402, 32768, 0, 0, 0, 0};
+    const auto* loaded_channels = reinterpret_cast<const std::uint16_t*>(loaded.GetData());
+    for (std::size_t channel_i = 0; channel_i < 12; channel_i++)
+    {
+        CHECK(std::abs(static_cast<int>(loaded_channels[channel_i]) - static_cast<int>(expected[channel_i])) <= tolerance);
+    }
+    premultiplied.Save(path);
+    rl::Image saved(path, rl::Bitmap::Depth::Sexdecuple);
+    const auto* saved_channels = reinterpret_cast<const std::uint16_t*>(saved.GetData());
+    // colors of transparent pixels are lost
+    for (std::size_t channel_i = 0; channel_i < 8; channel_i++)
+    {
+        CHECK(std::abs(static_cast<int>(saved_channels[channel_i]) - static_cast<int>(pixels[channel_i])) <= tolerance);
+    }
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("rl::Image::GetMaxMipCount counts the levels down to 1x1")
+{
+    CHECK(rl::Image::GetMaxMipCount(1, 1) == 1);
+    CHECK(rl::Image::GetMaxMipCount(8, 4) == 4);
+    CHECK(rl::Image::GetMaxMipCount(5, 3) == 3);
+    CHECK(rl::Image::GetMaxMipCount(0, 0) == 1);
+}
+
+TEST_CASE("rl::Image::GenerateMips builds a chain of halved levels")
+{
+    rl::Image image(8, 5, 2, rl::Bitmap::Depth::Octuple, rl::Bitmap::Color::Rgb, rl::Bitmap::Layout::Linear, 16);
+    for (std::size_t byte_i = 0; byte_i < image.GetSize(); byte_i++)
+    {
+        image.GetData()[byte_i] = static_cast<rl::Bitmap::byte_t>(byte_i * 7 + 3);
+    }
+    rl::Image copy(8, 5, 2, rl::Bitmap::Depth::Octuple, rl::Bitmap::Color::Rgb);
+    copy.Blit(image, 0, 0, 0);
+    image.GenerateMips();
+    REQUIRE(image.GetMipCount() == 4);
+    CHECK(image.GetMip(1).GetWidth() == 4);
+    CHECK(image.GetMip(1).GetHeight() == 2);
+    CHECK(image.GetMip(2).GetWidth() == 2);
+    CHECK(image.GetMip(2).GetHeight() == 1);
+    CHECK(image.GetMip(3).GetWidth() == 1);
+    CHECK(image.GetMip(3).GetHeight() == 1);
+    CHECK(image.GetMip(3).GetPageCount() == 2);
+    CHECK_THROWS(image.GetMip(4));
+    CHECK_THROWS(image.GenerateMips(5));
+    for (std::size_t mip_i = 1; mip_i < image.GetMipCount(); mip_i++)
+    {
+        CHECK(reinterpret_cast<std::uintptr_t>(image.GetMip(mip_i).GetData()) % 16 == 0);
+        CHECK(image.GetMip(mip_i).GetData() + image.GetMip(mip_i).GetSize() <= image.GetData() + image.GetCapacity());
+    }
+    rl::Image level(8, 5, 2, rl::Bitmap::Depth::Octuple, rl::Bitmap::Color::Rgb);
+    level.Blit(image, 0, 0, 0);
+    CHECK(std::memcmp(level.GetData(), copy.GetData(), copy.GetSize()) == 0);
+    image.Create(8, 5, 2, rl::Bitmap::Depth::Octuple, rl::Bitmap::Color::Rgb);
+    CHECK(image.GetMipCount() == 1);
+}
+
+TEST_CASE("rl::Image::GenerateMips averages 2x2 blocks")
+{
+    rl::Image image(4, 2, 1, rl::Bitmap::Depth::Normalized, rl::Bitmap::Color::G);
+    const float values[] = { 0.0f, 0.25f, 0.5f, 1.0f, 0.5f, 0.25f, 1.0f, 0.5f };
+    std::memcpy(image.GetData(), values, sizeof(values));
+    SECTION("Linear colors are averaged directly")
+    {
+        image.GenerateMips(2, false);
+        const auto* mip = reinterpret_cast<const float*>(image.GetMip(1).GetData());
+        CHECK(std::abs(mip[0] - 0.25f) <= 1e-6f);
+        CHECK(std::abs(mip[1] - 0.75f) <= 1e-6f);
+    }
+    SECTION("Srgb colors are averaged in linear light")
+    {
+        image.GenerateMips(2);
+        const auto* mip = reinterpret_cast<const float*>(image.GetMip(1).GetData());
+        const auto to_linear = [](float value) { return (value <= 0.04045f) ? value / 12.92f : std::pow((value + 0.055f) / 1.055f, 2.4f); };
+        const auto to_srgb = [](float value) { return (value <= 0.0031308f) ? value * 12.92f : 1.055f * std::pow(value, 1.0f / 2.4f) - 0.055f; };
+        const float expected = to_srgb((to_linear(0.0f) + to_linear(0.25f) + to_linear(0.5f) + to_linear(0.25f)) / 4.0f);
+        CHECK(std::abs(mip[0] - expected) <= 1e-5f);
+        CHECK(mip[0] > 0.3f);
+    }
+}
+
+TEST_CASE("rl::Image::GenerateMips does not bleed the colors of transparent pixels")
+{
+    rl::Image image(2, 1, 1, rl::Bitmap::Depth::Octuple, rl::Bitmap::Color::Rgba);
+    const std::uint8_t pixels[] = { 255, 0, 0, 0, 0, 0, 255, 255 };
+    std::memcpy(image.GetData(), pixels, sizeof(pixels));
+    image.GenerateMips();
+    const auto* mip = reinterpret_cast<const std::uint8_t*>(image.GetMip(1).GetData());
+    CHECK(mip[0] == 0);
+    CHECK(mip[1] == 0);
+    CHECK(mip[2] == 255);
+    CHECK(std::abs(static_cast<int>(mip[3]) - 128) <= 1);
+}
+
+TEST_CASE("rl::Image::GenerateMips matches between layouts and in parallel")
+{
+    rl::Image linear(37, 21, 3, rl::Bitmap::Depth::Octuple, rl::Bitmap::Color::Ga);
+    for (std::size_t byte_i = 0; byte_i < linear.GetSize(); byte_i++)
+    {
+        linear.GetData()[byte_i] = static_cast<rl::Bitmap::byte_t>(byte_i * 13 + 5);
+    }
+    rl::Image other(37, 21, 3, rl::Bitmap::Depth::Octuple, rl::Bitmap::Color::Ga);
+    other.Blit(linear, 0, 0, 0);
+    linear.GenerateMips();
+    const auto check_mips = [&](const rl::Image& image)
+    {
+        REQUIRE(image.GetMipCount() == linear.GetMipCount());
+        for (std::size_t mip_i = 1; mip_i < linear.GetMipCount(); mip_i++)
+        {
+            const auto expected = linear.GetMipView(mip_i);
+            rl::Image mip(expected.GetWidth(), expected.GetHeight(), 3, rl::Bitmap::Depth::Octuple, rl::Bitmap::Color::Ga);
+            mip.Blit(image.GetMipView(mip_i), 0, 0, 0);
+            CHECK(std::memcmp(mip.GetData(), expected.GetData(), mip.GetSize()) == 0);
+        }
+    };
+    SECTION("Parallel")
+    {
+        rl::Executor executor(4);
+        other.GenerateMips(rl::ExecutionPolicy{ &executor, 0 });
+        check_mips(other);
+    }
+    SECTION("Tiled")
+    {
+        other.ConvertLayout(rl::Bitmap::Layout::Tiled);
+        other.GenerateMips();
+        check_mips(other);
+    }
+    SECTION("Planar")
+    {
+        other.ConvertLayout(rl::Bitmap::Layout::Planar);
+        other.GenerateMips();
+        check_mips(other);
+    }
+    SECTION("Converted after generating")
+    {
+        other.GenerateMips();
+        other.ConvertLayout(rl::Bitmap::Layout::Planar);
+        check_mips(other);
+    }
+}
+
+TEST_CASE("A color keyed rl::Image load makes the keyed pixels transparent")
+{
+    const auto path = (std::filesystem::temp_directory_path() / "rla_color_key_test.png").string();
+    rl::Image rgb(3, 1, 1, rl::Bitmap::Depth::Octuple, rl::Bitmap::Color::Rgb);
+    const std::uint8_t pixels[] = { 255, 0, 255, 10, 20, 30, 255, 0, 254 };
+    std::memcpy(rgb.GetData(), pixels, sizeof(pixels));
+    rgb.Save(path);
+    const rl::Bitmap::color_key key{ rl::color_rgb<std::uint8_t>(255, 0, 255) };
+    SECTION("Pngs without alpha gain alpha")
+    {
+        rl::Image keyed(path, std::nullopt, std::nullopt, rl::Bitmap::Alpha::Default, key);
+        REQUIRE(keyed.GetColor() == rl::Bitmap::Color::Rgba);
+        const std::uint8_t expected[] = { 0, 0, 0, 0, 10, 20, 30, 255, 255, 0, 254, 255 };
+        CHECK(std::memcmp(keyed.GetData(), expected, sizeof(expected)) == 0);
+    }
+    SECTION("Skipped pixels are zero")
+    {
+        rl::Image keyed(path, rl::Bitmap::Depth::Sexdecuple, rl::Bitmap::Color::Rgb, rl::Bitmap::Alpha::Default, rl::Bitmap::color_key{ key.color, rl::Bitmap::color_key::Mode::Skip });
+        rl::Image converted(3, 1, 1, rl::Bitmap::Depth::Octuple, rl::Bitmap::Color::Rgb);
+        converted.Blit(keyed, 0, 0, 0);
+        const std::uint8_t expected[] = { 0, 0, 0, 10, 20, 30, 255, 0, 254 };
+        CHECK(std::memcmp(converted.GetData(), expected, sizeof(expected)) == 0);
+    }
+    std::filesystem::remove(path);
+}
@@ -0,0 +1,265 @@
+// SPDX-FileCopyrightText: 2023 Daniel Aimé Valcour <fosssweeper@gmail.com>
+//
+// SPDX-License-Identifier: MIT
+
+/*
+    Copyright (c) 2023 Daniel Aimé Valcour
+    Permission is hereby granted, free of charge, to any person obtaining a copy of
+    this software and associated documentation files (the "Software"), to deal in
+    the Software without restriction, including without limitation the rights to
+    use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+    the Software, and to permit persons to whom the Software is furnished to do so,
+    subject to the following conditions:
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+    FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+    COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+    IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+    CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include <catch2/catch_all.hpp>
+#include <rla/Bitmap.hpp>
+#include <rla/Image.hpp>
+#include <rla/simd.hpp>
+#include <rld/except.hpp>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+namespace
+{
+    void fill_test_row(rl::Bitmap::Row& row)
+    {
+        std::uint32_t state = 0x2545f491;
+        const auto channel_count = rl::Bitmap::GetChannelCount(row.GetColor());
+        for (std::size_t value_i = 0; value_i < row.GetWidth() * channel_count; value_i++)
+        {
+            state = state * 1664525 + 1013904223;
+            const auto value = state >> 16;
+            switch (row.GetDepth())
+            {
+                case rl::Bitmap::Depth::Octuple:
+                    reinterpret_cast<rl::Bitmap::octuple_t*>(row.GetData())[value_i] = static_cast<rl::Bitmap::octuple_t>(value);
+                    break;
+                case rl::Bitmap::Depth::Sexdecuple:
+                    reinterpret_cast<rl::Bitmap::sexdecuple_t*>(row.GetData())[value_i] = static_cast<rl::Bitmap::sexdecuple_t>(value);
+                    break;
+                case rl::Bitmap::Depth::Normalized:
+                    reinterpret_cast<rl::Bitmap::normalized_t*>(row.GetData())[value_i] = static_cast<rl::Bitmap::normalized_t>(value % 1024) / 1023.0f;
+                    break;
+                case rl::Bitmap::Depth::Half:
+                    // any finite half, since converting signaling nans quiets them
+                    reinterpret_cast<rl::Bitmap::half_t*>(row.GetData())[value_i] = static_cast<rl::Bitmap::half_t>(value & 0xfbff);
+                    break;
+                case rl::Bitmap::Depth::Single:
+                case rl::Bitmap::Depth::Duple:
+                case rl::Bitmap::Depth::Quadruple:
+                    throw rl::runtime_error("sub-byte test rows are not filled by channel");
+            }
+        }
+    }
+}
+
+// clang-format off
+
+TEST_CASE("The scalar simd level is always supported")
+{
+    CHECK(rl::get_is_simd_level_supported(rl::SimdLevel::Scalar));
+    CHECK(rl::get_is_simd_level_supported(rl::get_supported_simd_level()));
+}
+
+TEST_CASE("Every simd row converter matches the scalar rl::Bitmap::Row::Blit conversion")
+{
+    const std::vector<rl::SimdLevel> levels = { rl::SimdLevel::Ssse3, rl::SimdLevel::Avx2, rl::SimdLevel::Neon };
+    const std::vector<rl::Bitmap::Depth> depths = { rl::Bitmap::Depth::Octuple, rl::Bitmap::Depth::Sexdecuple, rl::Bitmap::Depth::Normalized, rl::Bitmap::Depth::Half };
+    const std::vector<rl::Bitmap::Color> colors = { rl::Bitmap::Color::G, rl::Bitmap::Color::Ga, rl::Bitmap::Color::Rgb, rl::Bitmap::Color::Rgba };
+    const std::vector<std::size_t> widths = { 1, 2, 5, 16, 17, 63, 250 };
+    for (const auto level : levels)
+    {
+        if (!rl::get_is_simd_level_supported(level))
+        {
+            continue;
+        }
+        for (const auto source_depth : depths)
+        {
+            for (const auto destination_depth : depths)
+            {
+                for (const auto source_color : colors)
+                {
+                    for (const auto destination_color : colors)
+                    {
+                        const auto converter = rl::Bitmap::GetRowConverter(level, source_depth, source_color, destination_depth, destination_color);
+                        if (converter == nullptr)
+                        {
+                            continue;
+                        }
+                        for (const auto width : widths)
+                        {
+                            INFO("level " << static_cast<int>(level) << " source depth " << static_cast<int>(source_depth) << " destination depth " << static_cast<int>(destination_depth) << " source color " << static_cast<int>(source_color) << " destination color " << static_cast<int>(destination_color) << " width " << width);
+                            rl::Image::Row source(width, source_depth, source_color);
+                            fill_test_row(source);
+                            rl::Image::Row scalar_destination(width, destination_depth, destination_color);
+                            rl::Image::Row simd_destination(width, destination_depth, destination_color);
+                            rl::Image::Row blit_destination(width, destination_depth, destination_color);
+                            REQUIRE(rl::set_simd_level(rl::SimdLevel::Scalar));
+                            scalar_destination.Blit(source);
+                            converter(source.GetData(), simd_destination.GetData(), width);
+                            REQUIRE(rl::set_simd_level(level));
+                            blit_destination.Blit(source);
+                            CHECK(std::memcmp(scalar_destination.GetData(), simd_destination.GetData(), scalar_destination.GetSize()) == 0);
+                            CHECK(std::memcmp(scalar_destination.GetData(), blit_destination.GetData(), scalar_destination.GetSize()) == 0);
+                        }
+                    }
+                }
+            }
+        }
+    }
+    rl::set_simd_level(rl::get_supported_simd_level());
+}
+
+TEST_CASE("Octuple to sexdecuple rows have a simd row converter at every simd level")
+{
+    for (const auto level : { rl::SimdLevel::Ssse3, rl::SimdLevel::Avx2, rl::SimdLevel::Neon })
+    {
+        if (!rl::get_is_simd_level_supported(level))
+        {
+            continue;
+        }
+        for (const auto color : { rl::Bitmap::Color::G, rl::Bitmap::Color::Ga, rl::Bitmap::Color::Rgb, rl::Bitmap::Color::Rgba })
+        {
+            const auto converter = rl::Bitmap::GetRowConverter(level, rl::Bitmap::Depth::Octuple, color, rl::Bitmap::Depth::Sexdecuple, color);
+            REQUIRE(converter != nullptr);
+            rl::Image::Row source(70, rl::Bitmap::Depth::Octuple, color);
+            fill_test_row(source);
+            rl::Image::Row destination(70, rl::Bitmap::Depth::Sexdecuple, color);
+            converter(source.GetData(), destination.GetData(), 70);
+            const auto* channels = reinterpret_cast<const rl::Bitmap::octuple_t*>(source.GetData());
+            const auto* wide_channels = reinterpret_cast<const rl::Bitmap::sexdecuple_t*>(destination.GetData());
+            for (std::size_t channel_i = 0; channel_i < 70 * rl::Bitmap::GetChannelCount(color); channel_i++)
+            {
+                CHECK(wide_channels[channel_i] == channels[channel_i] * 257);
+            }
+        }
+    }
+}
+
+TEST_CASE("Narrowing simd row converters round every edge value like the scalar converters")
+{
+    // every sexdecuple and finite half value, and normalized values around each rounding boundary and out of range
+    std::vector<rl::Bitmap::sexdecuple_t> sexdecuples;
+    std::vector<rl::Bitmap::half_t> halves;
+    for (std::size_t value_i = 0; value_i < 65536; value_i++)
+    {
+        sexdecuples.push_back(static_cast<rl::Bitmap::sexdecuple_t>(value_i));
+        if ((value_i & 0x7c00) != 0x7c00)
+        {
+            halves.push_back(static_cast<rl::Bitmap::half_t>(value_i));
+        }
+    }
+    std::vector<rl::Bitmap::normalized_t> normalizeds = {
+        -1.0f, -0.0f, 0.0f, std::numeric_limits<float>::denorm_min(), 1.0f, 1.5f, std::numeric_limits<float>::max(),
+        std::numeric_limits<float>::infinity(), -std::numeric_limits<float>::infinity()
+    };
+    for (const double max : { 255.0, 65535.0 })
+    {
+        for (double value = 0.0; value <= max; value++)
+        {
+            const auto boundary = static_cast<float>((value + 0.5) / max);
+            normalizeds.push_back(boundary);
+            normalizeds.push_back(std::nextafter(boundary, 0.0f));
+            normalizeds.push_back(std::nextafter(boundary, 2.0f));
+        }
+    }
+    const auto check_converter = [](rl::SimdLevel level, rl::Bitmap::Depth source_depth, rl::Bitmap::Depth destination_depth, const void* values, std::size_t width)
+    {
+        INFO("level " << static_cast<int>(level) << " source depth " << static_cast<int>(source_depth) << " destination depth " << static_cast<int>(destination_depth));
+        const auto converter = rl::Bitmap::GetRowConverter(level, source_depth, rl::Bitmap::Color::G, destination_depth, rl::Bitmap::Color::G);
+        // only avx2 and neon have half kernels
+        if (source_depth == rl::Bitmap::Depth::Half && converter == nullptr)
+        {
+            return;
+        }
+        REQUIRE(converter != nullptr);
+        rl::Image::Row source(width, source_depth, rl::Bitmap::Color::G);
+        std::memcpy(source.GetData(), values, source.GetSize());
+        rl::Image::Row scalar_destination(width, destination_depth, rl::Bitmap::Color::G);
+        rl::Image::Row simd_destination(width, destination_depth, rl::Bitmap::Color::G);
+        rl::Bitmap::GetRowConverter(source_depth, rl::Bitmap::Color::G, destination_depth, rl::Bitmap::Color::G)(source.GetData(), scalar_destination.GetData(), width);
+        converter(source.GetData(), simd_destination.GetData(), width);
+        CHECK(std::memcmp(scalar_destination.GetData(), simd_destination.GetData(), scalar_destination.GetSize()) == 0);
+    };
+    for (const auto level : { rl::SimdLevel::Ssse3, rl::SimdLevel::Avx2, rl::SimdLevel::Neon })
+    {
+        if (!rl::get_is_simd_level_supported(level))
+        {
+            continue;
+        }
+        check_converter(level, rl::Bitmap::Depth::Sexdecuple, rl::Bitmap::Depth::Octuple, sexdecuples.data(), sexdecuples.size());
+        for (const auto destination_depth : { rl::Bitmap::Depth::Octuple, rl::Bitmap::Depth::Sexdecuple })
+        {
+            check_converter(level, rl::Bitmap::Depth::Normalized, destination_depth, normalizeds.data(), normalizeds.size());
+            check_converter(level, rl::Bitmap::Depth::Half, destination_depth, halves.data(), halves.size());
+        }
+    }
+}
+
+TEST_CASE("Integer to floating point rl::Bitmap::Row::Blit conversions match the arithmetic row converters")
+{
+    const auto simd_level = GENERATE(rl::SimdLevel::Scalar, rl::get_supported_simd_level());
+    const auto source_depth = GENERATE(rl::Bitmap::Depth::Octuple, rl::Bitmap::Depth::Sexdecuple);
+    const auto destination_depth = GENERATE(rl::Bitmap::Depth::Normalized, rl::Bitmap::Depth::Half);
+    const std::vector<rl::Bitmap::Color> colors = { rl::Bitmap::Color::G, rl::Bitmap::Color::Ga, rl::Bitmap::Color::Rgb, rl::Bitmap::Color::Rgba };
+    const auto level = rl::get_simd_level();
+    rl::set_simd_level(simd_level);
+    for (const auto source_color : colors)
+    {
+        for (const auto destination_color : colors)
+        {
+            INFO("source color " << static_cast<int>(source_color) << " destination color " << static_cast<int>(destination_color));
+            const std::size_t width = 250;
+            rl::Image::Row source(width, source_depth, source_color);
+            fill_test_row(source);
+            rl::Image::Row arithmetic_destination(width, destination_depth, destination_color);
+            rl::Bitmap::GetRowConverter(source_depth, source_color, destination_depth, destination_color)(source.GetData(), arithmetic_destination.GetData(), width);
+            rl::Image::Row destination(width, destination_depth, destination_color);
+            destination.Blit(source);
+            CHECK(std::memcmp(arithmetic_destination.GetData(), destination.GetData(), destination.GetSize()) == 0);
+        }
+    }
+    rl::set_simd_level(level);
+}
+
+TEST_CASE("rl::Bitmap::GetNormalizedTable holds every integer channel value")
+{
+    const auto octuple_table = rl::Bitmap::GetNormalizedTable(rl::Bitmap::Depth::Octuple);
+    const auto sexdecuple_table = rl::Bitmap::GetNormalizedTable(rl::Bitmap::Depth::Sexdecuple);
+    REQUIRE(octuple_table.size() == 256);
+    REQUIRE(sexdecuple_table.size() == 65536);
+    CHECK(rl::Bitmap::GetNormalizedTable(rl::Bitmap::Depth::Normalized).empty());
+    // every sexdecuple value converts through the table in one row
+    rl::Image::Row sexdecuple(65536, rl::Bitmap::Depth::Sexdecuple, rl::Bitmap::Color::G);
+    for (std::size_t value_i = 0; value_i < 65536; value_i++)
+    {
+        reinterpret_cast<rl::Bitmap::sexdecuple_t*>(sexdecuple.GetData())[value_i] = static_cast<rl::Bitmap::sexdecuple_t>(value_i);
+    }
+    rl::Image::Row arithmetic_normalized(65536, rl::Bitmap::Depth::Normalized, rl::Bitmap::Color::G);
+    rl::Bitmap::GetRowConverter(rl::Bitmap::Depth::Sexdecuple, rl::Bitmap::Color::G, rl::Bitmap::Depth::Normalized, rl::Bitmap::Color::G)(sexdecuple.GetData(), arithmetic_normalized.GetData(), 65536);
+    CHECK(std::memcmp(arithmetic_normalized.GetData(), sexdecuple_table.data(), arithmetic_normalized.GetSize()) == 0);
+    CHECK(octuple_table[0] == 0.0f);
+    CHECK(octuple_table[255] == 1.0f);
+    SECTION("The linear tables decode srgb")
+    {
+        const auto linear_table = rl::Bitmap::GetNormalizedTable(rl::Bitmap::Depth::Octuple, true);
+        REQUIRE(linear_table.size() == 256);
+        CHECK(linear_table[0] == 0.0f);
+        CHECK(std::abs(linear_table[255] - 1.0f) <= 0.000001f);
+        CHECK(std::abs(linear_table[10] - 0.0030353f) <= 0.000001f);
+        CHECK(std::abs(linear_table[128] - 0.2158605f) <= 0.000001f);
+        CHECK(std::abs(rl::Bitmap::GetNormalizedTable(rl::Bitmap::Depth::Sexdecuple, true)[65535] - 1.0f) <= 0.000001f);
+    }
+}
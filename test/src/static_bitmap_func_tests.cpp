@@ -22,6 +22,8 @@
 
 #include <catch2/catch_all.hpp>
 #include <rla/Bitmap.hpp>
+#include <array>
+#include <vector>
 
 // clang-format off
 
@@ -201,4 +203,66 @@ TEST_CASE("A Bitmap byte index is calculated given a width, a height, a page cou
     CHECK(rl::Bitmap::GetByteIndex(512, 512, 512, rl::Bitmap::Depth::Sexdecuple, rl::Bitmap::Color::Rgb, 2000, 80000,  101,   0,   0, 1) == 608);
     CHECK(rl::Bitmap::GetByteIndex(512, 512, 512, rl::Bitmap::Depth::Sexdecuple, rl::Bitmap::Color::Rgb, 2000, 80000,    0, 101,   0, 2) == 202004);
     CHECK(rl::Bitmap::GetByteIndex(512, 512, 512, rl::Bitmap::Depth::Sexdecuple, rl::Bitmap::Color::Rgb, 2000, 80000,    0,   0, 101, 0) == 8080000);
-}
\ No newline at end of file
+}
+
+TEST_CASE("Tiled Bitmap sizes are determined given a width, a height, a page count, a rl::Bitmap::Depth, and a rl::Bitmap::Color")
+{
+    CHECK(rl::Bitmap::GetTileWidth() == 8);
+    CHECK(rl::Bitmap::GetTileSize(rl::Bitmap::Depth::Octuple,    rl::Bitmap::Color::G)    == 64);
+    CHECK(rl::Bitmap::GetTileSize(rl::Bitmap::Depth::Normalized, rl::Bitmap::Color::Rgba) == 1024);
+    CHECK(rl::Bitmap::GetTileRowSize(8,  rl::Bitmap::Depth::Octuple,    rl::Bitmap::Color::G)    == 64);
+    CHECK(rl::Bitmap::GetTileRowSize(17, rl::Bitmap::Depth::Octuple,    rl::Bitmap::Color::Rgb)  == 576);
+    CHECK(rl::Bitmap::GetPageSize(8,  8, rl::Bitmap::Depth::Octuple,    rl::Bitmap::Color::Rgba, rl::Bitmap::Layout::Tiled) == 256);
+    CHECK(rl::Bitmap::GetPageSize(10, 9, rl::Bitmap::Depth::Octuple,    rl::Bitmap::Color::G,    rl::Bitmap::Layout::Tiled) == 256);
+    CHECK(rl::Bitmap::GetPageSize(1,  1, rl::Bitmap::Depth::Sexdecuple, rl::Bitmap::Color::Ga,   rl::Bitmap::Layout::Tiled) == 256);
+    CHECK(rl::Bitmap::GetSize(10, 9, 3, rl::Bitmap::Depth::Octuple,     rl::Bitmap::Color::G,    rl::Bitmap::Layout::Tiled) == 768);
+    CHECK(rl::Bitmap::GetSize(10, 9, 3, rl::Bitmap::Depth::Octuple,     rl::Bitmap::Color::G,    rl::Bitmap::Layout::Linear) == 270);
+}
+
+TEST_CASE("A tiled Bitmap byte index is calculated given a width, a height, a page count, a rl::Bitmap::Depth, a rl::Bitmap::Color, a row offset, a page offset, an x, a y, a page, and a channel")
+{
+    CHECK(rl::Bitmap::GetByteIndex(16, 16, 2, rl::Bitmap::Depth::Octuple,    rl::Bitmap::Color::G,   128, 256,  16,  0, 0, 0, rl::Bitmap::Layout::Tiled) == std::nullopt);
+    CHECK(rl::Bitmap::GetByteIndex(16, 16, 2, rl::Bitmap::Depth::Octuple,    rl::Bitmap::Color::G,   128, 256,   0,  0, 0, 0, rl::Bitmap::Layout::Tiled) == 0);
+    CHECK(rl::Bitmap::GetByteIndex(16, 16, 2, rl::Bitmap::Depth::Octuple,    rl::Bitmap::Color::G,   128, 256,   1,  0, 0, 0, rl::Bitmap::Layout::Tiled) == 1);
+    CHECK(rl::Bitmap::GetByteIndex(16, 16, 2, rl::Bitmap::Depth::Octuple,    rl::Bitmap::Color::G,   128, 256,   0,  1, 0, 0, rl::Bitmap::Layout::Tiled) == 8);
+    CHECK(rl::Bitmap::GetByteIndex(16, 16, 2, rl::Bitmap::Depth::Octuple,    rl::Bitmap::Color::G,   128, 256,   8,  0, 0, 0, rl::Bitmap::Layout::Tiled) == 64);
+    CHECK(rl::Bitmap::GetByteIndex(16, 16, 2, rl::Bitmap::Depth::Octuple,    rl::Bitmap::Color::G,   128, 256,   9,  1, 0, 0, rl::Bitmap::Layout::Tiled) == 73);
+    CHECK(rl::Bitmap::GetByteIndex(16, 16, 2, rl::Bitmap::Depth::Octuple,    rl::Bitmap::Color::G,   128, 256,   0,  8, 0, 0, rl::Bitmap::Layout::Tiled) == 128);
+    CHECK(rl::Bitmap::GetByteIndex(16, 16, 2, rl::Bitmap::Depth::Octuple,    rl::Bitmap::Color::G,   128, 256,   9,  9, 1, 0, rl::Bitmap::Layout::Tiled) == 457);
+    CHECK(rl::Bitmap::GetByteIndex(16, 16, 2, rl::Bitmap::Depth::Sexdecuple, rl::Bitmap::Color::Rgb, 768, 1536,  9,  9, 1, 2, rl::Bitmap::Layout::Tiled) == 2746);
+}
+
+TEST_CASE("A planar Bitmap byte index is calculated given a width, a height, a page count, a rl::Bitmap::Depth, a rl::Bitmap::Color, a row offset, a page offset, an x, a y, a page, a channel, and a plane offset")
+{
+    CHECK(rl::Bitmap::GetByteIndex(16, 8, 2, rl::Bitmap::Depth::Octuple,    rl::Bitmap::Color::Rgb, 16, 384, 16, 0, 0, 0, rl::Bitmap::Layout::Planar, 128) == std::nullopt);
+    CHECK(rl::Bitmap::GetByteIndex(16, 8, 2, rl::Bitmap::Depth::Octuple,    rl::Bitmap::Color::Rgb, 16, 384,  0, 0, 0, 0, rl::Bitmap::Layout::Planar, 128) == 0);
+    CHECK(rl::Bitmap::GetByteIndex(16, 8, 2, rl::Bitmap::Depth::Octuple,    rl::Bitmap::Color::Rgb, 16, 384,  3, 0, 0, 0, rl::Bitmap::Layout::Planar, 128) == 3);
+    CHECK(rl::Bitmap::GetByteIndex(16, 8, 2, rl::Bitmap::Depth::Octuple,    rl::Bitmap::Color::Rgb, 16, 384,  3, 2, 0, 0, rl::Bitmap::Layout::Planar, 128) == 35);
+    CHECK(rl::Bitmap::GetByteIndex(16, 8, 2, rl::Bitmap::Depth::Octuple,    rl::Bitmap::Color::Rgb, 16, 384,  3, 2, 0, 2, rl::Bitmap::Layout::Planar, 128) == 291);
+    CHECK(rl::Bitmap::GetByteIndex(16, 8, 2, rl::Bitmap::Depth::Octuple,    rl::Bitmap::Color::Rgb, 16, 384,  3, 2, 1, 1, rl::Bitmap::Layout::Planar, 128) == 547);
+    CHECK(rl::Bitmap::GetByteIndex(16, 8, 2, rl::Bitmap::Depth::Normalized, rl::Bitmap::Color::Ga, 64, 1024, 3, 2, 1, 1, rl::Bitmap::Layout::Planar, 512) == 1676);
+}
+
+TEST_CASE("A Bitmap row converter is determined given a source and a destination rl::Bitmap::Depth and rl::Bitmap::Color")
+{
+    const std::vector<rl::Bitmap::Depth> depths = { rl::Bitmap::Depth::Octuple, rl::Bitmap::Depth::Sexdecuple, rl::Bitmap::Depth::Normalized };
+    const std::vector<rl::Bitmap::Color> colors = { rl::Bitmap::Color::G, rl::Bitmap::Color::Ga, rl::Bitmap::Color::Rgb, rl::Bitmap::Color::Rgba };
+    for (const auto source_depth : depths)
+    {
+        for (const auto source_color : colors)
+        {
+            for (const auto destination_depth : depths)
+            {
+                for (const auto destination_color : colors)
+                {
+                    CHECK(rl::Bitmap::GetRowConverter(source_depth, source_color, destination_depth, destination_color) != nullptr);
+                }
+            }
+        }
+    }
+    constexpr auto converter = rl::Bitmap::GetRowConverter(rl::Bitmap::Depth::Sexdecuple, rl::Bitmap::Color::Rgb, rl::Bitmap::Depth::Sexdecuple, rl::Bitmap::Color::Rgb);
+    const std::array<rl::Bitmap::sexdecuple_t, 6> source = { 1, 2, 3, 4000, 5000, 65535 };
+    std::array<rl::Bitmap::sexdecuple_t, 6> destination = {};
+    converter(reinterpret_cast<const rl::Bitmap::byte_t*>(source.data()), reinterpret_cast<rl::Bitmap::byte_t*>(destination.data()), 2);
+    CHECK(destination == source);
+}
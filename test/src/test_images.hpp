@@ -0,0 +1,96 @@
+// SPDX-FileCopyrightText: 2023 Daniel Aimé Valcour <fosssweeper@gmail.com>
+//
+// SPDX-License-Identifier: MIT
+
+/*
+    Copyright (c) 2023 Daniel Aimé Valcour
+    Permission is hereby granted, free of charge, to any person obtaining a copy of
+    this software and associated documentation files (the "Software"), to deal in
+    the Software without restriction, including without limitation the rights to
+    use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+    the Software, and to permit persons to whom the Software is furnished to do so,
+    subject to the following conditions:
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+    FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+    COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+    IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+    CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#pragma once
+
+#include <rla/Bitmap.hpp>
+#include <rla/Image.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <vector>
+
+// image helpers shared by the tests
+namespace rl::test
+{
+    // a byte pattern that is different for every byte of the image
+    inline void fill_test_image(rl::Image& image)
+    {
+        for (std::size_t byte_i = 0; byte_i < image.GetSize(); byte_i++)
+        {
+            image.GetData()[byte_i] = static_cast<rl::Bitmap::byte_t>(byte_i * 7 + 3);
+        }
+    }
+
+    // every byte of the image, row and tile padding included
+    inline std::vector<std::uint8_t> get_bytes(const rl::Image& image)
+    {
+        const auto* bytes = reinterpret_cast<const std::uint8_t*>(image.GetData());
+        return std::vector<std::uint8_t>(bytes, bytes + image.GetPageOffset() * image.GetPageCount());
+    }
+
+    inline bool get_is_same(const rl::Image& a, const rl::Image& b)
+    {
+        return a.GetSize() == b.GetSize() && std::memcmp(a.GetData(), b.GetData(), a.GetSize()) == 0;
+    }
+
+    // random channels with the padding included. float and half channels are kept in 0 to 1, so they are finite and
+    // blits between images of the same format copy them unchanged.
+    inline rl::Image make_noise_image(std::size_t width, std::size_t height, std::size_t page_count, rl::Bitmap::Depth depth, rl::Bitmap::Color color, rl::Bitmap::Layout layout = rl::Bitmap::Layout::Linear, rl::Bitmap::Alpha alpha = rl::Bitmap::Alpha::Default)
+    {
+        rl::Image image(width, height, page_count, depth, color, layout, 1, std::nullopt, alpha);
+        const std::size_t size = image.GetPageOffset() * image.GetPageCount();
+        std::uint32_t state = 0x2545f491;
+        const auto get_next = [&]()
+        {
+            state = state * 1664525 + 1013904223;
+            return state >> 16;
+        };
+        const auto store = [&](std::size_t channel_i, auto channel)
+        {
+            std::memcpy(image.GetData() + channel_i * sizeof(channel), &channel, sizeof(channel));
+        };
+        const std::size_t channel_size = rl::Bitmap::GetIsSubByte(depth) ? 1 : rl::Bitmap::GetChannelSize(depth);
+        for (std::size_t channel_i = 0; channel_i < size / channel_size; channel_i++)
+        {
+            switch (depth)
+            {
+                case rl::Bitmap::Depth::Sexdecuple:
+                    store(channel_i, static_cast<rl::Bitmap::sexdecuple_t>(get_next()));
+                    break;
+                case rl::Bitmap::Depth::Normalized:
+                    store(channel_i, static_cast<rl::Bitmap::normalized_t>(get_next() % 1024) / 1023.0f);
+                    break;
+                case rl::Bitmap::Depth::Half:
+                    // the positive halves up to one are the bit patterns up to 0x3c00
+                    store(channel_i, static_cast<rl::Bitmap::half_t>(get_next() % 0x3c01));
+                    break;
+                default:
+                    store(channel_i, static_cast<rl::Bitmap::octuple_t>(get_next()));
+                    break;
+            }
+        }
+        return image;
+    }
+}
@@ -0,0 +1,119 @@
+// SPDX-FileCopyrightText: 2023 Daniel Aimé Valcour <fosssweeper@gmail.com>
+//
+// SPDX-License-Identifier: MIT
+
+/*
+    Copyright (c) 2023 Daniel Aimé Valcour
+    Permission is hereby granted, free of charge, to any person obtaining a copy of
+    this software and associated documentation files (the "Software"), to deal in
+    the Software without restriction, including without limitation the rights to
+    use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+    the Software, and to permit persons to whom the Software is furnished to do so,
+    subject to the following conditions:
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+    FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+    COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+    IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+    CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include <catch2/catch_all.hpp>
+#include <rla/Image.hpp>
+#include <rla/TypedView.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <ranges>
+#include <vector>
+
+// clang-format off
+
+TEST_CASE("rl::TypedView rows and pixels point into the bitmap")
+{
+    rl::Image image(5, 3, 2, rl::Bitmap::Depth::Sexdecuple, rl::Bitmap::Color::Rgb, rl::Bitmap::Layout::Linear, 16);
+    const auto view = rl::TypedView<rl::Bitmap::Depth::Sexdecuple, rl::Bitmap::Color::Rgb>::Checked(image);
+    static_assert(std::ranges::random_access_range<decltype(view.GetRows())>);
+    static_assert(std::ranges::forward_range<decltype(view.GetPixels())>);
+    static_assert(std::is_same_v<decltype(view.GetRow(0)), std::span<const std::array<std::uint16_t, 3>>>);
+    CHECK(view.GetRowOffset() == image.GetRowOffset());
+    CHECK(view.GetPageOffset() == image.GetPageOffset());
+    for (std::size_t page = 0; page < 2; page++)
+    {
+        for (std::size_t y = 0; y < 3; y++)
+        {
+            CHECK(reinterpret_cast<const rl::Bitmap::byte_t*>(view.GetRow(y, page).data()) == image.GetData(0, y, page, 0));
+            for (std::size_t x = 0; x < 5; x++)
+            {
+                CHECK(reinterpret_cast<const rl::Bitmap::byte_t*>(&view.GetPixel(x, y, page)) == image.GetData(x, y, page, 0));
+            }
+        }
+    }
+    CHECK(std::ranges::distance(view.GetRows()) == 6);
+    std::size_t pixel_count = 0;
+    for ([[maybe_unused]] const auto& pixel : view.GetPixels())
+    {
+        pixel_count++;
+    }
+    CHECK(pixel_count == 30);
+}
+
+TEST_CASE("rl::TypedView pixels can be iterated over a temporary view")
+{
+    rl::Image image(3, 2, 2, rl::Bitmap::Depth::Octuple, rl::Bitmap::Color::G, rl::Bitmap::Layout::Linear, 4);
+    for (std::size_t page = 0; page < 2; page++)
+    {
+        for (std::size_t y = 0; y < 2; y++)
+        {
+            for (std::size_t x = 0; x < 3; x++)
+            {
+                image.GetData(x, y, page, 0)[0] = static_cast<rl::Bitmap::byte_t>(page * 6 + y * 3 + x);
+            }
+        }
+    }
+    // the view dies at the end of the range initializer, before the pixels are walked
+    std::vector<std::uint8_t> values;
+    for (const auto& pixel : rl::TypedView<rl::Bitmap::Depth::Octuple, rl::Bitmap::Color::G>::Checked(image).GetPixels())
+    {
+        values.push_back(pixel[0]);
+    }
+    CHECK(values == std::vector<std::uint8_t>{ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11 });
+}
+
+TEST_CASE("rl::TypedBitmap writes pixels through std::ranges")
+{
+    rl::Image image(4, 4, 2, rl::Bitmap::Depth::Normalized, rl::Bitmap::Color::Ga);
+    const auto bitmap = rl::TypedBitmap<rl::Bitmap::Depth::Normalized, rl::Bitmap::Color::Ga>::Checked(image);
+    std::ranges::fill(bitmap.GetPixels(), std::array<float, 2>{ 0.5f, 1.0f });
+    std::ranges::for_each(bitmap.GetRow(1, 1), [](auto& pixel) { pixel[0] = 0.25f; });
+    const rl::TypedView<rl::Bitmap::Depth::Normalized, rl::Bitmap::Color::Ga> view = bitmap;
+    for (std::size_t page = 0; page < 2; page++)
+    {
+        for (std::size_t y = 0; y < 4; y++)
+        {
+            for (std::size_t x = 0; x < 4; x++)
+            {
+                float channels[2];
+                std::memcpy(channels, image.GetData(x, y, page, 0), sizeof(channels));
+                CHECK(channels[0] == ((page == 1 && y == 1) ? 0.25f : 0.5f));
+                CHECK(channels[1] == 1.0f);
+                CHECK(view.GetPixel(x, y, page)[0] == channels[0]);
+            }
+        }
+    }
+}
+
+TEST_CASE("rl::TypedView::Checked throws for bitmaps the view can not point into")
+{
+    rl::Image image(8, 8, 1, rl::Bitmap::Depth::Sexdecuple, rl::Bitmap::Color::G);
+    CHECK_NOTHROW(rl::TypedView<rl::Bitmap::Depth::Sexdecuple, rl::Bitmap::Color::G>::Checked(image));
+    CHECK_THROWS(rl::TypedView<rl::Bitmap::Depth::Octuple, rl::Bitmap::Color::G>::Checked(image));
+    CHECK_THROWS(rl::TypedView<rl::Bitmap::Depth::Sexdecuple, rl::Bitmap::Color::Ga>::Checked(image));
+    const rl::Bitmap::View misaligned(image.GetData() + 1, 7, 7, 1, rl::Bitmap::Depth::Sexdecuple, rl::Bitmap::Color::G, image.GetRowOffset());
+    CHECK_THROWS(rl::TypedView<rl::Bitmap::Depth::Sexdecuple, rl::Bitmap::Color::G>::Checked(misaligned));
+    rl::Image tiled(8, 8, 1, rl::Bitmap::Depth::Octuple, rl::Bitmap::Color::Rgba, rl::Bitmap::Layout::Tiled);
+    CHECK_THROWS(rl::TypedBitmap<rl::Bitmap::Depth::Octuple, rl::Bitmap::Color::Rgba>::Checked(tiled));
+}